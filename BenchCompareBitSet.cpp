@@ -0,0 +1,542 @@
+#include "DynamicBitSet.hpp"
+
+#include <bitset>
+#include <memory>
+
+#include <benchmark/benchmark.h>
+
+#if defined( LARGE_DYNAMIC_BITSET_HAVE_BOOST )
+#include <boost/dynamic_bitset.hpp>
+#endif
+
+/*
+	DynamicBitSet 与其他比特集实现的对比基准测试
+	同一组负载分别运行在 DynamicBitSet、std::vector<bool>、std::bitset<N>，
+	以及找到 Boost 时的 boost::dynamic_bitset<uint64_t> 上。
+	负载：随机 set / test、批量 AND / OR / XOR、count、find-next (遍历所有为 1 的位)、左移、序列化为二进制字符串。
+
+	每个结果都带有 per_op (每次操作的耗时) 和 bytes_per_second (按比特集的字节数计算的吞吐量) 两个计数器，
+	名字的格式为 <负载>/<实现>/<比特数>，例如：
+		BenchCompareBitSet --benchmark_filter=Count/
+		BenchCompareBitSet --benchmark_format=json --benchmark_out=compare.json
+*/
+
+namespace
+{
+	using namespace TwilightDream;
+
+	constexpr size_t random_access_count = 4096;
+	constexpr size_t shift_distance = 13;
+
+	// 每个实现使用同一份随机数据
+	std::vector<uint32_t> random_chunks( size_t bit_count, uint32_t seed )
+	{
+		std::mt19937		  generator( seed );
+		std::vector<uint32_t> chunks( ( bit_count + 31 ) / 32 );
+		for ( auto& chunk : chunks )
+		{
+			chunk = generator();
+		}
+		return chunks;
+	}
+
+	std::vector<size_t> random_indices( size_t bit_count )
+	{
+		std::mt19937_64						  generator( 3 );
+		std::uniform_int_distribution<size_t> distribution( 0, bit_count - 1 );
+		std::vector<size_t>					  indices( random_access_count );
+		for ( auto& index : indices )
+		{
+			index = distribution( generator );
+		}
+		return indices;
+	}
+
+	/*
+		适配器：每个实现提供相同的接口
+		fill( seed ), set( index ), test( index ), and_assign / or_assign / xor_assign( other ),
+		count(), sum_of_set_positions() (find-next 遍历), shift_left( shift ), serialize()
+	*/
+
+	template <size_t Bits>
+	class DynamicBitSetAdapter
+	{
+	public:
+		static constexpr const char* name = "DynamicBitSet";
+
+		DynamicBitSetAdapter()
+			: bits( Bits, false )
+		{}
+
+		void fill( uint32_t seed )
+		{
+			const std::vector<uint32_t> chunks = random_chunks( Bits, seed );
+			for ( size_t index = 0; index < chunks.size(); ++index )
+			{
+				bits.chunk_data()[ index ].bits = chunks[ index ];
+			}
+		}
+
+		void set( size_t index )
+		{
+			bits.set_bit( true, index );
+		}
+
+		bool test( size_t index ) const
+		{
+			return bits.get_bit( index );
+		}
+
+		void and_assign( const DynamicBitSetAdapter& other )
+		{
+			bits.and_operation( other.bits );
+		}
+
+		void or_assign( const DynamicBitSetAdapter& other )
+		{
+			bits.or_operation( other.bits );
+		}
+
+		void xor_assign( const DynamicBitSetAdapter& other )
+		{
+			bits.xor_operation( other.bits );
+		}
+
+		size_t count() const
+		{
+			return bits.hamming_weight();
+		}
+
+		// find_next( pos ) 包含 pos 本身，find_next( 0 ) 就是第一个比特'1'
+		size_t sum_of_set_positions() const
+		{
+			size_t sum = 0;
+			for ( size_t index = bits.find_next( 0 ); index != DynamicBitSet::npos; index = bits.find_next( index + 1 ) )
+			{
+				sum += index;
+			}
+			return sum;
+		}
+
+		void shift_left( size_t shift )
+		{
+			bits.left_shift( shift );
+		}
+
+		std::string serialize() const
+		{
+			return bits.format_binary_string( true );
+		}
+
+	private:
+		DynamicBitSet bits;
+	};
+
+	template <size_t Bits>
+	class VectorBoolAdapter
+	{
+	public:
+		static constexpr const char* name = "std::vector<bool>";
+
+		VectorBoolAdapter()
+			: bits( Bits, false )
+		{}
+
+		void fill( uint32_t seed )
+		{
+			const std::vector<uint32_t> chunks = random_chunks( Bits, seed );
+			for ( size_t index = 0; index < Bits; ++index )
+			{
+				bits[ index ] = ( chunks[ index / 32 ] >> ( index % 32 ) ) & 1;
+			}
+		}
+
+		void set( size_t index )
+		{
+			bits[ index ] = true;
+		}
+
+		bool test( size_t index ) const
+		{
+			return bits[ index ];
+		}
+
+		// std::vector<bool> 没有按位运算，只能逐位处理
+		void and_assign( const VectorBoolAdapter& other )
+		{
+			std::transform( bits.begin(), bits.end(), other.bits.begin(), bits.begin(), std::logical_and<bool>() );
+		}
+
+		void or_assign( const VectorBoolAdapter& other )
+		{
+			std::transform( bits.begin(), bits.end(), other.bits.begin(), bits.begin(), std::logical_or<bool>() );
+		}
+
+		void xor_assign( const VectorBoolAdapter& other )
+		{
+			std::transform( bits.begin(), bits.end(), other.bits.begin(), bits.begin(), std::not_equal_to<bool>() );
+		}
+
+		size_t count() const
+		{
+			return std::count( bits.begin(), bits.end(), true );
+		}
+
+		size_t sum_of_set_positions() const
+		{
+			size_t sum = 0;
+			for ( auto it = std::find( bits.begin(), bits.end(), true ); it != bits.end(); it = std::find( it + 1, bits.end(), true ) )
+			{
+				sum += it - bits.begin();
+			}
+			return sum;
+		}
+
+		void shift_left( size_t shift )
+		{
+			std::copy_backward( bits.begin(), bits.end() - shift, bits.end() );
+			std::fill( bits.begin(), bits.begin() + shift, false );
+		}
+
+		std::string serialize() const
+		{
+			std::string result( Bits, '0' );
+			for ( size_t index = 0; index < Bits; ++index )
+			{
+				if ( bits[ index ] )
+				{
+					result[ Bits - 1 - index ] = '1';
+				}
+			}
+			return result;
+		}
+
+	private:
+		std::vector<bool> bits;
+	};
+
+	// std::bitset 放在堆上，避免大尺寸时栈溢出
+	template <size_t Bits>
+	class StdBitSetAdapter
+	{
+	public:
+		static constexpr const char* name = "std::bitset";
+
+		StdBitSetAdapter()
+			: bits( new std::bitset<Bits>() )
+		{}
+
+		void fill( uint32_t seed )
+		{
+			const std::vector<uint32_t> chunks = random_chunks( Bits, seed );
+			for ( size_t index = 0; index < Bits; ++index )
+			{
+				bits->set( index, ( chunks[ index / 32 ] >> ( index % 32 ) ) & 1 );
+			}
+		}
+
+		void set( size_t index )
+		{
+			bits->set( index );
+		}
+
+		bool test( size_t index ) const
+		{
+			return bits->test( index );
+		}
+
+		void and_assign( const StdBitSetAdapter& other )
+		{
+			*bits &= *other.bits;
+		}
+
+		void or_assign( const StdBitSetAdapter& other )
+		{
+			*bits |= *other.bits;
+		}
+
+		void xor_assign( const StdBitSetAdapter& other )
+		{
+			*bits ^= *other.bits;
+		}
+
+		size_t count() const
+		{
+			return bits->count();
+		}
+
+		size_t sum_of_set_positions() const
+		{
+			size_t sum = 0;
+#if defined( __GLIBCXX__ )
+			for ( size_t index = bits->_Find_first(); index < Bits; index = bits->_Find_next( index ) )
+			{
+				sum += index;
+			}
+#else
+			for ( size_t index = 0; index < Bits; ++index )
+			{
+				if ( bits->test( index ) )
+				{
+					sum += index;
+				}
+			}
+#endif
+			return sum;
+		}
+
+		void shift_left( size_t shift )
+		{
+			*bits <<= shift;
+		}
+
+		std::string serialize() const
+		{
+			return bits->to_string();
+		}
+
+	private:
+		std::unique_ptr<std::bitset<Bits>> bits;
+	};
+
+#if defined( LARGE_DYNAMIC_BITSET_HAVE_BOOST )
+	template <size_t Bits>
+	class BoostDynamicBitSetAdapter
+	{
+	public:
+		static constexpr const char* name = "boost::dynamic_bitset";
+
+		BoostDynamicBitSetAdapter()
+			: bits( Bits )
+		{}
+
+		void fill( uint32_t seed )
+		{
+			const std::vector<uint32_t> chunks = random_chunks( Bits, seed );
+			for ( size_t index = 0; index < Bits; ++index )
+			{
+				bits.set( index, ( chunks[ index / 32 ] >> ( index % 32 ) ) & 1 );
+			}
+		}
+
+		void set( size_t index )
+		{
+			bits.set( index );
+		}
+
+		bool test( size_t index ) const
+		{
+			return bits.test( index );
+		}
+
+		void and_assign( const BoostDynamicBitSetAdapter& other )
+		{
+			bits &= other.bits;
+		}
+
+		void or_assign( const BoostDynamicBitSetAdapter& other )
+		{
+			bits |= other.bits;
+		}
+
+		void xor_assign( const BoostDynamicBitSetAdapter& other )
+		{
+			bits ^= other.bits;
+		}
+
+		size_t count() const
+		{
+			return bits.count();
+		}
+
+		size_t sum_of_set_positions() const
+		{
+			size_t sum = 0;
+			for ( size_t index = bits.find_first(); index != bits.npos; index = bits.find_next( index ) )
+			{
+				sum += index;
+			}
+			return sum;
+		}
+
+		void shift_left( size_t shift )
+		{
+			bits <<= shift;
+		}
+
+		std::string serialize() const
+		{
+			std::string result;
+			boost::to_string( bits, result );
+			return result;
+		}
+
+	private:
+		boost::dynamic_bitset<uint64_t> bits;
+	};
+#endif
+
+	constexpr size_t bitset_bytes( size_t bit_count )
+	{
+		return ( bit_count + 7 ) / 8;
+	}
+
+	// 每次迭代执行 operations 次操作、访问 bytes 字节
+	void report( benchmark::State& state, size_t operations, size_t bytes )
+	{
+		state.counters[ "per_op" ] = benchmark::Counter( double( operations ), benchmark::Counter::kIsIterationInvariantRate | benchmark::Counter::kInvert );
+		state.SetBytesProcessed( int64_t( state.iterations() ) * int64_t( bytes ) );
+	}
+
+	/* 负载 */
+
+	template <typename Adapter, size_t Bits>
+	void BM_RandomSet( benchmark::State& state )
+	{
+		Adapter					  bits;
+		const std::vector<size_t> indices = random_indices( Bits );
+		for ( auto _ : state )
+		{
+			for ( size_t index : indices )
+			{
+				bits.set( index );
+			}
+			benchmark::ClobberMemory();
+		}
+		report( state, indices.size(), indices.size() * sizeof( uint64_t ) );
+	}
+
+	template <typename Adapter, size_t Bits>
+	void BM_RandomTest( benchmark::State& state )
+	{
+		Adapter bits;
+		bits.fill( 1 );
+		const std::vector<size_t> indices = random_indices( Bits );
+		for ( auto _ : state )
+		{
+			size_t count = 0;
+			for ( size_t index : indices )
+			{
+				count += bits.test( index );
+			}
+			benchmark::DoNotOptimize( count );
+		}
+		report( state, indices.size(), indices.size() * sizeof( uint64_t ) );
+	}
+
+	template <typename Adapter, size_t Bits, void ( Adapter::*Operation )( const Adapter& )>
+	void BM_Bulk( benchmark::State& state )
+	{
+		Adapter left;
+		Adapter right;
+		left.fill( 1 );
+		right.fill( 2 );
+		for ( auto _ : state )
+		{
+			( left.*Operation )( right );
+			benchmark::ClobberMemory();
+		}
+		report( state, 1, bitset_bytes( Bits ) * 2 );
+	}
+
+	template <typename Adapter, size_t Bits>
+	void BM_Count( benchmark::State& state )
+	{
+		Adapter bits;
+		bits.fill( 1 );
+		for ( auto _ : state )
+		{
+			benchmark::DoNotOptimize( bits.count() );
+		}
+		report( state, 1, bitset_bytes( Bits ) );
+	}
+
+	template <typename Adapter, size_t Bits>
+	void BM_FindNext( benchmark::State& state )
+	{
+		Adapter bits;
+		bits.fill( 1 );
+		for ( auto _ : state )
+		{
+			benchmark::DoNotOptimize( bits.sum_of_set_positions() );
+		}
+		report( state, 1, bitset_bytes( Bits ) );
+	}
+
+	template <typename Adapter, size_t Bits>
+	void BM_ShiftLeft( benchmark::State& state )
+	{
+		Adapter bits;
+		bits.fill( 1 );
+		for ( auto _ : state )
+		{
+			bits.shift_left( shift_distance );
+			benchmark::ClobberMemory();
+		}
+		report( state, 1, bitset_bytes( Bits ) );
+	}
+
+	template <typename Adapter, size_t Bits>
+	void BM_Serialize( benchmark::State& state )
+	{
+		Adapter bits;
+		bits.fill( 1 );
+		for ( auto _ : state )
+		{
+			std::string result = bits.serialize();
+			benchmark::DoNotOptimize( result.data() );
+		}
+		report( state, 1, bitset_bytes( Bits ) );
+	}
+
+	template <typename Adapter, size_t Bits>
+	void register_workload( const char* workload, void ( *function )( benchmark::State& ) )
+	{
+		const std::string name = std::string( workload ) + "/" + Adapter::name + "/" + std::to_string( Bits );
+		benchmark::RegisterBenchmark( name.c_str(), function )->Unit( benchmark::kNanosecond );
+	}
+
+	template <template <size_t> class AdapterTemplate, size_t Bits>
+	void register_size_class()
+	{
+		using Adapter = AdapterTemplate<Bits>;
+		register_workload<Adapter, Bits>( "RandomSet", BM_RandomSet<Adapter, Bits> );
+		register_workload<Adapter, Bits>( "RandomTest", BM_RandomTest<Adapter, Bits> );
+		register_workload<Adapter, Bits>( "And", BM_Bulk<Adapter, Bits, &Adapter::and_assign> );
+		register_workload<Adapter, Bits>( "Or", BM_Bulk<Adapter, Bits, &Adapter::or_assign> );
+		register_workload<Adapter, Bits>( "Xor", BM_Bulk<Adapter, Bits, &Adapter::xor_assign> );
+		register_workload<Adapter, Bits>( "Count", BM_Count<Adapter, Bits> );
+		register_workload<Adapter, Bits>( "FindNext", BM_FindNext<Adapter, Bits> );
+		register_workload<Adapter, Bits>( "ShiftLeft", BM_ShiftLeft<Adapter, Bits> );
+		register_workload<Adapter, Bits>( "Serialize", BM_Serialize<Adapter, Bits> );
+	}
+
+	// 规模分类：一个字、L1、L2 / L3、超出缓存
+	template <template <size_t> class AdapterTemplate>
+	void register_library()
+	{
+		register_size_class<AdapterTemplate, size_t( 1 ) << 6>();
+		register_size_class<AdapterTemplate, size_t( 1 ) << 12>();
+		register_size_class<AdapterTemplate, size_t( 1 ) << 18>();
+		register_size_class<AdapterTemplate, size_t( 1 ) << 24>();
+	}
+}  // namespace
+
+auto main( int argument_cout, char* argument_vector[] ) -> int
+{
+	register_library<DynamicBitSetAdapter>();
+	register_library<VectorBoolAdapter>();
+	register_library<StdBitSetAdapter>();
+#if defined( LARGE_DYNAMIC_BITSET_HAVE_BOOST )
+	register_library<BoostDynamicBitSetAdapter>();
+#endif
+
+	benchmark::Initialize( &argument_cout, argument_vector );
+	if ( benchmark::ReportUnrecognizedArguments( argument_cout, argument_vector ) )
+	{
+		return 1;
+	}
+	benchmark::RunSpecifiedBenchmarks();
+	benchmark::Shutdown();
+	return 0;
+}
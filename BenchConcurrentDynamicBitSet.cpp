@@ -0,0 +1,127 @@
+#include "ConcurrentDynamicBitSet.hpp"
+
+#include <mutex>
+#include <thread>
+#include <functional>
+
+/*
+	ConcurrentDynamicBitSet 的竞争基准测试 (contention benchmark)
+	每种场景分别使用 1, 2, 4, ... 个线程运行，输出总吞吐量 (Mops/s)：
+	- fetch_set (disjoint):  每个线程写自己的区间，只有真正的并行开销
+	- fetch_set (shared):    所有线程随机写同一个小区间，cache line 竞争最激烈
+	- test_and_set (shared): 同上，但先检查再写
+	- find_first_zero_and_set: 所有线程并发分配槽位，直到比特集被占满
+	- mutex + DynamicBitSet: 用互斥锁保护普通 DynamicBitSet 的 set_bit，作为对照
+*/
+
+namespace
+{
+	using namespace TwilightDream;
+
+	double run_threads( size_t thread_count, const std::function<void( size_t )>& body )
+	{
+		std::vector<std::thread> workers;
+		auto					 start = std::chrono::high_resolution_clock::now();
+		for ( size_t thread_index = 0; thread_index < thread_count; ++thread_index )
+		{
+			workers.emplace_back( body, thread_index );
+		}
+		for ( auto& worker : workers )
+		{
+			worker.join();
+		}
+		auto						  end = std::chrono::high_resolution_clock::now();
+		std::chrono::duration<double> elapsed = end - start;
+		return elapsed.count();
+	}
+
+	void report( const char* name, size_t thread_count, size_t operations, double seconds )
+	{
+		std::cout << std::left << std::setw( 28 ) << name << " threads=" << std::setw( 3 ) << thread_count << " " << std::fixed << std::setprecision( 2 ) << ( operations / seconds / 1e6 ) << " Mops/s\n";
+	}
+}  // namespace
+
+auto main( int argument_cout, char* argument_vector[] ) -> int
+{
+	const size_t operations_per_thread = argument_cout > 1 ? std::stoull( argument_vector[ 1 ] ) : 1000000;
+	size_t		 max_threads = std::thread::hardware_concurrency();
+	if ( max_threads == 0 )
+	{
+		max_threads = 1;
+	}
+
+	for ( size_t thread_count = 1; thread_count <= max_threads; thread_count *= 2 )
+	{
+		const size_t total_operations = operations_per_thread * thread_count;
+
+		{
+			ConcurrentDynamicBitSet bits( total_operations );
+			double					seconds = run_threads( thread_count, [ & ]( size_t thread_index ) {
+				   const size_t base = thread_index * operations_per_thread;
+				   for ( size_t i = 0; i < operations_per_thread; ++i )
+				   {
+					   bits.fetch_set( base + i );
+				   }
+			   } );
+			report( "fetch_set (disjoint)", thread_count, total_operations, seconds );
+		}
+
+		{
+			ConcurrentDynamicBitSet bits( 4096 );
+			double					seconds = run_threads( thread_count, [ & ]( size_t thread_index ) {
+				   std::minstd_rand generator( static_cast<uint32_t>( thread_index + 1 ) );
+				   for ( size_t i = 0; i < operations_per_thread; ++i )
+				   {
+					   bits.fetch_set( generator() % 4096 );
+				   }
+			   } );
+			report( "fetch_set (shared)", thread_count, total_operations, seconds );
+		}
+
+		{
+			ConcurrentDynamicBitSet bits( 4096 );
+			double					seconds = run_threads( thread_count, [ & ]( size_t thread_index ) {
+				   std::minstd_rand generator( static_cast<uint32_t>( thread_index + 1 ) );
+				   for ( size_t i = 0; i < operations_per_thread; ++i )
+				   {
+					   bits.test_and_set( generator() % 4096 );
+				   }
+			   } );
+			report( "test_and_set (shared)", thread_count, total_operations, seconds );
+		}
+
+		{
+			ConcurrentDynamicBitSet bits( total_operations );
+			double					seconds = run_threads( thread_count, [ & ]( size_t ) {
+				   for ( size_t i = 0; i < operations_per_thread; ++i )
+				   {
+					   bits.find_first_zero_and_set();
+				   }
+			   } );
+			// 每个槽位必须恰好分配一次；Release 构建中 assert 不起作用，所以总是检查
+			if ( bits.hamming_weight() != total_operations )
+			{
+				std::cerr << "find_first_zero_and_set: " << bits.hamming_weight() << " slots set after " << total_operations << " allocations with " << thread_count << " threads\n";
+				return 1;
+			}
+			report( "find_first_zero_and_set", thread_count, total_operations, seconds );
+		}
+
+		{
+			DynamicBitSet bits( 4096, false );
+			std::mutex	  mutex;
+			double		  seconds = run_threads( thread_count, [ & ]( size_t thread_index ) {
+				  std::minstd_rand generator( static_cast<uint32_t>( thread_index + 1 ) );
+				  for ( size_t i = 0; i < operations_per_thread; ++i )
+				  {
+					  const size_t				 index = generator() % 4096;
+					  std::lock_guard<std::mutex> lock( mutex );
+					  bits.set_bit( true, index );
+				  }
+			  } );
+			report( "mutex + DynamicBitSet", thread_count, total_operations, seconds );
+		}
+	}
+
+	return 0;
+}
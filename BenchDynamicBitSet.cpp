@@ -0,0 +1,1764 @@
+#include "DynamicBitSet.hpp"
+#include "PersistentDynamicBitSet.hpp"
+#include "TrackedDynamicBitSet.hpp"
+#include "CopyOnWriteDynamicBitSet.hpp"
+#include "HierarchicalDynamicBitSet.hpp"
+#include "PackedIntArray.hpp"
+#include "EliasFanoSequence.hpp"
+
+#include <benchmark/benchmark.h>
+
+/*
+	DynamicBitSet 的微基准测试集 (Google Benchmark)
+	每个操作都在 64 比特到 1 Gbit 的多个规模上运行 (按 8 倍递增)。
+	逐比特实现的操作 (字符串转换、insert / erase、subset / concat、迭代器等) 的规模上限更小，
+	十进制字符串转换是 O(n^2) 的，只测到 4096 比特；小位移的旋转只测到 256 Kbit。
+
+	输出机器可读的 JSON 以便追踪性能回归：
+		BenchLargeDynamicBitSet --benchmark_format=json --benchmark_out=dynamic_bitset.json
+	只运行一部分：
+		BenchLargeDynamicBitSet --benchmark_filter=BM_Hamming
+*/
+
+namespace
+{
+	using namespace TwilightDream;
+
+	constexpr int64_t minimum_bits = 64;
+	constexpr int64_t maximum_bits = int64_t( 1 ) << 30;  // 1 Gbit
+	constexpr int64_t per_bit_maximum_bits = int64_t( 1 ) << 24;
+	constexpr int64_t quadratic_maximum_bits = 4096;
+	// 小位移的旋转内部会执行一次接近整个长度的 operator>>= (每次最多移动 24 位)，也是 O(n^2)
+	constexpr int64_t small_rotate_maximum_bits = int64_t( 1 ) << 18;
+
+	// 生成 bit_count 个比特的随机块，最高位固定为 1，保证 DynamicBitSet 的有效比特数等于 bit_count
+	std::vector<uint32_t> random_chunks( size_t bit_count, uint32_t seed )
+	{
+		std::mt19937		  generator( seed );
+		std::vector<uint32_t> chunks( ( bit_count + 31 ) / 32 );
+		for ( auto& chunk : chunks )
+		{
+			chunk = generator();
+		}
+
+		const size_t top_bit = ( bit_count - 1 ) % 32;
+		chunks.back() &= top_bit == 31 ? 0xFFFFFFFF : ( ( uint32_t( 1 ) << ( top_bit + 1 ) ) - 1 );
+		chunks.back() |= uint32_t( 1 ) << top_bit;
+		return chunks;
+	}
+
+	DynamicBitSet random_bitset( size_t bit_count, uint32_t seed = 1 )
+	{
+		return DynamicBitSet( random_chunks( bit_count, seed ) );
+	}
+
+	std::vector<size_t> random_indices( size_t bit_count, size_t count, uint32_t seed = 2 )
+	{
+		std::mt19937_64						  generator( seed );
+		std::uniform_int_distribution<size_t> distribution( 0, bit_count - 1 );
+		std::vector<size_t>					  indices( count );
+		for ( auto& index : indices )
+		{
+			index = distribution( generator );
+		}
+		return indices;
+	}
+
+	// 每次迭代处理的比特块字节数
+	void set_bytes( benchmark::State& state, size_t bit_count, size_t passes = 1 )
+	{
+		state.SetBytesProcessed( int64_t( state.iterations() ) * int64_t( ( bit_count + 31 ) / 32 * sizeof( uint32_t ) * passes ) );
+	}
+
+	void set_bits( benchmark::State& state, size_t bit_count )
+	{
+		state.SetItemsProcessed( int64_t( state.iterations() ) * int64_t( bit_count ) );
+	}
+
+	/* 构造 */
+
+	void BM_ConstructFilled( benchmark::State& state )
+	{
+		const size_t bit_count = state.range( 0 );
+		for ( auto _ : state )
+		{
+			DynamicBitSet bits( bit_count, true );
+			benchmark::DoNotOptimize( bits.chunk_data() );
+		}
+		set_bytes( state, bit_count );
+	}
+
+	void BM_ConstructFromUint32Vector( benchmark::State& state )
+	{
+		const size_t				bit_count = state.range( 0 );
+		const std::vector<uint32_t> chunks = random_chunks( bit_count, 1 );
+		for ( auto _ : state )
+		{
+			DynamicBitSet bits( chunks );
+			benchmark::DoNotOptimize( bits.chunk_data() );
+		}
+		set_bytes( state, bit_count );
+	}
+
+	void BM_ConstructFromUint64Vector( benchmark::State& state )
+	{
+		const size_t		  bit_count = state.range( 0 );
+		std::vector<uint64_t> words( ( bit_count + 63 ) / 64, 0x0123456789ABCDEFULL );
+		for ( auto _ : state )
+		{
+			DynamicBitSet bits( words );
+			benchmark::DoNotOptimize( bits.chunk_data() );
+		}
+		set_bytes( state, bit_count );
+	}
+
+	void BM_ConstructFromBoolVector( benchmark::State& state )
+	{
+		const size_t			bit_count = state.range( 0 );
+		const std::vector<bool> bools = random_bitset( bit_count ).bit_vector_data();
+		for ( auto _ : state )
+		{
+			DynamicBitSet bits( bools );
+			benchmark::DoNotOptimize( bits.chunk_data() );
+		}
+		set_bits( state, bit_count );
+	}
+
+	void BM_Copy( benchmark::State& state )
+	{
+		const size_t		bit_count = state.range( 0 );
+		const DynamicBitSet source = random_bitset( bit_count );
+		for ( auto _ : state )
+		{
+			DynamicBitSet bits( source );
+			benchmark::DoNotOptimize( bits.chunk_data() );
+		}
+		set_bytes( state, bit_count );
+	}
+
+	// 写时复制：复制只增加引用计数
+	void BM_CopyOnWriteCopy( benchmark::State& state )
+	{
+		const size_t				   bit_count = state.range( 0 );
+		const CopyOnWriteDynamicBitSet source( random_bitset( bit_count ) );
+		for ( auto _ : state )
+		{
+			CopyOnWriteDynamicBitSet bits( source );
+			benchmark::DoNotOptimize( &bits );
+		}
+		set_bytes( state, bit_count );
+	}
+
+	// 复制之后修改一个比特 (复制块表和一个块)，对应"按值传入再做少量修改"的用法
+	void BM_CopyOnWriteCopyAndSetBit( benchmark::State& state )
+	{
+		const size_t				   bit_count = state.range( 0 );
+		const CopyOnWriteDynamicBitSet source( random_bitset( bit_count ) );
+		for ( auto _ : state )
+		{
+			CopyOnWriteDynamicBitSet bits( source );
+			bits.flip( bit_count / 2 );
+			benchmark::DoNotOptimize( bits.block_data( 0 ) );
+		}
+		set_bytes( state, bit_count );
+	}
+
+	/* 持久化版本 (每个新版本相对上一个版本修改少量比特) */
+
+	// 修改一个比特：复制根到叶子的路径
+	void BM_PersistentWithBit( benchmark::State& state )
+	{
+		const size_t				  bit_count = state.range( 0 );
+		const PersistentDynamicBitSet base( random_bitset( bit_count ) );
+		const std::vector<size_t>	  indices = random_indices( bit_count, 1024 );
+		size_t						  next = 0;
+		for ( auto _ : state )
+		{
+			PersistentDynamicBitSet version = base.with_flipped( indices[ next++ % indices.size() ] );
+			benchmark::DoNotOptimize( &version );
+		}
+		set_bytes( state, bit_count );
+	}
+
+	// 一次修改 4096 个比特
+	void BM_PersistentWithBits( benchmark::State& state )
+	{
+		const size_t				  bit_count = state.range( 0 );
+		const PersistentDynamicBitSet base( random_bitset( bit_count ) );
+		const std::vector<size_t>	  indices = random_indices( bit_count, 4096 );
+		for ( auto _ : state )
+		{
+			PersistentDynamicBitSet version = base.with_bits( true, indices );
+			benchmark::DoNotOptimize( &version );
+		}
+		set_bytes( state, bit_count );
+	}
+
+	// 两个只相差 4096 个比特的版本求交，共享的子树按指针跳过
+	void BM_PersistentAndVersions( benchmark::State& state )
+	{
+		const size_t				  bit_count = state.range( 0 );
+		const PersistentDynamicBitSet base( random_bitset( bit_count ) );
+		const PersistentDynamicBitSet version = base.with_bits( false, random_indices( bit_count, 4096 ) );
+		for ( auto _ : state )
+		{
+			PersistentDynamicBitSet result = base & version;
+			benchmark::DoNotOptimize( &result );
+		}
+		set_bytes( state, bit_count );
+	}
+
+	/* 增量同步 (自检查点以来修改了 1024 个随机比特) */
+
+	void BM_TrackedExportDelta( benchmark::State& state )
+	{
+		const size_t		 bit_count = state.range( 0 );
+		TrackedDynamicBitSet bits( random_bitset( bit_count ) );
+		for ( size_t index : random_indices( bit_count, 1024 ) )
+		{
+			bits.flip( index );
+		}
+		for ( auto _ : state )
+		{
+			std::vector<uint8_t> delta = bits.export_delta();
+			benchmark::DoNotOptimize( delta.data() );
+		}
+		set_bytes( state, bit_count );
+	}
+
+	// 没有脏块记录时只能逐块比较两个完整的副本
+	void BM_MakeDeltaFullCompare( benchmark::State& state )
+	{
+		const size_t		bit_count = state.range( 0 );
+		const DynamicBitSet base = random_bitset( bit_count );
+		DynamicBitSet		current = base;
+		for ( size_t index : random_indices( bit_count, 1024 ) )
+		{
+			current.set_bit( !current.get_bit( index ), index );
+		}
+		for ( auto _ : state )
+		{
+			std::vector<uint8_t> delta = TrackedDynamicBitSet::make_delta( base, current );
+			benchmark::DoNotOptimize( delta.data() );
+		}
+		set_bytes( state, bit_count );
+	}
+
+	void BM_TrackedApplyDelta( benchmark::State& state )
+	{
+		const size_t		 bit_count = state.range( 0 );
+		TrackedDynamicBitSet primary( random_bitset( bit_count ) );
+		TrackedDynamicBitSet replica( primary.bits() );
+		for ( size_t index : random_indices( bit_count, 1024 ) )
+		{
+			primary.flip( index );
+		}
+		const std::vector<uint8_t> delta = primary.export_delta();
+		for ( auto _ : state )
+		{
+			replica.apply_delta( delta );
+			replica.checkpoint();
+			benchmark::ClobberMemory();
+		}
+		set_bytes( state, bit_count );
+	}
+
+	/* 单个比特的访问 */
+
+	void BM_GetBit( benchmark::State& state )
+	{
+		const size_t			  bit_count = state.range( 0 );
+		const DynamicBitSet		  bits = random_bitset( bit_count );
+		const std::vector<size_t> indices = random_indices( bit_count, 4096 );
+		for ( auto _ : state )
+		{
+			size_t count = 0;
+			for ( size_t index : indices )
+			{
+				count += bits.get_bit( index );
+			}
+			benchmark::DoNotOptimize( count );
+		}
+		state.SetItemsProcessed( int64_t( state.iterations() ) * int64_t( indices.size() ) );
+	}
+
+	void BM_SetBit( benchmark::State& state )
+	{
+		const size_t			  bit_count = state.range( 0 );
+		DynamicBitSet			  bits = random_bitset( bit_count );
+		const std::vector<size_t> indices = random_indices( bit_count, 4096 );
+		for ( auto _ : state )
+		{
+			for ( size_t index : indices )
+			{
+				bits.set_bit( true, index );
+			}
+			benchmark::ClobberMemory();
+		}
+		state.SetItemsProcessed( int64_t( state.iterations() ) * int64_t( indices.size() ) );
+	}
+
+	void BM_SubscriptOperator( benchmark::State& state )
+	{
+		const size_t			  bit_count = state.range( 0 );
+		DynamicBitSet			  bits = random_bitset( bit_count );
+		const std::vector<size_t> indices = random_indices( bit_count, 4096 );
+		for ( auto _ : state )
+		{
+			for ( size_t index : indices )
+			{
+				bits[ index ] = true;
+			}
+			benchmark::ClobberMemory();
+		}
+		state.SetItemsProcessed( int64_t( state.iterations() ) * int64_t( indices.size() ) );
+	}
+
+	void BM_Flip( benchmark::State& state )
+	{
+		const size_t			  bit_count = state.range( 0 );
+		DynamicBitSet			  bits = random_bitset( bit_count );
+		const std::vector<size_t> indices = random_indices( bit_count, 4096 );
+		for ( auto _ : state )
+		{
+			for ( size_t index : indices )
+			{
+				bits.flip( index );
+			}
+			benchmark::ClobberMemory();
+		}
+		state.SetItemsProcessed( int64_t( state.iterations() ) * int64_t( indices.size() ) );
+	}
+
+	void BM_SetUnchecked( benchmark::State& state )
+	{
+		const size_t			  bit_count = state.range( 0 );
+		DynamicBitSet			  bits = random_bitset( bit_count );
+		const std::vector<size_t> indices = random_indices( bit_count, 4096 );
+		for ( auto _ : state )
+		{
+			for ( size_t index : indices )
+			{
+				bits.set_unchecked( index );
+			}
+			benchmark::ClobberMemory();
+		}
+		state.SetItemsProcessed( int64_t( state.iterations() ) * int64_t( indices.size() ) );
+	}
+
+	void BM_TestUnchecked( benchmark::State& state )
+	{
+		const size_t			  bit_count = state.range( 0 );
+		const DynamicBitSet		  bits = random_bitset( bit_count );
+		const std::vector<size_t> indices = random_indices( bit_count, 4096 );
+		for ( auto _ : state )
+		{
+			size_t count = 0;
+			for ( size_t index : indices )
+			{
+				count += bits.test_unchecked( index );
+			}
+			benchmark::DoNotOptimize( count );
+		}
+		state.SetItemsProcessed( int64_t( state.iterations() ) * int64_t( indices.size() ) );
+	}
+
+	void BM_SetMany( benchmark::State& state )
+	{
+		const size_t			  bit_count = state.range( 0 );
+		DynamicBitSet			  bits = random_bitset( bit_count );
+		const std::vector<size_t> indices = random_indices( bit_count, 65536 );
+		for ( auto _ : state )
+		{
+			bits.set_many( indices );
+			benchmark::ClobberMemory();
+		}
+		state.SetItemsProcessed( int64_t( state.iterations() ) * int64_t( indices.size() ) );
+	}
+
+	void BM_TestMany( benchmark::State& state )
+	{
+		const size_t			  bit_count = state.range( 0 );
+		const DynamicBitSet		  bits = random_bitset( bit_count );
+		const std::vector<size_t> indices = random_indices( bit_count, 65536 );
+		std::unique_ptr<bool[]>	  results( new bool[ indices.size() ] );
+		for ( auto _ : state )
+		{
+			bits.test_many( indices.data(), indices.size(), results.get() );
+			benchmark::DoNotOptimize( results.get() );
+		}
+		state.SetItemsProcessed( int64_t( state.iterations() ) * int64_t( indices.size() ) );
+	}
+
+	/* 整体的填充与统计 */
+
+	void BM_SetAll( benchmark::State& state )
+	{
+		const size_t  bit_count = state.range( 0 );
+		DynamicBitSet bits = random_bitset( bit_count );
+		for ( auto _ : state )
+		{
+			bits.set();
+			benchmark::ClobberMemory();
+		}
+		set_bytes( state, bit_count );
+	}
+
+	void BM_ResetAll( benchmark::State& state )
+	{
+		const size_t  bit_count = state.range( 0 );
+		DynamicBitSet bits = random_bitset( bit_count );
+		for ( auto _ : state )
+		{
+			bits.reset();
+			benchmark::ClobberMemory();
+		}
+		set_bytes( state, bit_count );
+	}
+
+	void BM_SetRange( benchmark::State& state )
+	{
+		const size_t  bit_count = state.range( 0 );
+		DynamicBitSet bits = random_bitset( bit_count );
+		for ( auto _ : state )
+		{
+			bits.set( 3, bit_count - 7, true );
+			benchmark::ClobberMemory();
+		}
+		set_bytes( state, bit_count );
+	}
+
+	void BM_HammingWeight( benchmark::State& state )
+	{
+		const size_t		bit_count = state.range( 0 );
+		const DynamicBitSet bits = random_bitset( bit_count );
+		for ( auto _ : state )
+		{
+			benchmark::DoNotOptimize( bits.hamming_weight() );
+		}
+		set_bytes( state, bit_count );
+	}
+
+	void BM_HammingDistance( benchmark::State& state )
+	{
+		const size_t		bit_count = state.range( 0 );
+		const DynamicBitSet left = random_bitset( bit_count, 1 );
+		const DynamicBitSet right = random_bitset( bit_count, 2 );
+		for ( auto _ : state )
+		{
+			benchmark::DoNotOptimize( left.hamming_distance( right ) );
+		}
+		set_bytes( state, bit_count, 2 );
+	}
+
+	void BM_ValidNumberOfBits( benchmark::State& state )
+	{
+		const size_t  bit_count = state.range( 0 );
+		DynamicBitSet bits( bit_count, false );
+		bits.set_bit( true, 0 );
+		for ( auto _ : state )
+		{
+			benchmark::DoNotOptimize( bits.valid_number_of_bits() );
+		}
+		set_bytes( state, bit_count );
+	}
+
+	void BM_AnyNone( benchmark::State& state )
+	{
+		const size_t		bit_count = state.range( 0 );
+		const DynamicBitSet bits( bit_count, false );
+		for ( auto _ : state )
+		{
+			benchmark::DoNotOptimize( bits.any() );
+			benchmark::DoNotOptimize( bits.none() );
+		}
+		set_bytes( state, bit_count, 2 );
+	}
+
+	/* 按位运算 */
+
+	void BM_AndAssign( benchmark::State& state )
+	{
+		const size_t		bit_count = state.range( 0 );
+		DynamicBitSet		left = random_bitset( bit_count, 1 );
+		const DynamicBitSet right = random_bitset( bit_count, 2 );
+		for ( auto _ : state )
+		{
+			left &= right;
+			benchmark::ClobberMemory();
+		}
+		set_bytes( state, bit_count, 2 );
+	}
+
+	void BM_OrAssign( benchmark::State& state )
+	{
+		const size_t		bit_count = state.range( 0 );
+		DynamicBitSet		left = random_bitset( bit_count, 1 );
+		const DynamicBitSet right = random_bitset( bit_count, 2 );
+		for ( auto _ : state )
+		{
+			left |= right;
+			benchmark::ClobberMemory();
+		}
+		set_bytes( state, bit_count, 2 );
+	}
+
+	void BM_XorAssign( benchmark::State& state )
+	{
+		const size_t		bit_count = state.range( 0 );
+		DynamicBitSet		left = random_bitset( bit_count, 1 );
+		const DynamicBitSet right = random_bitset( bit_count, 2 );
+		for ( auto _ : state )
+		{
+			left ^= right;
+			benchmark::ClobberMemory();
+		}
+		set_bytes( state, bit_count, 2 );
+	}
+
+	void BM_NotOperation( benchmark::State& state )
+	{
+		const size_t  bit_count = state.range( 0 );
+		DynamicBitSet bits = random_bitset( bit_count );
+		for ( auto _ : state )
+		{
+			bits.not_operation();
+			benchmark::ClobberMemory();
+		}
+		set_bytes( state, bit_count );
+	}
+
+	// 按值返回的运算符：包含一次完整的拷贝
+	void BM_AndOperator( benchmark::State& state )
+	{
+		const size_t		bit_count = state.range( 0 );
+		DynamicBitSet		left = random_bitset( bit_count, 1 );
+		const DynamicBitSet right = random_bitset( bit_count, 2 );
+		for ( auto _ : state )
+		{
+			DynamicBitSet result = left & right;
+			benchmark::DoNotOptimize( result.chunk_data() );
+		}
+		set_bytes( state, bit_count, 3 );
+	}
+
+	void BM_NotOperator( benchmark::State& state )
+	{
+		const size_t  bit_count = state.range( 0 );
+		DynamicBitSet bits = random_bitset( bit_count );
+		for ( auto _ : state )
+		{
+			DynamicBitSet result = ~bits;
+			benchmark::DoNotOptimize( result.chunk_data() );
+		}
+		set_bytes( state, bit_count, 2 );
+	}
+
+	/* 融合的按位运算 */
+
+	void BM_AndNot( benchmark::State& state )
+	{
+		const size_t		bit_count = state.range( 0 );
+		DynamicBitSet		left = random_bitset( bit_count, 1 );
+		const DynamicBitSet right = random_bitset( bit_count, 2 );
+		for ( auto _ : state )
+		{
+			left.and_not_operation( right );
+			benchmark::ClobberMemory();
+		}
+		set_bytes( state, bit_count, 2 );
+	}
+
+	// a & b.complement_view()：惰性取反的视图直接使用 andnot 内核
+	void BM_AndComplementView( benchmark::State& state )
+	{
+		const size_t		bit_count = state.range( 0 );
+		DynamicBitSet		left = random_bitset( bit_count, 1 );
+		const DynamicBitSet right = random_bitset( bit_count, 2 );
+		for ( auto _ : state )
+		{
+			DynamicBitSet result = left & right.complement_view();
+			benchmark::DoNotOptimize( result.chunk_data() );
+		}
+		set_bytes( state, bit_count, 3 );
+	}
+
+	// a & ~b：operator~ 先物化 ~b
+	void BM_AndMaterializedComplement( benchmark::State& state )
+	{
+		const size_t		bit_count = state.range( 0 );
+		DynamicBitSet		left = random_bitset( bit_count, 1 );
+		const DynamicBitSet right = random_bitset( bit_count, 2 );
+		for ( auto _ : state )
+		{
+			DynamicBitSet result = left & ~right;
+			benchmark::DoNotOptimize( result.chunk_data() );
+		}
+		set_bytes( state, bit_count, 5 );
+	}
+
+	void BM_TernaryMajority( benchmark::State& state )
+	{
+		const size_t		bit_count = state.range( 0 );
+		DynamicBitSet		first = random_bitset( bit_count, 1 );
+		const DynamicBitSet second = random_bitset( bit_count, 2 );
+		const DynamicBitSet third = random_bitset( bit_count, 3 );
+		for ( auto _ : state )
+		{
+			first.ternary_operation( second, third, ternary_function::majority );
+			benchmark::ClobberMemory();
+		}
+		set_bytes( state, bit_count, 3 );
+	}
+
+	// 同样的多数表决用 &、| 组合 (每一步都是一次完整的遍历)
+	void BM_ChainedMajority( benchmark::State& state )
+	{
+		const size_t		bit_count = state.range( 0 );
+		const DynamicBitSet first = random_bitset( bit_count, 1 );
+		const DynamicBitSet second = random_bitset( bit_count, 2 );
+		const DynamicBitSet third = random_bitset( bit_count, 3 );
+		for ( auto _ : state )
+		{
+			DynamicBitSet first_second = first;
+			first_second &= second;
+			DynamicBitSet first_third = first;
+			first_third &= third;
+			DynamicBitSet result = second;
+			result &= third;
+			result |= first_second;
+			result |= first_third;
+			benchmark::DoNotOptimize( result.chunk_data() );
+		}
+		set_bytes( state, bit_count, 3 );
+	}
+
+	constexpr size_t multi_operand_count = 16;
+
+	std::vector<DynamicBitSet> random_operands( size_t bit_count )
+	{
+		std::vector<DynamicBitSet> sets;
+		for ( size_t i = 0; i < multi_operand_count; ++i )
+		{
+			sets.push_back( random_bitset( bit_count, uint32_t( 10 + i ) ) );
+		}
+		return sets;
+	}
+
+	void BM_UnionAll( benchmark::State& state )
+	{
+		const size_t					 bit_count = state.range( 0 );
+		const std::vector<DynamicBitSet> sets = random_operands( bit_count );
+		for ( auto _ : state )
+		{
+			DynamicBitSet result = DynamicBitSet::union_all( sets );
+			benchmark::DoNotOptimize( result.chunk_data() );
+		}
+		set_bytes( state, bit_count, multi_operand_count );
+	}
+
+	void BM_ChainedUnion( benchmark::State& state )
+	{
+		const size_t					 bit_count = state.range( 0 );
+		const std::vector<DynamicBitSet> sets = random_operands( bit_count );
+		for ( auto _ : state )
+		{
+			DynamicBitSet result = sets.front();
+			for ( size_t i = 1; i < sets.size(); ++i )
+			{
+				result |= sets[ i ];
+			}
+			benchmark::DoNotOptimize( result.chunk_data() );
+		}
+		set_bytes( state, bit_count, multi_operand_count );
+	}
+
+	void BM_ThresholdCount( benchmark::State& state )
+	{
+		const size_t					 bit_count = state.range( 0 );
+		const std::vector<DynamicBitSet> sets = random_operands( bit_count );
+		for ( auto _ : state )
+		{
+			DynamicBitSet result = DynamicBitSet::threshold_count( sets, multi_operand_count / 2 + 1 );
+			benchmark::DoNotOptimize( result.chunk_data() );
+		}
+		set_bytes( state, bit_count, multi_operand_count );
+	}
+
+	/* 范围运算 (两边的偏移都不是 32 的倍数) */
+
+	// 把 source 中长度为 state.range( 0 ) 的窗口 OR 到 destination 的另一个偏移上
+	void BM_RangeOrUnaligned( benchmark::State& state )
+	{
+		const size_t		window = state.range( 0 );
+		DynamicBitSet		destination = random_bitset( window + 64, 1 );
+		const DynamicBitSet source = random_bitset( window + 64, 2 );
+		for ( auto _ : state )
+		{
+			destination.apply_range( BitRangeOperation::Or, 13, source, 39, window );
+			benchmark::ClobberMemory();
+		}
+		set_bytes( state, window, 2 );
+	}
+
+	// 同样的运算用 subset() + 移位 + 整个集合的 OR 完成
+	void BM_RangeOrBySubset( benchmark::State& state )
+	{
+		const size_t		window = state.range( 0 );
+		DynamicBitSet		destination = random_bitset( window + 64, 1 );
+		const DynamicBitSet source = random_bitset( window + 64, 2 );
+		for ( auto _ : state )
+		{
+			DynamicBitSet shifted = source.subset( 39, 39 + window );
+			shifted.resize( destination.chunk_count() * 32 );
+			shifted <<= 13;
+			destination |= shifted;
+			benchmark::ClobberMemory();
+		}
+		set_bytes( state, window, 2 );
+	}
+
+	void BM_RangeCount( benchmark::State& state )
+	{
+		const size_t		window = state.range( 0 );
+		const DynamicBitSet bits = random_bitset( window + 64 );
+		for ( auto _ : state )
+		{
+			benchmark::DoNotOptimize( bits.count( 13, window ) );
+		}
+		set_bytes( state, window );
+	}
+
+	/* 随机填充 */
+
+	// 以前的方式：每一位调用一次分布写入 vector<bool>，再构造比特集
+	void BM_RandomFillPerBit( benchmark::State& state )
+	{
+		const size_t					bit_count = state.range( 0 );
+		std::mt19937					generator( 1 );
+		std::uniform_int_distribution<> distribution( 0, 1 );
+		std::vector<bool>				values( bit_count );
+		for ( auto _ : state )
+		{
+			for ( size_t i = 0; i < bit_count; ++i )
+			{
+				values[ i ] = distribution( generator );
+			}
+			DynamicBitSet bits( values );
+			benchmark::DoNotOptimize( bits.chunk_data() );
+		}
+		set_bytes( state, bit_count );
+	}
+
+	void BM_FillRandom( benchmark::State& state )
+	{
+		const size_t  bit_count = state.range( 0 );
+		DynamicBitSet bits( bit_count, false );
+		Xoshiro256	  generator( 1 );
+		for ( auto _ : state )
+		{
+			bits.fill_random( generator );
+			benchmark::ClobberMemory();
+		}
+		set_bytes( state, bit_count );
+	}
+
+	void BM_FillRandomParallel( benchmark::State& state )
+	{
+		const size_t  bit_count = state.range( 0 );
+		DynamicBitSet bits( bit_count, false );
+		uint64_t	  seed = 1;
+		for ( auto _ : state )
+		{
+			bits.fill_random( seed++, ParallelExecution() );
+			benchmark::ClobberMemory();
+		}
+		set_bytes( state, bit_count );
+	}
+
+	// 密度为 0.1 的 Bernoulli 掩码
+	void BM_FillBernoulli( benchmark::State& state )
+	{
+		const size_t  bit_count = state.range( 0 );
+		DynamicBitSet bits( bit_count, false );
+		Xoshiro256	  generator( 1 );
+		for ( auto _ : state )
+		{
+			bits.fill_bernoulli( 0.1, generator );
+			benchmark::ClobberMemory();
+		}
+		set_bytes( state, bit_count );
+	}
+
+	void BM_FillBernoulliParallel( benchmark::State& state )
+	{
+		const size_t  bit_count = state.range( 0 );
+		DynamicBitSet bits( bit_count, false );
+		uint64_t	  seed = 1;
+		for ( auto _ : state )
+		{
+			bits.fill_bernoulli( 0.1, seed++, ParallelExecution() );
+			benchmark::ClobberMemory();
+		}
+		set_bytes( state, bit_count );
+	}
+
+	/* 位置列表 (密度 1/8 的升序 posting list) */
+
+	std::vector<uint32_t> sorted_positions( size_t bit_count )
+	{
+		std::vector<uint32_t> positions;
+		positions.reserve( bit_count / 8 + 1 );
+		std::mt19937 generator( 3 );
+		for ( size_t position = generator() % 16; position < bit_count; position += 1 + generator() % 15 )
+		{
+			positions.push_back( static_cast<uint32_t>( position ) );
+		}
+		return positions;
+	}
+
+	// 以前的方式：每个位置调用一次 set_bit
+	void BM_FromPositionsSetBit( benchmark::State& state )
+	{
+		const size_t				bit_count = state.range( 0 );
+		const std::vector<uint32_t> positions = sorted_positions( bit_count );
+		for ( auto _ : state )
+		{
+			DynamicBitSet bits( bit_count, false );
+			for ( const uint32_t position : positions )
+			{
+				bits.set_bit( true, position );
+			}
+			benchmark::DoNotOptimize( bits.chunk_data() );
+		}
+		set_bytes( state, bit_count );
+	}
+
+	void BM_FromPositionsSorted( benchmark::State& state )
+	{
+		const size_t				bit_count = state.range( 0 );
+		const std::vector<uint32_t> positions = sorted_positions( bit_count );
+		for ( auto _ : state )
+		{
+			DynamicBitSet bits = DynamicBitSet::from_positions( positions, bit_count );
+			benchmark::DoNotOptimize( bits.chunk_data() );
+		}
+		set_bytes( state, bit_count );
+	}
+
+	// 以前的方式：逐位测试
+	void BM_ToPositionsPerBit( benchmark::State& state )
+	{
+		const size_t		  bit_count = state.range( 0 );
+		const DynamicBitSet	  bits = DynamicBitSet::from_positions( sorted_positions( bit_count ), bit_count );
+		std::vector<uint32_t> positions;
+		for ( auto _ : state )
+		{
+			positions.clear();
+			for ( size_t index = 0; index < bit_count; ++index )
+			{
+				if ( bits.test_unchecked( index ) )
+				{
+					positions.push_back( static_cast<uint32_t>( index ) );
+				}
+			}
+			benchmark::DoNotOptimize( positions.data() );
+		}
+		set_bytes( state, bit_count );
+	}
+
+	void BM_ToPositions( benchmark::State& state )
+	{
+		const size_t		  bit_count = state.range( 0 );
+		const DynamicBitSet	  bits = DynamicBitSet::from_positions( sorted_positions( bit_count ), bit_count );
+		std::vector<uint32_t> positions;
+		for ( auto _ : state )
+		{
+			bits.to_positions( positions );
+			benchmark::DoNotOptimize( positions.data() );
+		}
+		set_bytes( state, bit_count );
+	}
+
+	/* 定宽整数 (13 位的编码，不与比特块对齐) */
+
+	constexpr unsigned packed_width = 13;
+
+	std::vector<uint32_t> packed_codes( size_t bit_count )
+	{
+		std::vector<uint32_t> codes( bit_count / packed_width );
+		std::mt19937		  generator( 5 );
+		for ( auto& code : codes )
+		{
+			code = generator() & ( ( 1u << packed_width ) - 1 );
+		}
+		return codes;
+	}
+
+	// 以前的方式：每个编码读 packed_width 个比特
+	void BM_PackedGetPerBit( benchmark::State& state )
+	{
+		const size_t						bit_count = state.range( 0 );
+		const PackedIntArray<packed_width> codes( packed_codes( bit_count ) );
+		const DynamicBitSet&				bits = codes.bits();
+		for ( auto _ : state )
+		{
+			uint32_t sum = 0;
+			for ( size_t i = 0; i < codes.size(); ++i )
+			{
+				uint32_t code = 0;
+				for ( unsigned bit = 0; bit < packed_width; ++bit )
+				{
+					code |= uint32_t( bits.test_unchecked( i * packed_width + bit ) ) << bit;
+				}
+				sum += code;
+			}
+			benchmark::DoNotOptimize( sum );
+		}
+		set_bytes( state, bit_count );
+	}
+
+	void BM_PackedGet( benchmark::State& state )
+	{
+		const size_t						bit_count = state.range( 0 );
+		const PackedIntArray<packed_width> codes( packed_codes( bit_count ) );
+		for ( auto _ : state )
+		{
+			uint32_t sum = 0;
+			for ( size_t i = 0; i < codes.size(); ++i )
+			{
+				sum += codes.get_unchecked( i );
+			}
+			benchmark::DoNotOptimize( sum );
+		}
+		set_bytes( state, bit_count );
+	}
+
+	// 运行时宽度的视图 (宽度对编译器不可见)
+	void BM_PackedViewGet( benchmark::State& state )
+	{
+		const size_t						bit_count = state.range( 0 );
+		const PackedIntArray<packed_width> codes( packed_codes( bit_count ) );
+		unsigned							width = packed_width;
+		benchmark::DoNotOptimize( width );
+		const ConstPackedIntView view( codes.bits(), codes.size(), width );
+		for ( auto _ : state )
+		{
+			uint32_t sum = 0;
+			for ( size_t i = 0; i < view.size(); ++i )
+			{
+				sum += view.get_unchecked( i );
+			}
+			benchmark::DoNotOptimize( sum );
+		}
+		set_bytes( state, bit_count );
+	}
+
+	void BM_PackedUnpack( benchmark::State& state )
+	{
+		const size_t						bit_count = state.range( 0 );
+		const PackedIntArray<packed_width> codes( packed_codes( bit_count ) );
+		std::vector<uint32_t>				output( codes.size() );
+		for ( auto _ : state )
+		{
+			codes.unpack( 0, codes.size(), output.data() );
+			benchmark::DoNotOptimize( output.data() );
+		}
+		set_bytes( state, bit_count );
+	}
+
+	// 以前的方式：每个比特调用一次 set_bit
+	void BM_PackedPackPerBit( benchmark::State& state )
+	{
+		const size_t				bit_count = state.range( 0 );
+		const std::vector<uint32_t> values = packed_codes( bit_count );
+		DynamicBitSet				bits( values.size() * packed_width, false );
+		for ( auto _ : state )
+		{
+			for ( size_t i = 0; i < values.size(); ++i )
+			{
+				for ( unsigned bit = 0; bit < packed_width; ++bit )
+				{
+					bits.set_bit( ( values[ i ] >> bit & 1 ) != 0, i * packed_width + bit );
+				}
+			}
+			benchmark::DoNotOptimize( bits.chunk_data() );
+		}
+		set_bytes( state, bit_count );
+	}
+
+	void BM_PackedPack( benchmark::State& state )
+	{
+		const size_t				 bit_count = state.range( 0 );
+		const std::vector<uint32_t>	 values = packed_codes( bit_count );
+		PackedIntArray<packed_width> codes( values.size() );
+		for ( auto _ : state )
+		{
+			codes.pack( 0, values.data(), values.size() );
+			benchmark::DoNotOptimize( codes.bits().chunk_data() );
+		}
+		set_bytes( state, bit_count );
+	}
+
+	/* Elias-Fano (密度 1/64 的升序 ID 列表，universe 是比特数量) */
+
+	std::vector<uint64_t> sparse_ids( size_t bit_count )
+	{
+		std::vector<uint64_t> ids;
+		std::mt19937		  generator( 7 );
+		for ( uint64_t id = generator() % 64; id < bit_count; id += 1 + generator() % 127 )
+		{
+			ids.push_back( id );
+		}
+		return ids;
+	}
+
+	std::vector<uint64_t> sparse_queries( size_t bit_count, size_t count )
+	{
+		std::vector<uint64_t> queries( count );
+		std::mt19937_64		  generator( 8 );
+		for ( auto& query : queries )
+		{
+			query = generator() % bit_count;
+		}
+		return queries;
+	}
+
+	void BM_EliasFanoBuild( benchmark::State& state )
+	{
+		const size_t				bit_count = state.range( 0 );
+		const std::vector<uint64_t> ids = sparse_ids( bit_count );
+		for ( auto _ : state )
+		{
+			EliasFanoBuilder builder( ids.size(), bit_count );
+			for ( const uint64_t id : ids )
+			{
+				builder.push_back( id );
+			}
+			EliasFanoSequence sequence = builder.build();
+			benchmark::DoNotOptimize( sequence.high_bits().chunk_data() );
+		}
+		set_bytes( state, bit_count );
+	}
+
+	void BM_EliasFanoAccess( benchmark::State& state )
+	{
+		const size_t			bit_count = state.range( 0 );
+		const EliasFanoSequence sequence( sparse_ids( bit_count ), bit_count );
+		std::mt19937			generator( 9 );
+		std::vector<size_t>		indices( 1024 );
+		for ( auto& index : indices )
+		{
+			index = generator() % sequence.size();
+		}
+		for ( auto _ : state )
+		{
+			uint64_t sum = 0;
+			for ( const size_t index : indices )
+			{
+				sum += sequence.access( index );
+			}
+			benchmark::DoNotOptimize( sum );
+		}
+		state.SetItemsProcessed( int64_t( state.iterations() ) * int64_t( indices.size() ) );
+		state.counters[ "bits_per_value" ] = double( sequence.encoded_bits() ) / double( sequence.size() );
+	}
+
+	// 以前的方式：在普通的比特集上用 find_next 找下一个 ID
+	void BM_NextGeqFindNext( benchmark::State& state )
+	{
+		const size_t				bit_count = state.range( 0 );
+		const DynamicBitSet			bits = DynamicBitSet::from_positions( sparse_ids( bit_count ), bit_count );
+		const std::vector<uint64_t> queries = sparse_queries( bit_count, 1024 );
+		for ( auto _ : state )
+		{
+			size_t sum = 0;
+			for ( const uint64_t query : queries )
+			{
+				sum += bits.find_next( query );
+			}
+			benchmark::DoNotOptimize( sum );
+		}
+		state.SetItemsProcessed( int64_t( state.iterations() ) * int64_t( queries.size() ) );
+	}
+
+	void BM_NextGeqLowerBound( benchmark::State& state )
+	{
+		const size_t				bit_count = state.range( 0 );
+		const std::vector<uint64_t> ids = sparse_ids( bit_count );
+		const std::vector<uint64_t> queries = sparse_queries( bit_count, 1024 );
+		for ( auto _ : state )
+		{
+			size_t sum = 0;
+			for ( const uint64_t query : queries )
+			{
+				sum += std::lower_bound( ids.begin(), ids.end(), query ) - ids.begin();
+			}
+			benchmark::DoNotOptimize( sum );
+		}
+		state.SetItemsProcessed( int64_t( state.iterations() ) * int64_t( queries.size() ) );
+	}
+
+	void BM_EliasFanoNextGeq( benchmark::State& state )
+	{
+		const size_t				bit_count = state.range( 0 );
+		const EliasFanoSequence		sequence( sparse_ids( bit_count ), bit_count );
+		const std::vector<uint64_t> queries = sparse_queries( bit_count, 1024 );
+		for ( auto _ : state )
+		{
+			size_t sum = 0;
+			for ( const uint64_t query : queries )
+			{
+				sum += sequence.next_geq( query );
+			}
+			benchmark::DoNotOptimize( sum );
+		}
+		state.SetItemsProcessed( int64_t( state.iterations() ) * int64_t( queries.size() ) );
+	}
+
+	void BM_EliasFanoDecode( benchmark::State& state )
+	{
+		const size_t			bit_count = state.range( 0 );
+		const EliasFanoSequence sequence( sparse_ids( bit_count ), bit_count );
+		std::vector<uint64_t>	values( sequence.size() );
+		for ( auto _ : state )
+		{
+			sequence.decode( values.data() );
+			benchmark::DoNotOptimize( values.data() );
+		}
+		state.SetItemsProcessed( int64_t( state.iterations() ) * int64_t( values.size() ) );
+	}
+
+	/* 比较 (都选择需要扫描全部块的输入，即最坏情况) */
+
+	// 两个相同的比特集
+	void BM_Equal( benchmark::State& state )
+	{
+		const size_t		bit_count = state.range( 0 );
+		const DynamicBitSet left = random_bitset( bit_count, 1 );
+		const DynamicBitSet right = left;
+		for ( auto _ : state )
+		{
+			benchmark::DoNotOptimize( left == right );
+		}
+		set_bytes( state, bit_count, 2 );
+	}
+
+	// 只有最低位不同：从最高的块向下一直比较到块 0
+	void BM_Compare( benchmark::State& state )
+	{
+		const size_t		bit_count = state.range( 0 );
+		const DynamicBitSet left = random_bitset( bit_count, 1 );
+		DynamicBitSet		right = left;
+		right.flip( 0 );
+		for ( auto _ : state )
+		{
+			benchmark::DoNotOptimize( left < right );
+		}
+		set_bytes( state, bit_count, 2 );
+	}
+
+	void BM_IsSubsetOf( benchmark::State& state )
+	{
+		const size_t		bit_count = state.range( 0 );
+		const DynamicBitSet left = random_bitset( bit_count, 1 );
+		const DynamicBitSet right = left;
+		for ( auto _ : state )
+		{
+			benchmark::DoNotOptimize( left.is_subset_of( right ) );
+		}
+		set_bytes( state, bit_count, 2 );
+	}
+
+	// 两个不相交的比特集
+	void BM_Intersects( benchmark::State& state )
+	{
+		const size_t		bit_count = state.range( 0 );
+		DynamicBitSet		left = random_bitset( bit_count, 1 );
+		const DynamicBitSet right = ~left;
+		for ( auto _ : state )
+		{
+			benchmark::DoNotOptimize( left.intersects( right ) );
+		}
+		set_bytes( state, bit_count, 2 );
+	}
+
+	/* 哈希 */
+
+	void BM_Hash( benchmark::State& state )
+	{
+		const size_t		bit_count = state.range( 0 );
+		const DynamicBitSet bits = random_bitset( bit_count );
+		for ( auto _ : state )
+		{
+			benchmark::DoNotOptimize( std::hash<DynamicBitSet>()( bits ) );
+		}
+		set_bytes( state, bit_count );
+	}
+
+	// 以前去重时的做法：对二进制字符串求哈希
+	void BM_HashFormatBinaryString( benchmark::State& state )
+	{
+		const size_t		bit_count = state.range( 0 );
+		const DynamicBitSet bits = random_bitset( bit_count );
+		for ( auto _ : state )
+		{
+			benchmark::DoNotOptimize( std::hash<std::string>()( bits.format_binary_string() ) );
+		}
+		set_bytes( state, bit_count );
+	}
+
+	/* 分层摘要索引 (几乎全满、唯一的 0 在最高位，即线性扫描的最坏情况) */
+
+	// 没有摘要时的做法：逐块扫描第一个不是全 1 的块
+	void BM_FindFirstZeroLinear( benchmark::State& state )
+	{
+		const size_t  bit_count = state.range( 0 );
+		DynamicBitSet bits( bit_count, true );
+		bits.set_bit( false, bit_count - 1 );
+		for ( auto _ : state )
+		{
+			const BooleanBitWrapper* chunks = bits.chunk_data();
+			const BooleanBitWrapper* found = std::find_if( chunks, chunks + bits.chunk_count(), []( const BooleanBitWrapper& chunk ) { return chunk.bits != 0xFFFFFFFF; } );
+			benchmark::DoNotOptimize( found );
+		}
+		set_bytes( state, bit_count );
+	}
+
+	void BM_FindFirstZeroHierarchical( benchmark::State& state )
+	{
+		const size_t			  bit_count = state.range( 0 );
+		HierarchicalDynamicBitSet bits( bit_count );
+		bits.set();
+		bits.reset( bit_count - 1 );
+		for ( auto _ : state )
+		{
+			benchmark::DoNotOptimize( bits.find_first_zero() );
+		}
+		set_bytes( state, bit_count );
+	}
+
+	// 分配一个槽位再释放它，每次都要更新摘要
+	void BM_AllocateReleaseHierarchical( benchmark::State& state )
+	{
+		const size_t			  bit_count = state.range( 0 );
+		HierarchicalDynamicBitSet bits( bit_count );
+		bits.set();
+		bits.reset( bit_count - 1 );
+		for ( auto _ : state )
+		{
+			const size_t slot = bits.find_first_zero_and_set();
+			bits.reset( slot );
+			benchmark::DoNotOptimize( slot );
+		}
+		set_bytes( state, bit_count );
+	}
+
+	void BM_AnyNoneHierarchical( benchmark::State& state )
+	{
+		const size_t					bit_count = state.range( 0 );
+		const HierarchicalDynamicBitSet bits( bit_count );
+		for ( auto _ : state )
+		{
+			benchmark::DoNotOptimize( bits.any() );
+			benchmark::DoNotOptimize( bits.none() );
+		}
+		set_bytes( state, bit_count, 2 );
+	}
+
+	// 只有 1/64 的块非空，或运算跳过其余的块
+	void BM_OrSparseHierarchical( benchmark::State& state )
+	{
+		const size_t			  bit_count = state.range( 0 );
+		HierarchicalDynamicBitSet left( bit_count );
+		HierarchicalDynamicBitSet right( bit_count );
+		for ( size_t index = 0; index < bit_count; index += 4096 * 64 )
+		{
+			right.set( index );
+		}
+		for ( auto _ : state )
+		{
+			left |= right;
+			benchmark::ClobberMemory();
+		}
+		set_bytes( state, bit_count );
+	}
+
+	/* 移位与旋转 */
+
+	void BM_LeftShift( benchmark::State& state )
+	{
+		const size_t  bit_count = state.range( 0 );
+		DynamicBitSet bits = random_bitset( bit_count );
+		for ( auto _ : state )
+		{
+			bits.left_shift( 13 );
+			benchmark::ClobberMemory();
+		}
+		set_bytes( state, bit_count );
+	}
+
+	void BM_RightShift( benchmark::State& state )
+	{
+		const size_t  bit_count = state.range( 0 );
+		DynamicBitSet bits = random_bitset( bit_count );
+		for ( auto _ : state )
+		{
+			bits.right_shift( 13 );
+			benchmark::ClobberMemory();
+		}
+		set_bytes( state, bit_count );
+	}
+
+	void BM_ShiftLeftOperator( benchmark::State& state )
+	{
+		const size_t  bit_count = state.range( 0 );
+		DynamicBitSet bits = random_bitset( bit_count );
+		for ( auto _ : state )
+		{
+			DynamicBitSet result = bits << 45;
+			benchmark::DoNotOptimize( result.chunk_data() );
+		}
+		set_bytes( state, bit_count, 2 );
+	}
+
+	void BM_ShiftRightOperator( benchmark::State& state )
+	{
+		const size_t  bit_count = state.range( 0 );
+		DynamicBitSet bits = random_bitset( bit_count );
+		for ( auto _ : state )
+		{
+			DynamicBitSet result = bits >> 45;
+			benchmark::DoNotOptimize( result.chunk_data() );
+		}
+		set_bytes( state, bit_count, 2 );
+	}
+
+	// 旋转会改变比特块的数量，所以每次迭代都从同一个原始比特集拷贝 (计时包含这次拷贝)
+	void BM_RotateLeftSmall( benchmark::State& state )
+	{
+		const size_t		bit_count = state.range( 0 );
+		const DynamicBitSet source = random_bitset( bit_count );
+		for ( auto _ : state )
+		{
+			DynamicBitSet bits( source );
+			bits.rotate_left( 17 );
+			benchmark::DoNotOptimize( bits.chunk_data() );
+		}
+		set_bytes( state, bit_count );
+	}
+
+	void BM_RotateLeftLarge( benchmark::State& state )
+	{
+		const size_t		bit_count = state.range( 0 );
+		const DynamicBitSet source = random_bitset( bit_count );
+		for ( auto _ : state )
+		{
+			DynamicBitSet bits( source );
+			bits.rotate_left( 256 + bit_count / 3 );
+			benchmark::DoNotOptimize( bits.chunk_data() );
+		}
+		set_bytes( state, bit_count );
+	}
+
+	void BM_RotateRightSmall( benchmark::State& state )
+	{
+		const size_t		bit_count = state.range( 0 );
+		const DynamicBitSet source = random_bitset( bit_count );
+		for ( auto _ : state )
+		{
+			DynamicBitSet bits( source );
+			bits.rotate_right( 17 );
+			benchmark::DoNotOptimize( bits.chunk_data() );
+		}
+		set_bytes( state, bit_count );
+	}
+
+	void BM_RotateRightLarge( benchmark::State& state )
+	{
+		const size_t		bit_count = state.range( 0 );
+		const DynamicBitSet source = random_bitset( bit_count );
+		for ( auto _ : state )
+		{
+			DynamicBitSet bits( source );
+			bits.rotate_right( 256 + bit_count / 3 );
+			benchmark::DoNotOptimize( bits.chunk_data() );
+		}
+		set_bytes( state, bit_count );
+	}
+
+	/* 插入、删除、压入、弹出 (成对执行，保持规模不变) */
+
+	void BM_InsertErase( benchmark::State& state )
+	{
+		const size_t  bit_count = state.range( 0 );
+		DynamicBitSet bits = random_bitset( bit_count );
+		for ( auto _ : state )
+		{
+			bits.insert( true, bits.bit_size() / 2 );
+			bits.erase( bits.bit_size() / 2 );
+			benchmark::ClobberMemory();
+		}
+		set_bits( state, bit_count );
+	}
+
+	void BM_PushPopBack( benchmark::State& state )
+	{
+		const size_t  bit_count = state.range( 0 );
+		DynamicBitSet bits = random_bitset( bit_count );
+		for ( auto _ : state )
+		{
+			bits.push_back( true );
+			bits.pop_back();
+			benchmark::ClobberMemory();
+		}
+		set_bytes( state, bit_count, 2 );
+	}
+
+	void BM_PushPopFront( benchmark::State& state )
+	{
+		const size_t  bit_count = state.range( 0 );
+		DynamicBitSet bits = random_bitset( bit_count );
+		for ( auto _ : state )
+		{
+			bits.push_front( true );
+			bits.pop_front();
+			benchmark::ClobberMemory();
+		}
+		set_bytes( state, bit_count, 2 );
+	}
+
+	/* 子集与连接 */
+
+	void BM_Subset( benchmark::State& state )
+	{
+		const size_t		bit_count = state.range( 0 );
+		const DynamicBitSet bits = random_bitset( bit_count );
+		for ( auto _ : state )
+		{
+			DynamicBitSet result = bits.subset( bit_count / 4, bit_count / 4 * 3 );
+			benchmark::DoNotOptimize( result.chunk_data() );
+		}
+		set_bits( state, bit_count / 2 );
+	}
+
+	void BM_Concat( benchmark::State& state )
+	{
+		const size_t		bit_count = state.range( 0 );
+		const DynamicBitSet left = random_bitset( bit_count / 2, 1 );
+		const DynamicBitSet right = random_bitset( bit_count / 2, 2 );
+		for ( auto _ : state )
+		{
+			DynamicBitSet result = bitset_concat( left, right );
+			benchmark::DoNotOptimize( result.chunk_data() );
+		}
+		set_bits( state, bit_count );
+	}
+
+	/* 字符串与向量的转换 */
+
+	void BM_FormatBinaryString( benchmark::State& state )
+	{
+		const size_t		bit_count = state.range( 0 );
+		const DynamicBitSet bits = random_bitset( bit_count );
+		for ( auto _ : state )
+		{
+			std::string result = bits.format_binary_string( true );
+			benchmark::DoNotOptimize( result.data() );
+		}
+		set_bits( state, bit_count );
+	}
+
+	void BM_ParseBinaryString( benchmark::State& state )
+	{
+		const size_t	  bit_count = state.range( 0 );
+		const std::string binary = random_bitset( bit_count ).format_binary_string( true );
+		for ( auto _ : state )
+		{
+			DynamicBitSet bits( binary, 2 );
+			benchmark::DoNotOptimize( bits.chunk_data() );
+		}
+		set_bits( state, bit_count );
+	}
+
+	void BM_HexadecimalHugeNumber( benchmark::State& state )
+	{
+		const size_t		bit_count = state.range( 0 );
+		const DynamicBitSet bits = random_bitset( bit_count );
+		for ( auto _ : state )
+		{
+			std::string result = bits.string_hexadecimal_hugenumber();
+			benchmark::DoNotOptimize( result.data() );
+		}
+		set_bits( state, bit_count );
+	}
+
+	void BM_ParseHexadecimalString( benchmark::State& state )
+	{
+		const size_t	  bit_count = state.range( 0 );
+		const std::string hexadecimal = random_bitset( bit_count ).string_hexadecimal_hugenumber();
+		for ( auto _ : state )
+		{
+			DynamicBitSet bits( hexadecimal, 16 );
+			benchmark::DoNotOptimize( bits.chunk_data() );
+		}
+		set_bits( state, bit_count );
+	}
+
+	void BM_HexadecimalRawArray( benchmark::State& state )
+	{
+		const size_t		bit_count = state.range( 0 );
+		const DynamicBitSet bits = random_bitset( bit_count );
+		for ( auto _ : state )
+		{
+			std::vector<std::string> result = bits.string_hexadecimal_raw_array();
+			benchmark::DoNotOptimize( result.data() );
+		}
+		set_bits( state, bit_count );
+	}
+
+	void BM_DecimalHugeNumber( benchmark::State& state )
+	{
+		const size_t		bit_count = state.range( 0 );
+		const DynamicBitSet bits = random_bitset( bit_count );
+		for ( auto _ : state )
+		{
+			std::string result = bits.string_decimal_hugenumber();
+			benchmark::DoNotOptimize( result.data() );
+		}
+		set_bits( state, bit_count );
+	}
+
+	void BM_ParseDecimalString( benchmark::State& state )
+	{
+		const size_t	  bit_count = state.range( 0 );
+		const std::string decimal = random_bitset( bit_count ).string_decimal_hugenumber();
+		for ( auto _ : state )
+		{
+			DynamicBitSet bits( decimal, 10 );
+			benchmark::DoNotOptimize( bits.chunk_data() );
+		}
+		set_bits( state, bit_count );
+	}
+
+	void BM_DecimalRawArray( benchmark::State& state )
+	{
+		const size_t		bit_count = state.range( 0 );
+		const DynamicBitSet bits = random_bitset( bit_count );
+		for ( auto _ : state )
+		{
+			std::vector<std::string> result = bits.string_decimal_raw_array();
+			benchmark::DoNotOptimize( result.data() );
+		}
+		set_bits( state, bit_count );
+	}
+
+	void BM_BitVectorData( benchmark::State& state )
+	{
+		const size_t		bit_count = state.range( 0 );
+		const DynamicBitSet bits = random_bitset( bit_count );
+		for ( auto _ : state )
+		{
+			std::vector<bool> result = bits.bit_vector_data();
+			benchmark::DoNotOptimize( result.size() );
+		}
+		set_bits( state, bit_count );
+	}
+
+	/* 迭代器 (常量迭代器每次创建都会向 std::cerr 打印警告，因此不在这里测量) */
+
+	void BM_ForwardIterator( benchmark::State& state )
+	{
+		const size_t  bit_count = state.range( 0 );
+		DynamicBitSet bits = random_bitset( bit_count );
+		for ( auto _ : state )
+		{
+			size_t count = 0;
+			for ( auto it = bits.begin(), end = bits.end(); it != end; ++it )
+			{
+				count += static_cast<bool>( *it );
+			}
+			benchmark::DoNotOptimize( count );
+		}
+		set_bits( state, bit_count );
+	}
+
+	void BM_ReverseIterator( benchmark::State& state )
+	{
+		const size_t  bit_count = state.range( 0 );
+		DynamicBitSet bits = random_bitset( bit_count );
+		for ( auto _ : state )
+		{
+			size_t count = 0;
+			for ( auto it = bits.rbegin(), end = bits.rend(); it != end; ++it )
+			{
+				count += static_cast<bool>( *it );
+			}
+			benchmark::DoNotOptimize( count );
+		}
+		set_bits( state, bit_count );
+	}
+
+	/* 并行版本 (ParallelExecution，使用全部硬件线程) */
+
+	void BM_ParallelAnd( benchmark::State& state )
+	{
+		const size_t		bit_count = state.range( 0 );
+		DynamicBitSet		left = random_bitset( bit_count, 1 );
+		const DynamicBitSet right = random_bitset( bit_count, 2 );
+		for ( auto _ : state )
+		{
+			left.and_operation( right, ParallelExecution() );
+			benchmark::ClobberMemory();
+		}
+		set_bytes( state, bit_count, 2 );
+	}
+
+	void BM_ParallelHammingWeight( benchmark::State& state )
+	{
+		const size_t		bit_count = state.range( 0 );
+		const DynamicBitSet bits = random_bitset( bit_count );
+		for ( auto _ : state )
+		{
+			benchmark::DoNotOptimize( bits.hamming_weight( ParallelExecution() ) );
+		}
+		set_bytes( state, bit_count );
+	}
+
+	void BM_ParallelLeftShift( benchmark::State& state )
+	{
+		const size_t  bit_count = state.range( 0 );
+		DynamicBitSet bits = random_bitset( bit_count );
+		for ( auto _ : state )
+		{
+			bits.left_shift( 13, ParallelExecution() );
+			benchmark::ClobberMemory();
+		}
+		set_bytes( state, bit_count, 2 );
+	}
+}  // namespace
+
+#define DYNAMIC_BITSET_BENCHMARK( function, maximum ) BENCHMARK( function )->RangeMultiplier( 8 )->Range( minimum_bits, maximum )->Unit( benchmark::kNanosecond )
+
+DYNAMIC_BITSET_BENCHMARK( BM_ConstructFilled, maximum_bits );
+DYNAMIC_BITSET_BENCHMARK( BM_ConstructFromUint32Vector, maximum_bits );
+DYNAMIC_BITSET_BENCHMARK( BM_ConstructFromUint64Vector, maximum_bits );
+DYNAMIC_BITSET_BENCHMARK( BM_ConstructFromBoolVector, per_bit_maximum_bits );
+DYNAMIC_BITSET_BENCHMARK( BM_Copy, maximum_bits );
+DYNAMIC_BITSET_BENCHMARK( BM_CopyOnWriteCopy, maximum_bits );
+DYNAMIC_BITSET_BENCHMARK( BM_CopyOnWriteCopyAndSetBit, maximum_bits );
+DYNAMIC_BITSET_BENCHMARK( BM_PersistentWithBit, maximum_bits );
+DYNAMIC_BITSET_BENCHMARK( BM_PersistentWithBits, maximum_bits );
+DYNAMIC_BITSET_BENCHMARK( BM_PersistentAndVersions, maximum_bits );
+DYNAMIC_BITSET_BENCHMARK( BM_TrackedExportDelta, maximum_bits );
+DYNAMIC_BITSET_BENCHMARK( BM_MakeDeltaFullCompare, maximum_bits );
+DYNAMIC_BITSET_BENCHMARK( BM_TrackedApplyDelta, maximum_bits );
+
+DYNAMIC_BITSET_BENCHMARK( BM_GetBit, maximum_bits );
+DYNAMIC_BITSET_BENCHMARK( BM_SetBit, maximum_bits );
+DYNAMIC_BITSET_BENCHMARK( BM_SubscriptOperator, maximum_bits );
+DYNAMIC_BITSET_BENCHMARK( BM_Flip, maximum_bits );
+DYNAMIC_BITSET_BENCHMARK( BM_SetUnchecked, maximum_bits );
+DYNAMIC_BITSET_BENCHMARK( BM_TestUnchecked, maximum_bits );
+DYNAMIC_BITSET_BENCHMARK( BM_SetMany, maximum_bits );
+DYNAMIC_BITSET_BENCHMARK( BM_TestMany, maximum_bits );
+
+DYNAMIC_BITSET_BENCHMARK( BM_SetAll, maximum_bits );
+DYNAMIC_BITSET_BENCHMARK( BM_ResetAll, maximum_bits );
+DYNAMIC_BITSET_BENCHMARK( BM_SetRange, maximum_bits );
+DYNAMIC_BITSET_BENCHMARK( BM_HammingWeight, maximum_bits );
+DYNAMIC_BITSET_BENCHMARK( BM_HammingDistance, maximum_bits );
+DYNAMIC_BITSET_BENCHMARK( BM_ValidNumberOfBits, maximum_bits );
+DYNAMIC_BITSET_BENCHMARK( BM_AnyNone, maximum_bits );
+
+DYNAMIC_BITSET_BENCHMARK( BM_AndAssign, maximum_bits );
+DYNAMIC_BITSET_BENCHMARK( BM_OrAssign, maximum_bits );
+DYNAMIC_BITSET_BENCHMARK( BM_XorAssign, maximum_bits );
+DYNAMIC_BITSET_BENCHMARK( BM_NotOperation, maximum_bits );
+DYNAMIC_BITSET_BENCHMARK( BM_AndOperator, maximum_bits );
+DYNAMIC_BITSET_BENCHMARK( BM_NotOperator, maximum_bits );
+
+DYNAMIC_BITSET_BENCHMARK( BM_AndNot, maximum_bits );
+DYNAMIC_BITSET_BENCHMARK( BM_AndComplementView, maximum_bits );
+DYNAMIC_BITSET_BENCHMARK( BM_AndMaterializedComplement, maximum_bits );
+DYNAMIC_BITSET_BENCHMARK( BM_TernaryMajority, maximum_bits );
+DYNAMIC_BITSET_BENCHMARK( BM_ChainedMajority, maximum_bits );
+DYNAMIC_BITSET_BENCHMARK( BM_UnionAll, per_bit_maximum_bits );
+DYNAMIC_BITSET_BENCHMARK( BM_ChainedUnion, per_bit_maximum_bits );
+DYNAMIC_BITSET_BENCHMARK( BM_ThresholdCount, per_bit_maximum_bits );
+
+DYNAMIC_BITSET_BENCHMARK( BM_RangeOrUnaligned, maximum_bits );
+DYNAMIC_BITSET_BENCHMARK( BM_RangeOrBySubset, per_bit_maximum_bits );
+DYNAMIC_BITSET_BENCHMARK( BM_RangeCount, maximum_bits );
+
+DYNAMIC_BITSET_BENCHMARK( BM_RandomFillPerBit, per_bit_maximum_bits );
+DYNAMIC_BITSET_BENCHMARK( BM_FillRandom, maximum_bits );
+DYNAMIC_BITSET_BENCHMARK( BM_FillRandomParallel, maximum_bits );
+DYNAMIC_BITSET_BENCHMARK( BM_FillBernoulli, maximum_bits );
+DYNAMIC_BITSET_BENCHMARK( BM_FillBernoulliParallel, maximum_bits );
+
+DYNAMIC_BITSET_BENCHMARK( BM_FromPositionsSetBit, per_bit_maximum_bits );
+DYNAMIC_BITSET_BENCHMARK( BM_FromPositionsSorted, maximum_bits );
+DYNAMIC_BITSET_BENCHMARK( BM_ToPositionsPerBit, per_bit_maximum_bits );
+DYNAMIC_BITSET_BENCHMARK( BM_ToPositions, maximum_bits );
+DYNAMIC_BITSET_BENCHMARK( BM_PackedGetPerBit, per_bit_maximum_bits );
+DYNAMIC_BITSET_BENCHMARK( BM_PackedGet, maximum_bits );
+DYNAMIC_BITSET_BENCHMARK( BM_PackedViewGet, maximum_bits );
+DYNAMIC_BITSET_BENCHMARK( BM_PackedUnpack, maximum_bits );
+DYNAMIC_BITSET_BENCHMARK( BM_PackedPackPerBit, per_bit_maximum_bits );
+DYNAMIC_BITSET_BENCHMARK( BM_PackedPack, maximum_bits );
+DYNAMIC_BITSET_BENCHMARK( BM_EliasFanoBuild, maximum_bits );
+DYNAMIC_BITSET_BENCHMARK( BM_EliasFanoAccess, maximum_bits );
+DYNAMIC_BITSET_BENCHMARK( BM_NextGeqFindNext, maximum_bits );
+DYNAMIC_BITSET_BENCHMARK( BM_NextGeqLowerBound, maximum_bits );
+DYNAMIC_BITSET_BENCHMARK( BM_EliasFanoNextGeq, maximum_bits );
+DYNAMIC_BITSET_BENCHMARK( BM_EliasFanoDecode, maximum_bits );
+
+DYNAMIC_BITSET_BENCHMARK( BM_Equal, maximum_bits );
+DYNAMIC_BITSET_BENCHMARK( BM_Compare, maximum_bits );
+DYNAMIC_BITSET_BENCHMARK( BM_IsSubsetOf, maximum_bits );
+DYNAMIC_BITSET_BENCHMARK( BM_Intersects, maximum_bits );
+
+DYNAMIC_BITSET_BENCHMARK( BM_Hash, maximum_bits );
+DYNAMIC_BITSET_BENCHMARK( BM_HashFormatBinaryString, per_bit_maximum_bits );
+
+DYNAMIC_BITSET_BENCHMARK( BM_FindFirstZeroLinear, maximum_bits );
+DYNAMIC_BITSET_BENCHMARK( BM_FindFirstZeroHierarchical, maximum_bits );
+DYNAMIC_BITSET_BENCHMARK( BM_AllocateReleaseHierarchical, maximum_bits );
+DYNAMIC_BITSET_BENCHMARK( BM_AnyNoneHierarchical, maximum_bits );
+DYNAMIC_BITSET_BENCHMARK( BM_OrSparseHierarchical, maximum_bits );
+
+DYNAMIC_BITSET_BENCHMARK( BM_LeftShift, maximum_bits );
+DYNAMIC_BITSET_BENCHMARK( BM_RightShift, maximum_bits );
+DYNAMIC_BITSET_BENCHMARK( BM_ShiftLeftOperator, maximum_bits );
+DYNAMIC_BITSET_BENCHMARK( BM_ShiftRightOperator, maximum_bits );
+DYNAMIC_BITSET_BENCHMARK( BM_RotateLeftSmall, small_rotate_maximum_bits );
+DYNAMIC_BITSET_BENCHMARK( BM_RotateLeftLarge, per_bit_maximum_bits );
+DYNAMIC_BITSET_BENCHMARK( BM_RotateRightSmall, small_rotate_maximum_bits );
+DYNAMIC_BITSET_BENCHMARK( BM_RotateRightLarge, per_bit_maximum_bits );
+
+DYNAMIC_BITSET_BENCHMARK( BM_InsertErase, per_bit_maximum_bits );
+DYNAMIC_BITSET_BENCHMARK( BM_PushPopBack, maximum_bits );
+DYNAMIC_BITSET_BENCHMARK( BM_PushPopFront, maximum_bits );
+
+DYNAMIC_BITSET_BENCHMARK( BM_Subset, per_bit_maximum_bits );
+DYNAMIC_BITSET_BENCHMARK( BM_Concat, per_bit_maximum_bits );
+
+DYNAMIC_BITSET_BENCHMARK( BM_FormatBinaryString, per_bit_maximum_bits );
+DYNAMIC_BITSET_BENCHMARK( BM_ParseBinaryString, per_bit_maximum_bits );
+DYNAMIC_BITSET_BENCHMARK( BM_HexadecimalHugeNumber, per_bit_maximum_bits );
+DYNAMIC_BITSET_BENCHMARK( BM_ParseHexadecimalString, per_bit_maximum_bits );
+DYNAMIC_BITSET_BENCHMARK( BM_HexadecimalRawArray, per_bit_maximum_bits );
+DYNAMIC_BITSET_BENCHMARK( BM_DecimalHugeNumber, quadratic_maximum_bits );
+DYNAMIC_BITSET_BENCHMARK( BM_ParseDecimalString, quadratic_maximum_bits );
+DYNAMIC_BITSET_BENCHMARK( BM_DecimalRawArray, per_bit_maximum_bits );
+DYNAMIC_BITSET_BENCHMARK( BM_BitVectorData, per_bit_maximum_bits );
+
+DYNAMIC_BITSET_BENCHMARK( BM_ForwardIterator, per_bit_maximum_bits );
+DYNAMIC_BITSET_BENCHMARK( BM_ReverseIterator, per_bit_maximum_bits );
+
+DYNAMIC_BITSET_BENCHMARK( BM_ParallelAnd, maximum_bits );
+DYNAMIC_BITSET_BENCHMARK( BM_ParallelHammingWeight, maximum_bits );
+DYNAMIC_BITSET_BENCHMARK( BM_ParallelLeftShift, maximum_bits );
+
+BENCHMARK_MAIN();
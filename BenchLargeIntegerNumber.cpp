@@ -0,0 +1,214 @@
+#include "LargeIntegerNumber.hpp"
+
+#include <benchmark/benchmark.h>
+
+/*
+	LargeIntegerNumber 的微基准测试集 (Google Benchmark)
+	- 十进制转换与 DynamicBitSet 基于字符串的实现 (string_decimal_hugenumber / DynamicBitSet( string, 10 )，
+	  内部是 HighPrecisionNumberAdd 和逐位的字符串除以 2) 在相同的规模上对比。字符串实现只测到 4096 比特。
+	- 加减法、教科书乘法与 Karatsuba、除法和模幂按比特数递增。
+	只运行对比部分：
+		BenchLargeIntegerNumber --benchmark_filter=Decimal
+*/
+
+namespace
+{
+	using namespace TwilightDream;
+
+	constexpr int64_t minimum_bits = 64;
+	constexpr int64_t string_maximum_bits = 4096;
+	constexpr int64_t conversion_maximum_bits = int64_t( 1 ) << 18;
+	constexpr int64_t linear_maximum_bits = int64_t( 1 ) << 24;
+	constexpr int64_t multiply_maximum_bits = int64_t( 1 ) << 20;
+	// 二次的乘法 (以及一直递归到单个肢、说明阈值必要性的纯 Karatsuba) 和除法的上限更小
+	constexpr int64_t quadratic_maximum_bits = int64_t( 1 ) << 17;
+	constexpr int64_t pow_mod_maximum_bits = 4096;
+
+	// bit_count 个比特的随机数，最高位固定为 1
+	std::vector<uint32_t> random_limbs( size_t bit_count, uint32_t seed )
+	{
+		std::mt19937		  generator( seed );
+		std::vector<uint32_t> limbs( ( bit_count + 31 ) / 32 );
+		for ( auto& limb : limbs )
+		{
+			limb = generator();
+		}
+
+		const size_t top_bit = ( bit_count - 1 ) % 32;
+		limbs.back() &= top_bit == 31 ? 0xFFFFFFFF : ( ( uint32_t( 1 ) << ( top_bit + 1 ) ) - 1 );
+		limbs.back() |= uint32_t( 1 ) << top_bit;
+		return limbs;
+	}
+
+	LargeIntegerNumber random_number( size_t bit_count, uint32_t seed = 1 )
+	{
+		return LargeIntegerNumber( DynamicBitSet( random_limbs( bit_count, seed ) ) );
+	}
+
+	void set_bits( benchmark::State& state, size_t bit_count )
+	{
+		state.SetItemsProcessed( int64_t( state.iterations() ) * int64_t( bit_count ) );
+	}
+
+	/* 十进制转换：LargeIntegerNumber 对比 DynamicBitSet 的字符串实现 */
+
+	void BM_DecimalToString_LargeIntegerNumber( benchmark::State& state )
+	{
+		const size_t			 bit_count = state.range( 0 );
+		const LargeIntegerNumber number = random_number( bit_count );
+		for ( auto _ : state )
+		{
+			std::string decimal = number.to_string();
+			benchmark::DoNotOptimize( decimal.data() );
+		}
+		set_bits( state, bit_count );
+	}
+
+	void BM_DecimalToString_DynamicBitSet( benchmark::State& state )
+	{
+		const size_t		bit_count = state.range( 0 );
+		const DynamicBitSet bits( random_limbs( bit_count, 1 ) );
+		for ( auto _ : state )
+		{
+			std::string decimal = bits.string_decimal_hugenumber();
+			benchmark::DoNotOptimize( decimal.data() );
+		}
+		set_bits( state, bit_count );
+	}
+
+	void BM_DecimalParse_LargeIntegerNumber( benchmark::State& state )
+	{
+		const size_t	  bit_count = state.range( 0 );
+		const std::string decimal = random_number( bit_count ).to_string();
+		for ( auto _ : state )
+		{
+			LargeIntegerNumber number( decimal );
+			benchmark::DoNotOptimize( number.magnitude().chunk_data() );
+		}
+		set_bits( state, bit_count );
+	}
+
+	void BM_DecimalParse_DynamicBitSet( benchmark::State& state )
+	{
+		const size_t	  bit_count = state.range( 0 );
+		const std::string decimal = random_number( bit_count ).to_string();
+		for ( auto _ : state )
+		{
+			DynamicBitSet bits( decimal, 10 );
+			benchmark::DoNotOptimize( bits.chunk_data() );
+		}
+		set_bits( state, bit_count );
+	}
+
+	/* 算术 */
+
+	void BM_Add( benchmark::State& state )
+	{
+		const size_t			 bit_count = state.range( 0 );
+		const LargeIntegerNumber left = random_number( bit_count, 1 );
+		const LargeIntegerNumber right = random_number( bit_count, 2 );
+		for ( auto _ : state )
+		{
+			LargeIntegerNumber sum = left + right;
+			benchmark::DoNotOptimize( sum.magnitude().chunk_data() );
+		}
+		set_bits( state, bit_count );
+	}
+
+	void BM_Subtract( benchmark::State& state )
+	{
+		const size_t			 bit_count = state.range( 0 );
+		const LargeIntegerNumber left = random_number( bit_count, 1 );
+		const LargeIntegerNumber right = random_number( bit_count - 1, 2 );
+		for ( auto _ : state )
+		{
+			LargeIntegerNumber difference = left - right;
+			benchmark::DoNotOptimize( difference.magnitude().chunk_data() );
+		}
+		set_bits( state, bit_count );
+	}
+
+	void BM_Multiply( benchmark::State& state )
+	{
+		const size_t			 bit_count = state.range( 0 );
+		const LargeIntegerNumber left = random_number( bit_count, 1 );
+		const LargeIntegerNumber right = random_number( bit_count, 2 );
+		for ( auto _ : state )
+		{
+			LargeIntegerNumber product = left * right;
+			benchmark::DoNotOptimize( product.magnitude().chunk_data() );
+		}
+		set_bits( state, bit_count );
+	}
+
+	void BM_MultiplySchoolbook( benchmark::State& state )
+	{
+		const size_t			 bit_count = state.range( 0 );
+		const LargeIntegerNumber left = random_number( bit_count, 1 );
+		const LargeIntegerNumber right = random_number( bit_count, 2 );
+		for ( auto _ : state )
+		{
+			LargeIntegerNumber product = LargeIntegerNumber::multiply_schoolbook( left, right );
+			benchmark::DoNotOptimize( product.magnitude().chunk_data() );
+		}
+		set_bits( state, bit_count );
+	}
+
+	void BM_MultiplyKaratsuba( benchmark::State& state )
+	{
+		const size_t			 bit_count = state.range( 0 );
+		const LargeIntegerNumber left = random_number( bit_count, 1 );
+		const LargeIntegerNumber right = random_number( bit_count, 2 );
+		for ( auto _ : state )
+		{
+			LargeIntegerNumber product = LargeIntegerNumber::multiply_karatsuba( left, right );
+			benchmark::DoNotOptimize( product.magnitude().chunk_data() );
+		}
+		set_bits( state, bit_count );
+	}
+
+	// 被除数是除数的两倍长
+	void BM_Divide( benchmark::State& state )
+	{
+		const size_t			 bit_count = state.range( 0 );
+		const LargeIntegerNumber dividend = random_number( 2 * bit_count, 1 );
+		const LargeIntegerNumber divisor = random_number( bit_count, 2 );
+		for ( auto _ : state )
+		{
+			auto result = LargeIntegerNumber::divide( dividend, divisor );
+			benchmark::DoNotOptimize( result.first.magnitude().chunk_data() );
+		}
+		set_bits( state, bit_count );
+	}
+
+	void BM_PowMod( benchmark::State& state )
+	{
+		const size_t			 bit_count = state.range( 0 );
+		const LargeIntegerNumber base = random_number( bit_count, 1 );
+		const LargeIntegerNumber exponent = random_number( bit_count, 2 );
+		const LargeIntegerNumber modulus = random_number( bit_count, 3 );
+		for ( auto _ : state )
+		{
+			LargeIntegerNumber result = LargeIntegerNumber::pow_mod( base, exponent, modulus );
+			benchmark::DoNotOptimize( result.magnitude().chunk_data() );
+		}
+		set_bits( state, bit_count );
+	}
+}  // namespace
+
+#define LARGE_INTEGER_BENCHMARK( function, maximum ) BENCHMARK( function )->RangeMultiplier( 8 )->Range( minimum_bits, ( maximum ) )
+
+LARGE_INTEGER_BENCHMARK( BM_DecimalToString_LargeIntegerNumber, conversion_maximum_bits );
+LARGE_INTEGER_BENCHMARK( BM_DecimalToString_DynamicBitSet, string_maximum_bits );
+LARGE_INTEGER_BENCHMARK( BM_DecimalParse_LargeIntegerNumber, conversion_maximum_bits );
+LARGE_INTEGER_BENCHMARK( BM_DecimalParse_DynamicBitSet, string_maximum_bits );
+
+LARGE_INTEGER_BENCHMARK( BM_Add, linear_maximum_bits );
+LARGE_INTEGER_BENCHMARK( BM_Subtract, linear_maximum_bits );
+LARGE_INTEGER_BENCHMARK( BM_Multiply, multiply_maximum_bits );
+LARGE_INTEGER_BENCHMARK( BM_MultiplySchoolbook, quadratic_maximum_bits );
+LARGE_INTEGER_BENCHMARK( BM_MultiplyKaratsuba, quadratic_maximum_bits );
+LARGE_INTEGER_BENCHMARK( BM_Divide, quadratic_maximum_bits );
+LARGE_INTEGER_BENCHMARK( BM_PowMod, pow_mod_maximum_bits );
+
+BENCHMARK_MAIN();
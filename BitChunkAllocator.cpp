@@ -0,0 +1,81 @@
+#include "BitChunkAllocator.hpp"
+
+#include <new>
+
+#if defined( __linux__ )
+#include <sys/mman.h>
+#endif
+
+namespace TwilightDream
+{
+	/* CacheAlignedMemoryResource */
+
+	void* CacheAlignedMemoryResource::do_allocate( size_t bytes, size_t alignment )
+	{
+		return ::operator new( bytes, std::align_val_t( alignment > bit_chunk_alignment ? alignment : bit_chunk_alignment ) );
+	}
+
+	void CacheAlignedMemoryResource::do_deallocate( void* pointer, size_t bytes, size_t alignment )
+	{
+		::operator delete( pointer, bytes, std::align_val_t( alignment > bit_chunk_alignment ? alignment : bit_chunk_alignment ) );
+	}
+
+	bool CacheAlignedMemoryResource::do_is_equal( const std::pmr::memory_resource& other ) const noexcept
+	{
+		return dynamic_cast<const CacheAlignedMemoryResource*>( &other ) != nullptr;
+	}
+
+	/* HugePageMemoryResource */
+
+	HugePageMemoryResource::HugePageMemoryResource( size_t threshold_bytes, std::pmr::memory_resource* upstream )
+		: threshold_bytes( threshold_bytes ), upstream( upstream != nullptr ? upstream : cache_aligned_memory_resource() )
+	{}
+
+	void* HugePageMemoryResource::do_allocate( size_t bytes, size_t alignment )
+	{
+		if ( bytes < threshold_bytes )
+		{
+			return upstream->allocate( bytes, alignment );
+		}
+
+		// 按大页的整数倍分配，保证 madvise 覆盖的区间都属于这次分配
+		const size_t rounded_bytes = ( bytes + huge_page_size - 1 ) / huge_page_size * huge_page_size;
+		void*		 pointer = ::operator new( rounded_bytes, std::align_val_t( huge_page_size ) );
+
+#if defined( __linux__ ) && defined( MADV_HUGEPAGE )
+		// 只是一个建议，内核不支持透明大页时失败也没有关系
+		madvise( pointer, rounded_bytes, MADV_HUGEPAGE );
+#endif
+
+		return pointer;
+	}
+
+	void HugePageMemoryResource::do_deallocate( void* pointer, size_t bytes, size_t alignment )
+	{
+		if ( bytes < threshold_bytes )
+		{
+			upstream->deallocate( pointer, bytes, alignment );
+			return;
+		}
+
+		const size_t rounded_bytes = ( bytes + huge_page_size - 1 ) / huge_page_size * huge_page_size;
+		::operator delete( pointer, rounded_bytes, std::align_val_t( huge_page_size ) );
+	}
+
+	bool HugePageMemoryResource::do_is_equal( const std::pmr::memory_resource& other ) const noexcept
+	{
+		return this == &other;
+	}
+
+	std::pmr::memory_resource* cache_aligned_memory_resource() noexcept
+	{
+		static CacheAlignedMemoryResource resource;
+		return &resource;
+	}
+
+	std::pmr::memory_resource* huge_page_memory_resource() noexcept
+	{
+		static HugePageMemoryResource resource;
+		return &resource;
+	}
+}  // namespace TwilightDream
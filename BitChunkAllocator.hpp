@@ -0,0 +1,141 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+#include <vector>
+#include <memory_resource>
+#include <type_traits>
+
+#include "BooleanBitWrapper.hpp"
+
+namespace TwilightDream
+{
+	// 比特块存储的默认对齐 (一条 cache line)
+	constexpr size_t bit_chunk_alignment = 64;
+
+	/*
+		CacheAlignedMemoryResource
+		默认的内存资源：所有分配都至少按 64 字节 (cache line) 对齐，
+		这样 SIMD 内核可以假定对齐的加载，比特集也不会从一条 cache line 的中间开始。
+	*/
+	class CacheAlignedMemoryResource : public std::pmr::memory_resource
+	{
+	protected:
+		void* do_allocate( size_t bytes, size_t alignment ) override;
+		void  do_deallocate( void* pointer, size_t bytes, size_t alignment ) override;
+		bool  do_is_equal( const std::pmr::memory_resource& other ) const noexcept override;
+	};
+
+	/*
+		HugePageMemoryResource
+		大于等于 threshold_bytes 的分配按 2 MiB 对齐，并在 Linux 上通过 madvise( MADV_HUGEPAGE ) 请求透明大页，
+		减少超大比特集 (几 MB 以上) 的 TLB miss；较小的分配转发给 upstream。
+	*/
+	class HugePageMemoryResource : public std::pmr::memory_resource
+	{
+	public:
+		static constexpr size_t huge_page_size = size_t( 2 ) * 1024 * 1024;
+
+		explicit HugePageMemoryResource( size_t threshold_bytes = size_t( 4 ) * 1024 * 1024, std::pmr::memory_resource* upstream = nullptr );
+
+		size_t threshold() const noexcept
+		{
+			return threshold_bytes;
+		}
+
+	protected:
+		void* do_allocate( size_t bytes, size_t alignment ) override;
+		void  do_deallocate( void* pointer, size_t bytes, size_t alignment ) override;
+		bool  do_is_equal( const std::pmr::memory_resource& other ) const noexcept override;
+
+	private:
+		size_t						threshold_bytes;
+		std::pmr::memory_resource* upstream;
+	};
+
+	// 进程内共享的默认资源实例
+	std::pmr::memory_resource* cache_aligned_memory_resource() noexcept;
+	std::pmr::memory_resource* huge_page_memory_resource() noexcept;
+
+	/*
+		BitChunkAllocator
+		DynamicBitSet 比特块向量使用的分配器。它持有一个 std::pmr::memory_resource 指针，
+		默认使用 cache_aligned_memory_resource()；也可以传入 huge_page_memory_resource()、
+		std::pmr::monotonic_buffer_resource (每个请求的临时比特集) 等任何 PMR 资源。
+		每次分配都向资源请求至少 bit_chunk_alignment 字节的对齐。
+
+		与 std::pmr::polymorphic_allocator 不同，拷贝构造时会沿用同一个资源，
+		所以由一个 arena 比特集派生出的临时结果 (operator&、rotate 等内部的拷贝) 也来自同一个 arena。
+		拷贝赋值 / 移动赋值 / 交换时不传播分配器：赋值的目标保持自己的资源，
+		避免一个长期存在的比特集在赋值后指向已经释放的 arena。
+		代价是资源不同的两个比特集之间的移动赋值会分配并复制 (所以 DynamicBitSet 的移动赋值不是 noexcept)，
+		而交换要求两边的资源相同。移动构造总是沿用源的资源，不分配。
+	*/
+	template <typename Type>
+	class BitChunkAllocator
+	{
+	public:
+		using value_type = Type;
+		using propagate_on_container_copy_assignment = std::false_type;
+		using propagate_on_container_move_assignment = std::false_type;
+		using propagate_on_container_swap = std::false_type;
+		using is_always_equal = std::false_type;
+
+		BitChunkAllocator() noexcept
+			: resource( cache_aligned_memory_resource() )
+		{}
+
+		BitChunkAllocator( std::pmr::memory_resource* resource ) noexcept
+			: resource( resource != nullptr ? resource : cache_aligned_memory_resource() )
+		{}
+
+		template <typename OtherType>
+		BitChunkAllocator( const BitChunkAllocator<OtherType>& other ) noexcept
+			: resource( other.memory_resource() )
+		{}
+
+		Type* allocate( size_t count )
+		{
+			return static_cast<Type*>( resource->allocate( count * sizeof( Type ), allocation_alignment() ) );
+		}
+
+		void deallocate( Type* pointer, size_t count ) noexcept
+		{
+			resource->deallocate( pointer, count * sizeof( Type ), allocation_alignment() );
+		}
+
+		BitChunkAllocator select_on_container_copy_construction() const noexcept
+		{
+			return *this;
+		}
+
+		std::pmr::memory_resource* memory_resource() const noexcept
+		{
+			return resource;
+		}
+
+		template <typename OtherType>
+		friend bool operator==( const BitChunkAllocator& left, const BitChunkAllocator<OtherType>& right ) noexcept
+		{
+			return left.resource == right.memory_resource() || left.resource->is_equal( *right.memory_resource() );
+		}
+
+		template <typename OtherType>
+		friend bool operator!=( const BitChunkAllocator& left, const BitChunkAllocator<OtherType>& right ) noexcept
+		{
+			return !( left == right );
+		}
+
+	private:
+		std::pmr::memory_resource* resource;
+
+		static constexpr size_t allocation_alignment() noexcept
+		{
+			return alignof( Type ) > bit_chunk_alignment ? alignof( Type ) : bit_chunk_alignment;
+		}
+	};
+
+	// DynamicBitSet 的比特块容器
+	using BitChunkVector = std::vector<BooleanBitWrapper, BitChunkAllocator<BooleanBitWrapper>>;
+}  // namespace TwilightDream
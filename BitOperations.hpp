@@ -0,0 +1,119 @@
+#pragma once
+
+#include <cstdint>
+#include <cstddef>
+
+#if defined( _MSC_VER )
+#include <intrin.h>
+#endif
+
+#if defined( __BMI2__ )
+#include <immintrin.h>
+#endif
+
+namespace TwilightDream
+{
+	/*
+		可移植的位操作原语 (Portable bit primitives)
+		在 GCC / Clang 上映射到内建函数 (tzcnt / lzcnt / popcnt)，在 MSVC 上映射到对应的 intrinsic。
+		参数为 0 时的结果：count_trailing_zeros64 / count_leading_zeros64 返回 64。
+	*/
+
+	// 统计 64 位整数中比特'1'的数量
+	inline uint32_t population_count64( uint64_t value ) noexcept
+	{
+#if defined( __GNUC__ ) || defined( __clang__ )
+		return static_cast<uint32_t>( __builtin_popcountll( value ) );
+#else
+		value = value - ( ( value >> 1 ) & 0x5555555555555555ULL );
+		value = ( value & 0x3333333333333333ULL ) + ( ( value >> 2 ) & 0x3333333333333333ULL );
+		value = ( value + ( value >> 4 ) ) & 0x0F0F0F0F0F0F0F0FULL;
+		return static_cast<uint32_t>( ( value * 0x0101010101010101ULL ) >> 56 );
+#endif
+	}
+
+	// 从最低位开始连续的比特'0'的数量
+	inline uint32_t count_trailing_zeros64( uint64_t value ) noexcept
+	{
+		if ( value == 0 )
+		{
+			return 64;
+		}
+#if defined( __GNUC__ ) || defined( __clang__ )
+		return static_cast<uint32_t>( __builtin_ctzll( value ) );
+#elif defined( _MSC_VER ) && defined( _M_X64 )
+		unsigned long index;
+		_BitScanForward64( &index, value );
+		return static_cast<uint32_t>( index );
+#else
+		uint32_t count = 0;
+		while ( ( value & 1 ) == 0 )
+		{
+			value >>= 1;
+			++count;
+		}
+		return count;
+#endif
+	}
+
+	// 从最高位开始连续的比特'0'的数量
+	inline uint32_t count_leading_zeros64( uint64_t value ) noexcept
+	{
+		if ( value == 0 )
+		{
+			return 64;
+		}
+#if defined( __GNUC__ ) || defined( __clang__ )
+		return static_cast<uint32_t>( __builtin_clzll( value ) );
+#elif defined( _MSC_VER ) && defined( _M_X64 )
+		unsigned long index;
+		_BitScanReverse64( &index, value );
+		return static_cast<uint32_t>( 63 - index );
+#else
+		uint32_t count = 0;
+		while ( ( value & ( uint64_t( 1 ) << 63 ) ) == 0 )
+		{
+			value <<= 1;
+			++count;
+		}
+		return count;
+#endif
+	}
+
+	// 范围两端不完整的 32 位块的掩码：块内的比特 [ bit % 32, 32 ) 和 [ 0, bit % 32 ]
+	constexpr uint32_t mask_from( size_t bit ) noexcept
+	{
+		return uint32_t( 0xFFFFFFFF ) << ( bit % 32 );
+	}
+
+	constexpr uint32_t mask_through( size_t bit ) noexcept
+	{
+		return uint32_t( 0xFFFFFFFF ) >> ( 31 - bit % 32 );
+	}
+
+	// 第 rank 个 (从 0 开始) 比特'1'的位置，要求 rank < population_count64( value )
+	inline uint32_t select_in_word64( uint64_t value, uint32_t rank ) noexcept
+	{
+#if defined( __BMI2__ )
+		return count_trailing_zeros64( _pdep_u64( uint64_t( 1 ) << rank, value ) );
+#else
+		// 按字节的 popcount 乘以 0x0101... 得到按字节的前缀和，前缀和不超过 rank 的字节数就是目标所在的字节 (前缀和不超过 64，比较时不会借位)
+		constexpr uint64_t ones_bytes = 0x0101010101010101ULL;
+		constexpr uint64_t high_bits = 0x8080808080808080ULL;
+		uint64_t		   counts = value - ( ( value >> 1 ) & 0x5555555555555555ULL );
+		counts = ( counts & 0x3333333333333333ULL ) + ( ( counts >> 2 ) & 0x3333333333333333ULL );
+		counts = ( counts + ( counts >> 4 ) ) & 0x0F0F0F0F0F0F0F0FULL;
+		const uint64_t prefix = counts * ones_bytes;
+		const uint32_t byte = population_count64( ( ( ( rank * ones_bytes ) | high_bits ) - prefix ) & high_bits );
+		const uint32_t before = byte == 0 ? 0 : static_cast<uint32_t>( ( prefix >> ( byte * 8 - 8 ) ) & 0xFF );
+
+		// 在字节内清除前面的比特'1'
+		uint64_t bits = ( value >> ( byte * 8 ) ) & 0xFF;
+		for ( uint32_t skipped = before; skipped < rank; ++skipped )
+		{
+			bits &= bits - 1;
+		}
+		return byte * 8 + count_trailing_zeros64( bits );
+#endif
+	}
+}  // namespace TwilightDream
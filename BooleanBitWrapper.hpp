@@ -1,5 +1,8 @@
 #pragma once
 
+#include <cstddef>
+#include <cstdint>
+
 #include <vector>
 #include <algorithm>
 
@@ -10,59 +13,152 @@
 
 namespace TwilightDream
 {
+	/*
+		BooleanBitWrapper
+		32 位比特块。所有成员都是内联的 constexpr 函数，类型是平凡可复制 (trivially copyable) 的，
+		这样 std::vector 可以直接 memcpy 它，编译器也可以把遍历比特块的循环向量化。
+	*/
 	struct BooleanBitWrapper
 	{
 		uint32_t bits;
 
-		BooleanBitWrapper();
-		BooleanBitWrapper( uint32_t value );
-		~BooleanBitWrapper();
+		constexpr BooleanBitWrapper() noexcept : bits( 0 ) {}
+		constexpr BooleanBitWrapper( uint32_t value ) noexcept : bits( value ) {}
 
 		// 按位与操作
-		void bit_and( uint32_t other );
+		constexpr void bit_and( uint32_t other ) noexcept
+		{
+			bits &= other;
+		}
+
 		// 按位或操作
-		void bit_or( uint32_t other );
+		constexpr void bit_or( uint32_t other ) noexcept
+		{
+			bits |= other;
+		}
 
 		// 按位非操作
-		void bit_not();
+		constexpr void bit_not() noexcept
+		{
+			bits = ~bits;
+		}
 
 		// 按位异或操作
-		void bit_xor( uint32_t other );
+		constexpr void bit_xor( uint32_t other ) noexcept
+		{
+			bits ^= other;
+		}
+
 		// 按位同或操作
-		void bit_not_xor( uint32_t other );
+		constexpr void bit_not_xor( uint32_t other ) noexcept
+		{
+			bits = ~( bits ^ other );
+		}
 
 		// 按位非与操作
-		void bit_not_and( uint32_t other );
+		constexpr void bit_not_and( uint32_t other ) noexcept
+		{
+			bits = ~( bits & other );
+		}
 
 		// 按位非或操作
-		void bit_not_or( uint32_t other );
+		constexpr void bit_not_or( uint32_t other ) noexcept
+		{
+			bits = ~( bits | other );
+		}
 
 		// 按位左移操作
-		void bit_leftshift( int shift );
+		constexpr void bit_leftshift( int shift ) noexcept
+		{
+			bits <<= shift;
+		}
+
 		// 按位右移操作
-		void bit_rightshift( int shift );
+		constexpr void bit_rightshift( int shift ) noexcept
+		{
+			bits >>= shift;
+		}
 
 		// 设置所有位为给定的布尔值
-		void bit_set( bool value );
+		constexpr void bit_set( bool value ) noexcept
+		{
+			bits = value ? 0xFFFFFFFF : 0;
+		}
 
 		// 设置指定索引的位为给定的布尔值
-		void bit_set( bool value, int index );
+		constexpr void bit_set( bool value, int index ) noexcept
+		{
+			if ( value )
+			{
+				bits |= ( uint32_t( 1 ) << index );
+			}
+			else
+			{
+				bits &= ~( uint32_t( 1 ) << index );
+			}
+		}
 
 		// 翻转指定索引的位
-		void bit_flip( size_t index );
+		constexpr void bit_flip( size_t index ) noexcept
+		{
+			bits ^= ( uint32_t( 1 ) << index );
+		}
 
 		// 获取指定索引的位的布尔值
-		bool bit_get( int index ) const;
+		constexpr bool bit_get( int index ) const noexcept
+		{
+			return ( bits >> index ) & 1;
+		}
 
 		// 统计比特'1'的数量
-		size_t count_bits() const;
-
-		BooleanBitWrapper operator=( const BooleanBitWrapper& other );
-
-		operator uint32_t() const noexcept;
-
-		friend bool operator==( const BooleanBitWrapper& left, const BooleanBitWrapper& right );
-
-		friend bool operator!=( const BooleanBitWrapper& left, const BooleanBitWrapper& right );
+		constexpr size_t count_bits() const noexcept
+		{
+#if defined( __GNUC__ ) || defined( __clang__ )
+			return static_cast<size_t>( __builtin_popcount( bits ) );
+#else
+			uint32_t n = bits;
+
+			// 将相邻的位分组，每两位一组，然后用这两位中较低的一位表示这一组中置位的数量（0或1或2）
+			// 例如: 0b1101 (原始数值) 变成 0b0100
+			n = n - ( ( n >> 1 ) & 0x55555555 );
+
+			// 将相邻的两组位（即4位）合并为一组，然后用这一组中较低的两位表示这一组中置位的数量（0到4）
+			// 例如: 0b0100 (来自上一步) 变成 0b0010
+			n = ( n & 0x33333333 ) + ( ( n >> 2 ) & 0x33333333 );
+
+			// 将相邻的两组位（即8位）合并为一组，然后用这一组中较低的4位表示这一组中置位的数量（0到8）
+			// 并且我们通过和 0x0F0F0F0F 相与，消除了不需要的位
+			n = ( n + ( n >> 4 ) ) & 0x0F0F0F0F;
+
+			// 将32位数中的所有8位组合并，得到一个8位数，这个8位数的低8位表示原32位数中置位的数量（0到32）
+			n = n + ( n >> 8 );
+
+			// 同上，但这次是将两个8位数合并为一个16位数
+			n = n + ( n >> 16 );
+
+			// 使用与操作消除不需要的位，返回计数结果
+			return n & 0x3F;
+#endif
+		}
+
+		constexpr operator uint32_t() const noexcept
+		{
+			return bits;
+		}
+
+		friend constexpr bool operator==( const BooleanBitWrapper& left, const BooleanBitWrapper& right ) noexcept
+		{
+			return left.bits == right.bits;
+		}
+
+		friend constexpr bool operator!=( const BooleanBitWrapper& left, const BooleanBitWrapper& right ) noexcept
+		{
+			return left.bits != right.bits;
+		}
 	};
-}
\ No newline at end of file
+
+	// 比特块必须保持为一个普通的 32 位字：DynamicBitSet 的内核、AVX-512 gather 和 ConcurrentDynamicBitSet 的转换都依赖这一点
+	static_assert( sizeof( BooleanBitWrapper ) == sizeof( uint32_t ), "BooleanBitWrapper must be exactly one 32-bit word" );
+	static_assert( std::is_trivially_copyable<BooleanBitWrapper>::value, "BooleanBitWrapper must be trivially copyable" );
+	static_assert( std::is_standard_layout<BooleanBitWrapper>::value, "BooleanBitWrapper must be standard layout" );
+}  // namespace TwilightDream
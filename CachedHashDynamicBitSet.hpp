@@ -0,0 +1,133 @@
+#pragma once
+
+#include <cstdint>
+#include <cstddef>
+
+#include <atomic>
+#include <type_traits>
+#include <utility>
+
+#include "DynamicBitSet.hpp"
+
+namespace TwilightDream
+{
+	/*
+		CachedHashDynamicBitSet
+		带哈希缓存的 DynamicBitSet，用作 std::unordered_map / std::unordered_set 的键时每个元素只计算一次哈希。
+		- hash() 第一次调用时计算并缓存 (多个线程同时读取是安全的，最坏情况下重复计算同一个值)。
+		- 只能通过 modify() / assign() 修改比特，它们会让缓存失效；bits() 只返回常量引用。
+		- operator== 在两边都有缓存并且哈希值不同时直接返回 false。
+	*/
+	class CachedHashDynamicBitSet
+	{
+	public:
+		CachedHashDynamicBitSet() = default;
+
+		explicit CachedHashDynamicBitSet( DynamicBitSet bits )
+			: bits_value( std::move( bits ) )
+		{}
+
+		CachedHashDynamicBitSet( const CachedHashDynamicBitSet& other )
+			: bits_value( other.bits_value ), cached_hash( other.cached_hash.load( std::memory_order_relaxed ) ), cache_valid( other.cache_valid.load( std::memory_order_acquire ) )
+		{}
+
+		CachedHashDynamicBitSet( CachedHashDynamicBitSet&& other ) noexcept
+			: bits_value( std::move( other.bits_value ) ), cached_hash( other.cached_hash.load( std::memory_order_relaxed ) ), cache_valid( other.cache_valid.load( std::memory_order_acquire ) )
+		{
+			other.cache_valid.store( false, std::memory_order_relaxed );
+		}
+
+		CachedHashDynamicBitSet& operator=( const CachedHashDynamicBitSet& other )
+		{
+			if ( this != &other )
+			{
+				bits_value = other.bits_value;
+				cached_hash.store( other.cached_hash.load( std::memory_order_relaxed ), std::memory_order_relaxed );
+				cache_valid.store( other.cache_valid.load( std::memory_order_acquire ), std::memory_order_release );
+			}
+			return *this;
+		}
+
+		// 与 DynamicBitSet 相同，内存资源不同时移动赋值会分配
+		CachedHashDynamicBitSet& operator=( CachedHashDynamicBitSet&& other )
+		{
+			if ( this != &other )
+			{
+				bits_value = std::move( other.bits_value );
+				cached_hash.store( other.cached_hash.load( std::memory_order_relaxed ), std::memory_order_relaxed );
+				cache_valid.store( other.cache_valid.load( std::memory_order_acquire ), std::memory_order_release );
+				other.cache_valid.store( false, std::memory_order_relaxed );
+			}
+			return *this;
+		}
+
+		const DynamicBitSet& bits() const noexcept
+		{
+			return bits_value;
+		}
+
+		/*
+			用 modifier( DynamicBitSet& ) 修改比特，缓存失效；返回 modifier 的返回值。
+			返回引用的 modifier 不能使用 (重载不参与决议)：通过这个引用的修改发生在缓存失效之后，之后的 hash() 会返回过时的值。
+		*/
+		template <typename Modifier, typename = std::enable_if_t<!std::is_reference_v<std::invoke_result_t<Modifier, DynamicBitSet&>>>>
+		decltype( auto ) modify( Modifier&& modifier )
+		{
+			cache_valid.store( false, std::memory_order_relaxed );
+			return std::forward<Modifier>( modifier )( bits_value );
+		}
+
+		void assign( DynamicBitSet bits )
+		{
+			cache_valid.store( false, std::memory_order_relaxed );
+			bits_value = std::move( bits );
+		}
+
+		// 缓存中是否已经有哈希值
+		bool hash_cached() const noexcept
+		{
+			return cache_valid.load( std::memory_order_acquire );
+		}
+
+		uint64_t hash() const noexcept
+		{
+			if ( !cache_valid.load( std::memory_order_acquire ) )
+			{
+				cached_hash.store( bits_value.hash(), std::memory_order_relaxed );
+				cache_valid.store( true, std::memory_order_release );
+			}
+			return cached_hash.load( std::memory_order_relaxed );
+		}
+
+		friend bool operator==( const CachedHashDynamicBitSet& left, const CachedHashDynamicBitSet& right ) noexcept
+		{
+			if ( left.hash_cached() && right.hash_cached() && left.hash() != right.hash() )
+			{
+				return false;
+			}
+			return left.bits_value == right.bits_value;
+		}
+
+		friend bool operator!=( const CachedHashDynamicBitSet& left, const CachedHashDynamicBitSet& right ) noexcept
+		{
+			return !( left == right );
+		}
+
+	private:
+		DynamicBitSet				  bits_value;
+		mutable std::atomic<uint64_t> cached_hash { 0 };
+		mutable std::atomic<bool>	  cache_valid { false };
+	};
+}  // namespace TwilightDream
+
+namespace std
+{
+	template <>
+	struct hash<TwilightDream::CachedHashDynamicBitSet>
+	{
+		size_t operator()( const TwilightDream::CachedHashDynamicBitSet& bits ) const noexcept
+		{
+			return static_cast<size_t>( bits.hash() );
+		}
+	};
+}  // namespace std
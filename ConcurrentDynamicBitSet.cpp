@@ -0,0 +1,137 @@
+#include "ConcurrentDynamicBitSet.hpp"
+
+namespace TwilightDream
+{
+	/* ConcurrentDynamicBitSet */
+
+	ConcurrentDynamicBitSet::ConcurrentDynamicBitSet( size_t bit_size )
+		: data_size( bit_size ), data_word_count( ( bit_size + 63 ) / 64 )
+	{
+		const size_t cache_line_count = ( data_word_count + words_per_cache_line - 1 ) / words_per_cache_line;
+		cache_lines.reset( new CacheLineWords[ cache_line_count ] );
+
+		for ( size_t line = 0; line < cache_line_count; ++line )
+		{
+			for ( auto& value : cache_lines[ line ].words )
+			{
+				value.store( 0, std::memory_order_relaxed );
+			}
+		}
+	}
+
+	ConcurrentDynamicBitSet::ConcurrentDynamicBitSet( const DynamicBitSet& other )
+		: ConcurrentDynamicBitSet( other.bit_size() )
+	{
+		or_merge( other );
+	}
+
+	size_t ConcurrentDynamicBitSet::find_first_zero_and_set( size_t hint )
+	{
+		if ( data_word_count == 0 )
+		{
+			return npos;
+		}
+
+		const size_t first_word = ( hint < data_size ? hint : 0 ) / 64;
+		for ( size_t step = 0; step < data_word_count; ++step )
+		{
+			size_t word_index = first_word + step;
+			if ( word_index >= data_word_count )
+			{
+				word_index -= data_word_count;
+			}
+
+			std::atomic<uint64_t>& target = word( word_index );
+			const uint64_t		   mask = valid_mask( word_index );
+			uint64_t			   value = target.load( std::memory_order_relaxed );
+
+			// 这个字中还有空闲位时反复尝试，直到成功占用一个或者这个字被占满
+			uint64_t available = ~value & mask;
+			while ( available != 0 )
+			{
+				const uint64_t bit = uint64_t( 1 ) << count_trailing_zeros64( available );
+				const uint64_t previous = target.fetch_or( bit, std::memory_order_acq_rel );
+				if ( ( previous & bit ) == 0 )
+				{
+					const size_t index = word_index * 64 + count_trailing_zeros64( bit );
+					allocation_hint.value.store( index, std::memory_order_relaxed );
+					return index;
+				}
+				available = ~( previous | bit ) & mask;
+			}
+		}
+
+		return npos;
+	}
+
+	void ConcurrentDynamicBitSet::or_merge( const DynamicBitSet& other )
+	{
+		const BooleanBitWrapper* chunks = other.chunk_data();
+		const size_t			 chunk_count = std::min( other.chunk_count(), data_word_count * 2 );
+
+		for ( size_t word_index = 0; word_index * 2 < chunk_count; ++word_index )
+		{
+			uint64_t value = chunks[ word_index * 2 ].bits;
+			if ( word_index * 2 + 1 < chunk_count )
+			{
+				value |= uint64_t( chunks[ word_index * 2 + 1 ].bits ) << 32;
+			}
+
+			value &= valid_mask( word_index );
+			if ( value != 0 )
+			{
+				word( word_index ).fetch_or( value, std::memory_order_acq_rel );
+			}
+		}
+	}
+
+	void ConcurrentDynamicBitSet::or_merge( const ConcurrentDynamicBitSet& other )
+	{
+		const size_t word_count = std::min( data_word_count, other.data_word_count );
+		for ( size_t word_index = 0; word_index < word_count; ++word_index )
+		{
+			const uint64_t value = other.word( word_index ).load( std::memory_order_acquire ) & valid_mask( word_index );
+			if ( value != 0 )
+			{
+				word( word_index ).fetch_or( value, std::memory_order_acq_rel );
+			}
+		}
+	}
+
+	size_t ConcurrentDynamicBitSet::hamming_weight() const
+	{
+		size_t total_count = 0;
+		for ( size_t word_index = 0; word_index < data_word_count; ++word_index )
+		{
+			total_count += population_count64( word( word_index ).load( std::memory_order_relaxed ) & valid_mask( word_index ) );
+		}
+		return total_count;
+	}
+
+	DynamicBitSet ConcurrentDynamicBitSet::snapshot() const
+	{
+		DynamicBitSet		result( data_size, false );
+		BooleanBitWrapper* chunks = result.chunk_data();
+		const size_t		chunk_count = result.chunk_count();
+
+		for ( size_t word_index = 0; word_index < data_word_count; ++word_index )
+		{
+			const uint64_t value = word( word_index ).load( std::memory_order_acquire ) & valid_mask( word_index );
+			chunks[ word_index * 2 ].bits = static_cast<uint32_t>( value );
+			if ( word_index * 2 + 1 < chunk_count )
+			{
+				chunks[ word_index * 2 + 1 ].bits = static_cast<uint32_t>( value >> 32 );
+			}
+		}
+
+		return result;
+	}
+
+	void ConcurrentDynamicBitSet::reset()
+	{
+		for ( size_t word_index = 0; word_index < data_word_count; ++word_index )
+		{
+			word( word_index ).store( 0, std::memory_order_release );
+		}
+	}
+}  // namespace TwilightDream
@@ -0,0 +1,162 @@
+#pragma once
+
+#include <cstdint>
+#include <cstddef>
+
+#include <atomic>
+#include <memory>
+#include <stdexcept>
+
+#include "BitOperations.hpp"
+#include "DynamicBitSet.hpp"
+
+namespace TwilightDream
+{
+	/*
+		ConcurrentDynamicBitSet
+		固定大小、可以被多个线程同时修改的比特集 (lock-free)。
+		- 每个字都是 std::atomic<uint64_t>，单个比特的修改使用 fetch_or / fetch_and / fetch_xor 完成，不会丢失其他线程的更新。
+		- 字按 cache line (64 字节 = 8 个字) 分组并对齐，分配提示 (allocation hint) 单独占用一条 cache line，避免伪共享。
+		- 比特数量在构造时确定，不支持 resize / insert / erase 等会移动数据的操作。
+	*/
+	class ConcurrentDynamicBitSet
+	{
+	public:
+		static constexpr size_t npos = static_cast<size_t>( -1 );
+
+		// 一条 cache line 中的 64 位字的数量
+		static constexpr size_t words_per_cache_line = 8;
+
+		explicit ConcurrentDynamicBitSet( size_t bit_size );
+
+		// 从 DynamicBitSet 复制数据 (按 bit_size() 个比特)
+		explicit ConcurrentDynamicBitSet( const DynamicBitSet& other );
+
+		ConcurrentDynamicBitSet( const ConcurrentDynamicBitSet& other ) = delete;
+		ConcurrentDynamicBitSet& operator=( const ConcurrentDynamicBitSet& other ) = delete;
+
+		~ConcurrentDynamicBitSet() = default;
+
+		// 被记录的比特数量(大小)
+		size_t bit_size() const noexcept
+		{
+			return data_size;
+		}
+
+		// 64 位字的数量
+		size_t word_count() const noexcept
+		{
+			return data_word_count;
+		}
+
+		// 获取指定索引的位
+		bool test( size_t index, std::memory_order order = std::memory_order_acquire ) const
+		{
+			check_index( index );
+			return ( word( index / 64 ).load( order ) >> ( index % 64 ) ) & 1;
+		}
+
+		// 原子地把指定索引的位设置为 1，返回之前的值
+		bool fetch_set( size_t index, std::memory_order order = std::memory_order_acq_rel )
+		{
+			check_index( index );
+			const uint64_t mask = uint64_t( 1 ) << ( index % 64 );
+			return ( word( index / 64 ).fetch_or( mask, order ) & mask ) != 0;
+		}
+
+		// 原子地把指定索引的位设置为 0，返回之前的值
+		bool fetch_reset( size_t index, std::memory_order order = std::memory_order_acq_rel )
+		{
+			check_index( index );
+			const uint64_t mask = uint64_t( 1 ) << ( index % 64 );
+			return ( word( index / 64 ).fetch_and( ~mask, order ) & mask ) != 0;
+		}
+
+		// 原子地翻转指定索引的位，返回之前的值
+		bool fetch_flip( size_t index, std::memory_order order = std::memory_order_acq_rel )
+		{
+			check_index( index );
+			const uint64_t mask = uint64_t( 1 ) << ( index % 64 );
+			return ( word( index / 64 ).fetch_xor( mask, order ) & mask ) != 0;
+		}
+
+		/*
+			test-and-test-and-set：先用普通的 load 检查，只有当该位为 0 时才执行原子的读-改-写。
+			返回之前的值 (与 std::atomic_flag::test_and_set 相同)。
+			在高竞争的情况下避免了对已经置位的 cache line 的反复独占。
+		*/
+		bool test_and_set( size_t index )
+		{
+			check_index( index );
+			const uint64_t		   mask = uint64_t( 1 ) << ( index % 64 );
+			std::atomic<uint64_t>& target = word( index / 64 );
+			if ( target.load( std::memory_order_acquire ) & mask )
+			{
+				return true;
+			}
+			return ( target.fetch_or( mask, std::memory_order_acq_rel ) & mask ) != 0;
+		}
+
+		/*
+			查找第一个为 0 的位并原子地把它设置为 1 (用于槽位分配)，返回该位的索引；没有空闲位时返回 npos。
+			从 hint 所在的字开始循环扫描。每次 fetch_or 要么成功占用一个位，要么观察到该位已被其他线程占用，
+			因此在没有并发 fetch_reset 的情况下，每个字最多重试 64 次 (wait-free)；有并发释放时为 lock-free。
+		*/
+		size_t find_first_zero_and_set( size_t hint );
+
+		// 使用内部的分配提示作为起点
+		size_t find_first_zero_and_set()
+		{
+			return find_first_zero_and_set( allocation_hint.value.load( std::memory_order_relaxed ) );
+		}
+
+		// 原子地把 other 按位或合并进来 (逐字 fetch_or，other 超出 bit_size() 的部分被忽略)
+		void or_merge( const DynamicBitSet& other );
+		void or_merge( const ConcurrentDynamicBitSet& other );
+
+		// 计算设置为 true 的位数 (在并发修改时只是一个近似的快照)
+		size_t hamming_weight() const;
+
+		// 把当前内容复制为一个 DynamicBitSet (在并发修改时每个字各自是原子的)
+		DynamicBitSet snapshot() const;
+
+		// 把所有位设置为 0 (逐字原子写入)
+		void reset();
+
+	private:
+		struct alignas( 64 ) CacheLineWords
+		{
+			std::atomic<uint64_t> words[ words_per_cache_line ];
+		};
+
+		struct alignas( 64 ) PaddedHint
+		{
+			std::atomic<size_t> value { 0 };
+		};
+
+		std::unique_ptr<CacheLineWords[]> cache_lines;
+
+		size_t data_size = 0;
+		size_t data_word_count = 0;
+
+		// 上一次成功分配的位置，单独占用一条 cache line
+		PaddedHint allocation_hint;
+
+		std::atomic<uint64_t>& word( size_t word_index ) const noexcept
+		{
+			return cache_lines[ word_index / words_per_cache_line ].words[ word_index % words_per_cache_line ];
+		}
+
+		// 第 word_index 个字中属于有效比特的掩码
+		uint64_t valid_mask( size_t word_index ) const noexcept
+		{
+			const size_t remaining_bits = data_size - word_index * 64;
+			return remaining_bits >= 64 ? ~uint64_t( 0 ) : ( uint64_t( 1 ) << remaining_bits ) - 1;
+		}
+
+		void check_index( size_t index ) const
+		{
+			DefaultBitAccess::check_index( index, data_size, "Index out of range from concurrent bit set" );
+		}
+	};
+}  // namespace TwilightDream
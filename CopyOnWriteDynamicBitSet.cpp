@@ -0,0 +1,316 @@
+#include "CopyOnWriteDynamicBitSet.hpp"
+
+#include "DynamicBitSetKernels.hpp"
+
+#include <algorithm>
+#include <cstring>
+
+namespace TwilightDream
+{
+	/* CopyOnWriteDynamicBitSet */
+
+	CopyOnWriteDynamicBitSet::CopyOnWriteDynamicBitSet( size_t bit_size, bool fill_bit )
+		: table( std::make_shared<BlockTable>( ( bit_size + block_bits - 1 ) / block_bits, zero_block() ) ), data_size( bit_size )
+	{
+		if ( fill_bit )
+		{
+			for ( size_t block = 0; block < table->size(); ++block )
+			{
+				( *table )[ block ] = make_filled_block( block );
+			}
+		}
+	}
+
+	CopyOnWriteDynamicBitSet::CopyOnWriteDynamicBitSet( const DynamicBitSet& other )
+		: CopyOnWriteDynamicBitSet( other.bit_size() )
+	{
+		for ( size_t block = 0; block < table->size(); ++block )
+		{
+			// 只读取块内属于 [ 0, bit_size() ) 的比特，全零的块继续共享零块
+			const size_t block_begin = block * block_bits;
+			const size_t block_end = std::min( block_begin + block_bits, data_size );
+			if ( bits_find_next( other.chunk_data(), block_begin, block_end ) != block_end )
+			{
+				BlockPointer copied = std::make_shared<Block>();
+				bits_apply_range( BitRangeOperation::Copy, copied->chunks.data(), 0, other.chunk_data(), block_begin, block_end - block_begin );
+				( *table )[ block ] = std::move( copied );
+			}
+		}
+	}
+
+	const CopyOnWriteDynamicBitSet::BlockPointer& CopyOnWriteDynamicBitSet::zero_block()
+	{
+		static const BlockPointer block = std::make_shared<Block>();
+		return block;
+	}
+
+	void CopyOnWriteDynamicBitSet::detach_table()
+	{
+		if ( table.use_count() > 1 )
+		{
+			table = std::make_shared<BlockTable>( *table );
+		}
+	}
+
+	BooleanBitWrapper* CopyOnWriteDynamicBitSet::mutable_block( size_t block )
+	{
+		detach_table();
+		BlockPointer& pointer = ( *table )[ block ];
+		// 零块总是至少有两个引用 (zero_block() 自己持有一个)，所以也会在这里被复制
+		if ( pointer.use_count() > 1 )
+		{
+			pointer = std::make_shared<Block>( *pointer );
+		}
+		return pointer->chunks.data();
+	}
+
+	size_t CopyOnWriteDynamicBitSet::block_chunk_count( size_t block ) const noexcept
+	{
+		return std::min( block_chunks, chunk_count() - block * block_chunks );
+	}
+
+	CopyOnWriteDynamicBitSet::BlockPointer CopyOnWriteDynamicBitSet::make_filled_block( size_t block ) const
+	{
+		BlockPointer filled = std::make_shared<Block>();
+		bits_assign_range( filled->chunks.data(), 0, std::min( block_bits, data_size - block * block_bits ), true );
+		return filled;
+	}
+
+	void CopyOnWriteDynamicBitSet::set_bit( bool value, size_t index )
+	{
+		check_index( index );
+		const size_t   block = index / block_bits;
+		const size_t   chunk = index % block_bits / 32;
+		const uint32_t mask = uint32_t( 1 ) << ( index % 32 );
+		if ( ( ( block_data( block )[ chunk ].bits & mask ) != 0 ) == value )
+		{
+			return;
+		}
+		mutable_block( block )[ chunk ].bits ^= mask;
+	}
+
+	void CopyOnWriteDynamicBitSet::flip( size_t index )
+	{
+		check_index( index );
+		mutable_block( index / block_bits )[ index % block_bits / 32 ].bits ^= uint32_t( 1 ) << ( index % 32 );
+	}
+
+	void CopyOnWriteDynamicBitSet::set( size_t pos, size_t len, bool value )
+	{
+		if ( len == 0 )
+		{
+			return;
+		}
+		check_index( pos );
+		check_index( pos + len - 1 );
+
+		const size_t end = pos + len;
+		for ( size_t block = pos / block_bits; block <= ( end - 1 ) / block_bits; ++block )
+		{
+			const size_t block_begin = block * block_bits;
+			const size_t block_end = std::min( block_begin + block_bits, data_size );
+			const size_t first = std::max( pos, block_begin );
+			const size_t last = std::min( end, block_end );
+
+			// 整块被覆盖：直接换成零块或者新的全 1 块，不需要复制旧的数据
+			if ( first == block_begin && last == block_end )
+			{
+				detach_table();
+				( *table )[ block ] = value ? make_filled_block( block ) : zero_block();
+				continue;
+			}
+
+			bits_assign_range( mutable_block( block ), first - block_begin, last - first, value );
+		}
+	}
+
+	void CopyOnWriteDynamicBitSet::set()
+	{
+		if ( data_size != 0 )
+		{
+			set( 0, data_size, true );
+		}
+	}
+
+	void CopyOnWriteDynamicBitSet::reset()
+	{
+		table = std::make_shared<BlockTable>( table->size(), zero_block() );
+	}
+
+	bool CopyOnWriteDynamicBitSet::any() const noexcept
+	{
+		for ( size_t block = 0; block < table->size(); ++block )
+		{
+			if ( !is_zero_block( block ) && chunks_any( block_data( block ), block_chunk_count( block ) ) )
+			{
+				return true;
+			}
+		}
+		return false;
+	}
+
+	size_t CopyOnWriteDynamicBitSet::hamming_weight() const noexcept
+	{
+		size_t weight = 0;
+		for ( size_t block = 0; block < table->size(); ++block )
+		{
+			if ( !is_zero_block( block ) )
+			{
+				weight += chunks_population_count( block_data( block ), block_chunk_count( block ) );
+			}
+		}
+		return weight;
+	}
+
+	/*
+		按位运算按块进行：两边是同一个块、或者有一边是零块时结果可以直接确定 (跳过、换成零块或者共享对方的块)，
+		只有两边是不同的非零块时才复制自己的块并调用内核。结果变为全零的块换回零块，释放它的存储。
+	*/
+
+	CopyOnWriteDynamicBitSet& CopyOnWriteDynamicBitSet::and_operation( const CopyOnWriteDynamicBitSet& other )
+	{
+		check_same_bit_size( data_size, other.data_size, "CopyOnWriteDynamicBitSet" );
+		for ( size_t block = 0; block < table->size(); ++block )
+		{
+			const BlockPointer& theirs = ( *other.table )[ block ];
+			if ( is_zero_block( block ) || ( *table )[ block ] == theirs )
+			{
+				continue;
+			}
+			if ( theirs == zero_block() )
+			{
+				detach_table();
+				( *table )[ block ] = zero_block();
+				continue;
+			}
+
+			const size_t	   count = block_chunk_count( block );
+			BooleanBitWrapper* chunks = mutable_block( block );
+			chunks_and( chunks, theirs->chunks.data(), count );
+			if ( !chunks_any( chunks, count ) )
+			{
+				( *table )[ block ] = zero_block();
+			}
+		}
+		return *this;
+	}
+
+	CopyOnWriteDynamicBitSet& CopyOnWriteDynamicBitSet::or_operation( const CopyOnWriteDynamicBitSet& other )
+	{
+		check_same_bit_size( data_size, other.data_size, "CopyOnWriteDynamicBitSet" );
+		for ( size_t block = 0; block < table->size(); ++block )
+		{
+			const BlockPointer& theirs = ( *other.table )[ block ];
+			if ( theirs == zero_block() || ( *table )[ block ] == theirs )
+			{
+				continue;
+			}
+			if ( is_zero_block( block ) )
+			{
+				detach_table();
+				( *table )[ block ] = theirs;
+				continue;
+			}
+
+			chunks_or( mutable_block( block ), theirs->chunks.data(), block_chunk_count( block ) );
+		}
+		return *this;
+	}
+
+	CopyOnWriteDynamicBitSet& CopyOnWriteDynamicBitSet::xor_operation( const CopyOnWriteDynamicBitSet& other )
+	{
+		check_same_bit_size( data_size, other.data_size, "CopyOnWriteDynamicBitSet" );
+		for ( size_t block = 0; block < table->size(); ++block )
+		{
+			const BlockPointer& theirs = ( *other.table )[ block ];
+			if ( theirs == zero_block() )
+			{
+				continue;
+			}
+			if ( ( *table )[ block ] == theirs || is_zero_block( block ) )
+			{
+				// 相同的块异或为零，零块异或对方的块就是对方的块
+				const BlockPointer result = ( *table )[ block ] == theirs ? zero_block() : theirs;
+				detach_table();
+				( *table )[ block ] = result;
+				continue;
+			}
+
+			const size_t	   count = block_chunk_count( block );
+			BooleanBitWrapper* chunks = mutable_block( block );
+			chunks_xor( chunks, theirs->chunks.data(), count );
+			if ( !chunks_any( chunks, count ) )
+			{
+				( *table )[ block ] = zero_block();
+			}
+		}
+		return *this;
+	}
+
+	CopyOnWriteDynamicBitSet& CopyOnWriteDynamicBitSet::and_not_operation( const CopyOnWriteDynamicBitSet& other )
+	{
+		check_same_bit_size( data_size, other.data_size, "CopyOnWriteDynamicBitSet" );
+		for ( size_t block = 0; block < table->size(); ++block )
+		{
+			const BlockPointer& theirs = ( *other.table )[ block ];
+			if ( is_zero_block( block ) || theirs == zero_block() )
+			{
+				continue;
+			}
+			if ( ( *table )[ block ] == theirs )
+			{
+				detach_table();
+				( *table )[ block ] = zero_block();
+				continue;
+			}
+
+			const size_t	   count = block_chunk_count( block );
+			BooleanBitWrapper* chunks = mutable_block( block );
+			chunks_and_not( chunks, theirs->chunks.data(), count );
+			if ( !chunks_any( chunks, count ) )
+			{
+				( *table )[ block ] = zero_block();
+			}
+		}
+		return *this;
+	}
+
+	DynamicBitSet CopyOnWriteDynamicBitSet::to_dynamic_bitset() const
+	{
+		DynamicBitSet result( data_size, false );
+		for ( size_t block = 0; block < table->size(); ++block )
+		{
+			if ( !is_zero_block( block ) )
+			{
+				const BooleanBitWrapper* source = block_data( block );
+				std::copy( source, source + block_chunk_count( block ), result.chunk_data() + block * block_chunks );
+			}
+		}
+		return result;
+	}
+
+	bool operator==( const CopyOnWriteDynamicBitSet& left, const CopyOnWriteDynamicBitSet& right ) noexcept
+	{
+		if ( left.data_size != right.data_size )
+		{
+			return false;
+		}
+		if ( left.table == right.table )
+		{
+			return true;
+		}
+
+		for ( size_t block = 0; block < left.table->size(); ++block )
+		{
+			if ( left.shares_block( right, block ) )
+			{
+				continue;
+			}
+			if ( std::memcmp( left.block_data( block ), right.block_data( block ), left.block_chunk_count( block ) * sizeof( BooleanBitWrapper ) ) != 0 )
+			{
+				return false;
+			}
+		}
+		return true;
+	}
+}  // namespace TwilightDream
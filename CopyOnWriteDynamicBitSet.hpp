@@ -0,0 +1,186 @@
+#pragma once
+
+#include <cstdint>
+#include <cstddef>
+
+#include <array>
+#include <memory>
+#include <vector>
+
+#include "DynamicBitSet.hpp"
+
+namespace TwilightDream
+{
+	/*
+		CopyOnWriteDynamicBitSet
+		写时复制 (copy-on-write) 的固定大小比特集，复制是 O(1) 的，多个副本共享没有被修改过的存储。
+		- 两级结构：对象持有一个 std::shared_ptr 指向块表，块表中的每一项是指向一个块 (4 KiB = 1024 个比特块) 的 std::shared_ptr。
+		- 复制只增加块表的引用计数。第一次修改时，如果块表被共享就先复制块表 (只复制指针)，
+		  如果要写的块被共享就只复制这一个块，所以修改一个比特最多复制一个 4 KiB 的页。
+		- 全零的块共享同一个只读的零块：构造一个空集合或者 reset() 不需要分配块内存。
+		- 按位运算在两边的块是同一个指针或者有一边是零块时不读取数据 (例如 or 直接共享对方的块)。
+		- 最后一个块中超出 bit_size() 的比特保持为 0 (set() 得到的全 1 块也只填到 bit_size())，所以计数和比较可以对整块调用内核。
+		- 不同的副本可以交给不同的线程；同一个对象的并发修改需要外部同步。
+	*/
+	class CopyOnWriteDynamicBitSet
+	{
+	public:
+		// 每个块的比特块数量和比特数量
+		static constexpr size_t block_chunks = 1024;
+		static constexpr size_t block_bits = block_chunks * 32;
+
+		explicit CopyOnWriteDynamicBitSet( size_t bit_size = 0, bool fill_bit = false );
+
+		// bit_size() 取 other.bit_size()；只为含有比特'1'的块分配存储，其余的块共享零块
+		explicit CopyOnWriteDynamicBitSet( const DynamicBitSet& other );
+
+		// 复制与赋值只共享块表 (O(1))
+		// (没有单独的移动操作，被移动的对象仍然是一个有效的副本)
+		CopyOnWriteDynamicBitSet( const CopyOnWriteDynamicBitSet& other ) = default;
+		CopyOnWriteDynamicBitSet& operator=( const CopyOnWriteDynamicBitSet& other ) = default;
+
+		size_t bit_size() const noexcept
+		{
+			return data_size;
+		}
+
+		size_t chunk_count() const noexcept
+		{
+			return ( data_size + 31 ) / 32;
+		}
+
+		size_t block_count() const noexcept
+		{
+			return table->size();
+		}
+
+		// 第 block 个块的比特块 (只读，共 block_chunks 个，超出 chunk_count() 的部分为 0)
+		const BooleanBitWrapper* block_data( size_t block ) const noexcept
+		{
+			return ( *table )[ block ]->chunks.data();
+		}
+
+		// 第 block 个块是否与 other 共享同一份存储
+		bool shares_block( const CopyOnWriteDynamicBitSet& other, size_t block ) const noexcept
+		{
+			return ( *table )[ block ] == ( *other.table )[ block ];
+		}
+
+		// 整个块表是否与 other 共享 (复制之后还没有修改过)
+		bool shares_storage( const CopyOnWriteDynamicBitSet& other ) const noexcept
+		{
+			return table == other.table;
+		}
+
+		bool test( size_t index ) const
+		{
+			check_index( index );
+			return ( block_data( index / block_bits )[ index % block_bits / 32 ].bits >> ( index % 32 ) ) & 1;
+		}
+
+		bool operator[]( size_t index ) const
+		{
+			return test( index );
+		}
+
+		// 参数顺序与 DynamicBitSet::set_bit 相同；值没有改变时不会复制块
+		void set_bit( bool value, size_t index );
+
+		void set( size_t index )
+		{
+			set_bit( true, index );
+		}
+
+		void reset( size_t index )
+		{
+			set_bit( false, index );
+		}
+
+		void flip( size_t index );
+
+		// 把 [ pos, pos + len ) 设置为 value，整块覆盖的部分直接换成零块或者新的全 1 块
+		void set( size_t pos, size_t len, bool value );
+
+		// 所有位设置为 1 / 0 (reset() 让所有块共享零块)
+		void set();
+		void reset();
+
+		bool any() const noexcept;
+
+		bool none() const noexcept
+		{
+			return !any();
+		}
+
+		size_t hamming_weight() const noexcept;
+
+		// 要求 bit_size() 相同，否则抛出 std::invalid_argument
+		CopyOnWriteDynamicBitSet& and_operation( const CopyOnWriteDynamicBitSet& other );
+		CopyOnWriteDynamicBitSet& or_operation( const CopyOnWriteDynamicBitSet& other );
+		CopyOnWriteDynamicBitSet& xor_operation( const CopyOnWriteDynamicBitSet& other );
+		CopyOnWriteDynamicBitSet& and_not_operation( const CopyOnWriteDynamicBitSet& other );
+
+		CopyOnWriteDynamicBitSet& operator&=( const CopyOnWriteDynamicBitSet& other )
+		{
+			return and_operation( other );
+		}
+
+		CopyOnWriteDynamicBitSet& operator|=( const CopyOnWriteDynamicBitSet& other )
+		{
+			return or_operation( other );
+		}
+
+		CopyOnWriteDynamicBitSet& operator^=( const CopyOnWriteDynamicBitSet& other )
+		{
+			return xor_operation( other );
+		}
+
+		// 复制为普通的 DynamicBitSet (bit_size() 相同)
+		DynamicBitSet to_dynamic_bitset() const;
+
+		// bit_size() 相同并且每一位都相同 (共享的块不比较数据)
+		friend bool operator==( const CopyOnWriteDynamicBitSet& left, const CopyOnWriteDynamicBitSet& right ) noexcept;
+
+		friend bool operator!=( const CopyOnWriteDynamicBitSet& left, const CopyOnWriteDynamicBitSet& right ) noexcept
+		{
+			return !( left == right );
+		}
+
+	private:
+		struct Block
+		{
+			std::array<BooleanBitWrapper, block_chunks> chunks {};
+		};
+
+		using BlockPointer = std::shared_ptr<Block>;
+		using BlockTable = std::vector<BlockPointer>;
+
+		std::shared_ptr<BlockTable> table;
+		size_t						data_size = 0;
+
+		// 所有对象共享的只读零块 (它本身总是持有一个引用，因此永远不会被就地修改)
+		static const BlockPointer& zero_block();
+
+		bool is_zero_block( size_t block ) const noexcept
+		{
+			return ( *table )[ block ] == zero_block();
+		}
+
+		// 获得第 block 个块的独占可写指针 (必要时复制块表和块)
+		BooleanBitWrapper* mutable_block( size_t block );
+
+		// 块表被共享时复制块表 (只复制指针)
+		void detach_table();
+
+		// 第 block 个块中有效的比特块数量
+		size_t block_chunk_count( size_t block ) const noexcept;
+
+		// 一个完全属于有效范围的全 1 块，最后一个块只有有效比特为 1
+		BlockPointer make_filled_block( size_t block ) const;
+
+		void check_index( size_t index ) const
+		{
+			DefaultBitAccess::check_index( index, data_size, "Index out of range from copy-on-write bit set" );
+		}
+	};
+}  // namespace TwilightDream
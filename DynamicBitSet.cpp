@@ -51,17 +51,16 @@ namespace TwilightDream
 	// Subscript Operator for non-const DynamicBitSet
 	BitReference DynamicBitSet::operator[]( size_t index )
 	{
-		if ( index >= this->data_size )
-			throw std::out_of_range( "Index out of range" );
+		DefaultBitAccess::check_index( index, this->data_size, "Index out of range" );
 
-		return BitReference( &(this->bitset[index / 32]), uint32_t(1) << index % 32 );
+		// 比特块的地址直接取自 bitset，一定有效，所以使用不检查空指针的 (noexcept) 构造函数
+		return BitReference( &(this->bitset[index / 32].bits), uint32_t(1) << index % 32 );
 	}
 
 	// Subscript Operator for non-const DynamicBitSet
 	bool DynamicBitSet::operator[]( size_t index ) const
 	{
-		if ( index >= this->data_size )
-			throw std::out_of_range( "Index out of range" );
+		DefaultBitAccess::check_index( index, this->data_size, "Index out of range" );
 
 		return this->bitset[ index / 32 ].bit_get( index % 32 );
 	}
@@ -75,8 +74,13 @@ namespace TwilightDream
 			return;
 		}
 
+		DYNAMIC_BITSET_RECORD_CALL( RotateLeft, bitset.size() * sizeof( BooleanBitWrapper ) );
+
 		if( shift >= 256 )
 		{
+			// 转换为 std::vector<bool> 再旋转是慢速路径
+			DYNAMIC_BITSET_RECORD_SLOW_PATH( RotateLeft, bitset.size() * sizeof( BooleanBitWrapper ) );
+
 			std::vector<bool> buffer = this->bit_vector_data();
 			std::rotate(buffer.begin(), buffer.begin() + shift % buffer.size(), buffer.end());
 			*this = DynamicBitSet(buffer);
@@ -105,8 +109,13 @@ namespace TwilightDream
 			return;
 		}
 
+		DYNAMIC_BITSET_RECORD_CALL( RotateRight, bitset.size() * sizeof( BooleanBitWrapper ) );
+
 		if( shift >= 256 )
 		{
+			// 转换为 std::vector<bool> 再旋转是慢速路径
+			DYNAMIC_BITSET_RECORD_SLOW_PATH( RotateRight, bitset.size() * sizeof( BooleanBitWrapper ) );
+
 			std::vector<bool> buffer = this->bit_vector_data();
 			std::rotate(buffer.rbegin(), buffer.rbegin() + shift % buffer.size(), buffer.rend());
 			*this = DynamicBitSet(buffer);
@@ -3,6 +3,8 @@
 #include <cstdint>
 #include <cstdlib>
 #include <cassert>
+#include <climits>
+#include <cstring>
 
 #include <iostream>
 #include <iomanip>
@@ -15,17 +17,75 @@
 #include <random>
 #include <chrono>
 #include <stdexcept>
+#include <string>
 #include <sstream>
 #include <utility>
 #include <type_traits>
 
+#if defined( __AVX512F__ ) || defined( __SSE__ ) || defined( _M_X64 ) || defined( _M_IX86 )
+#include <immintrin.h>
+#endif
+
+#include "BitOperations.hpp"
 #include "DynamicBitSetIterators.hpp"
+#include "DynamicBitSetParallel.hpp"
+#include "DynamicBitSetRandom.hpp"
+#include "DynamicBitSetInstrumentation.hpp"
+#include "DynamicBitSetKernels.hpp"
+#include "DynamicBitSetHash.hpp"
 
 namespace TwilightDream
 {
+	/*
+		比特访问策略 (Bit access policy)
+		CheckedBitAccess:   索引越界时抛出 std::out_of_range
+		UncheckedBitAccess: 不做任何检查 (仅 Debug 下的 assert)，调用者必须保证 index < bit_size()
+		定义 LARGE_DYNAMIC_BITSET_UNCHECKED_ACCESS 之后，get_bit / set_bit / flip / operator[] 默认使用 UncheckedBitAccess
+	*/
+	struct CheckedBitAccess
+	{
+		static constexpr void check_index( size_t index, size_t bit_size, const char* message )
+		{
+			if ( index >= bit_size )
+			{
+				throw std::out_of_range( message );
+			}
+		}
+	};
+
+	struct UncheckedBitAccess
+	{
+		static constexpr void check_index( size_t index, size_t bit_size, const char* message ) noexcept
+		{
+			assert( index < bit_size && message != nullptr );
+			( void )index;
+			( void )bit_size;
+			( void )message;
+		}
+	};
+
+#if defined( LARGE_DYNAMIC_BITSET_UNCHECKED_ACCESS )
+	using DefaultBitAccess = UncheckedBitAccess;
+#else
+	using DefaultBitAccess = CheckedBitAccess;
+#endif
+
+	// 固定大小的比特集 (例如 HierarchicalDynamicBitSet) 之间的按位运算要求两边的 bit_size() 相同，否则抛出 std::invalid_argument
+	inline void check_same_bit_size( size_t left_size, size_t right_size, const char* type_name )
+	{
+		if ( left_size != right_size )
+		{
+			throw std::invalid_argument( std::string( type_name ) + ": operands must have the same bit_size()" );
+		}
+	}
+
+	class DynamicBitSetComplement;
+
 	class DynamicBitSet
 	{
 	public:
+		// find_next 没有找到时的返回值
+		static constexpr size_t npos = static_cast<size_t>( -1 );
 
 		DynamicBitSet()
 		{
@@ -35,9 +95,19 @@ namespace TwilightDream
 			data_chunk_count = 0;
 		}
 
-		DynamicBitSet( size_t initial_bit_capacity, bool fill_bit )
+		// 使用指定的内存资源 (例如 huge_page_memory_resource() 或 std::pmr::monotonic_buffer_resource) 的空比特集
+		explicit DynamicBitSet( std::pmr::memory_resource* resource )
+			:
+			bitset( BitChunkAllocator<BooleanBitWrapper>( resource ) )
+		{
+			data_size = 0;
+			data_capacity = 0;
+			data_chunk_count = 0;
+		}
+
+		DynamicBitSet( size_t initial_bit_capacity, bool fill_bit, std::pmr::memory_resource* resource = nullptr )
 			:
-			bitset(needed_chunks(initial_bit_capacity), fill_bit ? BooleanBitWrapper( 0xFFFFFFFF ) : BooleanBitWrapper( 0x00000000 ))
+			bitset(needed_chunks(initial_bit_capacity), fill_bit ? BooleanBitWrapper( 0xFFFFFFFF ) : BooleanBitWrapper( 0x00000000 ), BitChunkAllocator<BooleanBitWrapper>( resource ))
 		{
 			// 设置实际的比特大小
 			data_chunk_count = bitset.size();
@@ -47,7 +117,7 @@ namespace TwilightDream
 			// 如果有多余的比特，设置它们
 			size_t extra_bits = initial_bit_capacity % 32;  // 假设每个块有32位
 			if (extra_bits != 0) {
-				uint32_t mask = (1 << extra_bits) - 1;  // 创建一个掩码，用于保留需要的比特
+				uint32_t mask = (uint32_t(1) << extra_bits) - 1;  // 创建一个掩码，用于保留需要的比特
 				this->bitset.back().bits &= mask;  // 使用掩码来清除(MSB)多余的比特
 			}
 		}
@@ -79,9 +149,9 @@ namespace TwilightDream
 					set_bit( binary[ i ] == '1', i );
 			}
 
-			// 设置实际的比特大小
+			// 设置实际的比特大小 (与 DynamicBitSet( string, 2 ) 相同，保留前导零：比特数量就是字符串的长度)
 			data_chunk_count = bitset.size();
-			data_size = this->valid_number_of_bits();
+			data_size = binaryString.size();
 			data_capacity = bitset.size() * 32;
 		}
 
@@ -125,9 +195,9 @@ namespace TwilightDream
 				throw std::invalid_argument( "Invalid format specifier" );
 			}
 
-			// 设置实际的比特大小
+			// 设置实际的比特大小 (二进制字符串保留前导零：比特数量就是字符串的长度，format_binary_string( true ) 可以原样还原)
 			data_chunk_count = bitset.size();
-			data_size = this->valid_number_of_bits();
+			data_size = formatted == 2 ? string.size() : this->valid_number_of_bits();
 			data_capacity = bitset.size() * 32;
 		}
 
@@ -235,7 +305,7 @@ namespace TwilightDream
 		}
 
 		DynamicBitSet( const std::vector<BooleanBitWrapper>& wrapper_bool_vector )
-			: bitset( wrapper_bool_vector )
+			: bitset( wrapper_bool_vector.begin(), wrapper_bool_vector.end() )
 		{
 			// 更新成员变量
 			this->data_chunk_count = bitset.size();
@@ -270,7 +340,8 @@ namespace TwilightDream
 			// 这里你可能还想进行一些额外的移动操作
 		}
 
-		DynamicBitSet& operator=( DynamicBitSet&& other ) noexcept
+		// 不是 noexcept：BitChunkAllocator 在移动赋值时不传播，两边的内存资源不同时 vector 会在目标的资源中重新分配并复制比特块
+		DynamicBitSet& operator=( DynamicBitSet&& other )
 		{
 			if ( this == &other )
 			{
@@ -369,12 +440,25 @@ namespace TwilightDream
 				// 如果当前 wrapper 不全为零，则进一步检查
 				if ( currentWrapperBits != 0 )
 				{
+					// 扫描超过最高的一个块就是一次完整的重新扫描 (慢速路径)
+					DYNAMIC_BITSET_RECORD_CALL( ValidNumberOfBits, ( bitset.size() - wrapperIndex + 1 ) * sizeof( BooleanBitWrapper ) );
+					if ( wrapperIndex != bitset.size() )
+					{
+						DYNAMIC_BITSET_RECORD_SLOW_PATH( ValidNumberOfBits, 0 );
+					}
+
 					// 使用 LeadingZeros 函数来找到从最高位开始到第一个非零位之间的零的数量
 					// 然后计算并返回实际使用的比特数量
 					return ( wrapperIndex - 1 ) * 32 + ( uint32_t( 32 ) - LeadingZeros( currentWrapperBits ) );
 				}
 			}
 
+			DYNAMIC_BITSET_RECORD_CALL( ValidNumberOfBits, bitset.size() * sizeof( BooleanBitWrapper ) );
+			if ( bitset.size() > 1 )
+			{
+				DYNAMIC_BITSET_RECORD_SLOW_PATH( ValidNumberOfBits, 0 );
+			}
+
 			// 如果所有位都是 0，则实际使用的比特数量为 0
 			return 0;
 		}
@@ -385,8 +469,8 @@ namespace TwilightDream
 			return this->data_size;
 		}
 
-		// "虚拟容量"（即，在不调整底层 std::vector<BooleanBitWrapper>::size() 大小的情况下，可以存储的最大比特位数）
-		// 被记录的比特集"容量"（以BooleanBitWrapper为单位的比特数 * std::vector<BooleanBitWrapper>::size()）
+		// "虚拟容量"（即，在不调整底层 BitChunkVector::size() 大小的情况下，可以存储的最大比特位数）
+		// 被记录的比特集"容量"（以BooleanBitWrapper为单位的比特数 * BitChunkVector::size()）
 		size_t bit_capacity() const
 		{
 			return this->data_capacity;
@@ -404,6 +488,23 @@ namespace TwilightDream
 			return bitset.capacity();
 		}
 
+		// 比特块存储所使用的内存资源
+		std::pmr::memory_resource* memory_resource() const noexcept
+		{
+			return bitset.get_allocator().memory_resource();
+		}
+
+		// 获取底层比特块数组（以BooleanBitWrapper为单位，LSB 所在的块在最前面，共 chunk_count() 个）
+		BooleanBitWrapper* chunk_data() noexcept
+		{
+			return bitset.data();
+		}
+
+		const BooleanBitWrapper* chunk_data() const noexcept
+		{
+			return bitset.data();
+		}
+
 		// 检查是否所有的位都被设置
 		bool all() const
 		{
@@ -449,10 +550,7 @@ namespace TwilightDream
 		// 设置指定索引的位为给定的布尔值
 		void set_bit( bool value, size_t index )
 		{
-			if ( index >= this->data_size )
-			{
-				throw std::out_of_range( "Index out of range from set bit" );
-			}
+			DefaultBitAccess::check_index( index, this->data_size, "Index out of range from set bit" );
 			size_t wrapperIndex = index / 32;
 			size_t bitIndex = index % 32;
 			bitset[ wrapperIndex ].bit_set( value, bitIndex );
@@ -461,15 +559,207 @@ namespace TwilightDream
 		// 获取指定索引的位的布尔值
 		bool get_bit( size_t index ) const
 		{
-			if ( index >= this->data_size )
-			{
-				throw std::out_of_range( "Index out of range from get bit" );
-			}
+			DefaultBitAccess::check_index( index, this->data_size, "Index out of range from get bit" );
 			size_t wrapperIndex = index / 32;
 			size_t bitIndex = index % 32;
 			return bitset[ wrapperIndex ].bit_get( bitIndex );
 		}
 
+		// 按访问策略获取指定索引的位 (AccessPolicy = CheckedBitAccess / UncheckedBitAccess)
+		template <typename AccessPolicy = DefaultBitAccess>
+		bool test( size_t index ) const
+		{
+			AccessPolicy::check_index( index, this->data_size, "Index out of range from test" );
+			return ( bitset[ index / 32 ].bits >> ( index % 32 ) ) & uint32_t( 1 );
+		}
+
+		// 按访问策略设置指定索引的位为给定的布尔值
+		template <typename AccessPolicy = DefaultBitAccess>
+		void assign( bool value, size_t index )
+		{
+			AccessPolicy::check_index( index, this->data_size, "Index out of range from assign" );
+			const uint32_t mask = uint32_t( 1 ) << ( index % 32 );
+			uint32_t&	   chunk = bitset[ index / 32 ].bits;
+			chunk = value ? ( chunk | mask ) : ( chunk & ~mask );
+		}
+
+		/*
+			快速路径 (Fast path): 不做边界检查，也不经过 BooleanBitWrapper 的非内联调用。
+			只会编译为一次 load / (and|or|xor) / store，调用者必须保证 index < bit_size()。
+		*/
+
+		// 获取指定索引的位 (无边界检查)
+		bool test_unchecked( size_t index ) const noexcept
+		{
+			return ( bitset[ index / 32 ].bits >> ( index % 32 ) ) & uint32_t( 1 );
+		}
+
+		// 设置指定索引的位为 1 (无边界检查)
+		void set_unchecked( size_t index ) noexcept
+		{
+			bitset[ index / 32 ].bits |= uint32_t( 1 ) << ( index % 32 );
+		}
+
+		// 设置指定索引的位为 0 (无边界检查)
+		void reset_unchecked( size_t index ) noexcept
+		{
+			bitset[ index / 32 ].bits &= ~( uint32_t( 1 ) << ( index % 32 ) );
+		}
+
+		// 翻转指定索引的位 (无边界检查)
+		void flip_unchecked( size_t index ) noexcept
+		{
+			bitset[ index / 32 ].bits ^= uint32_t( 1 ) << ( index % 32 );
+		}
+
+		/*
+			批量 (scatter / gather) 操作
+			先一次性检查所有索引，然后按内存区域分桶并预取，避免每个索引都是一次函数调用、一次边界检查和一次 cache miss。
+			重复的索引是允许的 (flip_many 对重复索引会翻转多次)。
+		*/
+
+		// 批量设置指定索引的位为 1
+		void set_many( const size_t* indices, size_t count )
+		{
+			scatter_bits( indices, count, []( uint32_t& chunk, uint32_t mask ) { chunk |= mask; } );
+		}
+
+		void set_many( const std::vector<size_t>& indices )
+		{
+			set_many( indices.data(), indices.size() );
+		}
+
+		// 批量设置指定索引的位为 0
+		void reset_many( const size_t* indices, size_t count )
+		{
+			scatter_bits( indices, count, []( uint32_t& chunk, uint32_t mask ) { chunk &= ~mask; } );
+		}
+
+		void reset_many( const std::vector<size_t>& indices )
+		{
+			reset_many( indices.data(), indices.size() );
+		}
+
+		// 批量翻转指定索引的位
+		void flip_many( const size_t* indices, size_t count )
+		{
+			scatter_bits( indices, count, []( uint32_t& chunk, uint32_t mask ) { chunk ^= mask; } );
+		}
+
+		void flip_many( const std::vector<size_t>& indices )
+		{
+			flip_many( indices.data(), indices.size() );
+		}
+
+		// 批量获取指定索引的位 (results[ i ] = 第 indices[ i ] 位)
+		void test_many( const size_t* indices, size_t count, bool* results ) const
+		{
+			for ( size_t i = 0; i < count; ++i )
+			{
+				DefaultBitAccess::check_index( indices[ i ], this->data_size, "Index out of range from test many" );
+			}
+
+			const BooleanBitWrapper* chunks = bitset.data();
+			size_t					 i = 0;
+
+#if defined( __AVX512F__ ) && defined( __AVX512VL__ )
+			// AVX-512: 每次 gather 8 个 32 位块，再按位偏移取出目标比特
+			static_assert( sizeof( size_t ) == sizeof( uint64_t ) && sizeof( bool ) == 1, "AVX-512 gather path expects 64-bit indices and 1-byte bool" );
+			static_assert( sizeof( BooleanBitWrapper ) == sizeof( uint32_t ), "AVX-512 gather path expects 32-bit chunks" );
+			const __m512i bit_offset_mask = _mm512_set1_epi64( 31 );
+			const __m256i one = _mm256_set1_epi32( 1 );
+			for ( ; i + 8 <= count; i += 8 )
+			{
+				const __m512i index_vector = _mm512_loadu_si512( static_cast<const void*>( indices + i ) );
+				const __m256i words = _mm512_i64gather_epi32( _mm512_srli_epi64( index_vector, 5 ), static_cast<const void*>( chunks ), 4 );
+				const __m256i bit_offsets = _mm512_cvtepi64_epi32( _mm512_and_si512( index_vector, bit_offset_mask ) );
+				const __m256i bits = _mm256_and_si256( _mm256_srlv_epi32( words, bit_offsets ), one );
+				_mm_storel_epi64( reinterpret_cast<__m128i*>( results + i ), _mm256_cvtepi32_epi8( bits ) );
+			}
+#endif
+
+			for ( ; i < count; ++i )
+			{
+				if ( i + batch_prefetch_distance < count )
+				{
+					prefetch_address( &chunks[ indices[ i + batch_prefetch_distance ] / 32 ] );
+				}
+				const size_t index = indices[ i ];
+				results[ i ] = ( chunks[ index / 32 ].bits >> ( index % 32 ) ) & uint32_t( 1 );
+			}
+		}
+
+		std::vector<bool> test_many( const std::vector<size_t>& indices ) const
+		{
+			std::vector<bool> results( indices.size(), false );
+
+			// 分段写入临时缓冲区，避免为 std::vector<bool> 额外分配一份 bool 数组
+			bool buffer[ 256 ];
+			for ( size_t offset = 0; offset < indices.size(); offset += 256 )
+			{
+				const size_t length = std::min<size_t>( 256, indices.size() - offset );
+				test_many( indices.data() + offset, length, buffer );
+				for ( size_t i = 0; i < length; ++i )
+				{
+					results[ offset + i ] = buffer[ i ];
+				}
+			}
+
+			return results;
+		}
+
+		/*
+			位置列表 (例如倒排索引的 posting list) 与比特集之间的转换。
+			from_positions：bit_size 为 0 时取最大的位置 + 1，有位置不小于 bit_size 时抛出 std::out_of_range；
+			输入是升序时 (允许重复) 只遍历一次并且顺序地写入比特块 (chunks_set_positions)；乱序的输入在推断大小时需要再求一次剩余部分的最大值。
+			to_positions：按升序输出所有比特'1'的位置 (见 chunks_to_positions)，输出为 uint32_t 而位置超过 32 位时抛出 std::out_of_range。
+		*/
+		static DynamicBitSet from_positions( const uint32_t* positions, size_t count, size_t bit_size = 0 )
+		{
+			return from_positions_with( positions, count, bit_size );
+		}
+
+		static DynamicBitSet from_positions( const uint64_t* positions, size_t count, size_t bit_size = 0 )
+		{
+			return from_positions_with( positions, count, bit_size );
+		}
+
+		static DynamicBitSet from_positions( const std::vector<uint32_t>& positions, size_t bit_size = 0 )
+		{
+			return from_positions_with( positions.data(), positions.size(), bit_size );
+		}
+
+		static DynamicBitSet from_positions( const std::vector<uint64_t>& positions, size_t bit_size = 0 )
+		{
+			return from_positions_with( positions.data(), positions.size(), bit_size );
+		}
+
+		// output 至少要有 hamming_weight() 个元素，返回写入的数量
+		size_t to_positions( uint32_t* output ) const
+		{
+			check_positions_fit_uint32();
+			return chunks_to_positions( bitset.data(), this->data_chunk_count, output );
+		}
+
+		size_t to_positions( uint64_t* output ) const
+		{
+			return chunks_to_positions( bitset.data(), this->data_chunk_count, output );
+		}
+
+		// 用所有比特'1'的位置替换 output 的内容
+		void to_positions( std::vector<uint32_t>& output ) const
+		{
+			check_positions_fit_uint32();
+			output.resize( hamming_weight() );
+			output.resize( chunks_to_positions( bitset.data(), this->data_chunk_count, output.data() ) );
+		}
+
+		void to_positions( std::vector<uint64_t>& output ) const
+		{
+			output.resize( hamming_weight() );
+			output.resize( chunks_to_positions( bitset.data(), this->data_chunk_count, output.data() ) );
+		}
+
 		/* 最低有效位（LSB）是在最前面{(Bitchunk[0] >> 0) & 1}，而最高有效位（MSB）是在最后面{(Bitchunk[Bitchunk.size() - 1] >> 32 - 1) & 1)} */
 
 		// 获取子集
@@ -528,6 +818,8 @@ namespace TwilightDream
 		// 在基于 LSB 位置 处 向左 插入 比特
 		void insert( bool value, size_t index )
 		{
+			DYNAMIC_BITSET_RECORD_CALL( Insert, 0 );
+
 			if ( bitset.empty() )
 			{
 				// 如果没有比特块，保持安全数据后，直接返回
@@ -623,6 +915,9 @@ namespace TwilightDream
 			// 扩展数据大小
 			resize( this->data_size + 1 );
 
+			// 逐位移动是慢速路径
+			DYNAMIC_BITSET_RECORD_SLOW_PATH( Insert, ( this->data_size - index + 7 ) / 8 );
+
 			// 从MSB开始，将每个比特值向左移动一位，直到达到指定的插入位置
 			for (size_t i = this->data_size - 1; i > index; --i)
 			{
@@ -640,6 +935,8 @@ namespace TwilightDream
 		// 在基于 LSB 位置 处 向左 擦除 比特
 		void erase( size_t index )
 		{
+			DYNAMIC_BITSET_RECORD_CALL( Erase, 0 );
+
 			if ( bitset.empty() )
 			{
 				// 如果没有比特块，保持安全数据后，直接返回
@@ -677,6 +974,9 @@ namespace TwilightDream
 				return;
 			}
 
+			// 逐位移动是慢速路径
+			DYNAMIC_BITSET_RECORD_SLOW_PATH( Erase, ( this->data_size - index + 7 ) / 8 );
+
 			// 从指定的索引位置开始，将每个比特值向右移动一位，直到达到MSB
 			for (size_t i = index; i < this->data_size - 1; ++i)
 			{
@@ -694,6 +994,8 @@ namespace TwilightDream
 		// 在基于 MSB 位置 处 向右 插入 比特
 		void reverse_insert( bool value, size_t backward_index )
 		{
+			DYNAMIC_BITSET_RECORD_CALL( ReverseInsert, 0 );
+
 			if ( bitset.empty() )
 			{
 				// 如果没有比特块，保持安全数据后，直接返回
@@ -792,6 +1094,9 @@ namespace TwilightDream
 			// 扩展数据大小
 			resize( this->data_size + 1 );
 
+			// subset + bitset_concat 都是逐位复制，属于慢速路径
+			DYNAMIC_BITSET_RECORD_SLOW_PATH( ReverseInsert, ( this->data_size + 7 ) / 8 * 2 );
+
 			DynamicBitSet subset1 = this->subset( 0, forward_index );
 			DynamicBitSet subset2 = this->subset( forward_index, this->data_size );
 
@@ -806,6 +1111,8 @@ namespace TwilightDream
 		// 在基于 MSB 位置 处 向右 擦除 比特
 		void reverse_erase( size_t backward_index )
 		{
+			DYNAMIC_BITSET_RECORD_CALL( ReverseErase, 0 );
+
 			if ( bitset.empty() )
 			{
 				// 如果没有比特块，保持安全数据后，直接返回
@@ -847,6 +1154,9 @@ namespace TwilightDream
 				return;
 			}
 
+			// subset + bitset_concat 都是逐位复制，属于慢速路径
+			DYNAMIC_BITSET_RECORD_SLOW_PATH( ReverseErase, ( this->data_size + 7 ) / 8 * 2 );
+
 			DynamicBitSet subset1 = this->subset( 0, forward_index );
 			DynamicBitSet subset2 = this->subset( forward_index + 1, this->data_size );
 
@@ -859,6 +1169,9 @@ namespace TwilightDream
 		// 追加一个位到 MSB（最重要位）
 		void push_front( bool value )
 		{
+			DYNAMIC_BITSET_RECORD_CALL( PushFront, bitset.size() * sizeof( BooleanBitWrapper ) );
+			DYNAMIC_BITSET_TRACE_REALLOCATION( PushFront, bitset );
+
 			if ( bitset.empty() )
 			{
 				// 如果没有比特块，保持安全数据后，直接返回
@@ -894,6 +1207,9 @@ namespace TwilightDream
 		// 删除一个位 MSB（最重要位）
 		void pop_front()
 		{
+			DYNAMIC_BITSET_RECORD_CALL( PopFront, bitset.size() * sizeof( BooleanBitWrapper ) );
+			DYNAMIC_BITSET_TRACE_REALLOCATION( PopFront, bitset );
+
 			if ( bitset.empty() )
 			{
 				// 如果没有比特块，保持安全数据后，直接返回
@@ -926,6 +1242,9 @@ namespace TwilightDream
 		// 追加一个位到 LSB（最不重要位）
 		void push_back( bool value )
 		{
+			DYNAMIC_BITSET_RECORD_CALL( PushBack, bitset.size() * sizeof( BooleanBitWrapper ) );
+			DYNAMIC_BITSET_TRACE_REALLOCATION( PushBack, bitset );
+
 			size_t new_bit_size = data_size + 1;
 
 			// 增加数据大小
@@ -954,6 +1273,9 @@ namespace TwilightDream
 		// 删除一个位 LSB（最不重要位）
 		void pop_back()
 		{
+			DYNAMIC_BITSET_RECORD_CALL( PopBack, bitset.size() * sizeof( BooleanBitWrapper ) );
+			DYNAMIC_BITSET_TRACE_REALLOCATION( PopBack, bitset );
+
 			size_t new_bit_size = data_size - 1;
 
 			// 将所有位向右移动一位以覆盖 LSB
@@ -979,10 +1301,7 @@ namespace TwilightDream
 		// 翻转指定位置的比特位
 		DynamicBitSet& flip( size_t position )
 		{
-			if ( position >= this->data_size )
-			{
-				throw std::out_of_range( "Filp bit: Position out of range" );
-			}
+			DefaultBitAccess::check_index( position, this->data_size, "Filp bit: Position out of range" );
 			bitset[ position / 32 ].bit_flip( position % 32 );
 			return *this;
 		}
@@ -1015,7 +1334,7 @@ namespace TwilightDream
 
 			if ( first_chunk == last_chunk )
 			{
-				mask = ( ( 1 << ( last_bit_index - first_bit_index + 1 ) ) - 1 ) << first_bit_index;
+				mask = static_cast<uint32_t>( ( uint64_t( 1 ) << ( last_bit_index - first_bit_index + 1 ) ) - 1 ) << first_bit_index;
 				if ( value )
 				{
 					bitset[ first_chunk ].bits |= mask;
@@ -1028,7 +1347,7 @@ namespace TwilightDream
 			else
 			{
 				// First chunk
-				mask = ( 1 << ( 32 - first_bit_index ) ) - 1;
+				mask = static_cast<uint32_t>( ( uint64_t( 1 ) << ( 32 - first_bit_index ) ) - 1 );
 				if ( value )
 				{
 					bitset[ first_chunk ].bits |= mask << first_bit_index;
@@ -1046,7 +1365,7 @@ namespace TwilightDream
 				}
 
 				// Last chunk
-				mask = ( 1 << ( last_bit_index + 1 ) ) - 1;
+				mask = static_cast<uint32_t>( ( uint64_t( 1 ) << ( last_bit_index + 1 ) ) - 1 );
 				if ( value )
 				{
 					bitset[ last_chunk ].bits |= mask;
@@ -1078,14 +1397,124 @@ namespace TwilightDream
 			( *this )[ pos ] = false;
 		}
 
+		/*
+			任意比特偏移的范围运算：把 source 的比特 [ source_pos, source_pos + len ) 对齐到 this 的比特 [ pos, pos + len ) 上运算，
+			范围之外的比特不变。使用 bits_apply_range (funnel shift)，代价是 O( len / 32 )，不需要 subset() + 移位 + 整个集合的运算。
+			范围按存储检查 (不能超过 chunk_count() * 32)，否则抛出 std::out_of_range；source 可以是 *this，范围可以重叠。
+		*/
+		void apply_range( BitRangeOperation operation, size_t pos, const DynamicBitSet& source, size_t source_pos, size_t len )
+		{
+			DYNAMIC_BITSET_RECORD_CALL( RangeOperation, 2 * ( len / 32 + 1 ) * sizeof( BooleanBitWrapper ) );
+
+			check_chunk_range( pos, len, "Invalid destination range for apply_range" );
+			source.check_chunk_range( source_pos, len, "Invalid source range for apply_range" );
+			if ( len == 0 )
+			{
+				return;
+			}
+
+			bits_apply_range( operation, bitset.data(), pos, source.bitset.data(), source_pos, len );
+
+			// 只向上调整：范围内新的最高位'1'可能在 data_size 之上
+			for ( size_t chunk = ( pos + len - 1 ) / 32 + 1; chunk-- > pos / 32 && ( chunk + 1 ) * 32 > data_size; )
+			{
+				if ( bitset[ chunk ].bits != 0 )
+				{
+					data_size = std::max( data_size, chunk * 32 + 32 - ( count_leading_zeros64( bitset[ chunk ].bits ) - 32 ) );
+					break;
+				}
+			}
+		}
+
+		void copy_bits( size_t pos, const DynamicBitSet& source, size_t source_pos, size_t len )
+		{
+			apply_range( BitRangeOperation::Copy, pos, source, source_pos, len );
+		}
+
+		// 比特 [ pos, pos + len ) 中比特'1'的数量
+		size_t count( size_t pos, size_t len ) const
+		{
+			check_chunk_range( pos, len, "Invalid range for count" );
+			return bits_population_count( bitset.data(), pos, len );
+		}
+
+		// 比特 [ pos, pos + len ) 中是否有比特'1'
+		bool any( size_t pos, size_t len ) const
+		{
+			check_chunk_range( pos, len, "Invalid range for any" );
+			return bits_find_next( bitset.data(), pos, pos + len ) != pos + len;
+		}
+
+		// [ pos, end ) 中第一个比特'1'的位置，没有时返回 npos；end 默认是 bit_size()
+		size_t find_next( size_t pos, size_t end ) const
+		{
+			check_chunk_range( 0, end, "Invalid range for find_next" );
+			const size_t found = bits_find_next( bitset.data(), pos, end );
+			return found < end ? found : npos;
+		}
+
+		size_t find_next( size_t pos ) const
+		{
+			return pos < data_size ? find_next( pos, data_size ) : npos;
+		}
+
+		/*
+			随机填充：把全部 chunk_count() 个比特块换成随机的比特，之后 bit_size() 等于 bit_capacity() (与 set() 相同)。
+			填充的范围只与存储有关，而不是会被按位运算缩小的 bit_size()，所以 "填充，然后 &=" 的循环每次都覆盖同样多的比特。
+			每次从生成器取一个 64 位的字 (任意 UniformRandomBitGenerator，推荐 Xoshiro256，见 DynamicBitSetRandom.hpp)。
+			fill_bernoulli 中每一位独立地以概率 probability 为'1'，代价与 probability 无关；probability 不在 [ 0, 1 ] 中时抛出 std::invalid_argument。
+			使用种子的版本把比特块分成固定大小的段，每段使用由 ( seed, 段序号 ) 决定的序列，
+			所以并行版本的结果与线程数无关，并且与串行版本相同。
+		*/
+		template <typename Generator, typename = std::enable_if_t<is_uniform_random_bit_generator_v<Generator>>>
+		void fill_random( Generator& generator )
+		{
+			chunks_fill_random( bitset.data(), random_fill_chunks(), generator );
+			finish_random_fill();
+		}
+
+		void fill_random( uint64_t seed )
+		{
+			fill_random( seed, ParallelExecution( 1 ) );
+		}
+
+		void fill_random( uint64_t seed, const ParallelExecution& execution )
+		{
+			fill_random_segments( execution, [ seed ]( size_t segment, BooleanBitWrapper* chunks, size_t count ) {
+				Xoshiro256 generator( seed, segment );
+				chunks_fill_random( chunks, count, generator );
+			} );
+		}
+
+		template <typename Generator, typename = std::enable_if_t<is_uniform_random_bit_generator_v<Generator>>>
+		void fill_bernoulli( double probability, Generator& generator )
+		{
+			check_probability( probability );
+			chunks_fill_bernoulli( bitset.data(), random_fill_chunks(), probability, generator );
+			finish_random_fill();
+		}
+
+		void fill_bernoulli( double probability, uint64_t seed )
+		{
+			fill_bernoulli( probability, seed, ParallelExecution( 1 ) );
+		}
+
+		void fill_bernoulli( double probability, uint64_t seed, const ParallelExecution& execution )
+		{
+			check_probability( probability );
+			fill_random_segments( execution, [ probability, seed ]( size_t segment, BooleanBitWrapper* chunks, size_t count ) {
+				Xoshiro256 generator( seed, segment );
+				chunks_fill_bernoulli( chunks, count, probability, generator );
+			} );
+		}
+
 		// 按位与操作 (&=)
 		void and_operation( const DynamicBitSet& other )
 		{
+			DYNAMIC_BITSET_RECORD_CALL( BitwiseAnd, ( this->bitset.size() + other.bitset.size() ) * sizeof( BooleanBitWrapper ) );
+
 			size_t min_size = std::min( this->data_chunk_count, other.data_chunk_count );
-			for ( size_t i = 0; i < min_size; ++i )
-			{
-				this->bitset[ i ].bit_and( other.bitset[ i ].bits );
-			}
+			chunks_and( this->bitset.data(), other.bitset.data(), min_size );
 
 			// 如果 this->bitset 比 other.bitset 长，将多余的部分设置为0
 			if ( this->data_chunk_count > other.data_chunk_count )
@@ -1099,17 +1528,19 @@ namespace TwilightDream
 		// 按位或操作 (|=)
 		void or_operation( const DynamicBitSet& other )
 		{
+			DYNAMIC_BITSET_RECORD_CALL( BitwiseOr, ( this->bitset.size() + other.bitset.size() ) * sizeof( BooleanBitWrapper ) );
+
 			size_t min_size = std::min( this->data_chunk_count, other.data_chunk_count );
-			for ( size_t i = 0; i < min_size; ++i )
-			{
-				this->bitset[ i ].bit_or( other.bitset[ i ].bits );
-			}
+			chunks_or( this->bitset.data(), other.bitset.data(), min_size );
 
 			// 如果需要，扩展 this->bitset
 			if ( this->data_chunk_count < other.data_chunk_count )
 			{
 				this->bitset.resize( other.data_chunk_count );
 				std::copy( other.bitset.begin() + min_size, other.bitset.end(), this->bitset.begin() + min_size );
+
+				this->data_chunk_count = this->bitset.size();
+				this->data_capacity = this->bitset.size() * 32;
 			}
 
 			this->data_size = this->valid_number_of_bits();
@@ -1118,10 +1549,9 @@ namespace TwilightDream
 		// 按位非操作 (~=) / 翻转所有位
 		void not_operation()
 		{
-			for ( auto& wrapper : bitset )
-			{
-				wrapper.bit_not();
-			}
+			DYNAMIC_BITSET_RECORD_CALL( BitwiseNot, bitset.size() * sizeof( BooleanBitWrapper ) );
+
+			chunks_not( bitset.data(), bitset.size() );
 
 			this->data_size = this->valid_number_of_bits();
 		}
@@ -1129,69 +1559,216 @@ namespace TwilightDream
 		// 按位异或操作 (^=)
 		void xor_operation( const DynamicBitSet& other )
 		{
+			DYNAMIC_BITSET_RECORD_CALL( BitwiseXor, ( this->bitset.size() + other.bitset.size() ) * sizeof( BooleanBitWrapper ) );
+
 			size_t min_size = std::min( this->data_chunk_count, other.data_chunk_count );
-			for ( size_t i = 0; i < min_size; ++i )
-			{
-				this->bitset[ i ].bit_xor( other.bitset[ i ].bits );
-			}
+			chunks_xor( this->bitset.data(), other.bitset.data(), min_size );
 
 			// 如果需要，扩展 this->bitset
 			if ( this->data_chunk_count < other.data_chunk_count )
 			{
 				this->bitset.resize( other.data_chunk_count );
 				std::copy( other.bitset.begin() + min_size, other.bitset.end(), this->bitset.begin() + min_size );
+
+				this->data_chunk_count = this->bitset.size();
+				this->data_capacity = this->bitset.size() * 32;
 			}
 
 			this->data_size = this->valid_number_of_bits();
 		}
 
-		// 左移操作 (<<=)
-		DynamicBitSet& left_shift( size_t shift )
+		// 按位与非操作 (this &= ~other)，other 中缺少的块视为 0，所以这些位置保持不变
+		void and_not_operation( const DynamicBitSet& other )
 		{
-			assert( shift > 0 );
-			assert( shift < bitset.size() * 32 );
+			DYNAMIC_BITSET_RECORD_CALL( BitwiseAndNot, ( this->bitset.size() + other.bitset.size() ) * sizeof( BooleanBitWrapper ) );
 
-			const size_t blocks_shift = shift / 32;
-			const size_t bits_offset = shift % 32;
+			chunks_and_not( this->bitset.data(), other.bitset.data(), std::min( this->data_chunk_count, other.data_chunk_count ) );
 
-			if ( bits_offset == 0 )
-			{
-				for ( size_t i = bitset.size() - 1; i >= blocks_shift; --i )
-				{
-					bitset[ i ] = bitset[ i - blocks_shift ];
-				}
-			}
-			else
-			{
-				const size_t reverse_bits_offset = 32 - bits_offset;
-				for ( size_t i = bitset.size() - 1; i > blocks_shift; --i )
-				{
-					bitset[ i ] = uint32_t( ( bitset[ i - blocks_shift ].bits << bits_offset ) | uint32_t( bitset[ i - blocks_shift - 1 ].bits >> reverse_bits_offset ) );
-				}
-				bitset[ blocks_shift ] = uint32_t( bitset[ 0 ].bits << bits_offset );
-			}
+			this->data_size = this->valid_number_of_bits();
+		}
 
-			// set bit that came at the right to 0 in unmodified blocks
-			std::fill( bitset.begin(), bitset.begin() + static_cast<typename decltype( bitset )::difference_type>( blocks_shift ), 0x00000000 );
+		// 按位或非操作 (this |= ~other)，与 not_operation() 相同，~other 只在 other 的 chunk_count() 个块内取反
+		void or_not_operation( const DynamicBitSet& other )
+		{
+			DYNAMIC_BITSET_RECORD_CALL( BitwiseOrNot, ( this->bitset.size() + other.bitset.size() ) * sizeof( BooleanBitWrapper ) );
+
+			extend_chunks( other.data_chunk_count );
+			chunks_or_not( this->bitset.data(), other.bitset.data(), other.data_chunk_count );
 
 			this->data_size = this->valid_number_of_bits();
+		}
 
-			return *this;
+		// 按位同或操作 (this = ~( this ^ other ))，较短的一方用 0 补齐到两者中较长的块数
+		void xnor_operation( const DynamicBitSet& other )
+		{
+			DYNAMIC_BITSET_RECORD_CALL( BitwiseXnor, ( this->bitset.size() + other.bitset.size() ) * sizeof( BooleanBitWrapper ) );
+
+			extend_chunks( other.data_chunk_count );
+			chunks_xnor( this->bitset.data(), other.bitset.data(), other.data_chunk_count );
+			chunks_not( this->bitset.data() + other.data_chunk_count, this->data_chunk_count - other.data_chunk_count );
+
+			this->data_size = this->valid_number_of_bits();
 		}
 
-		// 右移操作 (>>=)
-		DynamicBitSet& right_shift( size_t shift )
+		/*
+			与惰性取反的视图 other.complement_view() (见 DynamicBitSetComplement) 的运算：结果与先物化 ~other 再调用对应的运算完全相同，
+			但直接使用融合的 andnot / ornot / xnor 内核，只遍历一次并且不分配临时的比特集。
+		*/
+		void and_operation( const DynamicBitSetComplement& other );
+		void or_operation( const DynamicBitSetComplement& other );
+		void xor_operation( const DynamicBitSetComplement& other );
+
+		/*
+			任意三输入布尔函数：this = f( this, second, third )，一次遍历完成 (见 DynamicBitSetKernels.hpp 中 chunks_ternary 的真值表约定，
+			常用的真值表在 ternary_function 中，例如 ternary_function::majority)。三者中较短的用 0 补齐到最长的块数。
+		*/
+		void ternary_operation( const DynamicBitSet& second, const DynamicBitSet& third, uint8_t truth_table )
 		{
-			assert( shift > 0 );
-			assert( shift < bitset.size() * 32 );
+			DYNAMIC_BITSET_RECORD_CALL( BitwiseTernary, ( this->bitset.size() + second.bitset.size() + third.bitset.size() ) * sizeof( BooleanBitWrapper ) );
 
-			const size_t blocks_shift = shift / 32;
-			const size_t bits_offset = shift % 32;
-			const size_t last_block_to_shift = bitset.size() - blocks_shift - 1;
+			extend_chunks( std::max( second.data_chunk_count, third.data_chunk_count ) );
+			const size_t count = this->data_chunk_count;
 
-			if ( bits_offset == 0 )
+			// 只有长度不同时才需要补齐的副本
+			BitChunkVector			 second_padded( bitset.get_allocator() );
+			BitChunkVector			 third_padded( bitset.get_allocator() );
+			const BooleanBitWrapper* second_chunks = second.bitset.data();
+			const BooleanBitWrapper* third_chunks = third.bitset.data();
+			if ( second.data_chunk_count < count )
 			{
-				for ( size_t i = 0; i <= last_block_to_shift; ++i )
+				second_padded.assign( count, BooleanBitWrapper( 0 ) );
+				std::copy( second.bitset.begin(), second.bitset.end(), second_padded.begin() );
+				second_chunks = second_padded.data();
+			}
+			if ( third.data_chunk_count < count )
+			{
+				third_padded.assign( count, BooleanBitWrapper( 0 ) );
+				std::copy( third.bitset.begin(), third.bitset.end(), third_padded.begin() );
+				third_chunks = third_padded.data();
+			}
+
+			chunks_ternary( this->bitset.data(), second_chunks, third_chunks, count, truth_table );
+
+			this->data_size = this->valid_number_of_bits();
+		}
+
+		/*
+			多操作数运算：一次遍历所有操作数 (输出按段保持在寄存器 / L1 中)，最后只调用一次 valid_number_of_bits()，
+			代替逐个 |= / &= (每次都要完整地读写一遍结果并重新扫描有效位数)。
+			各个集合中缺少的块视为 0。
+		*/
+
+		// 所有集合的并集
+		static DynamicBitSet union_all( const std::vector<const DynamicBitSet*>& sets )
+		{
+			std::vector<const BooleanBitWrapper*> sources;
+			std::vector<size_t>					  lengths;
+			const size_t						  count = collect_operands( sets, sources, lengths, false );
+
+			DynamicBitSet result( count * 32, false );
+			chunks_or_many( result.bitset.data(), sources.data(), lengths.data(), sources.size(), count );
+			result.data_size = result.valid_number_of_bits();
+			return result;
+		}
+
+		static DynamicBitSet union_all( const std::vector<DynamicBitSet>& sets )
+		{
+			return union_all( operand_pointers( sets ) );
+		}
+
+		// 所有集合的交集 (没有集合时为空集)
+		static DynamicBitSet intersect_all( const std::vector<const DynamicBitSet*>& sets )
+		{
+			std::vector<const BooleanBitWrapper*> sources;
+			std::vector<size_t>					  lengths;
+			const size_t						  count = collect_operands( sets, sources, lengths, true );
+
+			DynamicBitSet result( count * 32, false );
+			if ( !sources.empty() )
+			{
+				chunks_and_many( result.bitset.data(), sources.data(), sources.size(), count );
+			}
+			result.data_size = result.valid_number_of_bits();
+			return result;
+		}
+
+		static DynamicBitSet intersect_all( const std::vector<DynamicBitSet>& sets )
+		{
+			return intersect_all( operand_pointers( sets ) );
+		}
+
+		/*
+			在至少 threshold 个集合中为'1'的比特 (threshold_count( sets, 1 ) 是并集，threshold_count( sets, sets.size() ) 是交集，
+			sets.size() / 2 + 1 是多数表决)。结果的块数是最长的集合的块数；threshold 为 0 时这些块全部为'1'。
+		*/
+		static DynamicBitSet threshold_count( const std::vector<const DynamicBitSet*>& sets, size_t threshold )
+		{
+			std::vector<const BooleanBitWrapper*> sources;
+			std::vector<size_t>					  lengths;
+			const size_t						  count = collect_operands( sets, sources, lengths, false );
+
+			DynamicBitSet result( count * 32, false );
+			chunks_threshold( result.bitset.data(), sources.data(), lengths.data(), sources.size(), count, threshold );
+			result.data_size = result.valid_number_of_bits();
+			return result;
+		}
+
+		static DynamicBitSet threshold_count( const std::vector<DynamicBitSet>& sets, size_t threshold )
+		{
+			return threshold_count( operand_pointers( sets ), threshold );
+		}
+
+		// 左移操作 (<<=)
+		DynamicBitSet& left_shift( size_t shift )
+		{
+			DYNAMIC_BITSET_RECORD_CALL( LeftShift, bitset.size() * sizeof( BooleanBitWrapper ) );
+
+			assert( shift > 0 );
+			assert( shift < bitset.size() * 32 );
+
+			const size_t blocks_shift = shift / 32;
+			const size_t bits_offset = shift % 32;
+
+			if ( bits_offset == 0 )
+			{
+				for ( size_t i = bitset.size() - 1; i >= blocks_shift; --i )
+				{
+					bitset[ i ] = bitset[ i - blocks_shift ];
+				}
+			}
+			else
+			{
+				const size_t reverse_bits_offset = 32 - bits_offset;
+				for ( size_t i = bitset.size() - 1; i > blocks_shift; --i )
+				{
+					bitset[ i ] = uint32_t( ( bitset[ i - blocks_shift ].bits << bits_offset ) | uint32_t( bitset[ i - blocks_shift - 1 ].bits >> reverse_bits_offset ) );
+				}
+				bitset[ blocks_shift ] = uint32_t( bitset[ 0 ].bits << bits_offset );
+			}
+
+			// set bit that came at the right to 0 in unmodified blocks
+			std::fill( bitset.begin(), bitset.begin() + static_cast<typename decltype( bitset )::difference_type>( blocks_shift ), 0x00000000 );
+
+			this->data_size = this->valid_number_of_bits();
+
+			return *this;
+		}
+
+		// 右移操作 (>>=)
+		DynamicBitSet& right_shift( size_t shift )
+		{
+			DYNAMIC_BITSET_RECORD_CALL( RightShift, bitset.size() * sizeof( BooleanBitWrapper ) );
+
+			assert( shift > 0 );
+			assert( shift < bitset.size() * 32 );
+
+			const size_t blocks_shift = shift / 32;
+			const size_t bits_offset = shift % 32;
+			const size_t last_block_to_shift = bitset.size() - blocks_shift - 1;
+
+			if ( bits_offset == 0 )
+			{
+				for ( size_t i = 0; i <= last_block_to_shift; ++i )
 				{
 					bitset[ i ] = bitset[ i + blocks_shift ];
 				}
@@ -1223,12 +1800,9 @@ namespace TwilightDream
 		// 计算设置为 true 的位数 (汉明权重)
 		size_t hamming_weight() const
 		{
-			size_t total_count = 0;
-			for ( const auto& chunk : bitset )
-			{
-				total_count += chunk.count_bits();
-			}
-			return total_count;
+			DYNAMIC_BITSET_RECORD_CALL( HammingWeight, bitset.size() * sizeof( BooleanBitWrapper ) );
+
+			return chunks_population_count( bitset.data(), bitset.size() );
 		}
 
 		size_t hamming_distance( const DynamicBitSet& other ) const
@@ -1251,6 +1825,203 @@ namespace TwilightDream
 			return distance;
 		}
 
+		/*
+			并行版本的批量操作 (Parallel bulk operations)
+			语义与对应的单线程版本相同，只是把比特块区间切分后交给多个线程处理。
+			有结果的操作 (汉明权重、最高有效位) 先在每个线程内计算部分结果，再在调用线程上归约。
+		*/
+
+		// 计算实际有效比特数量 (并行：每段找到自己最高的非零块，再取最大值)
+		size_t valid_number_of_bits( const ParallelExecution& execution ) const
+		{
+			const BooleanBitWrapper* chunks = bitset.data();
+			const size_t			 highest_chunk_plus_one = parallel_reduce_chunk_ranges(
+				execution, bitset.size(), size_t( 0 ),
+				[ chunks ]( size_t begin, size_t end ) -> size_t {
+					for ( size_t i = end; i > begin; --i )
+					{
+						if ( chunks[ i - 1 ].bits != 0 )
+						{
+							return i;
+						}
+					}
+					return 0;
+				},
+				[]( size_t left, size_t right ) { return std::max( left, right ); } );
+
+			if ( highest_chunk_plus_one == 0 )
+			{
+				return 0;
+			}
+
+			uint32_t top_chunk = chunks[ highest_chunk_plus_one - 1 ].bits;
+			size_t	 top_bits = 0;
+			while ( top_chunk != 0 )
+			{
+				top_chunk >>= 1;
+				++top_bits;
+			}
+			return ( highest_chunk_plus_one - 1 ) * 32 + top_bits;
+		}
+
+		// 计算设置为 true 的位数 (汉明权重，并行归约)
+		size_t hamming_weight( const ParallelExecution& execution ) const
+		{
+			const BooleanBitWrapper* chunks = bitset.data();
+			return parallel_reduce_chunk_ranges(
+				execution, bitset.size(), size_t( 0 ),
+				[ chunks ]( size_t begin, size_t end ) -> size_t { return chunks_population_count( chunks + begin, end - begin ); },
+				[]( size_t left, size_t right ) { return left + right; } );
+		}
+
+		// 设置所有位为 1 (并行)
+		void set( const ParallelExecution& execution )
+		{
+			BooleanBitWrapper* chunks = bitset.data();
+			parallel_for_chunk_ranges( execution, bitset.size(), [ chunks ]( size_t begin, size_t end, size_t ) { std::fill( chunks + begin, chunks + end, BooleanBitWrapper( 0xFFFFFFFF ) ); } );
+
+			this->data_size = this->data_capacity;
+		}
+
+		// 设置所有位为 0 (并行)
+		void reset( const ParallelExecution& execution )
+		{
+			BooleanBitWrapper* chunks = bitset.data();
+			parallel_for_chunk_ranges( execution, bitset.size(), [ chunks ]( size_t begin, size_t end, size_t ) { std::fill( chunks + begin, chunks + end, BooleanBitWrapper( 0 ) ); } );
+
+			this->data_size = 0;
+		}
+
+		// 按位与操作 (&=，并行)
+		void and_operation( const DynamicBitSet& other, const ParallelExecution& execution )
+		{
+			const size_t			 min_size = std::min( this->data_chunk_count, other.data_chunk_count );
+			BooleanBitWrapper*		 chunks = bitset.data();
+			const BooleanBitWrapper* other_chunks = other.bitset.data();
+			parallel_for_chunk_ranges( execution, bitset.size(), [ chunks, other_chunks, min_size ]( size_t begin, size_t end, size_t ) {
+				const size_t and_end = std::min( end, std::max( begin, min_size ) );
+				chunks_and( chunks + begin, other_chunks + begin, and_end - begin );
+				std::fill( chunks + and_end, chunks + end, BooleanBitWrapper( 0 ) );
+			} );
+
+			this->data_size = this->valid_number_of_bits( execution );
+		}
+
+		// 按位或操作 (|=，并行)
+		void or_operation( const DynamicBitSet& other, const ParallelExecution& execution )
+		{
+			// 先扩展 this->bitset，新扩展的块为 0，与 other 做或运算即等价于复制
+			if ( this->data_chunk_count < other.data_chunk_count )
+			{
+				this->bitset.resize( other.data_chunk_count );
+				this->data_chunk_count = this->bitset.size();
+				this->data_capacity = this->bitset.size() * 32;
+			}
+
+			BooleanBitWrapper*		 chunks = bitset.data();
+			const BooleanBitWrapper* other_chunks = other.bitset.data();
+			parallel_for_chunk_ranges( execution, other.data_chunk_count, [ chunks, other_chunks ]( size_t begin, size_t end, size_t ) { chunks_or( chunks + begin, other_chunks + begin, end - begin ); } );
+
+			this->data_size = this->valid_number_of_bits( execution );
+		}
+
+		// 按位异或操作 (^=，并行)
+		void xor_operation( const DynamicBitSet& other, const ParallelExecution& execution )
+		{
+			if ( this->data_chunk_count < other.data_chunk_count )
+			{
+				this->bitset.resize( other.data_chunk_count );
+				this->data_chunk_count = this->bitset.size();
+				this->data_capacity = this->bitset.size() * 32;
+			}
+
+			BooleanBitWrapper*		 chunks = bitset.data();
+			const BooleanBitWrapper* other_chunks = other.bitset.data();
+			parallel_for_chunk_ranges( execution, other.data_chunk_count, [ chunks, other_chunks ]( size_t begin, size_t end, size_t ) { chunks_xor( chunks + begin, other_chunks + begin, end - begin ); } );
+
+			this->data_size = this->valid_number_of_bits( execution );
+		}
+
+		// 按位非操作 (~=，并行)
+		void not_operation( const ParallelExecution& execution )
+		{
+			BooleanBitWrapper* chunks = bitset.data();
+			parallel_for_chunk_ranges( execution, bitset.size(), [ chunks ]( size_t begin, size_t end, size_t ) { chunks_not( chunks + begin, end - begin ); } );
+
+			this->data_size = this->valid_number_of_bits( execution );
+		}
+
+		// 左移操作 (<<=，并行)：与 left_shift 相同的语义，但一次完成任意位数的移动 (写入新的块向量后交换)
+		DynamicBitSet& left_shift( size_t shift, const ParallelExecution& execution )
+		{
+			assert( shift > 0 );
+			assert( shift < bitset.size() * 32 );
+
+			const size_t				   blocks_shift = shift / 32;
+			const size_t				   bits_offset = shift % 32;
+			const size_t				   chunk_count = bitset.size();
+			BitChunkVector				   shifted( chunk_count, BooleanBitWrapper( 0 ), bitset.get_allocator() );
+
+			const BooleanBitWrapper* source = bitset.data();
+			BooleanBitWrapper*		 target = shifted.data();
+			parallel_for_chunk_ranges( execution, chunk_count, [ source, target, blocks_shift, bits_offset ]( size_t begin, size_t end, size_t ) {
+				for ( size_t i = begin; i < end; ++i )
+				{
+					uint32_t value = 0;
+					if ( i >= blocks_shift )
+					{
+						value = source[ i - blocks_shift ].bits << bits_offset;
+						if ( bits_offset != 0 && i > blocks_shift )
+						{
+							value |= source[ i - blocks_shift - 1 ].bits >> ( 32 - bits_offset );
+						}
+					}
+					target[ i ].bits = value;
+				}
+			} );
+
+			bitset.swap( shifted );
+			this->data_size = this->valid_number_of_bits( execution );
+
+			return *this;
+		}
+
+		// 右移操作 (>>=，并行)
+		DynamicBitSet& right_shift( size_t shift, const ParallelExecution& execution )
+		{
+			assert( shift > 0 );
+			assert( shift < bitset.size() * 32 );
+
+			const size_t				   blocks_shift = shift / 32;
+			const size_t				   bits_offset = shift % 32;
+			const size_t				   chunk_count = bitset.size();
+			BitChunkVector				   shifted( chunk_count, BooleanBitWrapper( 0 ), bitset.get_allocator() );
+
+			const BooleanBitWrapper* source = bitset.data();
+			BooleanBitWrapper*		 target = shifted.data();
+			parallel_for_chunk_ranges( execution, chunk_count, [ source, target, blocks_shift, bits_offset, chunk_count ]( size_t begin, size_t end, size_t ) {
+				for ( size_t i = begin; i < end; ++i )
+				{
+					uint32_t	 value = 0;
+					const size_t source_index = i + blocks_shift;
+					if ( source_index < chunk_count )
+					{
+						value = source[ source_index ].bits >> bits_offset;
+						if ( bits_offset != 0 && source_index + 1 < chunk_count )
+						{
+							value |= source[ source_index + 1 ].bits << ( 32 - bits_offset );
+						}
+					}
+					target[ i ].bits = value;
+				}
+			} );
+
+			bitset.swap( shifted );
+			this->data_size = this->valid_number_of_bits( execution );
+
+			return *this;
+		}
+
 		// for_each函数接口
 		template <typename Func>
 		void for_each_block( Func func )
@@ -1264,6 +2035,9 @@ namespace TwilightDream
 		// 预分配内存
 		void reserve( size_t nunber_bit_size )
 		{
+			DYNAMIC_BITSET_RECORD_CALL( Reserve, 0 );
+			DYNAMIC_BITSET_TRACE_REALLOCATION( Reserve, bitset );
+
 			bitset.reserve( needed_chunks( nunber_bit_size ) );
 			this->data_capacity = bitset.capacity() * 32;
 		}
@@ -1271,6 +2045,9 @@ namespace TwilightDream
 		// 重新分配比特大小 (可能调整 bit chunk 数量)
 		void resize( std::size_t update_capacity_and_size, bool fill_bit = false )
 		{
+			DYNAMIC_BITSET_RECORD_CALL( Resize, needed_chunks( update_capacity_and_size ) * sizeof( BooleanBitWrapper ) );
+			DYNAMIC_BITSET_TRACE_REALLOCATION( Resize, bitset );
+
 			if ( data_size == 0 && update_capacity_and_size == 1 )
 			{
 				bitset.push_back( BooleanBitWrapper( fill_bit ) );
@@ -1331,6 +2108,9 @@ namespace TwilightDream
 		// 释放多余的内存容量
 		void shrink_to_fit()
 		{
+			DYNAMIC_BITSET_RECORD_CALL( ShrinkToFit, bitset.size() * sizeof( BooleanBitWrapper ) );
+			DYNAMIC_BITSET_TRACE_REALLOCATION( ShrinkToFit, bitset );
+
 			bitset.shrink_to_fit();
 
 			this->data_capacity = bitset.size() * 32;
@@ -1353,22 +2133,90 @@ namespace TwilightDream
 			}
 		}
 
+		/*
+			比较运算按数值进行：把比特集看作一个无符号整数 (LSB 在索引 0)，高位缺少的块视为 0，
+			与 bit_size()、memory_capacity() 和 reserve() 的历史无关。所以 <、<= 等是一个全序，可以用作 std::map 的键或者排序。
+		*/
+
 		// Equality Operator
-		bool operator==( const DynamicBitSet& other ) const
+		bool operator==( const DynamicBitSet& other ) const noexcept
 		{
-			if ( memory_capacity() != other.memory_capacity() )
+			const size_t common_chunks = std::min( bitset.size(), other.bitset.size() );
+			if ( common_chunks != 0 && std::memcmp( bitset.data(), other.bitset.data(), common_chunks * sizeof( BooleanBitWrapper ) ) != 0 )
 				return false;
-			return ( bitset == other.bitset ) && ( data_chunk_count == other.data_chunk_count );
+			return !chunks_any( bitset.data() + common_chunks, bitset.size() - common_chunks )
+				&& !chunks_any( other.bitset.data() + common_chunks, other.bitset.size() - common_chunks );
 		}
 
 		// Inequality Operator
-		bool operator!=( const DynamicBitSet& other ) const
+		bool operator!=( const DynamicBitSet& other ) const noexcept
 		{
 			return !( *this == other );
 		}
 
+		// 从最高的块向下比较，返回 -1、0 或 1
+		int compare( const DynamicBitSet& other ) const noexcept
+		{
+			const size_t common_chunks = std::min( bitset.size(), other.bitset.size() );
+			if ( chunks_any( bitset.data() + common_chunks, bitset.size() - common_chunks ) )
+				return 1;
+			if ( chunks_any( other.bitset.data() + common_chunks, other.bitset.size() - common_chunks ) )
+				return -1;
+
+			const size_t index = chunks_find_last_difference( bitset.data(), other.bitset.data(), common_chunks );
+			if ( index == common_chunks )
+				return 0;
+			return bitset[ index ].bits < other.bitset[ index ].bits ? -1 : 1;
+		}
+
+		bool operator<( const DynamicBitSet& other ) const noexcept
+		{
+			return compare( other ) < 0;
+		}
+
+		bool operator<=( const DynamicBitSet& other ) const noexcept
+		{
+			return compare( other ) <= 0;
+		}
+
+		bool operator>( const DynamicBitSet& other ) const noexcept
+		{
+			return compare( other ) > 0;
+		}
+
+		bool operator>=( const DynamicBitSet& other ) const noexcept
+		{
+			return compare( other ) >= 0;
+		}
+
+		// 这里的每一个比特在 other 中也都是'1' (other 中缺少的块视为 0)
+		bool is_subset_of( const DynamicBitSet& other ) const noexcept
+		{
+			const size_t common_chunks = std::min( bitset.size(), other.bitset.size() );
+			return !chunks_any_and_not( bitset.data(), other.bitset.data(), common_chunks )
+				&& !chunks_any( bitset.data() + common_chunks, bitset.size() - common_chunks );
+		}
+
+		// 是子集并且 other 中至少还有一个比特不在这里
+		bool is_proper_subset_of( const DynamicBitSet& other ) const noexcept
+		{
+			return is_subset_of( other ) && !( other.is_subset_of( *this ) );
+		}
+
+		// 比特块的哈希值 (BitChunkHasher)，与 operator== 一致：与容量和高位的零块无关
+		uint64_t hash( uint64_t seed = 0 ) const noexcept
+		{
+			return BitChunkHasher::hash( bitset.data(), bitset.size(), seed );
+		}
+
+		// 是否至少有一个比特在两边都是'1'
+		bool intersects( const DynamicBitSet& other ) const noexcept
+		{
+			return chunks_any_and( bitset.data(), other.bitset.data(), std::min( bitset.size(), other.bitset.size() ) );
+		}
+
 		// Bitwise AND Operator
-		DynamicBitSet operator&( const DynamicBitSet& other )
+		DynamicBitSet operator&( const DynamicBitSet& other ) const
 		{
 			DynamicBitSet result = *this;
 			result.and_operation( other );
@@ -1376,7 +2224,7 @@ namespace TwilightDream
 		}
 
 		// Bitwise OR Operator
-		DynamicBitSet operator|( const DynamicBitSet& other )
+		DynamicBitSet operator|( const DynamicBitSet& other ) const
 		{
 			DynamicBitSet result = *this;
 			result.or_operation( other );
@@ -1384,15 +2232,23 @@ namespace TwilightDream
 		}
 
 		// Bitwise NOT Operator
-		DynamicBitSet operator~()
+		DynamicBitSet operator~() const
 		{
 			DynamicBitSet result = *this;
 			result.not_operation();
 			return result;
 		}
 
+		/*
+			O(1) 的惰性取反视图 (见 DynamicBitSetComplement)，例如 a & b.complement_view() 不复制 b，直接使用 andnot 内核。
+			视图只保存 *this 的地址：*this 被销毁或者移动之后视图失效，修改 *this 之后视图看到的是修改后的值。
+			右值上调用是编译错误 (视图会立即悬空)，临时对象请直接用 ~。
+		*/
+		DynamicBitSetComplement complement_view() const& noexcept;
+		DynamicBitSetComplement complement_view() const&& = delete;
+
 		// Bitwise XOR Operator
-		DynamicBitSet operator^( const DynamicBitSet& other )
+		DynamicBitSet operator^( const DynamicBitSet& other ) const
 		{
 			DynamicBitSet result = *this;
 			result.xor_operation( other );
@@ -1420,6 +2276,14 @@ namespace TwilightDream
 			return *this;
 		}
 
+		// 与取反视图的运算 (例如 a & b.complement_view()) 不物化 ~b，直接使用融合的内核
+		DynamicBitSet  operator&( const DynamicBitSetComplement& other ) const;
+		DynamicBitSet  operator|( const DynamicBitSetComplement& other ) const;
+		DynamicBitSet  operator^( const DynamicBitSetComplement& other ) const;
+		DynamicBitSet& operator&=( const DynamicBitSetComplement& other );
+		DynamicBitSet& operator|=( const DynamicBitSetComplement& other );
+		DynamicBitSet& operator^=( const DynamicBitSetComplement& other );
+
 		// Left Shift Operator
 		DynamicBitSet operator<<( size_t shift )
 		{
@@ -1666,13 +2530,200 @@ namespace TwilightDream
 		}
 
 	private:
-		//Bit chunks
-		std::vector<BooleanBitWrapper> bitset;
+		//Bit chunks (64 字节对齐，分配自 BitChunkAllocator 所持有的内存资源)
+		BitChunkVector bitset;
 
 		size_t data_size = 0;
 		size_t data_capacity = 0;
 		size_t data_chunk_count = 0;
 
+		// 批量操作的参数：预取距离、开始分桶的索引数量、每个分桶覆盖的块数 (65536 个块 = 256 KiB，大约一个 L2 的大小)
+		static constexpr size_t batch_prefetch_distance = 16;
+		static constexpr size_t batch_bucket_threshold = 4096;
+		static constexpr size_t batch_region_chunks = 65536;
+
+		template <typename Position>
+		static DynamicBitSet from_positions_with( const Position* positions, size_t count, size_t bit_size )
+		{
+			// 升序的输入不需要先扫描一遍求最大值：bit_size 取最后一个位置 + 1，一次遍历完成
+			const bool	  inferred = bit_size == 0;
+			DynamicBitSet result( inferred && count != 0 ? static_cast<size_t>( positions[ count - 1 ] ) + 1 : bit_size, false );
+			size_t		  done = chunks_set_positions( result.bitset.data(), positions, count, result.data_size );
+			if ( done == count )
+			{
+				return result;
+			}
+
+			// 遇到超出大小的位置：推断大小时 (输入不是升序的) 扩展到剩余部分中最大的位置，否则是错误
+			if ( !inferred )
+			{
+				throw std::out_of_range( "Position out of range for from_positions" );
+			}
+			const size_t largest = static_cast<size_t>( *std::max_element( positions + done, positions + count ) );
+			result.extend_chunks( result.needed_chunks( largest + 1 ) );
+			result.data_size = largest + 1;
+			chunks_set_positions( result.bitset.data(), positions + done, count - done, result.data_size );
+			return result;
+		}
+
+		void check_positions_fit_uint32() const
+		{
+			if ( this->data_chunk_count > ( size_t( 1 ) << 27 ) && valid_number_of_bits() > ( size_t( 1 ) << 32 ) )
+			{
+				throw std::out_of_range( "Positions do not fit in uint32_t for to_positions" );
+			}
+		}
+
+		// 使用种子的随机填充中每一段的比特块数量 (16 KiB)，段的划分只与比特块的数量有关
+		static constexpr size_t random_segment_chunks = 4096;
+
+		// 随机填充覆盖的比特块数量 (全部的存储)
+		size_t random_fill_chunks() const noexcept
+		{
+			return this->data_chunk_count;
+		}
+
+		// 随机填充之后所有的比特块都是有效的
+		void finish_random_fill() noexcept
+		{
+			this->data_size = this->data_capacity;
+		}
+
+		// 按段并行调用 fill_segment( segment, chunks, count )，每个线程处理连续的若干段
+		template <typename SegmentFunction>
+		void fill_random_segments( const ParallelExecution& execution, SegmentFunction&& fill_segment )
+		{
+			const size_t			fill_chunks = random_fill_chunks();
+			const size_t			segment_count = ( fill_chunks + random_segment_chunks - 1 ) / random_segment_chunks;
+			const ParallelExecution segment_execution( execution.thread_count, std::max<size_t>( execution.minimum_chunks_per_thread / random_segment_chunks, 1 ) );
+			BooleanBitWrapper*		chunks = bitset.data();
+			parallel_for_chunk_ranges( segment_execution, segment_count, [ & ]( size_t first_segment, size_t end_segment, size_t ) {
+				for ( size_t segment = first_segment; segment < end_segment; ++segment )
+				{
+					const size_t begin = segment * random_segment_chunks;
+					fill_segment( segment, chunks + begin, std::min( random_segment_chunks, fill_chunks - begin ) );
+				}
+			} );
+			finish_random_fill();
+		}
+
+		static void check_probability( double probability )
+		{
+			if ( !( probability >= 0.0 && probability <= 1.0 ) )
+			{
+				throw std::invalid_argument( "Probability for fill_bernoulli must be in [0, 1]" );
+			}
+		}
+
+		// 范围运算的检查：[ pos, pos + len ) 必须在存储的 chunk_count() * 32 个比特之内
+		void check_chunk_range( size_t pos, size_t len, const char* message ) const
+		{
+			const size_t storage_bits = this->data_chunk_count * 32;
+			if ( pos > storage_bits || len > storage_bits - pos )
+			{
+				throw std::out_of_range( message );
+			}
+		}
+
+		// 用 0 把比特块扩展到至少 chunk_count 个 (与 or_operation 中的扩展相同)
+		void extend_chunks( size_t chunk_count )
+		{
+			if ( this->data_chunk_count < chunk_count )
+			{
+				this->bitset.resize( chunk_count, BooleanBitWrapper( 0 ) );
+				this->data_chunk_count = this->bitset.size();
+				this->data_capacity = this->bitset.size() * 32;
+			}
+		}
+
+		// 多操作数运算的操作数：返回结果的块数 (intersection 为 true 时取最短的，否则取最长的)
+		static size_t collect_operands( const std::vector<const DynamicBitSet*>& sets, std::vector<const BooleanBitWrapper*>& sources, std::vector<size_t>& lengths, bool intersection )
+		{
+			size_t count = 0;
+			size_t bytes_touched = 0;
+			sources.reserve( sets.size() );
+			lengths.reserve( sets.size() );
+			for ( const DynamicBitSet* set : sets )
+			{
+				sources.push_back( set->bitset.data() );
+				lengths.push_back( set->data_chunk_count );
+				count = sources.size() == 1 ? set->data_chunk_count : ( intersection ? std::min( count, set->data_chunk_count ) : std::max( count, set->data_chunk_count ) );
+				bytes_touched += set->data_chunk_count * sizeof( BooleanBitWrapper );
+			}
+			DYNAMIC_BITSET_RECORD_CALL( MultiOperand, bytes_touched + count * sizeof( BooleanBitWrapper ) );
+			return count;
+		}
+
+		static std::vector<const DynamicBitSet*> operand_pointers( const std::vector<DynamicBitSet>& sets )
+		{
+			std::vector<const DynamicBitSet*> pointers;
+			pointers.reserve( sets.size() );
+			for ( const DynamicBitSet& set : sets )
+			{
+				pointers.push_back( &set );
+			}
+			return pointers;
+		}
+
+		static void prefetch_address( const void* address ) noexcept
+		{
+#if defined( __GNUC__ ) || defined( __clang__ )
+			__builtin_prefetch( address, 1, 1 );
+#elif defined( _M_X64 ) || defined( _M_IX86 )
+			_mm_prefetch( static_cast<const char*>( address ), _MM_HINT_T0 );
+#else
+			( void )address;
+#endif
+		}
+
+		// 批量 scatter 的公共实现：检查索引 -> (可选) 按区域分桶 -> 带预取地执行 operation( chunk, mask )
+		template <typename ChunkOperation>
+		void scatter_bits( const size_t* indices, size_t count, ChunkOperation operation )
+		{
+			for ( size_t i = 0; i < count; ++i )
+			{
+				DefaultBitAccess::check_index( indices[ i ], this->data_size, "Index out of range from batch operation" );
+			}
+
+			const size_t region_count = ( bitset.size() + batch_region_chunks - 1 ) / batch_region_chunks;
+
+			std::vector<size_t> bucketed_indices;
+			const size_t*		ordered_indices = indices;
+
+			if ( count >= batch_bucket_threshold && region_count > 1 )
+			{
+				// 计数排序 (只按区域分桶，不做完整排序)：O(n)，之后每个桶的写入都落在同一个 L2 大小的区域里
+				const size_t		region_bits = batch_region_chunks * 32;
+				std::vector<size_t> region_offsets( region_count + 1, 0 );
+				for ( size_t i = 0; i < count; ++i )
+				{
+					++region_offsets[ indices[ i ] / region_bits + 1 ];
+				}
+				for ( size_t region = 0; region < region_count; ++region )
+				{
+					region_offsets[ region + 1 ] += region_offsets[ region ];
+				}
+
+				bucketed_indices.resize( count );
+				for ( size_t i = 0; i < count; ++i )
+				{
+					bucketed_indices[ region_offsets[ indices[ i ] / region_bits ]++ ] = indices[ i ];
+				}
+				ordered_indices = bucketed_indices.data();
+			}
+
+			BooleanBitWrapper* chunks = bitset.data();
+			for ( size_t i = 0; i < count; ++i )
+			{
+				if ( i + batch_prefetch_distance < count )
+				{
+					prefetch_address( &chunks[ ordered_indices[ i + batch_prefetch_distance ] / 32 ] );
+				}
+				const size_t index = ordered_indices[ i ];
+				operation( chunks[ index / 32 ].bits, uint32_t( 1 ) << ( index % 32 ) );
+			}
+		}
+
 		void sanitize()
 		{
 			size_t shift = data_size % 32;
@@ -1952,5 +3003,346 @@ namespace TwilightDream
 			return decimal;
 		}
 	};
+
+	/*
+		DynamicBitSetComplement
+		DynamicBitSet::complement_view() 返回的惰性取反视图：只保存被取反的比特集的地址，O(1)，不复制也不翻转任何比特块。
+		- 值与 ~bits 相同：取反的范围与 not_operation() 相同，是被取反的比特集的 chunk_count() 个块。
+		- 与 DynamicBitSet 的 & | ^ (以及 &= |= ^=) 直接使用融合的 andnot / ornot / xnor 内核，
+		  例如 a & b.complement_view() 只遍历一次 a 和 b，而不是先复制并翻转 b 再做一次按位与。
+		- 计数、查询、比较 (==) 和迭代直接读原来的比特块；需要真正的比特集时转换为 DynamicBitSet (或者调用 materialize())。
+		- 视图不拥有比特集：被取反的比特集被销毁或者移动之后视图失效，它被修改之后视图的值随之改变。
+		  只在比特集确定活得更久的表达式或者作用域里使用视图，不要把它保存到成员变量或者容器中。
+	*/
+	class DynamicBitSetComplement
+	{
+	public:
+		// 只读的正向迭代器，依次给出比特 0 .. size() - 1 取反之后的值
+		class const_iterator
+		{
+		public:
+			using iterator_category = std::forward_iterator_tag;
+			using value_type = bool;
+			using difference_type = std::ptrdiff_t;
+			using pointer = const bool*;
+			using reference = bool;
+
+			const_iterator() noexcept = default;
+
+			const_iterator( const DynamicBitSet* bits, size_t index ) noexcept : complemented_bits( bits ), bit_index( index ) {}
+
+			bool operator*() const noexcept
+			{
+				return !complemented_bits->chunk_data()[ bit_index / 32 ].bit_get( static_cast<int>( bit_index % 32 ) );
+			}
+
+			const_iterator& operator++() noexcept
+			{
+				++bit_index;
+				return *this;
+			}
+
+			const_iterator operator++( int ) noexcept
+			{
+				const_iterator old = *this;
+				++bit_index;
+				return old;
+			}
+
+			friend bool operator==( const const_iterator& left, const const_iterator& right ) noexcept
+			{
+				return left.bit_index == right.bit_index;
+			}
+
+			friend bool operator!=( const const_iterator& left, const const_iterator& right ) noexcept
+			{
+				return left.bit_index != right.bit_index;
+			}
+
+		private:
+			const DynamicBitSet* complemented_bits = nullptr;
+			size_t				 bit_index = 0;
+		};
+
+		using iterator = const_iterator;
+
+		explicit DynamicBitSetComplement( const DynamicBitSet& bits ) noexcept : complemented_bits( &bits ) {}
+
+		// 被取反的比特集
+		const DynamicBitSet& complemented() const noexcept
+		{
+			return *complemented_bits;
+		}
+
+		// ~~a 就是 a 本身
+		const DynamicBitSet& operator~() const noexcept
+		{
+			return *complemented_bits;
+		}
+
+		size_t chunk_count() const noexcept
+		{
+			return complemented_bits->chunk_count();
+		}
+
+		// 视图覆盖的比特数量 (chunk_count() 个完整的块)
+		size_t size() const noexcept
+		{
+			return chunk_count() * 32;
+		}
+
+		const_iterator begin() const noexcept
+		{
+			return const_iterator( complemented_bits, 0 );
+		}
+
+		const_iterator end() const noexcept
+		{
+			return const_iterator( complemented_bits, size() );
+		}
+
+		const_iterator cbegin() const noexcept
+		{
+			return begin();
+		}
+
+		const_iterator cend() const noexcept
+		{
+			return end();
+		}
+
+		bool get_bit( size_t index ) const
+		{
+			DefaultBitAccess::check_index( index, size(), "Index out of range from complemented bit set" );
+			return !complemented_bits->chunk_data()[ index / 32 ].bit_get( static_cast<int>( index % 32 ) );
+		}
+
+		bool operator[]( size_t index ) const
+		{
+			return get_bit( index );
+		}
+
+		size_t hamming_weight() const
+		{
+			return size() - complemented_bits->hamming_weight();
+		}
+
+		// 存在不全是'1'的块时取反之后才有'1'
+		bool any() const
+		{
+			return !complemented_bits->all();
+		}
+
+		bool none() const
+		{
+			return complemented_bits->all();
+		}
+
+		// 物化为普通的比特集，与 ~complemented() 相同
+		DynamicBitSet materialize() const
+		{
+			return ~*complemented_bits;
+		}
+
+		operator DynamicBitSet() const
+		{
+			return materialize();
+		}
+
+		// 视图在左边时交换两边 (结果的值相同)
+		friend DynamicBitSet operator&( const DynamicBitSetComplement& left, const DynamicBitSet& right )
+		{
+			DynamicBitSet result = right;
+			result.and_operation( left );
+			return result;
+		}
+
+		friend DynamicBitSet operator|( const DynamicBitSetComplement& left, const DynamicBitSet& right )
+		{
+			DynamicBitSet result = right;
+			result.or_operation( left );
+			return result;
+		}
+
+		friend DynamicBitSet operator^( const DynamicBitSetComplement& left, const DynamicBitSet& right )
+		{
+			DynamicBitSet result = right;
+			result.xor_operation( left );
+			return result;
+		}
+
+		// 两边都是视图时物化左边，右边仍然使用融合的内核
+		friend DynamicBitSet operator&( const DynamicBitSetComplement& left, const DynamicBitSetComplement& right )
+		{
+			DynamicBitSet result = left.materialize();
+			result.and_operation( right );
+			return result;
+		}
+
+		friend DynamicBitSet operator|( const DynamicBitSetComplement& left, const DynamicBitSetComplement& right )
+		{
+			DynamicBitSet result = left.materialize();
+			result.or_operation( right );
+			return result;
+		}
+
+		friend DynamicBitSet operator^( const DynamicBitSetComplement& left, const DynamicBitSetComplement& right )
+		{
+			DynamicBitSet result = left.materialize();
+			result.xor_operation( right );
+			return result;
+		}
+
+		// 按数值比较 (与 DynamicBitSet::operator== 相同，高位缺少的块视为 0)，不物化
+		friend bool operator==( const DynamicBitSetComplement& left, const DynamicBitSet& right ) noexcept
+		{
+			const BooleanBitWrapper* complemented = left.complemented_bits->chunk_data();
+			const BooleanBitWrapper* other = right.chunk_data();
+			const size_t			 left_chunks = left.chunk_count();
+			const size_t			 right_chunks = right.chunk_count();
+			const size_t			 common_chunks = std::min( left_chunks, right_chunks );
+			for ( size_t index = 0; index < common_chunks; ++index )
+			{
+				if ( ( complemented[ index ].bits ^ other[ index ].bits ) != 0xFFFFFFFF )
+					return false;
+			}
+			// 较长一边多出的块取值必须为 0：视图一边是被取反的块全为'1'
+			for ( size_t index = common_chunks; index < left_chunks; ++index )
+			{
+				if ( complemented[ index ].bits != 0xFFFFFFFF )
+					return false;
+			}
+			return !chunks_any( other + common_chunks, right_chunks - common_chunks );
+		}
+
+		friend bool operator==( const DynamicBitSet& left, const DynamicBitSetComplement& right ) noexcept
+		{
+			return right == left;
+		}
+
+		// ~a == ~b：相同长度的部分 a 与 b 相同，较长一边多出的块全为'1'
+		friend bool operator==( const DynamicBitSetComplement& left, const DynamicBitSetComplement& right ) noexcept
+		{
+			const DynamicBitSet& shorter = left.chunk_count() <= right.chunk_count() ? *left.complemented_bits : *right.complemented_bits;
+			const DynamicBitSet& longer = left.chunk_count() <= right.chunk_count() ? *right.complemented_bits : *left.complemented_bits;
+			const size_t		 common_chunks = shorter.chunk_count();
+			if ( common_chunks != 0 && std::memcmp( shorter.chunk_data(), longer.chunk_data(), common_chunks * sizeof( BooleanBitWrapper ) ) != 0 )
+				return false;
+			for ( size_t index = common_chunks; index < longer.chunk_count(); ++index )
+			{
+				if ( longer.chunk_data()[ index ].bits != 0xFFFFFFFF )
+					return false;
+			}
+			return true;
+		}
+
+		friend bool operator!=( const DynamicBitSetComplement& left, const DynamicBitSet& right ) noexcept
+		{
+			return !( left == right );
+		}
+
+		friend bool operator!=( const DynamicBitSet& left, const DynamicBitSetComplement& right ) noexcept
+		{
+			return !( right == left );
+		}
+
+		friend bool operator!=( const DynamicBitSetComplement& left, const DynamicBitSetComplement& right ) noexcept
+		{
+			return !( left == right );
+		}
+
+	private:
+		const DynamicBitSet* complemented_bits;
+	};
+
+	inline DynamicBitSetComplement DynamicBitSet::complement_view() const& noexcept
+	{
+		return DynamicBitSetComplement( *this );
+	}
+
+	// 与物化的 other 做 and_operation 相同：this 比 other 长的部分被清零
+	inline void DynamicBitSet::and_operation( const DynamicBitSetComplement& other )
+	{
+		const DynamicBitSet& complemented = other.complemented();
+		DYNAMIC_BITSET_RECORD_CALL( BitwiseAndNot, ( this->bitset.size() + complemented.bitset.size() ) * sizeof( BooleanBitWrapper ) );
+
+		const size_t min_size = std::min( this->data_chunk_count, complemented.data_chunk_count );
+		chunks_and_not( this->bitset.data(), complemented.bitset.data(), min_size );
+		if ( this->data_chunk_count > min_size )
+		{
+			std::fill( this->bitset.begin() + min_size, this->bitset.end(), BooleanBitWrapper( 0 ) );
+		}
+
+		this->data_size = this->valid_number_of_bits();
+	}
+
+	// 与物化的 other 做 or_operation 相同，就是 or_not_operation
+	inline void DynamicBitSet::or_operation( const DynamicBitSetComplement& other )
+	{
+		this->or_not_operation( other.complemented() );
+	}
+
+	// 与物化的 other 做 xor_operation 相同：this 比 other 长的部分保持不变 (与 xnor_operation 不同)
+	inline void DynamicBitSet::xor_operation( const DynamicBitSetComplement& other )
+	{
+		const DynamicBitSet& complemented = other.complemented();
+		DYNAMIC_BITSET_RECORD_CALL( BitwiseXnor, ( this->bitset.size() + complemented.bitset.size() ) * sizeof( BooleanBitWrapper ) );
+
+		const size_t complemented_chunks = complemented.data_chunk_count;
+		extend_chunks( complemented_chunks );
+		chunks_xnor( this->bitset.data(), complemented.bitset.data(), complemented_chunks );
+
+		this->data_size = this->valid_number_of_bits();
+	}
+
+	inline DynamicBitSet DynamicBitSet::operator&( const DynamicBitSetComplement& other ) const
+	{
+		DynamicBitSet result = *this;
+		result.and_operation( other );
+		return result;
+	}
+
+	inline DynamicBitSet DynamicBitSet::operator|( const DynamicBitSetComplement& other ) const
+	{
+		DynamicBitSet result = *this;
+		result.or_operation( other );
+		return result;
+	}
+
+	inline DynamicBitSet DynamicBitSet::operator^( const DynamicBitSetComplement& other ) const
+	{
+		DynamicBitSet result = *this;
+		result.xor_operation( other );
+		return result;
+	}
+
+	inline DynamicBitSet& DynamicBitSet::operator&=( const DynamicBitSetComplement& other )
+	{
+		this->and_operation( other );
+		return *this;
+	}
+
+	inline DynamicBitSet& DynamicBitSet::operator|=( const DynamicBitSetComplement& other )
+	{
+		this->or_operation( other );
+		return *this;
+	}
+
+	inline DynamicBitSet& DynamicBitSet::operator^=( const DynamicBitSetComplement& other )
+	{
+		this->xor_operation( other );
+		return *this;
+	}
 }
 
+namespace std
+{
+	template <>
+	struct hash<TwilightDream::DynamicBitSet>
+	{
+		size_t operator()( const TwilightDream::DynamicBitSet& bits ) const noexcept
+		{
+			return static_cast<size_t>( bits.hash() );
+		}
+	};
+}  // namespace std
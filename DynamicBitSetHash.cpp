@@ -0,0 +1,188 @@
+#include "DynamicBitSetHash.hpp"
+
+#include <algorithm>
+
+#include "DynamicBitSetKernels.hpp"
+
+namespace TwilightDream
+{
+	namespace
+	{
+		constexpr std::array<uint64_t, 8> hash_secret {
+			0xA0761D6478BD642FULL, 0xE7037ED1A0B428DBULL, 0x8EBC6AF09C88C6E3ULL, 0x589965CC75374CC3ULL,
+			0x1D8E4E27C47D124FULL, 0x9E3779B185EBCA87ULL, 0xC2B2AE3D27D4EB4FULL, 0x165667B19E3779F9ULL
+		};
+
+		// 每个条带的 key 增加的量 (2^64 / 黄金分割比)
+		constexpr uint64_t stripe_key_step = 0x9E3779B97F4A7C15ULL;
+
+		// 每隔多少个条带打散一次累加器
+		constexpr uint64_t stripes_per_scramble = 16;
+
+		// wyhash 的混合函数：64 x 64 -> 128 位乘法，高低两半异或
+		inline uint64_t wymix( uint64_t left, uint64_t right ) noexcept
+		{
+#if defined( __SIZEOF_INT128__ )
+			const unsigned __int128 product = static_cast<unsigned __int128>( left ) * right;
+			return static_cast<uint64_t>( product ) ^ static_cast<uint64_t>( product >> 64 );
+#else
+			const uint64_t left_low = left & 0xFFFFFFFF, left_high = left >> 32;
+			const uint64_t right_low = right & 0xFFFFFFFF, right_high = right >> 32;
+			const uint64_t low_low = left_low * right_low, low_high = left_low * right_high;
+			const uint64_t high_low = left_high * right_low, high_high = left_high * right_high;
+			const uint64_t middle = ( low_low >> 32 ) + ( low_high & 0xFFFFFFFF ) + ( high_low & 0xFFFFFFFF );
+			const uint64_t low = ( middle << 32 ) | ( low_low & 0xFFFFFFFF );
+			const uint64_t high = high_high + ( low_high >> 32 ) + ( high_low >> 32 ) + ( middle >> 32 );
+			return low ^ high;
+#endif
+		}
+
+		inline uint64_t chunk_pair( const BooleanBitWrapper* chunks, size_t index ) noexcept
+		{
+			return uint64_t( chunks[ index ].bits ) | ( uint64_t( chunks[ index + 1 ].bits ) << 32 );
+		}
+	}  // namespace
+
+	namespace hash_detail
+	{
+		// 把 stripe_count 个完整的条带累加进 accumulators，第一个条带的序号是 first_stripe_index
+		DYNAMIC_BITSET_TARGET_CLONES( "default", "avx2", "avx512f" )
+		void accumulate_stripes( uint64_t* accumulators, const BooleanBitWrapper* chunks, size_t stripe_count, uint64_t first_stripe_index ) noexcept
+		{
+			for ( size_t stripe = 0; stripe < stripe_count; ++stripe )
+			{
+				const uint64_t			 stripe_index = first_stripe_index + stripe;
+				const uint64_t			 stripe_key = stripe_index * stripe_key_step;
+				const BooleanBitWrapper* stripe_chunks = chunks + stripe * BitChunkHasher::stripe_chunks;
+				uint64_t words[ 8 ];
+				for ( size_t lane = 0; lane < 8; ++lane )
+				{
+					words[ lane ] = chunk_pair( stripe_chunks, 2 * lane );
+				}
+				// acc[ i ] += w[ i ^ 1 ] + lo32( k ) * hi32( k )，写成没有跨元素写入的形式以便向量化
+				for ( size_t lane = 0; lane < 8; ++lane )
+				{
+					const uint64_t keyed = words[ lane ] ^ ( hash_secret[ lane ] + stripe_key );
+					accumulators[ lane ] += words[ lane ^ 1 ] + ( keyed & 0xFFFFFFFF ) * ( keyed >> 32 );
+				}
+
+				if ( ( stripe_index + 1 ) % stripes_per_scramble == 0 )
+				{
+					for ( size_t lane = 0; lane < 8; ++lane )
+					{
+						uint64_t accumulator = accumulators[ lane ];
+						accumulator ^= accumulator >> 47;
+						accumulator ^= hash_secret[ lane ];
+						accumulators[ lane ] = accumulator * 0x9E3779B1ULL;
+					}
+				}
+			}
+		}
+	}  // namespace hash_detail
+
+	BitChunkHasher::BitChunkHasher( uint64_t seed ) noexcept
+		: seed( seed )
+	{
+		for ( size_t lane = 0; lane < accumulators.size(); ++lane )
+		{
+			accumulators[ lane ] = hash_secret[ lane ] + seed;
+		}
+	}
+
+	BitChunkHasher& BitChunkHasher::update( const BooleanBitWrapper* chunks, size_t count ) noexcept
+	{
+		// 最高位的零块先记下来，后面再出现非零块时才真正追加
+		size_t significant = count;
+		while ( significant > 0 && chunks[ significant - 1 ].bits == 0 )
+		{
+			--significant;
+		}
+		if ( significant == 0 )
+		{
+			pending_zero_chunks += count;
+			return *this;
+		}
+
+		append_zeros( pending_zero_chunks );
+		append( chunks, significant );
+		pending_zero_chunks = count - significant;
+		return *this;
+	}
+
+	BitChunkHasher& BitChunkHasher::update( uint64_t word ) noexcept
+	{
+		const BooleanBitWrapper chunks[ 2 ] = { BooleanBitWrapper( static_cast<uint32_t>( word ) ), BooleanBitWrapper( static_cast<uint32_t>( word >> 32 ) ) };
+		return update( chunks, 2 );
+	}
+
+	void BitChunkHasher::append( const BooleanBitWrapper* chunks, size_t count ) noexcept
+	{
+		total_chunks += count;
+
+		if ( buffered_chunks != 0 )
+		{
+			const size_t taken = std::min( count, stripe_chunks - buffered_chunks );
+			std::copy( chunks, chunks + taken, buffer.begin() + buffered_chunks );
+			buffered_chunks += taken;
+			chunks += taken;
+			count -= taken;
+			if ( buffered_chunks < stripe_chunks )
+			{
+				return;
+			}
+			consume_stripes( buffer.data(), 1 );
+			buffered_chunks = 0;
+		}
+
+		const size_t stripe_count = count / stripe_chunks;
+		consume_stripes( chunks, stripe_count );
+		chunks += stripe_count * stripe_chunks;
+		count -= stripe_count * stripe_chunks;
+
+		std::copy( chunks, chunks + count, buffer.begin() );
+		buffered_chunks = count;
+	}
+
+	void BitChunkHasher::append_zeros( size_t count ) noexcept
+	{
+		static constexpr std::array<BooleanBitWrapper, stripe_chunks> zeros {};
+		while ( count != 0 )
+		{
+			const size_t taken = std::min( count, stripe_chunks );
+			append( zeros.data(), taken );
+			count -= taken;
+		}
+	}
+
+	void BitChunkHasher::consume_stripes( const BooleanBitWrapper* chunks, size_t stripe_count ) noexcept
+	{
+		if ( stripe_count != 0 )
+		{
+			hash_detail::accumulate_stripes( accumulators.data(), chunks, stripe_count, stripe_index );
+			stripe_index += stripe_count;
+		}
+	}
+
+	uint64_t BitChunkHasher::finish() const noexcept
+	{
+		uint64_t result = seed ^ ( total_chunks * stripe_key_step );
+		for ( size_t lane = 0; lane < accumulators.size(); lane += 2 )
+		{
+			result += wymix( accumulators[ lane ] ^ hash_secret[ lane ], accumulators[ lane + 1 ] ^ hash_secret[ lane + 1 ] );
+		}
+
+		// 不满一个条带的尾部 (奇数个块时最高的一个块单独成为一个字)
+		for ( size_t index = 0; index < buffered_chunks; index += 2 )
+		{
+			const uint64_t word = index + 1 < buffered_chunks ? chunk_pair( buffer.data(), index ) : uint64_t( buffer[ index ].bits );
+			result = wymix( result ^ word, hash_secret[ ( index / 2 ) % hash_secret.size() ] ^ index );
+		}
+
+		return wymix( result ^ hash_secret[ 0 ], total_chunks ^ hash_secret[ 1 ] );
+	}
+
+	uint64_t BitChunkHasher::hash( const BooleanBitWrapper* chunks, size_t count, uint64_t seed ) noexcept
+	{
+		return BitChunkHasher( seed ).update( chunks, count ).finish();
+	}
+}  // namespace TwilightDream
@@ -0,0 +1,61 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+#include <array>
+
+#include "BooleanBitWrapper.hpp"
+
+/*
+	比特块的哈希 (Bit chunk hashing)
+	xxh3 风格的条带 (stripe) 累加：每个条带是 8 个 64 位字 (16 个比特块)，8 个相互独立的累加器各自做
+	acc[ i ] += lo32( w ^ key ) * hi32( w ^ key )，acc[ i ^ 1 ] += w，这个循环可以被向量化 (vpmuludq)，
+	在 DynamicBitSetHash.cpp 中和其他内核一样用 target_clones 生成 default / AVX2 / AVX-512 版本。
+	每个条带的 key 随条带序号变化，交换两个条带会改变哈希值；每 16 个条带对累加器做一次打散 (scramble)，
+	最后用 wyhash 的 128 位乘法折叠 (wymix) 合并累加器和不满一个条带的尾部。
+
+	哈希值只取决于去掉最高位的零块之后的比特块序列，所以与 bit_size()、容量以及高位的零块无关，
+	和 DynamicBitSet::operator== 的数值语义一致。
+*/
+
+namespace TwilightDream
+{
+	class BitChunkHasher
+	{
+	public:
+		// 每个条带的比特块数量
+		static constexpr size_t stripe_chunks = 16;
+
+		explicit BitChunkHasher( uint64_t seed = 0 ) noexcept;
+
+		// 追加 chunks[ 0, count )，紧接在之前追加的比特块之后 (即更高的位)
+		BitChunkHasher& update( const BooleanBitWrapper* chunks, size_t count ) noexcept;
+
+		// 按 LSB 在前追加两个比特块
+		BitChunkHasher& update( uint64_t word ) noexcept;
+
+		// 计算到目前为止的哈希值，不改变状态 (可以继续 update)
+		uint64_t finish() const noexcept;
+
+		// 一次性计算 chunks[ 0, count ) 的哈希值，等价于 BitChunkHasher( seed ).update( chunks, count ).finish()
+		static uint64_t hash( const BooleanBitWrapper* chunks, size_t count, uint64_t seed = 0 ) noexcept;
+
+	private:
+		// 真正追加比特块 (调用者保证这一段之后还会有非零块，或者这一段的最高块非零)
+		void append( const BooleanBitWrapper* chunks, size_t count ) noexcept;
+		void append_zeros( size_t count ) noexcept;
+		void consume_stripes( const BooleanBitWrapper* chunks, size_t stripe_count ) noexcept;
+
+		std::array<uint64_t, 8>						accumulators;
+		std::array<BooleanBitWrapper, stripe_chunks> buffer {};
+		uint64_t									seed;
+		// 已经追加 (不含延迟的零块) 的比特块数量
+		uint64_t total_chunks = 0;
+		// 已经折叠进累加器的条带数量
+		uint64_t stripe_index = 0;
+		size_t	 buffered_chunks = 0;
+		// 最后收到的、还不能确定是否在最高位的零块的数量
+		uint64_t pending_zero_chunks = 0;
+	};
+}  // namespace TwilightDream
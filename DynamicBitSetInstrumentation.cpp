@@ -0,0 +1,52 @@
+#include "DynamicBitSetInstrumentation.hpp"
+
+namespace TwilightDream
+{
+	namespace instrumentation_detail
+	{
+		OperationCounters operation_counters[ bitset_operation_count ];
+	}
+
+	const char* operation_name( BitSetOperation operation ) noexcept
+	{
+		static const char* const names[ bitset_operation_count ] = {
+			"resize",		  "reserve",	 "shrink_to_fit", "insert",		 "erase",		 "reverse_insert", "reverse_erase",
+			"push_front",	  "push_back",	 "pop_front",	  "pop_back",	 "left_shift",	 "right_shift",	   "rotate_left",
+			"rotate_right",	  "valid_number_of_bits",		  "and",		 "or",			 "xor",			   "not",
+			"and_not",		  "or_not",		 "xnor",		  "ternary",	 "multi_operand", "range_operation",
+			"hamming_weight",
+		};
+
+		const size_t index = static_cast<size_t>( operation );
+		return index < bitset_operation_count ? names[ index ] : "unknown";
+	}
+
+	DynamicBitSetStatistics instrumentation_snapshot()
+	{
+		DynamicBitSetStatistics statistics;
+		for ( size_t index = 0; index < bitset_operation_count; ++index )
+		{
+			const instrumentation_detail::OperationCounters& source = instrumentation_detail::operation_counters[ index ];
+			OperationStatistics&							 target = statistics.operations[ index ];
+
+			target.calls = source.calls.load( std::memory_order_relaxed );
+			target.bytes_touched = source.bytes_touched.load( std::memory_order_relaxed );
+			target.reallocations = source.reallocations.load( std::memory_order_relaxed );
+			target.bytes_allocated = source.bytes_allocated.load( std::memory_order_relaxed );
+			target.slow_path_hits = source.slow_path_hits.load( std::memory_order_relaxed );
+		}
+		return statistics;
+	}
+
+	void reset_instrumentation()
+	{
+		for ( auto& counters : instrumentation_detail::operation_counters )
+		{
+			counters.calls.store( 0, std::memory_order_relaxed );
+			counters.bytes_touched.store( 0, std::memory_order_relaxed );
+			counters.reallocations.store( 0, std::memory_order_relaxed );
+			counters.bytes_allocated.store( 0, std::memory_order_relaxed );
+			counters.slow_path_hits.store( 0, std::memory_order_relaxed );
+		}
+	}
+}  // namespace TwilightDream
@@ -0,0 +1,165 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+#include <array>
+#include <atomic>
+#include <type_traits>
+
+/*
+	DynamicBitSet 热路径计数 (Hot-path instrumentation)
+	定义 LARGE_DYNAMIC_BITSET_INSTRUMENTATION (CMake 选项同名) 之后，DynamicBitSet 的关键操作会统计：
+	- calls:          调用次数
+	- bytes_touched:  读写的比特块字节数
+	- reallocations:  底层比特块数组重新分配的次数
+	- bytes_allocated: 重新分配后新的比特块数组的字节数
+	- slow_path_hits: 进入慢速路径的次数 (rotate 的 vector<bool> 回退、insert / erase 的逐位循环、
+	                  valid_number_of_bits() 扫描超过最高的一个块等)
+	没有定义时，所有记录宏都展开为空语句，instrumentation_snapshot() 返回全零。
+*/
+
+namespace TwilightDream
+{
+	enum class BitSetOperation : size_t
+	{
+		Resize,
+		Reserve,
+		ShrinkToFit,
+		Insert,
+		Erase,
+		ReverseInsert,
+		ReverseErase,
+		PushFront,
+		PushBack,
+		PopFront,
+		PopBack,
+		LeftShift,
+		RightShift,
+		RotateLeft,
+		RotateRight,
+		ValidNumberOfBits,
+		BitwiseAnd,
+		BitwiseOr,
+		BitwiseXor,
+		BitwiseNot,
+		BitwiseAndNot,
+		BitwiseOrNot,
+		BitwiseXnor,
+		BitwiseTernary,
+		MultiOperand,
+		RangeOperation,
+		HammingWeight,
+		Count
+	};
+
+	constexpr size_t bitset_operation_count = static_cast<size_t>( BitSetOperation::Count );
+
+	// 操作的名字 (用于输出统计报告)
+	const char* operation_name( BitSetOperation operation ) noexcept;
+
+	struct OperationStatistics
+	{
+		uint64_t calls = 0;
+		uint64_t bytes_touched = 0;
+		uint64_t reallocations = 0;
+		uint64_t bytes_allocated = 0;
+		uint64_t slow_path_hits = 0;
+	};
+
+	// 某一时刻所有操作的计数快照
+	struct DynamicBitSetStatistics
+	{
+		std::array<OperationStatistics, bitset_operation_count> operations {};
+
+		const OperationStatistics& operator[]( BitSetOperation operation ) const
+		{
+			return operations[ static_cast<size_t>( operation ) ];
+		}
+	};
+
+#if defined( LARGE_DYNAMIC_BITSET_INSTRUMENTATION )
+	constexpr bool instrumentation_enabled = true;
+#else
+	constexpr bool instrumentation_enabled = false;
+#endif
+
+	// 读取当前计数 (各个计数器分别原子读取，并发修改时快照不是一个整体的瞬间)
+	DynamicBitSetStatistics instrumentation_snapshot();
+
+	// 把所有计数器清零
+	void reset_instrumentation();
+
+	namespace instrumentation_detail
+	{
+		struct OperationCounters
+		{
+			std::atomic<uint64_t> calls { 0 };
+			std::atomic<uint64_t> bytes_touched { 0 };
+			std::atomic<uint64_t> reallocations { 0 };
+			std::atomic<uint64_t> bytes_allocated { 0 };
+			std::atomic<uint64_t> slow_path_hits { 0 };
+		};
+
+		extern OperationCounters operation_counters[ bitset_operation_count ];
+
+		inline OperationCounters& counters( BitSetOperation operation ) noexcept
+		{
+			return operation_counters[ static_cast<size_t>( operation ) ];
+		}
+
+		inline void record_call( BitSetOperation operation, size_t bytes_touched ) noexcept
+		{
+			OperationCounters& target = counters( operation );
+			target.calls.fetch_add( 1, std::memory_order_relaxed );
+			target.bytes_touched.fetch_add( bytes_touched, std::memory_order_relaxed );
+		}
+
+		inline void record_slow_path( BitSetOperation operation, size_t bytes_touched ) noexcept
+		{
+			OperationCounters& target = counters( operation );
+			target.slow_path_hits.fetch_add( 1, std::memory_order_relaxed );
+			target.bytes_touched.fetch_add( bytes_touched, std::memory_order_relaxed );
+		}
+
+		// 在作用域结束时比较容器的 capacity()，变化了就记录一次重新分配
+		template <typename Container>
+		class ReallocationTracer
+		{
+		public:
+			ReallocationTracer( BitSetOperation operation, const Container& container ) noexcept
+				: operation( operation ), container( container ), capacity( container.capacity() ), data( container.data() )
+			{}
+
+			~ReallocationTracer()
+			{
+				if ( container.capacity() != capacity || container.data() != data )
+				{
+					OperationCounters& target = counters( operation );
+					target.reallocations.fetch_add( 1, std::memory_order_relaxed );
+					target.bytes_allocated.fetch_add( container.capacity() * sizeof( typename Container::value_type ), std::memory_order_relaxed );
+				}
+			}
+
+			ReallocationTracer( const ReallocationTracer& ) = delete;
+			ReallocationTracer& operator=( const ReallocationTracer& ) = delete;
+
+		private:
+			BitSetOperation						  operation;
+			const Container&					  container;
+			size_t								  capacity;
+			const typename Container::value_type* data;
+		};
+	}  // namespace instrumentation_detail
+}  // namespace TwilightDream
+
+#if defined( LARGE_DYNAMIC_BITSET_INSTRUMENTATION )
+#define DYNAMIC_BITSET_RECORD_CALL( operation, bytes_touched ) ::TwilightDream::instrumentation_detail::record_call( ::TwilightDream::BitSetOperation::operation, ( bytes_touched ) )
+#define DYNAMIC_BITSET_RECORD_SLOW_PATH( operation, bytes_touched ) ::TwilightDream::instrumentation_detail::record_slow_path( ::TwilightDream::BitSetOperation::operation, ( bytes_touched ) )
+#define DYNAMIC_BITSET_TRACE_REALLOCATION( operation, container ) \
+	::TwilightDream::instrumentation_detail::ReallocationTracer<std::decay_t<decltype( container )>> dynamic_bitset_reallocation_tracer( ::TwilightDream::BitSetOperation::operation, ( container ) )
+#else
+#define DYNAMIC_BITSET_RECORD_CALL( operation, bytes_touched ) ( ( void )0 )
+#define DYNAMIC_BITSET_RECORD_SLOW_PATH( operation, bytes_touched ) ( ( void )0 )
+#define DYNAMIC_BITSET_TRACE_REALLOCATION( operation, container ) ( ( void )0 )
+#endif
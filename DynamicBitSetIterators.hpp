@@ -9,6 +9,7 @@
 #include <type_traits>
 
 #include "BooleanBitWrapper.hpp"
+#include "BitChunkAllocator.hpp"
 
 namespace TwilightDream
 {
@@ -51,7 +52,7 @@ namespace TwilightDream
 	class BitIteratorBaseData : public AbstractBitIteratorBase
 	{
 	public:
-		BitIteratorBaseData(bool is_begin_or_end_iterator, std::vector<BooleanBitWrapper>* container, size_t MVB )
+		BitIteratorBaseData(bool is_begin_or_end_iterator, BitChunkVector* container, size_t MVB )
 			: AbstractBitIteratorBase(is_begin_or_end_iterator ? 0 : MVB - 1, MVB), container_pointer(container)
 		{
 			if(container == nullptr)
@@ -89,7 +90,7 @@ namespace TwilightDream
 
 	protected:
 		BooleanBitWrapper*				data_pointer = nullptr;
-		std::vector<BooleanBitWrapper>* container_pointer = nullptr;
+		BitChunkVector* container_pointer = nullptr;
 		
 		/*
 			Regardless of whether the instantiated iterator is read-only or not.
@@ -104,7 +105,7 @@ namespace TwilightDream
 	class ReverseBitIteratorBaseData : public AbstractBitIteratorBase
 	{
 	public:
-		ReverseBitIteratorBaseData(bool is_begin_or_end_iterator, std::vector<BooleanBitWrapper>* container, size_t MVB )
+		ReverseBitIteratorBaseData(bool is_begin_or_end_iterator, BitChunkVector* container, size_t MVB )
 			: AbstractBitIteratorBase(is_begin_or_end_iterator ? MVB - 1 : 0, MVB), container_pointer(container)
 		{
 			if(container == nullptr)
@@ -142,7 +143,7 @@ namespace TwilightDream
 
 	protected:
 		BooleanBitWrapper*				data_pointer = nullptr;
-		std::vector<BooleanBitWrapper>* container_pointer = nullptr;
+		BitChunkVector* container_pointer = nullptr;
 		
 		/*
 			Regardless of whether the instantiated iterator is read-only or not.
@@ -157,7 +158,7 @@ namespace TwilightDream
 	class ConstantBitIteratorBaseData : public AbstractBitIteratorBase
 	{
 	public:
-		ConstantBitIteratorBaseData(bool is_begin_or_end_iterator, const std::vector<BooleanBitWrapper>* container, size_t MVB )
+		ConstantBitIteratorBaseData(bool is_begin_or_end_iterator, const BitChunkVector* container, size_t MVB )
 			: AbstractBitIteratorBase(is_begin_or_end_iterator ? 0 : MVB - 1, MVB), container_pointer(container)
 		{
 			if(container == nullptr)
@@ -195,7 +196,7 @@ namespace TwilightDream
 
 	protected:
 		const BooleanBitWrapper*			  data_pointer = nullptr;
-		const std::vector<BooleanBitWrapper>* container_pointer = nullptr;
+		const BitChunkVector* container_pointer = nullptr;
 		
 		/*
 			Regardless of whether the instantiated iterator is read-only or not.
@@ -210,7 +211,7 @@ namespace TwilightDream
 	class ConstantReverseBitIteratorBaseData : public AbstractBitIteratorBase
 	{
 	public:
-		ConstantReverseBitIteratorBaseData(bool is_begin_or_end_iterator, const std::vector<BooleanBitWrapper>* container, size_t MVB )
+		ConstantReverseBitIteratorBaseData(bool is_begin_or_end_iterator, const BitChunkVector* container, size_t MVB )
 			: AbstractBitIteratorBase(is_begin_or_end_iterator ? MVB - 1 : 0, MVB), container_pointer(container)
 		{
 			if(container == nullptr)
@@ -248,7 +249,7 @@ namespace TwilightDream
 
 	protected:
 		const BooleanBitWrapper*			  data_pointer = nullptr;
-		const std::vector<BooleanBitWrapper>* container_pointer = nullptr;
+		const BitChunkVector* container_pointer = nullptr;
 		
 		/*
 			Regardless of whether the instantiated iterator is read-only or not.
@@ -268,6 +269,10 @@ namespace TwilightDream
 
 		BitReference() noexcept;
 		BitReference(BooleanBitWrapper* wrapper_pointer, uint32_t bits_mask);
+		//不检查空指针的构造函数：调用者已经持有有效的比特块地址
+		BitReference(uint32_t* chunk_bits_pointer, uint32_t bits_mask) noexcept
+			: data_pointer(chunk_bits_pointer), bits_mask(bits_mask)
+		{}
 		BitReference(const BitReference& other) = default;
 
 		operator bool() const noexcept;
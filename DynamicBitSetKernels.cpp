@@ -0,0 +1,850 @@
+#include "DynamicBitSetKernels.hpp"
+
+#include "BitOperations.hpp"
+
+#include <algorithm>
+#include <array>
+#include <utility>
+
+#if DYNAMIC_BITSET_MULTIVERSIONED
+#include <immintrin.h>
+#endif
+
+namespace TwilightDream
+{
+	namespace
+	{
+		// 提前退出的比较内核每次归约的块数 (AVX-512 下正好一个 512 位向量)
+		constexpr size_t early_exit_block_chunks = 16;
+
+		// 多操作数内核的分段大小：chunks_and_many / chunks_or_many 的一段 (256 字节) 保持在向量寄存器中，
+		// chunks_threshold 的一段连同所有计数平面 (最多 64 x 64 x 4 字节) 保持在 L1 中
+		constexpr size_t register_block_chunks = 64;
+
+		// 计数平面的最大数量 (source_count < 2^64)
+		constexpr size_t maximum_counter_planes = 64;
+
+		/*
+			bits_apply_range 的实现：目标块 chunk 对应的源比特从 chunk * 32 + ( source_pos - destination_pos ) 开始，
+			即源块 chunk + quotient 的第 remainder 位 (向下取整的除法，所以 remainder 对所有的块都相同)。
+			中间的目标块完整地落在范围内，它需要的源块也都在源范围内，不需要检查边界；
+			两端的块可能需要源范围之外的块，这些块按 0 处理 (它们的比特会被掩码去掉)，所以不会越界读取。
+		*/
+		template <typename Combine>
+		inline void apply_range_with( Combine combine, BooleanBitWrapper* destination, size_t destination_pos, const BooleanBitWrapper* source, size_t source_pos, size_t length ) noexcept
+		{
+			const size_t	first = destination_pos / 32;
+			const size_t	last = ( destination_pos + length - 1 ) / 32;
+			const ptrdiff_t source_first = static_cast<ptrdiff_t>( source_pos / 32 );
+			const ptrdiff_t source_last = static_cast<ptrdiff_t>( ( source_pos + length - 1 ) / 32 );
+			const ptrdiff_t shift = static_cast<ptrdiff_t>( source_pos % 32 ) - static_cast<ptrdiff_t>( destination_pos % 32 );
+			const ptrdiff_t quotient = source_first - static_cast<ptrdiff_t>( first ) + ( shift < 0 ? -1 : 0 );
+			const unsigned	remainder = static_cast<unsigned>( shift < 0 ? shift + 32 : shift );
+
+			auto funnel = [ remainder ]( uint32_t low, uint32_t high ) -> uint32_t {
+				return remainder == 0 ? low : static_cast<uint32_t>( ( ( uint64_t( high ) << 32 ) | low ) >> remainder );
+			};
+			auto edge_word = [ & ]( size_t chunk ) -> uint32_t {
+				const ptrdiff_t low = static_cast<ptrdiff_t>( chunk ) + quotient;
+				const uint32_t	low_bits = low >= source_first && low <= source_last ? source[ low ].bits : 0;
+				const uint32_t	high_bits = low + 1 >= source_first && low + 1 <= source_last ? source[ low + 1 ].bits : 0;
+				return funnel( low_bits, high_bits );
+			};
+			// 中间的块：对齐与不对齐分成两个循环，循环体中没有分支，可以向量化
+			auto apply_middle = [ & ]( size_t begin, size_t end ) {
+				const BooleanBitWrapper* low = source + ( static_cast<ptrdiff_t>( begin ) + quotient );
+				if ( remainder == 0 )
+				{
+					for ( size_t chunk = begin; chunk < end; ++chunk, ++low )
+					{
+						destination[ chunk ].bits = combine( destination[ chunk ].bits, low->bits );
+					}
+				}
+				else
+				{
+					for ( size_t chunk = begin; chunk < end; ++chunk, ++low )
+					{
+						destination[ chunk ].bits = combine( destination[ chunk ].bits, ( low[ 0 ].bits >> remainder ) | ( low[ 1 ].bits << ( 32 - remainder ) ) );
+					}
+				}
+			};
+			auto apply_middle_backward = [ & ]( size_t begin, size_t end ) {
+				for ( size_t chunk = end; chunk > begin; --chunk )
+				{
+					const ptrdiff_t low = static_cast<ptrdiff_t>( chunk - 1 ) + quotient;
+					destination[ chunk - 1 ].bits = combine( destination[ chunk - 1 ].bits, funnel( source[ low ].bits, remainder == 0 ? 0 : source[ low + 1 ].bits ) );
+				}
+			};
+			auto store_masked = [ & ]( size_t chunk, uint32_t value, uint32_t mask ) {
+				const uint32_t current = destination[ chunk ].bits;
+				destination[ chunk ].bits = ( current & ~mask ) | ( combine( current, value ) & mask );
+			};
+
+			if ( first == last )
+			{
+				store_masked( first, edge_word( first ), mask_from( destination_pos ) & mask_through( destination_pos + length - 1 ) );
+				return;
+			}
+
+			// 同一个数组并且目标在源的后面时从高到低处理，保证每个源块在被覆盖之前读取
+			if ( destination == source && destination_pos > source_pos )
+			{
+				store_masked( last, edge_word( last ), mask_through( destination_pos + length - 1 ) );
+				apply_middle_backward( first + 1, last );
+				store_masked( first, edge_word( first ), mask_from( destination_pos ) );
+				return;
+			}
+
+			store_masked( first, edge_word( first ), mask_from( destination_pos ) );
+			apply_middle( first + 1, last );
+			store_masked( last, edge_word( last ), mask_through( destination_pos + length - 1 ) );
+		}
+
+		template <typename Position>
+		inline size_t to_positions_with( const BooleanBitWrapper* chunks, size_t count, Position* output ) noexcept
+		{
+			size_t written = 0;
+			for ( size_t i = 0; i < count; i += 2 )
+			{
+				uint64_t word = chunks[ i ].bits;
+				if ( i + 1 < count )
+				{
+					word |= uint64_t( chunks[ i + 1 ].bits ) << 32;
+				}
+				const Position base = static_cast<Position>( i * 32 );
+				while ( word != 0 )
+				{
+					output[ written++ ] = base + static_cast<Position>( count_trailing_zeros64( word ) );
+					word &= word - 1;
+				}
+			}
+			return written;
+		}
+
+		template <typename Position>
+		inline size_t set_positions_with( BooleanBitWrapper* chunks, const Position* positions, size_t count, size_t bit_limit ) noexcept
+		{
+			// 直接对目标块做 OR (比在寄存器中按块合并再写回更快：同一个块的几次更新之间只有 store forwarding 的延迟，
+			// 不同的块之间没有依赖)；停止的条件正常情况下从不成立，分支总是被正确预测
+			for ( size_t i = 0; i < count; ++i )
+			{
+				const size_t position = static_cast<size_t>( positions[ i ] );
+				if ( position >= bit_limit )
+				{
+					return i;
+				}
+				chunks[ position / 32 ].bits |= uint32_t( 1 ) << ( position % 32 );
+			}
+			return count;
+		}
+
+#if DYNAMIC_BITSET_MULTIVERSIONED
+		// 每 16 位：位置向量 base + { 0, 1, ..., 15 } 按掩码压缩到前面，再用掩码存储只写出有效的元素
+		__attribute__( ( target( "avx512f" ) ) ) size_t to_positions_avx512( const BooleanBitWrapper* chunks, size_t count, uint32_t* output ) noexcept
+		{
+			const __m512i lane_offsets = _mm512_setr_epi32( 0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15 );
+			size_t		  written = 0;
+			for ( size_t i = 0; i < count; ++i )
+			{
+				const uint32_t word = chunks[ i ].bits;
+				if ( word == 0 )
+				{
+					continue;
+				}
+				for ( unsigned half = 0; half < 2; ++half )
+				{
+					const __mmask16 mask = static_cast<__mmask16>( word >> ( half * 16 ) );
+					if ( mask == 0 )
+					{
+						continue;
+					}
+					const __m512i positions = _mm512_add_epi32( _mm512_set1_epi32( static_cast<int>( i * 32 + half * 16 ) ), lane_offsets );
+					const unsigned length = static_cast<unsigned>( __builtin_popcount( mask ) );
+					_mm512_mask_storeu_epi32( output + written, static_cast<__mmask16>( ( 1u << length ) - 1 ), _mm512_maskz_compress_epi32( mask, positions ) );
+					written += length;
+				}
+			}
+			return written;
+		}
+#endif
+
+		// 按宽度实例化 (FastPFor 的 fastpack / fastunpack 的方式)：块内每个值的位置都是编译期常量，
+		// 用折叠表达式完全展开之后只剩移位和或 (普通的循环不会被展开，移位量和是否跨越比特块都要在运行时计算)
+		template <unsigned Width, size_t Index>
+		inline void pack_value( uint32_t* words, uint32_t value ) noexcept
+		{
+			constexpr unsigned chunk = Index * Width / 32;
+			constexpr unsigned shift = Index * Width % 32;
+			value &= static_cast<uint32_t>( ~uint64_t( 0 ) >> ( 64 - Width ) );
+			words[ chunk ] |= value << shift;
+			if constexpr ( shift + Width > 32 )
+			{
+				words[ chunk + 1 ] |= value >> ( 32 - shift );
+			}
+		}
+
+		template <unsigned Width, size_t Index>
+		inline uint32_t unpack_value( const BooleanBitWrapper* input ) noexcept
+		{
+			constexpr unsigned chunk = Index * Width / 32;
+			constexpr unsigned shift = Index * Width % 32;
+			uint64_t		   window = input[ chunk ].bits;
+			if constexpr ( shift + Width > 32 )
+			{
+				window |= uint64_t( input[ chunk + 1 ].bits ) << 32;
+			}
+			return static_cast<uint32_t>( window >> shift ) & static_cast<uint32_t>( ~uint64_t( 0 ) >> ( 64 - Width ) );
+		}
+
+		template <unsigned Width, size_t... Indices>
+		void pack_blocks_width( BooleanBitWrapper* chunks, const uint32_t* values, size_t block_count, std::index_sequence<Indices...> ) noexcept
+		{
+			for ( size_t block = 0; block < block_count; ++block )
+			{
+				const uint32_t* input = values + block * 32;
+				uint32_t		words[ Width ] = {};
+				( pack_value<Width, Indices>( words, input[ Indices ] ), ... );
+				for ( unsigned i = 0; i < Width; ++i )
+				{
+					chunks[ block * Width + i ].bits = words[ i ];
+				}
+			}
+		}
+
+		template <unsigned Width, size_t... Indices>
+		void unpack_blocks_width( const BooleanBitWrapper* chunks, uint32_t* values, size_t block_count, std::index_sequence<Indices...> ) noexcept
+		{
+			for ( size_t block = 0; block < block_count; ++block )
+			{
+				const BooleanBitWrapper* input = chunks + block * Width;
+				uint32_t*				 output = values + block * 32;
+				( ( output[ Indices ] = unpack_value<Width, Indices>( input ) ), ... );
+			}
+		}
+
+		template <unsigned Width>
+		void pack_blocks_width( BooleanBitWrapper* chunks, const uint32_t* values, size_t block_count ) noexcept
+		{
+			pack_blocks_width<Width>( chunks, values, block_count, std::make_index_sequence<32> {} );
+		}
+
+		template <unsigned Width>
+		void unpack_blocks_width( const BooleanBitWrapper* chunks, uint32_t* values, size_t block_count ) noexcept
+		{
+			unpack_blocks_width<Width>( chunks, values, block_count, std::make_index_sequence<32> {} );
+		}
+
+		using PackKernel = void ( * )( BooleanBitWrapper*, const uint32_t*, size_t ) noexcept;
+		using UnpackKernel = void ( * )( const BooleanBitWrapper*, uint32_t*, size_t ) noexcept;
+
+		template <size_t... Widths>
+		constexpr std::array<PackKernel, sizeof...( Widths )> make_pack_kernels( std::index_sequence<Widths...> ) noexcept
+		{
+			return { { &pack_blocks_width<static_cast<unsigned>( Widths + 1 )>... } };
+		}
+
+		template <size_t... Widths>
+		constexpr std::array<UnpackKernel, sizeof...( Widths )> make_unpack_kernels( std::index_sequence<Widths...> ) noexcept
+		{
+			return { { &unpack_blocks_width<static_cast<unsigned>( Widths + 1 )>... } };
+		}
+
+		// 下标是 width - 1
+		constexpr std::array<PackKernel, 32>   pack_kernels = make_pack_kernels( std::make_index_sequence<32> {} );
+		constexpr std::array<UnpackKernel, 32> unpack_kernels = make_unpack_kernels( std::make_index_sequence<32> {} );
+
+#if DYNAMIC_BITSET_MULTIVERSIONED
+		/*
+			一块的 width 个比特块 (最多 32 个) 装在两个寄存器中。每次输出 16 个值：用 vpermt2d 把每个值所在的比特块 (low)
+			和下一个比特块 (high) 置换到它的通道，再 (low >> shift) | (high << (32 - shift)) 并取掩码。
+			移位量为 32 时 vpsllvd 的结果是 0，所以不跨越比特块的值不需要特殊处理。
+		*/
+		__attribute__( ( target( "avx512f" ) ) ) void unpack_blocks_avx512( const BooleanBitWrapper* chunks, uint32_t* values, size_t block_count, unsigned width ) noexcept
+		{
+			alignas( 64 ) uint32_t low_index[ 32 ];
+			alignas( 64 ) uint32_t high_index[ 32 ];
+			alignas( 64 ) uint32_t right_shift[ 32 ];
+			alignas( 64 ) uint32_t left_shift[ 32 ];
+			for ( unsigned i = 0; i < 32; ++i )
+			{
+				low_index[ i ] = i * width / 32;
+				high_index[ i ] = ( low_index[ i ] + 1 ) % 32;
+				right_shift[ i ] = i * width % 32;
+				left_shift[ i ] = 32 - right_shift[ i ];
+			}
+
+			__m512i low_indices[ 2 ], high_indices[ 2 ], right_shifts[ 2 ], left_shifts[ 2 ];
+			for ( unsigned half = 0; half < 2; ++half )
+			{
+				low_indices[ half ] = _mm512_load_si512( low_index + half * 16 );
+				high_indices[ half ] = _mm512_load_si512( high_index + half * 16 );
+				right_shifts[ half ] = _mm512_load_si512( right_shift + half * 16 );
+				left_shifts[ half ] = _mm512_load_si512( left_shift + half * 16 );
+			}
+			const __m512i	mask = _mm512_set1_epi32( static_cast<int>( ~uint64_t( 0 ) >> ( 64 - width ) ) );
+			const __mmask16 first_mask = static_cast<__mmask16>( width >= 16 ? 0xFFFF : ( 1u << width ) - 1 );
+			const __mmask16 second_mask = static_cast<__mmask16>( width > 16 ? ( 1u << ( width - 16 ) ) - 1 : 0 );
+
+			for ( size_t block = 0; block < block_count; ++block )
+			{
+				const BooleanBitWrapper* input = chunks + block * width;
+				const __m512i			 first = _mm512_maskz_loadu_epi32( first_mask, input );
+				const __m512i			 second = _mm512_maskz_loadu_epi32( second_mask, input + 16 );
+				for ( unsigned half = 0; half < 2; ++half )
+				{
+					const __m512i low = _mm512_permutex2var_epi32( first, low_indices[ half ], second );
+					const __m512i high = _mm512_permutex2var_epi32( first, high_indices[ half ], second );
+					const __m512i value = _mm512_or_si512( _mm512_srlv_epi32( low, right_shifts[ half ] ), _mm512_sllv_epi32( high, left_shifts[ half ] ) );
+					_mm512_storeu_si512( values + block * 32 + half * 16, _mm512_and_si512( value, mask ) );
+				}
+			}
+		}
+#endif
+
+		inline uint32_t ternary_minterms( uint32_t a, uint32_t b, uint32_t c, const uint32_t ( &minterm_masks )[ 8 ] ) noexcept
+		{
+			return ( ~a & ~b & ~c & minterm_masks[ 0 ] ) | ( ~a & ~b & c & minterm_masks[ 1 ] ) | ( ~a & b & ~c & minterm_masks[ 2 ] ) | ( ~a & b & c & minterm_masks[ 3 ] )
+				| ( a & ~b & ~c & minterm_masks[ 4 ] ) | ( a & ~b & c & minterm_masks[ 5 ] ) | ( a & b & ~c & minterm_masks[ 6 ] ) | ( a & b & c & minterm_masks[ 7 ] );
+		}
+
+#if DYNAMIC_BITSET_MULTIVERSIONED
+		// vpternlogd 的真值表必须是编译期常量，所以为 256 个真值表各实例化一个版本，运行时查表
+		template <int TruthTable>
+		__attribute__( ( target( "avx512f" ) ) ) void chunks_ternary_avx512( BooleanBitWrapper* destination, const BooleanBitWrapper* second, const BooleanBitWrapper* third, size_t count ) noexcept
+		{
+			size_t i = 0;
+			for ( ; i + 16 <= count; i += 16 )
+			{
+				const __m512i a = _mm512_loadu_si512( destination + i );
+				const __m512i b = _mm512_loadu_si512( second + i );
+				const __m512i c = _mm512_loadu_si512( third + i );
+				_mm512_storeu_si512( destination + i, _mm512_ternarylogic_epi32( a, b, c, TruthTable ) );
+			}
+			if ( i < count )
+			{
+				const __mmask16 mask = static_cast<__mmask16>( ( 1u << ( count - i ) ) - 1 );
+				const __m512i	a = _mm512_maskz_loadu_epi32( mask, destination + i );
+				const __m512i	b = _mm512_maskz_loadu_epi32( mask, second + i );
+				const __m512i	c = _mm512_maskz_loadu_epi32( mask, third + i );
+				_mm512_mask_storeu_epi32( destination + i, mask, _mm512_ternarylogic_epi32( a, b, c, TruthTable ) );
+			}
+		}
+
+		using TernaryKernel = void ( * )( BooleanBitWrapper*, const BooleanBitWrapper*, const BooleanBitWrapper*, size_t ) noexcept;
+
+		template <size_t... TruthTables>
+		constexpr std::array<TernaryKernel, sizeof...( TruthTables )> make_ternary_avx512_kernels( std::index_sequence<TruthTables...> ) noexcept
+		{
+			return { { &chunks_ternary_avx512<static_cast<int>( TruthTables )>... } };
+		}
+
+		constexpr std::array<TernaryKernel, 256> ternary_avx512_kernels = make_ternary_avx512_kernels( std::make_index_sequence<256> {} );
+#endif
+	}  // namespace
+
+	namespace kernel_detail
+	{
+		DYNAMIC_BITSET_TARGET_CLONES( "default", "avx2", "avx512f" )
+		void chunks_ternary_minterms( BooleanBitWrapper* destination, const BooleanBitWrapper* second, const BooleanBitWrapper* third, size_t count, uint8_t truth_table ) noexcept
+		{
+			uint32_t minterm_masks[ 8 ];
+			for ( unsigned minterm = 0; minterm < 8; ++minterm )
+			{
+				minterm_masks[ minterm ] = ( ( truth_table >> minterm ) & 1 ) ? 0xFFFFFFFF : 0;
+			}
+			for ( size_t i = 0; i < count; ++i )
+			{
+				destination[ i ].bits = ternary_minterms( destination[ i ].bits, second[ i ].bits, third[ i ].bits, minterm_masks );
+			}
+		}
+	}  // namespace kernel_detail
+
+	DYNAMIC_BITSET_TARGET_CLONES( "default", "avx2", "avx512f" )
+	void chunks_and( BooleanBitWrapper* destination, const BooleanBitWrapper* source, size_t count ) noexcept
+	{
+		for ( size_t i = 0; i < count; ++i )
+		{
+			destination[ i ].bits &= source[ i ].bits;
+		}
+	}
+
+	DYNAMIC_BITSET_TARGET_CLONES( "default", "avx2", "avx512f" )
+	void chunks_or( BooleanBitWrapper* destination, const BooleanBitWrapper* source, size_t count ) noexcept
+	{
+		for ( size_t i = 0; i < count; ++i )
+		{
+			destination[ i ].bits |= source[ i ].bits;
+		}
+	}
+
+	DYNAMIC_BITSET_TARGET_CLONES( "default", "avx2", "avx512f" )
+	void chunks_xor( BooleanBitWrapper* destination, const BooleanBitWrapper* source, size_t count ) noexcept
+	{
+		for ( size_t i = 0; i < count; ++i )
+		{
+			destination[ i ].bits ^= source[ i ].bits;
+		}
+	}
+
+	DYNAMIC_BITSET_TARGET_CLONES( "default", "avx2", "avx512f" )
+	void chunks_not( BooleanBitWrapper* destination, size_t count ) noexcept
+	{
+		for ( size_t i = 0; i < count; ++i )
+		{
+			destination[ i ].bits = ~destination[ i ].bits;
+		}
+	}
+
+	DYNAMIC_BITSET_TARGET_CLONES( "default", "popcnt" )
+	size_t chunks_population_count( const BooleanBitWrapper* chunks, size_t count ) noexcept
+	{
+		size_t total_count = 0;
+		for ( size_t i = 0; i < count; ++i )
+		{
+#if defined( __GNUC__ ) || defined( __clang__ )
+			total_count += static_cast<size_t>( __builtin_popcount( chunks[ i ].bits ) );
+#else
+			total_count += chunks[ i ].count_bits();
+#endif
+		}
+		return total_count;
+	}
+
+	DYNAMIC_BITSET_TARGET_CLONES( "default", "avx2", "avx512f" )
+	bool chunks_any( const BooleanBitWrapper* chunks, size_t count ) noexcept
+	{
+		for ( size_t begin = 0; begin < count; begin += early_exit_block_chunks )
+		{
+			const size_t end = std::min( count, begin + early_exit_block_chunks );
+			uint32_t	 accumulated = 0;
+			for ( size_t i = begin; i < end; ++i )
+			{
+				accumulated |= chunks[ i ].bits;
+			}
+			if ( accumulated != 0 )
+			{
+				return true;
+			}
+		}
+		return false;
+	}
+
+	DYNAMIC_BITSET_TARGET_CLONES( "default", "avx2", "avx512f" )
+	bool chunks_any_and( const BooleanBitWrapper* left, const BooleanBitWrapper* right, size_t count ) noexcept
+	{
+		for ( size_t begin = 0; begin < count; begin += early_exit_block_chunks )
+		{
+			const size_t end = std::min( count, begin + early_exit_block_chunks );
+			uint32_t	 accumulated = 0;
+			for ( size_t i = begin; i < end; ++i )
+			{
+				accumulated |= left[ i ].bits & right[ i ].bits;
+			}
+			if ( accumulated != 0 )
+			{
+				return true;
+			}
+		}
+		return false;
+	}
+
+	DYNAMIC_BITSET_TARGET_CLONES( "default", "avx2", "avx512f" )
+	bool chunks_any_and_not( const BooleanBitWrapper* left, const BooleanBitWrapper* right, size_t count ) noexcept
+	{
+		for ( size_t begin = 0; begin < count; begin += early_exit_block_chunks )
+		{
+			const size_t end = std::min( count, begin + early_exit_block_chunks );
+			uint32_t	 accumulated = 0;
+			for ( size_t i = begin; i < end; ++i )
+			{
+				accumulated |= left[ i ].bits & ~right[ i ].bits;
+			}
+			if ( accumulated != 0 )
+			{
+				return true;
+			}
+		}
+		return false;
+	}
+
+	DYNAMIC_BITSET_TARGET_CLONES( "default", "avx2", "avx512f" )
+	size_t chunks_find_last_difference( const BooleanBitWrapper* left, const BooleanBitWrapper* right, size_t count ) noexcept
+	{
+		for ( size_t end = count; end > 0; )
+		{
+			const size_t begin = end > early_exit_block_chunks ? end - early_exit_block_chunks : 0;
+			uint32_t	 difference = 0;
+			for ( size_t i = begin; i < end; ++i )
+			{
+				difference |= left[ i ].bits ^ right[ i ].bits;
+			}
+			if ( difference != 0 )
+			{
+				for ( size_t i = end; i > begin; --i )
+				{
+					if ( left[ i - 1 ].bits != right[ i - 1 ].bits )
+					{
+						return i - 1;
+					}
+				}
+			}
+			end = begin;
+		}
+		return count;
+	}
+
+	DYNAMIC_BITSET_TARGET_CLONES( "default", "avx2", "avx512f" )
+	void chunks_and_not( BooleanBitWrapper* destination, const BooleanBitWrapper* source, size_t count ) noexcept
+	{
+		for ( size_t i = 0; i < count; ++i )
+		{
+			destination[ i ].bits &= ~source[ i ].bits;
+		}
+	}
+
+	DYNAMIC_BITSET_TARGET_CLONES( "default", "avx2", "avx512f" )
+	void chunks_or_not( BooleanBitWrapper* destination, const BooleanBitWrapper* source, size_t count ) noexcept
+	{
+		for ( size_t i = 0; i < count; ++i )
+		{
+			destination[ i ].bits |= ~source[ i ].bits;
+		}
+	}
+
+	DYNAMIC_BITSET_TARGET_CLONES( "default", "avx2", "avx512f" )
+	void chunks_xnor( BooleanBitWrapper* destination, const BooleanBitWrapper* source, size_t count ) noexcept
+	{
+		for ( size_t i = 0; i < count; ++i )
+		{
+			destination[ i ].bits = ~( destination[ i ].bits ^ source[ i ].bits );
+		}
+	}
+
+	void chunks_ternary( BooleanBitWrapper* destination, const BooleanBitWrapper* second, const BooleanBitWrapper* third, size_t count, uint8_t truth_table ) noexcept
+	{
+#if DYNAMIC_BITSET_MULTIVERSIONED
+		if ( __builtin_cpu_supports( "avx512f" ) )
+		{
+			ternary_avx512_kernels[ truth_table ]( destination, second, third, count );
+			return;
+		}
+#endif
+		kernel_detail::chunks_ternary_minterms( destination, second, third, count, truth_table );
+	}
+
+	DYNAMIC_BITSET_TARGET_CLONES( "default", "avx2", "avx512f" )
+	void chunks_or_many( BooleanBitWrapper* destination, const BooleanBitWrapper* const* sources, const size_t* lengths, size_t source_count, size_t count ) noexcept
+	{
+		for ( size_t begin = 0; begin < count; begin += register_block_chunks )
+		{
+			const size_t block = std::min( register_block_chunks, count - begin );
+			uint32_t	 accumulated[ register_block_chunks ] = {};
+			for ( size_t source = 0; source < source_count; ++source )
+			{
+				if ( lengths[ source ] <= begin )
+				{
+					continue;
+				}
+				const BooleanBitWrapper* chunks = sources[ source ] + begin;
+				const size_t			 available = std::min( block, lengths[ source ] - begin );
+				if ( available == register_block_chunks )
+				{
+					for ( size_t i = 0; i < register_block_chunks; ++i )
+					{
+						accumulated[ i ] |= chunks[ i ].bits;
+					}
+				}
+				else
+				{
+					for ( size_t i = 0; i < available; ++i )
+					{
+						accumulated[ i ] |= chunks[ i ].bits;
+					}
+				}
+			}
+			for ( size_t i = 0; i < block; ++i )
+			{
+				destination[ begin + i ].bits = accumulated[ i ];
+			}
+		}
+	}
+
+	DYNAMIC_BITSET_TARGET_CLONES( "default", "avx2", "avx512f" )
+	void chunks_and_many( BooleanBitWrapper* destination, const BooleanBitWrapper* const* sources, size_t source_count, size_t count ) noexcept
+	{
+		for ( size_t begin = 0; begin < count; begin += register_block_chunks )
+		{
+			const size_t block = std::min( register_block_chunks, count - begin );
+			uint32_t	 accumulated[ register_block_chunks ];
+			for ( size_t i = 0; i < block; ++i )
+			{
+				accumulated[ i ] = sources[ 0 ][ begin + i ].bits;
+			}
+			for ( size_t source = 1; source < source_count; ++source )
+			{
+				const BooleanBitWrapper* chunks = sources[ source ] + begin;
+				if ( block == register_block_chunks )
+				{
+					for ( size_t i = 0; i < register_block_chunks; ++i )
+					{
+						accumulated[ i ] &= chunks[ i ].bits;
+					}
+				}
+				else
+				{
+					for ( size_t i = 0; i < block; ++i )
+					{
+						accumulated[ i ] &= chunks[ i ].bits;
+					}
+				}
+			}
+			for ( size_t i = 0; i < block; ++i )
+			{
+				destination[ begin + i ].bits = accumulated[ i ];
+			}
+		}
+	}
+
+	DYNAMIC_BITSET_TARGET_CLONES( "default", "avx2", "avx512f" )
+	void chunks_threshold( BooleanBitWrapper* destination, const BooleanBitWrapper* const* sources, const size_t* lengths, size_t source_count, size_t count, size_t threshold ) noexcept
+	{
+		if ( threshold == 0 || threshold > source_count )
+		{
+			std::fill( destination, destination + count, BooleanBitWrapper( threshold == 0 ? 0xFFFFFFFF : 0 ) );
+			return;
+		}
+
+		// 每个比特位置的计数 (0 .. source_count) 按位切片保存在 plane_count 个平面中：planes[ p ][ i ] 的第 b 位是块 i 第 b 位计数的第 p 位
+		size_t plane_count = 0;
+		while ( plane_count < maximum_counter_planes && ( source_count >> plane_count ) != 0 )
+		{
+			++plane_count;
+		}
+
+		uint32_t planes[ maximum_counter_planes ][ register_block_chunks ];
+		for ( size_t begin = 0; begin < count; begin += register_block_chunks )
+		{
+			const size_t block = std::min( register_block_chunks, count - begin );
+			for ( size_t plane = 0; plane < plane_count; ++plane )
+			{
+				std::fill( planes[ plane ], planes[ plane ] + block, 0u );
+			}
+
+			// 逐个操作数做按位切片的加法 (行波进位)
+			for ( size_t source = 0; source < source_count; ++source )
+			{
+				if ( lengths[ source ] <= begin )
+				{
+					continue;
+				}
+				const BooleanBitWrapper* chunks = sources[ source ] + begin;
+				const size_t			 available = std::min( block, lengths[ source ] - begin );
+
+				uint32_t carry[ register_block_chunks ];
+				for ( size_t i = 0; i < available; ++i )
+				{
+					carry[ i ] = chunks[ i ].bits;
+				}
+				for ( size_t plane = 0; plane < plane_count; ++plane )
+				{
+					uint32_t any_carry = 0;
+					for ( size_t i = 0; i < available; ++i )
+					{
+						const uint32_t current = planes[ plane ][ i ];
+						planes[ plane ][ i ] = current ^ carry[ i ];
+						carry[ i ] &= current;
+						any_carry |= carry[ i ];
+					}
+					if ( any_carry == 0 )
+					{
+						break;
+					}
+				}
+			}
+
+			// 按位切片比较 count >= threshold，从最高的平面开始
+			for ( size_t i = 0; i < block; ++i )
+			{
+				uint32_t greater = 0;
+				uint32_t equal = 0xFFFFFFFF;
+				for ( size_t plane = plane_count; plane > 0; --plane )
+				{
+					const uint32_t threshold_bit = ( ( threshold >> ( plane - 1 ) ) & 1 ) ? 0xFFFFFFFF : 0;
+					const uint32_t value = planes[ plane - 1 ][ i ];
+					greater |= equal & value & ~threshold_bit;
+					equal &= ~( value ^ threshold_bit );
+				}
+				destination[ begin + i ].bits = greater | equal;
+			}
+		}
+	}
+
+	DYNAMIC_BITSET_TARGET_CLONES( "default", "avx2", "avx512f" )
+	void bits_apply_range( BitRangeOperation operation, BooleanBitWrapper* destination, size_t destination_pos, const BooleanBitWrapper* source, size_t source_pos, size_t length ) noexcept
+	{
+		if ( length == 0 )
+		{
+			return;
+		}
+
+		// 运算在循环之外选择，每一种都是单独实例化的循环
+		switch ( operation )
+		{
+			case BitRangeOperation::Copy:
+				apply_range_with( []( uint32_t, uint32_t value ) { return value; }, destination, destination_pos, source, source_pos, length );
+				break;
+			case BitRangeOperation::And:
+				apply_range_with( []( uint32_t current, uint32_t value ) { return current & value; }, destination, destination_pos, source, source_pos, length );
+				break;
+			case BitRangeOperation::Or:
+				apply_range_with( []( uint32_t current, uint32_t value ) { return current | value; }, destination, destination_pos, source, source_pos, length );
+				break;
+			case BitRangeOperation::Xor:
+				apply_range_with( []( uint32_t current, uint32_t value ) { return current ^ value; }, destination, destination_pos, source, source_pos, length );
+				break;
+			case BitRangeOperation::AndNot:
+				apply_range_with( []( uint32_t current, uint32_t value ) { return current & ~value; }, destination, destination_pos, source, source_pos, length );
+				break;
+		}
+	}
+
+	void bits_assign_range( BooleanBitWrapper* chunks, size_t pos, size_t length, bool value ) noexcept
+	{
+		if ( length == 0 )
+		{
+			return;
+		}
+
+		const size_t   first = pos / 32;
+		const size_t   last = ( pos + length - 1 ) / 32;
+		const uint32_t fill = value ? 0xFFFFFFFF : 0x00000000;
+		auto		   assign_masked = [ chunks, fill ]( size_t chunk, uint32_t mask ) { chunks[ chunk ].bits = ( chunks[ chunk ].bits & ~mask ) | ( fill & mask ); };
+		if ( first == last )
+		{
+			assign_masked( first, mask_from( pos ) & mask_through( pos + length - 1 ) );
+			return;
+		}
+		assign_masked( first, mask_from( pos ) );
+		std::fill( chunks + first + 1, chunks + last, BooleanBitWrapper( fill ) );
+		assign_masked( last, mask_through( pos + length - 1 ) );
+	}
+
+	size_t bits_population_count( const BooleanBitWrapper* chunks, size_t pos, size_t length ) noexcept
+	{
+		if ( length == 0 )
+		{
+			return 0;
+		}
+
+		const size_t first = pos / 32;
+		const size_t last = ( pos + length - 1 ) / 32;
+		if ( first == last )
+		{
+			return population_count64( chunks[ first ].bits & mask_from( pos ) & mask_through( pos + length - 1 ) );
+		}
+		return population_count64( chunks[ first ].bits & mask_from( pos ) ) + chunks_population_count( chunks + first + 1, last - first - 1 )
+			+ population_count64( chunks[ last ].bits & mask_through( pos + length - 1 ) );
+	}
+
+	size_t bits_find_next( const BooleanBitWrapper* chunks, size_t pos, size_t end ) noexcept
+	{
+		if ( pos >= end )
+		{
+			return end;
+		}
+
+		const size_t last = ( end - 1 ) / 32;
+		size_t		 chunk = pos / 32;
+		uint32_t	 word = chunks[ chunk ].bits & mask_from( pos );
+		while ( true )
+		{
+			if ( chunk == last )
+			{
+				word &= mask_through( end - 1 );
+			}
+			if ( word != 0 )
+			{
+				return chunk * 32 + count_trailing_zeros64( word );
+			}
+			if ( chunk == last )
+			{
+				return end;
+			}
+
+			// 中间的块按组跳过全零的部分 (与 chunks_any 相同的分组)
+			++chunk;
+			while ( chunk < last )
+			{
+				const size_t group_end = std::min( last, chunk + early_exit_block_chunks );
+				if ( chunks_any( chunks + chunk, group_end - chunk ) )
+				{
+					break;
+				}
+				chunk = group_end;
+			}
+			word = chunks[ chunk ].bits;
+		}
+	}
+
+	DYNAMIC_BITSET_TARGET_CLONES( "default", "popcnt" )
+	size_t bits_select( const BooleanBitWrapper* chunks, size_t pos, size_t rank, bool ones ) noexcept
+	{
+		// 数比特'0'时把每个块取反
+		const uint32_t flip = ones ? 0 : 0xFFFFFFFF;
+		size_t		   chunk = pos / 32;
+		uint32_t	   word = ( chunks[ chunk ].bits ^ flip ) & mask_from( pos );
+		while ( true )
+		{
+			const uint32_t count = population_count64( word );
+			if ( rank < count )
+			{
+				return chunk * 32 + select_in_word64( word, static_cast<uint32_t>( rank ) );
+			}
+			rank -= count;
+			word = chunks[ ++chunk ].bits ^ flip;
+		}
+	}
+
+	size_t chunks_to_positions( const BooleanBitWrapper* chunks, size_t count, uint32_t* output ) noexcept
+	{
+#if DYNAMIC_BITSET_MULTIVERSIONED
+		if ( __builtin_cpu_supports( "avx512f" ) )
+		{
+			return to_positions_avx512( chunks, count, output );
+		}
+#endif
+		return to_positions_with( chunks, count, output );
+	}
+
+	size_t chunks_to_positions( const BooleanBitWrapper* chunks, size_t count, uint64_t* output ) noexcept
+	{
+		return to_positions_with( chunks, count, output );
+	}
+
+	size_t chunks_set_positions( BooleanBitWrapper* chunks, const uint32_t* positions, size_t count, size_t bit_limit ) noexcept
+	{
+		return set_positions_with( chunks, positions, count, bit_limit );
+	}
+
+	size_t chunks_set_positions( BooleanBitWrapper* chunks, const uint64_t* positions, size_t count, size_t bit_limit ) noexcept
+	{
+		return set_positions_with( chunks, positions, count, bit_limit );
+	}
+
+	void chunks_pack_blocks( BooleanBitWrapper* chunks, const uint32_t* values, size_t block_count, unsigned width ) noexcept
+	{
+		pack_kernels[ width - 1 ]( chunks, values, block_count );
+	}
+
+	void chunks_unpack_blocks( const BooleanBitWrapper* chunks, uint32_t* values, size_t block_count, unsigned width ) noexcept
+	{
+#if DYNAMIC_BITSET_MULTIVERSIONED
+		if ( __builtin_cpu_supports( "avx512f" ) )
+		{
+			unpack_blocks_avx512( chunks, values, block_count, width );
+			return;
+		}
+#endif
+		unpack_kernels[ width - 1 ]( chunks, values, block_count );
+	}
+}  // namespace TwilightDream
@@ -0,0 +1,148 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+#include "BooleanBitWrapper.hpp"
+
+/*
+	比特块的热点内核 (Hot chunk kernels)
+	DynamicBitSet 的批量按位运算和汉明权重都落在这几个循环上。它们单独编译在 DynamicBitSetKernels.cpp 中，
+	在 GCC + x86 + Linux 上用 target_clones 生成 default / AVX2 / AVX-512 (popcount 为 default / POPCNT) 几个版本，
+	程序加载时由 ifunc 根据 CPU 选择，这样不开 -march=native 的发布版本也能用上宽向量。
+	定义 LARGE_DYNAMIC_BITSET_NO_TARGET_CLONES (CMake 选项 LARGE_DYNAMIC_BITSET_TARGET_CLONES=OFF) 可以关闭多版本。
+*/
+
+#if defined( __GNUC__ ) && !defined( __clang__ ) && ( defined( __x86_64__ ) || defined( __i386__ ) ) && defined( __linux__ ) && !defined( LARGE_DYNAMIC_BITSET_NO_TARGET_CLONES )
+#define DYNAMIC_BITSET_TARGET_CLONES( ... ) __attribute__( ( target_clones( __VA_ARGS__ ) ) )
+#define DYNAMIC_BITSET_MULTIVERSIONED 1
+#else
+#define DYNAMIC_BITSET_TARGET_CLONES( ... )
+#define DYNAMIC_BITSET_MULTIVERSIONED 0
+#endif
+
+namespace TwilightDream
+{
+	// destination[ i ] &= source[ i ]，i < count
+	void chunks_and( BooleanBitWrapper* destination, const BooleanBitWrapper* source, size_t count ) noexcept;
+
+	// destination[ i ] |= source[ i ]，i < count
+	void chunks_or( BooleanBitWrapper* destination, const BooleanBitWrapper* source, size_t count ) noexcept;
+
+	// destination[ i ] ^= source[ i ]，i < count
+	void chunks_xor( BooleanBitWrapper* destination, const BooleanBitWrapper* source, size_t count ) noexcept;
+
+	// destination[ i ] = ~destination[ i ]，i < count
+	void chunks_not( BooleanBitWrapper* destination, size_t count ) noexcept;
+
+	// destination[ i ] &= ~source[ i ]，i < count
+	void chunks_and_not( BooleanBitWrapper* destination, const BooleanBitWrapper* source, size_t count ) noexcept;
+
+	// destination[ i ] |= ~source[ i ]，i < count
+	void chunks_or_not( BooleanBitWrapper* destination, const BooleanBitWrapper* source, size_t count ) noexcept;
+
+	// destination[ i ] = ~( destination[ i ] ^ source[ i ] )，i < count
+	void chunks_xnor( BooleanBitWrapper* destination, const BooleanBitWrapper* source, size_t count ) noexcept;
+
+	/*
+		任意的三输入布尔函数 (与 AVX-512 的 vpternlogd 相同的真值表约定)：
+		对每个比特，结果是 truth_table 的第 ( a << 2 ) | ( b << 1 ) | c 位，a、b、c 分别来自 destination、second、third。
+		支持 AVX-512F 的 CPU 上每 16 个块只需要一条 vpternlogd，否则按 8 个最小项展开。
+	*/
+	namespace ternary_function
+	{
+		constexpr uint8_t majority = 0xE8;		 // 至少两个为 1
+		constexpr uint8_t select = 0xCA;		 // a ? b : c
+		constexpr uint8_t exclusive_or = 0x96;	 // a ^ b ^ c
+		constexpr uint8_t and_or = 0xF8;		 // a | ( b & c )
+	}  // namespace ternary_function
+
+	// destination[ i ] = f( destination[ i ], second[ i ], third[ i ] )，i < count
+	void chunks_ternary( BooleanBitWrapper* destination, const BooleanBitWrapper* second, const BooleanBitWrapper* third, size_t count, uint8_t truth_table ) noexcept;
+
+	/*
+		多操作数内核：输出按块 (block) 分段，每段只写一次，所有操作数各自只读一遍。
+		sources[ j ] 只有 lengths[ j ] 个块，超出的部分视为 0。
+	*/
+
+	// destination[ i ] = OR( sources[ j ][ i ] )，i < count (destination 不参与运算，直接被覆盖)
+	void chunks_or_many( BooleanBitWrapper* destination, const BooleanBitWrapper* const* sources, const size_t* lengths, size_t source_count, size_t count ) noexcept;
+
+	// destination[ i ] = AND( sources[ j ][ i ] )，i < count，要求每个 lengths[ j ] >= count，source_count > 0
+	void chunks_and_many( BooleanBitWrapper* destination, const BooleanBitWrapper* const* sources, size_t source_count, size_t count ) noexcept;
+
+	// 比特在至少 threshold 个 sources 中为 1 时结果为 1 (按位切片的计数器，即"垂直计数")
+	void chunks_threshold( BooleanBitWrapper* destination, const BooleanBitWrapper* const* sources, const size_t* lengths, size_t source_count, size_t count, size_t threshold ) noexcept;
+
+	// 统计 chunks[ 0, count ) 中比特'1'的数量
+	size_t chunks_population_count( const BooleanBitWrapper* chunks, size_t count ) noexcept;
+
+	/*
+		比较 / 测试内核：按 16 个块一组先用可以向量化的 OR 归约判断这一组是否命中，命中后才在组内逐块查找，
+		所以既能用上宽向量，又能在第一个命中的组提前退出，不会生成临时的结果数组。
+	*/
+
+	// chunks[ 0, count ) 中是否有比特'1'
+	bool chunks_any( const BooleanBitWrapper* chunks, size_t count ) noexcept;
+
+	// 是否存在 left[ i ] & right[ i ] != 0
+	bool chunks_any_and( const BooleanBitWrapper* left, const BooleanBitWrapper* right, size_t count ) noexcept;
+
+	// 是否存在 left[ i ] & ~right[ i ] != 0 (left 不是 right 的子集)
+	bool chunks_any_and_not( const BooleanBitWrapper* left, const BooleanBitWrapper* right, size_t count ) noexcept;
+
+	// 从最高的块向下查找第一个 left[ i ] != right[ i ] 的索引，全部相同时返回 count
+	size_t chunks_find_last_difference( const BooleanBitWrapper* left, const BooleanBitWrapper* right, size_t count ) noexcept;
+
+	/*
+		按比特偏移的范围内核：参数是比特的位置而不是块的索引。
+		bits_apply_range 把 source 的比特 [ source_pos, source_pos + length ) 对齐到 destination 的比特 [ destination_pos, destination_pos + length ) 上运算。
+		两边的偏移之差是固定的，所以每个目标块由相邻两个源块拼成 64 位再右移同样的位数得到 (funnel shift)，
+		代价是 O( length / 32 )，与偏移是否对齐无关。只读写范围覆盖的块，两端不完整的块用掩码保留范围之外的比特。
+	*/
+	enum class BitRangeOperation : uint8_t
+	{
+		Copy,
+		And,
+		Or,
+		Xor,
+		AndNot
+	};
+
+	// destination 与 source 可以是同一个数组并且范围重叠，结果与先把源范围复制出来再运算相同；length 为 0 时什么都不做
+	void bits_apply_range( BitRangeOperation operation, BooleanBitWrapper* destination, size_t destination_pos, const BooleanBitWrapper* source, size_t source_pos, size_t length ) noexcept;
+
+	// 把比特 [ pos, pos + length ) 全部设为 value，两端不完整的块保留范围之外的比特；length 为 0 时什么都不做
+	void bits_assign_range( BooleanBitWrapper* chunks, size_t pos, size_t length, bool value ) noexcept;
+
+	// 比特 [ pos, pos + length ) 中比特'1'的数量
+	size_t bits_population_count( const BooleanBitWrapper* chunks, size_t pos, size_t length ) noexcept;
+
+	// [ pos, end ) 中第一个比特'1'的位置，没有时返回 end
+	size_t bits_find_next( const BooleanBitWrapper* chunks, size_t pos, size_t end ) noexcept;
+
+	// 从比特 pos 开始 (包含 pos) 的第 rank 个 (从 0 开始) 比特'1'的位置，ones 为 false 时数比特'0'；调用者必须保证它存在
+	size_t bits_select( const BooleanBitWrapper* chunks, size_t pos, size_t rank, bool ones ) noexcept;
+
+	/*
+		位置列表的转换内核 (倒排索引的 posting list 与比特集之间的转换)。
+		chunks_to_positions 按 64 位的字用 tzcnt 循环输出比特'1'的位置；支持 AVX-512 时 32 位的输出每 16 位用一条 vpcompressd 输出，
+		output 至少要有 chunks_population_count( chunks, count ) 个元素 (不会写出更多)，返回写入的数量。
+		chunks_set_positions 按顺序把 positions 中的位置设为'1'，遇到第一个不小于 bit_limit 的位置时停止，返回已经处理的数量
+		(没有逐个的函数调用；输入是升序时对目标块的访问是顺序的)。
+	*/
+	size_t chunks_to_positions( const BooleanBitWrapper* chunks, size_t count, uint32_t* output ) noexcept;
+	size_t chunks_to_positions( const BooleanBitWrapper* chunks, size_t count, uint64_t* output ) noexcept;
+
+	size_t chunks_set_positions( BooleanBitWrapper* chunks, const uint32_t* positions, size_t count, size_t bit_limit ) noexcept;
+	size_t chunks_set_positions( BooleanBitWrapper* chunks, const uint64_t* positions, size_t count, size_t bit_limit ) noexcept;
+
+	/*
+		定宽整数的打包内核 (见 PackedIntArray.hpp)：每块 32 个 width 位 (1 <= width <= 32) 的值正好占 width 个比特块，
+		第 i 个值占块内的比特 [ i * width, i * width + width )。
+		chunks_pack_blocks 覆盖写 chunks[ 0, block_count * width )，只保留每个值的低 width 位；
+		chunks_unpack_blocks 输出 block_count * 32 个值。两者都按宽度分派到展开的循环，支持 AVX-512 时 unpack 用置换指令一次取出 16 个值。
+	*/
+	void chunks_pack_blocks( BooleanBitWrapper* chunks, const uint32_t* values, size_t block_count, unsigned width ) noexcept;
+	void chunks_unpack_blocks( const BooleanBitWrapper* chunks, uint32_t* values, size_t block_count, unsigned width ) noexcept;
+}  // namespace TwilightDream
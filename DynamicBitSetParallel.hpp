@@ -0,0 +1,164 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+#include <vector>
+#include <algorithm>
+
+#include <exception>
+#include <thread>
+#include <utility>
+#include <type_traits>
+
+#include "BooleanBitWrapper.hpp"
+
+namespace TwilightDream
+{
+	/*
+		并行执行策略 (Parallel execution policy)
+		作为 DynamicBitSet 批量操作的额外参数传入，用来选择多线程版本的实现。
+		比特块向量会被切分成按 cache line 对齐的区间，每个线程处理一个区间；数据量太小时直接在调用线程上执行。
+	*/
+	struct ParallelExecution
+	{
+		// 线程数量，0 表示使用 std::thread::hardware_concurrency()
+		size_t thread_count = 0;
+
+		// 每个线程至少处理的比特块数量 (65536 个 32 位块 = 256 KiB)，避免小数据集上创建线程的开销大于收益
+		size_t minimum_chunks_per_thread = 65536;
+
+		ParallelExecution() = default;
+
+		explicit ParallelExecution( size_t thread_count, size_t minimum_chunks_per_thread = 65536 )
+			: thread_count( thread_count ), minimum_chunks_per_thread( minimum_chunks_per_thread )
+		{}
+
+		// 计算处理 chunk_count 个比特块实际需要的线程数量 (至少为 1)
+		size_t resolve_thread_count( size_t chunk_count ) const noexcept
+		{
+			size_t threads = thread_count;
+			if ( threads == 0 )
+			{
+				threads = std::thread::hardware_concurrency();
+			}
+			if ( threads == 0 )
+			{
+				threads = 1;
+			}
+
+			const size_t minimum_chunks = std::max<size_t>( minimum_chunks_per_thread, 1 );
+			const size_t useful_threads = std::max<size_t>( chunk_count / minimum_chunks, 1 );
+			return std::min( threads, useful_threads );
+		}
+	};
+
+	// 一条 cache line (64 字节) 中包含的比特块数量，用于对齐每个线程的区间边界，防止相邻线程写同一条 cache line
+	constexpr size_t parallel_chunk_alignment = 64 / sizeof( BooleanBitWrapper );
+
+	namespace parallel_detail
+	{
+		// 离开作用域时 join 所有已经启动的线程：创建后面的线程失败时，已经启动的 std::thread 不会在可 join 的状态下被销毁 (std::terminate)
+		class ThreadJoinGuard
+		{
+		public:
+			explicit ThreadJoinGuard( std::vector<std::thread>& threads ) noexcept : threads( threads ) {}
+
+			ThreadJoinGuard( const ThreadJoinGuard& ) = delete;
+			ThreadJoinGuard& operator=( const ThreadJoinGuard& ) = delete;
+
+			~ThreadJoinGuard()
+			{
+				for ( auto& thread : threads )
+				{
+					if ( thread.joinable() )
+					{
+						thread.join();
+					}
+				}
+			}
+
+		private:
+			std::vector<std::thread>& threads;
+		};
+	}  // namespace parallel_detail
+
+	/*
+		把比特块区间 [0, chunk_count) 切分为按 cache line 对齐的若干段，
+		并行调用 function( begin_chunk, end_chunk, part_index )。最后一段由调用线程执行。
+		返回实际使用的分段数量 (part_index 的取值范围为 [0, 返回值))。
+		function 抛出的异常在所有线程结束之后重新抛出 (有多段抛出时取 part_index 最小的一个)；
+		创建线程失败时已经启动的线程先结束，然后抛出 std::system_error。两种情况下其余的段可能已经执行了一部分。
+	*/
+	template <typename Function>
+	size_t parallel_for_chunk_ranges( const ParallelExecution& execution, size_t chunk_count, Function&& function )
+	{
+		const size_t part_count = execution.resolve_thread_count( chunk_count );
+		if ( part_count <= 1 )
+		{
+			function( size_t( 0 ), chunk_count, size_t( 0 ) );
+			return 1;
+		}
+
+		// 每段的长度向上取整到 cache line 的整数倍
+		size_t part_length = ( chunk_count + part_count - 1 ) / part_count;
+		part_length = ( part_length + parallel_chunk_alignment - 1 ) / parallel_chunk_alignment * parallel_chunk_alignment;
+
+		// 每段的异常保存在自己的位置上，不能从线程函数中逃逸 (否则 std::terminate)
+		std::vector<std::exception_ptr> errors( part_count );
+		auto run_part = [ &function, &errors ]( size_t begin, size_t end, size_t part_index ) noexcept {
+			try
+			{
+				function( begin, end, part_index );
+			}
+			catch ( ... )
+			{
+				errors[ part_index ] = std::current_exception();
+			}
+		};
+
+		std::vector<std::thread> workers;
+		workers.reserve( part_count - 1 );
+
+		size_t part_index = 0;
+		{
+			parallel_detail::ThreadJoinGuard join_guard( workers );
+
+			size_t begin = 0;
+			for ( ; begin + part_length < chunk_count; begin += part_length, ++part_index )
+			{
+				workers.emplace_back( run_part, begin, begin + part_length, part_index );
+			}
+			run_part( begin, chunk_count, part_index );
+		}
+
+		for ( const auto& error : errors )
+		{
+			if ( error )
+			{
+				std::rethrow_exception( error );
+			}
+		}
+
+		return part_index + 1;
+	}
+
+	/*
+		并行归约：每一段计算出一个部分结果 partial_function( begin_chunk, end_chunk ) -> Value，
+		然后在调用线程上用 reduce_function( accumulated, partial ) 合并。
+	*/
+	template <typename Value, typename PartialFunction, typename ReduceFunction>
+	Value parallel_reduce_chunk_ranges( const ParallelExecution& execution, size_t chunk_count, Value initial_value, PartialFunction&& partial_function, ReduceFunction&& reduce_function )
+	{
+		std::vector<Value> partial_results( execution.resolve_thread_count( chunk_count ), initial_value );
+
+		const size_t part_count = parallel_for_chunk_ranges( execution, chunk_count, [ & ]( size_t begin, size_t end, size_t part_index ) { partial_results[ part_index ] = partial_function( begin, end ); } );
+
+		Value result = initial_value;
+		for ( size_t i = 0; i < part_count; ++i )
+		{
+			result = reduce_function( result, partial_results[ i ] );
+		}
+		return result;
+	}
+}  // namespace TwilightDream
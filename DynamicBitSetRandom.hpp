@@ -0,0 +1,212 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+#include <algorithm>
+#include <limits>
+#include <random>
+#include <type_traits>
+#include <utility>
+
+#include "BooleanBitWrapper.hpp"
+
+namespace TwilightDream
+{
+	/*
+		随机比特的生成 (Random fill)
+		DynamicBitSet::fill_random / fill_bernoulli 使用的生成器和填充循环。
+		- 每次从生成器取一个 64 位的字写入两个比特块，而不是每一位调用一次 std::uniform_int_distribution。
+		- Bernoulli(p) 用按位切片的比较：64 路同时比较 64 位的均匀随机数 U 与 p * 2^64，
+		  从最高位开始逐位比较，所有的路都分出大小就停止，平均每 64 个输出比特只需要大约 8 个随机字，与 p 无关。
+	*/
+
+	/*
+		Generator 是否满足 UniformRandomBitGenerator (C++20 的 std::uniform_random_bit_generator)：
+		无符号整数的 result_type，静态的 min() / max() 和 operator() 都返回 result_type。
+		DynamicBitSet::fill_random / fill_bernoulli 的生成器模板用它约束，所以传入整数的左值时选择使用种子的重载。
+	*/
+	template <typename Generator, typename = void>
+	struct is_uniform_random_bit_generator : std::false_type
+	{
+	};
+
+	template <typename Generator>
+	struct is_uniform_random_bit_generator<Generator, std::void_t<typename Generator::result_type, decltype( Generator::min() ), decltype( Generator::max() ), decltype( std::declval<Generator&>()() )>>
+		: std::bool_constant<std::is_unsigned_v<typename Generator::result_type> && std::is_same_v<decltype( Generator::min() ), typename Generator::result_type>
+							 && std::is_same_v<decltype( Generator::max() ), typename Generator::result_type> && std::is_same_v<decltype( std::declval<Generator&>()() ), typename Generator::result_type>>
+	{
+	};
+
+	template <typename Generator>
+	constexpr bool is_uniform_random_bit_generator_v = is_uniform_random_bit_generator<Generator>::value;
+
+	// splitmix64：用于从一个种子展开生成器的状态
+	inline uint64_t splitmix64( uint64_t& state ) noexcept
+	{
+		uint64_t value = ( state += 0x9E3779B97F4A7C15ULL );
+		value = ( value ^ ( value >> 30 ) ) * 0xBF58476D1CE4E5B9ULL;
+		value = ( value ^ ( value >> 27 ) ) * 0x94D049BB133111EBULL;
+		return value ^ ( value >> 31 );
+	}
+
+	/*
+		xoshiro256** (Blackman & Vigna)：满足 UniformRandomBitGenerator，每次调用输出 64 位，
+		状态只有 32 字节，每个字只需要几条移位、循环移位和乘法指令。
+	*/
+	class Xoshiro256
+	{
+	public:
+		using result_type = uint64_t;
+
+		explicit Xoshiro256( uint64_t seed = 0 ) noexcept
+		{
+			for ( auto& word : state )
+			{
+				word = splitmix64( seed );
+			}
+		}
+
+		// 由 ( seed, stream ) 决定的序列，不同的 stream 用于并行时的不同分段
+		Xoshiro256( uint64_t seed, uint64_t stream ) noexcept
+		{
+			uint64_t mixed_stream = stream;
+			seed ^= splitmix64( mixed_stream );
+			for ( auto& word : state )
+			{
+				word = splitmix64( seed );
+			}
+		}
+
+		static constexpr result_type min() noexcept
+		{
+			return 0;
+		}
+
+		static constexpr result_type max() noexcept
+		{
+			return std::numeric_limits<result_type>::max();
+		}
+
+		result_type operator()() noexcept
+		{
+			const uint64_t result = rotate_left( state[ 1 ] * 5, 7 ) * 9;
+			const uint64_t shifted = state[ 1 ] << 17;
+
+			state[ 2 ] ^= state[ 0 ];
+			state[ 3 ] ^= state[ 1 ];
+			state[ 1 ] ^= state[ 2 ];
+			state[ 0 ] ^= state[ 3 ];
+			state[ 2 ] ^= shifted;
+			state[ 3 ] = rotate_left( state[ 3 ], 45 );
+
+			return result;
+		}
+
+	private:
+		uint64_t state[ 4 ];
+
+		static constexpr uint64_t rotate_left( uint64_t value, int shift ) noexcept
+		{
+			return ( value << shift ) | ( value >> ( 64 - shift ) );
+		}
+	};
+
+	// 从任意 UniformRandomBitGenerator 取一个 64 位的均匀随机字 (64 位的生成器调用一次，32 位的调用两次)
+	template <typename Generator>
+	inline uint64_t random_word64( Generator& generator )
+	{
+		constexpr uint64_t range = static_cast<uint64_t>( Generator::max() - Generator::min() );
+		if constexpr ( range == std::numeric_limits<uint64_t>::max() )
+		{
+			return static_cast<uint64_t>( generator() - Generator::min() );
+		}
+		else if constexpr ( range == 0xFFFFFFFFULL )
+		{
+			const uint64_t low = static_cast<uint64_t>( generator() - Generator::min() );
+			const uint64_t high = static_cast<uint64_t>( generator() - Generator::min() );
+			return low | ( high << 32 );
+		}
+		else
+		{
+			std::uniform_int_distribution<uint64_t> distribution;
+			return distribution( generator );
+		}
+	}
+
+	// 概率 probability (0 < probability < 1) 对应的 64 位定点阈值：U < threshold 的概率是 threshold / 2^64
+	inline uint64_t bernoulli_threshold( double probability ) noexcept
+	{
+		// 小于 1 的 double 最多是 1 - 2^-53，乘以 2^64 之后不会溢出
+		return static_cast<uint64_t>( probability * 18446744073709551616.0 );
+	}
+
+	// 64 个独立的比特，每一位为'1'的概率是 threshold / 2^64
+	template <typename Generator>
+	inline uint64_t bernoulli_word64( uint64_t threshold, Generator& generator )
+	{
+		uint64_t less = 0;
+		uint64_t equal = ~uint64_t( 0 );
+		for ( int bit = 63; bit >= 0 && equal != 0; --bit )
+		{
+			// 阈值的这一位为'1'时随机位为'0'的路确定小于，阈值与随机位相同的路继续比较
+			const uint64_t random = random_word64( generator );
+			if ( ( threshold >> bit ) & 1 )
+			{
+				less |= equal & ~random;
+				equal &= random;
+			}
+			else
+			{
+				equal &= ~random;
+			}
+		}
+		return less;
+	}
+
+	// 把 chunks[ 0, count ) 换成均匀随机的比特
+	template <typename Generator>
+	void chunks_fill_random( BooleanBitWrapper* chunks, size_t count, Generator& generator )
+	{
+		size_t i = 0;
+		for ( ; i + 2 <= count; i += 2 )
+		{
+			const uint64_t word = random_word64( generator );
+			chunks[ i ].bits = static_cast<uint32_t>( word );
+			chunks[ i + 1 ].bits = static_cast<uint32_t>( word >> 32 );
+		}
+		if ( i < count )
+		{
+			chunks[ i ].bits = static_cast<uint32_t>( random_word64( generator ) );
+		}
+	}
+
+	// 把 chunks[ 0, count ) 换成每一位以概率 probability (0 <= probability <= 1) 为'1'的比特
+	template <typename Generator>
+	void chunks_fill_bernoulli( BooleanBitWrapper* chunks, size_t count, double probability, Generator& generator )
+	{
+		if ( probability <= 0.0 || probability >= 1.0 )
+		{
+			std::fill( chunks, chunks + count, BooleanBitWrapper( probability >= 1.0 ? 0xFFFFFFFF : 0 ) );
+			return;
+		}
+		if ( probability == 0.5 )
+		{
+			chunks_fill_random( chunks, count, generator );
+			return;
+		}
+
+		const uint64_t threshold = bernoulli_threshold( probability );
+		size_t		   i = 0;
+		for ( ; i + 2 <= count; i += 2 )
+		{
+			const uint64_t word = bernoulli_word64( threshold, generator );
+			chunks[ i ].bits = static_cast<uint32_t>( word );
+			chunks[ i + 1 ].bits = static_cast<uint32_t>( word >> 32 );
+		}
+		if ( i < count )
+		{
+			chunks[ i ].bits = static_cast<uint32_t>( bernoulli_word64( threshold, generator ) );
+		}
+	}
+}  // namespace TwilightDream
@@ -0,0 +1,231 @@
+#include "EliasFanoSequence.hpp"
+
+#include "BitOperations.hpp"
+#include "DynamicBitSetKernels.hpp"
+
+#include <algorithm>
+#include <stdexcept>
+#include <utility>
+
+namespace TwilightDream
+{
+	namespace
+	{
+		// floor( log2( universe / count ) )，最多 63
+		unsigned elias_fano_low_width( size_t count, uint64_t universe ) noexcept
+		{
+			if ( count == 0 || universe / count <= 1 )
+			{
+				return 0;
+			}
+			return 63 - count_leading_zeros64( universe / count );
+		}
+
+		template <typename Value>
+		EliasFanoSequence encode_values( const std::vector<Value>& values, uint64_t universe )
+		{
+			if ( universe == 0 && !values.empty() )
+			{
+				universe = static_cast<uint64_t>( values.back() ) + 1;
+			}
+			EliasFanoBuilder builder( values.size(), universe );
+			for ( const Value value : values )
+			{
+				builder.push_back( value );
+			}
+			return builder.build();
+		}
+	}  // namespace
+
+	EliasFanoSequence::EliasFanoSequence( const std::vector<uint32_t>& values, uint64_t universe ) : EliasFanoSequence( encode_values( values, universe ) ) {}
+
+	EliasFanoSequence::EliasFanoSequence( const std::vector<uint64_t>& values, uint64_t universe ) : EliasFanoSequence( encode_values( values, universe ) ) {}
+
+	EliasFanoSequence::EliasFanoSequence( const DynamicBitSet& bits )
+	{
+		EliasFanoBuilder builder( bits.hamming_weight(), bits.bit_size() );
+		for ( size_t position = bits.find_next( 0 ); position != DynamicBitSet::npos; position = bits.find_next( position + 1 ) )
+		{
+			builder.push_back( position );
+		}
+		*this = builder.build();
+	}
+
+	uint64_t EliasFanoSequence::access( size_t index ) const
+	{
+		DefaultBitAccess::check_index( index, data_size, "Index out of range from Elias-Fano sequence" );
+		const uint64_t high = select_one( index ) - index;
+		return ( high << low_bit_width ) | low_value( index );
+	}
+
+	size_t EliasFanoSequence::next_geq( uint64_t value ) const noexcept
+	{
+		if ( data_size == 0 || value > last_value )
+		{
+			return data_size;
+		}
+
+		// 高位为 high 的桶从第 high 个比特'0'之后开始
+		const uint64_t high = value >> low_bit_width;
+		const uint64_t low = value - ( high << low_bit_width );
+		size_t		   position = high == 0 ? 0 : select_zero( high - 1 ) + 1;
+		size_t		   index = position - high;
+
+		// 桶中的值按低位升序；遇到比特'0'说明桶已经结束，下一个值的高位更大 (value <= last_value 保证它存在)
+		for ( ;; ++position, ++index )
+		{
+			if ( !upper_bits.test_unchecked( position ) || low_value( index ) >= low )
+			{
+				return index;
+			}
+		}
+	}
+
+	void EliasFanoSequence::decode( uint64_t* output ) const
+	{
+		// 高位的比特图中恰好有 size() 个比特'1'，第 i 个的位置减去 i 就是第 i 个值的高位
+		upper_bits.to_positions( output );
+
+		uint32_t lows[ select_sample_rate ];
+		for ( size_t first = 0; first < data_size; first += select_sample_rate )
+		{
+			const size_t count = std::min( select_sample_rate, data_size - first );
+			if ( low_bit_width != 0 && low_bit_width <= 32 )
+			{
+				ConstPackedIntView( lower_bits.chunk_data(), data_size, low_bit_width ).unpack( first, count, lows );
+			}
+			for ( size_t i = 0; i < count; ++i )
+			{
+				const uint64_t high = output[ first + i ] - ( first + i );
+				const uint64_t low = low_bit_width > 32 ? low_value( first + i ) : ( low_bit_width != 0 ? lows[ i ] : 0 );
+				output[ first + i ] = ( high << low_bit_width ) | low;
+			}
+		}
+	}
+
+	std::vector<uint64_t> EliasFanoSequence::decode() const
+	{
+		std::vector<uint64_t> values( data_size );
+		decode( values.data() );
+		return values;
+	}
+
+	DynamicBitSet EliasFanoSequence::to_dynamic_bitset() const
+	{
+		return DynamicBitSet::from_positions( decode(), universe_value );
+	}
+
+	size_t EliasFanoSequence::select_one( size_t rank ) const noexcept
+	{
+		return bits_select( upper_bits.chunk_data(), one_samples[ rank / select_sample_rate ], rank % select_sample_rate, true );
+	}
+
+	size_t EliasFanoSequence::select_zero( size_t rank ) const noexcept
+	{
+		return bits_select( upper_bits.chunk_data(), zero_samples[ rank / select_sample_rate ], rank % select_sample_rate, false );
+	}
+
+	void EliasFanoSequence::build_select_samples()
+	{
+		one_samples.clear();
+		zero_samples.clear();
+		size_t		 ones = 0;
+		size_t		 zeros = 0;
+		const size_t word_count = upper_bits.chunk_count() / 2;
+		for ( size_t word_index = 0; word_index < word_count; ++word_index )
+		{
+			const uint64_t word = upper_word( word_index );
+			const uint32_t one_count = population_count64( word );
+			while ( one_samples.size() * select_sample_rate < ones + one_count )
+			{
+				const size_t rank = one_samples.size() * select_sample_rate - ones;
+				one_samples.push_back( word_index * 64 + select_in_word64( word, static_cast<uint32_t>( rank ) ) );
+			}
+			while ( zero_samples.size() * select_sample_rate < zeros + 64 - one_count )
+			{
+				const size_t rank = zero_samples.size() * select_sample_rate - zeros;
+				zero_samples.push_back( word_index * 64 + select_in_word64( ~word, static_cast<uint32_t>( rank ) ) );
+			}
+			ones += one_count;
+			zeros += 64 - one_count;
+		}
+	}
+
+	EliasFanoBuilder::EliasFanoBuilder( size_t count, uint64_t universe )
+	{
+		if ( count != 0 && universe == 0 )
+		{
+			throw std::invalid_argument( "EliasFanoBuilder: universe must be positive" );
+		}
+		const unsigned low_width = elias_fano_low_width( count, universe );
+		sequence.data_size = count;
+		sequence.universe_value = universe;
+		sequence.low_bit_width = low_width;
+		sequence.lower_bits = DynamicBitSet( count * low_width, false );
+
+		// 比特'1'有 count 个，比特'0'至少有最大的高位 + 1 个；大小取 64 的倍数，以便按 64 位的字读取
+		const size_t upper_size = count == 0 ? 0 : count + static_cast<size_t>( ( universe - 1 ) >> low_width ) + 1;
+		sequence.upper_bits = DynamicBitSet( ( upper_size + 63 ) / 64 * 64, false );
+	}
+
+	void EliasFanoBuilder::push_back( uint64_t value )
+	{
+		if ( pushed_count == sequence.data_size )
+		{
+			throw std::invalid_argument( "EliasFanoBuilder: more values than the declared count" );
+		}
+		if ( value >= sequence.universe_value || ( pushed_count != 0 && value < sequence.last_value ) )
+		{
+			throw std::invalid_argument( "EliasFanoBuilder: values must be non-decreasing and less than the universe" );
+		}
+
+		const unsigned low_width = sequence.low_bit_width;
+		sequence.upper_bits.set_bit( true, static_cast<size_t>( value >> low_width ) + pushed_count );
+		pending_lows[ pushed_count % 32 ] = value;
+		sequence.last_value = value;
+		++pushed_count;
+		if ( pushed_count % 32 == 0 )
+		{
+			flush_lows( 32 );
+		}
+	}
+
+	EliasFanoSequence EliasFanoBuilder::build()
+	{
+		if ( pushed_count != sequence.data_size )
+		{
+			throw std::invalid_argument( "EliasFanoBuilder: fewer values than the declared count" );
+		}
+		flush_lows( pushed_count % 32 );
+		sequence.build_select_samples();
+		return std::move( sequence );
+	}
+
+	void EliasFanoBuilder::flush_lows( size_t count )
+	{
+		// pack / set_bits 只保留每个值的低 low_width 位
+		const unsigned low_width = sequence.low_bit_width;
+		if ( low_width == 0 || count == 0 )
+		{
+			return;
+		}
+		const size_t first = pushed_count - count;
+		if ( low_width <= 32 )
+		{
+			uint32_t lows[ 32 ];
+			for ( size_t i = 0; i < count; ++i )
+			{
+				lows[ i ] = static_cast<uint32_t>( pending_lows[ i ] );
+			}
+			PackedIntView( sequence.lower_bits.chunk_data(), sequence.data_size, low_width ).pack( first, lows, count );
+			return;
+		}
+		BooleanBitWrapper* chunks = sequence.lower_bits.chunk_data();
+		for ( size_t i = 0; i < count; ++i )
+		{
+			const size_t bit = ( first + i ) * low_width;
+			packed_detail::set_bits( chunks, bit, 32, static_cast<uint32_t>( pending_lows[ i ] ) );
+			packed_detail::set_bits( chunks, bit + 32, low_width - 32, static_cast<uint32_t>( pending_lows[ i ] >> 32 ) );
+		}
+	}
+}  // namespace TwilightDream
@@ -0,0 +1,160 @@
+#pragma once
+
+#include <cstdint>
+#include <cstddef>
+
+#include <vector>
+
+#include "DynamicBitSet.hpp"
+#include "PackedIntArray.hpp"
+
+namespace TwilightDream
+{
+	/*
+		EliasFanoSequence
+		单调不减的整数序列 (例如排好序的 ID 列表) 的 Elias-Fano 编码：n 个小于 universe 的值大约占 n * ( 2 + log2( universe / n ) ) 比特。
+		- 每个值拆成低 low_width() 位和高位。低位按定宽整数存放在一个 DynamicBitSet 中 (与 PackedIntView 的布局相同)；
+		  高位存为一元编码的比特图：第 i 个值设置比特 ( value >> low_width() ) + i，所以第 i 个比特'1'对应第 i 个值，
+		  高位为 h 的值都在第 h 个比特'0'之后 (高位的"桶")。
+		- 每 select_sample_rate 个比特'1' / 比特'0'记录一次位置 (select 的采样)。access(i) 从采样点开始用 bits_select 逐块扫描
+		  (多版本的 popcnt)，高位的比特图中'1'和'0'大约各占一半，平均只需要读几个块，是 O(1) 的。
+		- next_geq(x) 用比特'0'的采样直接跳到 x 所在的桶，只比较这个桶中的几个值。
+		- low_width() = floor( log2( universe / n ) )，可以是 0 .. 63，所以高位的比特图总是不超过 2n + 1 比特 (与 universe 无关)。
+		  超过 32 位的低位按同样的布局连续存放，读写时拆成低 32 位和其余的位两段 (packed_detail::get_bits / set_bits)。
+	*/
+	class EliasFanoSequence
+	{
+	public:
+		static constexpr size_t select_sample_rate = 256;
+
+		EliasFanoSequence() = default;
+
+		// values 必须单调不减；universe 为 0 时取最后一个值 + 1，否则所有值必须小于 universe。不满足时抛出 std::invalid_argument
+		explicit EliasFanoSequence( const std::vector<uint32_t>& values, uint64_t universe = 0 );
+		explicit EliasFanoSequence( const std::vector<uint64_t>& values, uint64_t universe = 0 );
+
+		// 编码 bits 中比特'1'的位置，universe() 是 bits.bit_size()
+		explicit EliasFanoSequence( const DynamicBitSet& bits );
+
+		size_t size() const noexcept
+		{
+			return data_size;
+		}
+
+		bool empty() const noexcept
+		{
+			return data_size == 0;
+		}
+
+		uint64_t universe() const noexcept
+		{
+			return universe_value;
+		}
+
+		unsigned low_width() const noexcept
+		{
+			return low_bit_width;
+		}
+
+		// 编码占用的比特数量 (低位、高位的比特图和 select 的采样)
+		size_t encoded_bits() const noexcept
+		{
+			return lower_bits.bit_size() + upper_bits.bit_size() + ( one_samples.size() + zero_samples.size() ) * 64;
+		}
+
+		// 低位 (size() 个 low_width() 位的整数) 和高位的比特图
+		const DynamicBitSet& low_bits() const noexcept
+		{
+			return lower_bits;
+		}
+
+		const DynamicBitSet& high_bits() const noexcept
+		{
+			return upper_bits;
+		}
+
+		// 第 index 个值，越界时抛出 std::out_of_range
+		uint64_t access( size_t index ) const;
+
+		uint64_t operator[]( size_t index ) const
+		{
+			return access( index );
+		}
+
+		// 第一个不小于 value 的值的序号，没有时返回 size()
+		size_t next_geq( uint64_t value ) const noexcept;
+
+		// 解码全部的值：高位用 DynamicBitSet::to_positions 取出所有比特'1'的位置，低位用 PackedIntView::unpack 成块地取出
+		void decode( uint64_t* output ) const;
+
+		std::vector<uint64_t> decode() const;
+
+		// universe() 个比特的集合，值是比特'1'的位置 (重复的值只设置一次)
+		DynamicBitSet to_dynamic_bitset() const;
+
+	private:
+		friend class EliasFanoBuilder;
+
+		DynamicBitSet		  lower_bits;
+		DynamicBitSet		  upper_bits;
+		std::vector<uint64_t> one_samples;	 // 第 k * select_sample_rate 个比特'1'的位置
+		std::vector<uint64_t> zero_samples;	 // 第 k * select_sample_rate 个比特'0'的位置
+		size_t				  data_size = 0;
+		uint64_t			  universe_value = 0;
+		uint64_t			  last_value = 0;
+		unsigned			  low_bit_width = 0;
+
+		// 高位的比特图的第 index 个 64 位的字 (比特图的大小是 64 的倍数)
+		uint64_t upper_word( size_t index ) const noexcept
+		{
+			const BooleanBitWrapper* chunks = upper_bits.chunk_data();
+			return chunks[ index * 2 ].bits | ( uint64_t( chunks[ index * 2 + 1 ].bits ) << 32 );
+		}
+
+		uint64_t low_value( size_t index ) const noexcept
+		{
+			if ( low_bit_width <= 32 )
+			{
+				return low_bit_width == 0 ? 0 : packed_detail::get( lower_bits.chunk_data(), index, low_bit_width );
+			}
+			const size_t bit = index * low_bit_width;
+			return packed_detail::get_bits( lower_bits.chunk_data(), bit, 32 ) | ( uint64_t( packed_detail::get_bits( lower_bits.chunk_data(), bit + 32, low_bit_width - 32 ) ) << 32 );
+		}
+
+		// 第 rank 个比特'1' / 比特'0'在高位的比特图中的位置
+		size_t select_one( size_t rank ) const noexcept;
+		size_t select_zero( size_t rank ) const noexcept;
+
+		void build_select_samples();
+	};
+
+	/*
+		EliasFanoBuilder
+		流式地构造 EliasFanoSequence：需要预先知道值的数量和上界，push_back 直接写入高位的比特图，
+		低位每 32 个写入一次 (不超过 32 位时用 PackedIntView::pack)，不需要保存全部的值。
+	*/
+	class EliasFanoBuilder
+	{
+	public:
+		// count 个小于 universe 的值
+		EliasFanoBuilder( size_t count, uint64_t universe );
+
+		// 值必须单调不减并且小于 universe，最多 count 个，否则抛出 std::invalid_argument
+		void push_back( uint64_t value );
+
+		size_t size() const noexcept
+		{
+			return pushed_count;
+		}
+
+		// 必须已经加入了 count 个值，否则抛出 std::invalid_argument；之后 builder 不能再使用
+		EliasFanoSequence build();
+
+	private:
+		EliasFanoSequence sequence;
+		uint64_t		  pending_lows[ 32 ];
+		size_t			  pushed_count = 0;
+
+		void flush_lows( size_t count );
+	};
+}  // namespace TwilightDream
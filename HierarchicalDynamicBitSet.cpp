@@ -0,0 +1,403 @@
+#include "HierarchicalDynamicBitSet.hpp"
+
+#include "DynamicBitSetKernels.hpp"
+
+#include <algorithm>
+
+namespace TwilightDream
+{
+	/* HierarchicalDynamicBitSet */
+
+	HierarchicalDynamicBitSet::HierarchicalDynamicBitSet( size_t bit_size )
+		: bits_value( bit_size, false ), data_size( bit_size ), data_word_count( ( bit_size + 63 ) / 64 )
+	{
+		build_levels();
+	}
+
+	HierarchicalDynamicBitSet::HierarchicalDynamicBitSet( const DynamicBitSet& other )
+		: bits_value( other.bit_size(), false ), data_size( other.bit_size() ), data_word_count( ( other.bit_size() + 63 ) / 64 )
+	{
+		bits_apply_range( BitRangeOperation::Copy, bits_value.chunk_data(), 0, other.chunk_data(), 0, data_size );
+		build_levels();
+	}
+
+	void HierarchicalDynamicBitSet::build_levels()
+	{
+		non_empty_levels.clear();
+		non_full_levels.clear();
+		if ( data_word_count == 0 )
+		{
+			return;
+		}
+
+		// 每一层的字数是下一层的 1/64 (向上取整)，直到只剩一个字
+		size_t count = data_word_count;
+		do
+		{
+			count = ( count + 63 ) / 64;
+			non_empty_levels.emplace_back( count, 0 );
+			non_full_levels.emplace_back( count, 0 );
+		} while ( count > 1 );
+
+		refresh_words( 0, data_word_count - 1 );
+	}
+
+	void HierarchicalDynamicBitSet::update_word( size_t word_index ) noexcept
+	{
+		const uint64_t value = load_word( word_index );
+		bool		   non_empty = value != 0;
+		bool		   non_full = ( value | ~valid_mask( word_index ) ) != ~uint64_t( 0 );
+
+		size_t index = word_index;
+		for ( size_t level = 0; level < non_empty_levels.size(); ++level )
+		{
+			uint64_t&	   empty_word = non_empty_levels[ level ][ index / 64 ];
+			uint64_t&	   full_word = non_full_levels[ level ][ index / 64 ];
+			const uint64_t bit = uint64_t( 1 ) << ( index % 64 );
+			const bool	   was_non_empty = empty_word != 0;
+			const bool	   was_non_full = full_word != 0;
+
+			empty_word = non_empty ? ( empty_word | bit ) : ( empty_word & ~bit );
+			full_word = non_full ? ( full_word | bit ) : ( full_word & ~bit );
+
+			non_empty = empty_word != 0;
+			non_full = full_word != 0;
+			// 这一层的字是否为零都没有改变时，更高的层不受影响
+			if ( non_empty == was_non_empty && non_full == was_non_full )
+			{
+				return;
+			}
+			index /= 64;
+		}
+	}
+
+	void HierarchicalDynamicBitSet::refresh_words( size_t first_word, size_t last_word ) noexcept
+	{
+		if ( non_empty_levels.empty() )
+		{
+			return;
+		}
+
+		// 第 0 层：重新计算覆盖 [ first_word, last_word ] 的摘要字
+		size_t first = first_word / 64;
+		size_t last = last_word / 64;
+		for ( size_t summary = first; summary <= last; ++summary )
+		{
+			const size_t begin = summary * 64;
+			const size_t end = std::min( begin + 64, data_word_count );
+			uint64_t	 empty_word = 0;
+			uint64_t	 full_word = 0;
+			for ( size_t word_index = begin; word_index < end; ++word_index )
+			{
+				const uint64_t value = load_word( word_index );
+				empty_word |= uint64_t( value != 0 ) << ( word_index - begin );
+				full_word |= uint64_t( ( value | ~valid_mask( word_index ) ) != ~uint64_t( 0 ) ) << ( word_index - begin );
+			}
+			non_empty_levels[ 0 ][ summary ] = empty_word;
+			non_full_levels[ 0 ][ summary ] = full_word;
+		}
+
+		// 更高的层：每个比特表示下一层对应的字不为零
+		for ( size_t level = 1; level < non_empty_levels.size(); ++level )
+		{
+			const std::vector<uint64_t>& lower_empty = non_empty_levels[ level - 1 ];
+			const std::vector<uint64_t>& lower_full = non_full_levels[ level - 1 ];
+			first /= 64;
+			last /= 64;
+			for ( size_t summary = first; summary <= last; ++summary )
+			{
+				const size_t begin = summary * 64;
+				const size_t end = std::min( begin + 64, lower_empty.size() );
+				uint64_t	 empty_word = 0;
+				uint64_t	 full_word = 0;
+				for ( size_t lower = begin; lower < end; ++lower )
+				{
+					empty_word |= uint64_t( lower_empty[ lower ] != 0 ) << ( lower - begin );
+					full_word |= uint64_t( lower_full[ lower ] != 0 ) << ( lower - begin );
+				}
+				non_empty_levels[ level ][ summary ] = empty_word;
+				non_full_levels[ level ][ summary ] = full_word;
+			}
+		}
+	}
+
+	size_t HierarchicalDynamicBitSet::find_next( const SummaryLevels& levels, bool zeros, size_t from ) const noexcept
+	{
+		if ( from >= data_size )
+		{
+			return npos;
+		}
+
+		auto candidates = [ this, zeros ]( size_t word_index ) {
+			const uint64_t value = load_word( word_index );
+			return zeros ? ~value & valid_mask( word_index ) : value;
+		};
+
+		// 先检查 from 所在的字
+		const size_t word_index = from / 64;
+		const uint64_t first_candidates = candidates( word_index ) & ( ~uint64_t( 0 ) << ( from % 64 ) );
+		if ( first_candidates != 0 )
+		{
+			return word_index * 64 + count_trailing_zeros64( first_candidates );
+		}
+
+		// 向上走，直到某一层在 index 之后 (同一个摘要字内) 还有候选
+		size_t index = word_index + 1;
+		for ( size_t level = 0; level < levels.size(); ++level )
+		{
+			const size_t summary = index / 64;
+			if ( summary >= levels[ level ].size() )
+			{
+				return npos;
+			}
+
+			const uint64_t bits = levels[ level ][ summary ] & ( ~uint64_t( 0 ) << ( index % 64 ) );
+			if ( bits != 0 )
+			{
+				// 再沿着每一层的最低置位比特向下走到数据字
+				index = summary * 64 + count_trailing_zeros64( bits );
+				for ( size_t lower = level; lower-- > 0; )
+				{
+					index = index * 64 + count_trailing_zeros64( levels[ lower ][ index ] );
+				}
+				return index * 64 + count_trailing_zeros64( candidates( index ) );
+			}
+			index = summary + 1;
+		}
+		return npos;
+	}
+
+	void HierarchicalDynamicBitSet::set_bit( bool value, size_t index )
+	{
+		check_index( index );
+		const size_t   word_index = index / 64;
+		const uint64_t bit = uint64_t( 1 ) << ( index % 64 );
+		const uint64_t old_word = load_word( word_index );
+		const uint64_t new_word = value ? ( old_word | bit ) : ( old_word & ~bit );
+		if ( new_word != old_word )
+		{
+			store_word( word_index, new_word );
+			update_word( word_index );
+		}
+	}
+
+	void HierarchicalDynamicBitSet::flip( size_t index )
+	{
+		check_index( index );
+		const size_t word_index = index / 64;
+		store_word( word_index, load_word( word_index ) ^ ( uint64_t( 1 ) << ( index % 64 ) ) );
+		update_word( word_index );
+	}
+
+	void HierarchicalDynamicBitSet::set( size_t pos, size_t len, bool value )
+	{
+		if ( len == 0 )
+		{
+			return;
+		}
+		check_index( pos );
+		check_index( pos + len - 1 );
+
+		const size_t first_word = pos / 64;
+		const size_t last_word = ( pos + len - 1 ) / 64;
+		for ( size_t word_index = first_word; word_index <= last_word; ++word_index )
+		{
+			uint64_t mask = ~uint64_t( 0 );
+			if ( word_index == first_word )
+			{
+				mask &= ~uint64_t( 0 ) << ( pos % 64 );
+			}
+			if ( word_index == last_word )
+			{
+				mask &= ~uint64_t( 0 ) >> ( 63 - ( pos + len - 1 ) % 64 );
+			}
+			const uint64_t old_word = load_word( word_index );
+			store_word( word_index, value ? ( old_word | mask ) : ( old_word & ~mask ) );
+		}
+
+		if ( first_word == last_word )
+		{
+			update_word( first_word );
+		}
+		else
+		{
+			refresh_words( first_word, last_word );
+		}
+	}
+
+	void HierarchicalDynamicBitSet::set()
+	{
+		if ( data_word_count == 0 )
+		{
+			return;
+		}
+		bits_assign_range( bits_value.chunk_data(), 0, data_size, true );
+		refresh_words( 0, data_word_count - 1 );
+	}
+
+	void HierarchicalDynamicBitSet::reset()
+	{
+		if ( data_word_count == 0 )
+		{
+			return;
+		}
+		std::fill( bits_value.chunk_data(), bits_value.chunk_data() + bits_value.chunk_count(), BooleanBitWrapper( 0 ) );
+		refresh_words( 0, data_word_count - 1 );
+	}
+
+	size_t HierarchicalDynamicBitSet::find_first_zero_and_set()
+	{
+		const size_t index = find_first_zero();
+		if ( index != npos )
+		{
+			set_bit( true, index );
+		}
+		return index;
+	}
+
+	size_t HierarchicalDynamicBitSet::hamming_weight() const noexcept
+	{
+		return chunks_population_count( bits_value.chunk_data(), bits_value.chunk_count() );
+	}
+
+	void HierarchicalDynamicBitSet::block_chunk_range( size_t block, size_t& first_chunk, size_t& chunk_count ) const noexcept
+	{
+		const size_t chunks_per_block = words_per_block * 2;
+		first_chunk = block * chunks_per_block;
+		chunk_count = std::min( chunks_per_block, bits_value.chunk_count() - first_chunk );
+	}
+
+	template <typename SkipBlock, typename Operation>
+	void HierarchicalDynamicBitSet::apply_blocks( SkipBlock&& skip_block, Operation&& operation )
+	{
+		const size_t blocks = block_count();
+		for ( size_t block = 0; block < blocks; ++block )
+		{
+			if ( skip_block( block ) )
+			{
+				continue;
+			}
+
+			size_t first_chunk = 0;
+			size_t chunk_count = 0;
+			block_chunk_range( block, first_chunk, chunk_count );
+			operation( first_chunk, chunk_count );
+
+			const size_t first_word = block * words_per_block;
+			refresh_words( first_word, std::min( first_word + words_per_block, data_word_count ) - 1 );
+		}
+	}
+
+	HierarchicalDynamicBitSet& HierarchicalDynamicBitSet::and_operation( const DynamicBitSet& other )
+	{
+		BooleanBitWrapper*		 destination = bits_value.chunk_data();
+		const BooleanBitWrapper* source = other.chunk_data();
+		const size_t			 source_count = other.chunk_count();
+		// 自己为空的块结果仍然为空
+		apply_blocks(
+			[ this ]( size_t block ) { return block_empty( block ); },
+			[ & ]( size_t first_chunk, size_t chunk_count ) {
+				const size_t overlap = first_chunk < source_count ? std::min( chunk_count, source_count - first_chunk ) : 0;
+				chunks_and( destination + first_chunk, source + first_chunk, overlap );
+				std::fill( destination + first_chunk + overlap, destination + first_chunk + chunk_count, BooleanBitWrapper( 0 ) );
+			} );
+		return *this;
+	}
+
+	HierarchicalDynamicBitSet& HierarchicalDynamicBitSet::or_operation( const DynamicBitSet& other )
+	{
+		BooleanBitWrapper*		 destination = bits_value.chunk_data();
+		const BooleanBitWrapper* source = other.chunk_data();
+		const size_t			 source_count = other.chunk_count();
+		apply_blocks(
+			[ & ]( size_t block ) { return block * words_per_block * 2 >= source_count; },
+			[ & ]( size_t first_chunk, size_t chunk_count ) {
+				chunks_or( destination + first_chunk, source + first_chunk, std::min( chunk_count, source_count - first_chunk ) );
+				// other 可以比 bit_size() 长，超出的比特不能留在最后一个字中
+				bits_assign_range( destination, data_size, bits_value.chunk_count() * 32 - data_size, false );
+			} );
+		return *this;
+	}
+
+	HierarchicalDynamicBitSet& HierarchicalDynamicBitSet::xor_operation( const DynamicBitSet& other )
+	{
+		BooleanBitWrapper*		 destination = bits_value.chunk_data();
+		const BooleanBitWrapper* source = other.chunk_data();
+		const size_t			 source_count = other.chunk_count();
+		apply_blocks(
+			[ & ]( size_t block ) { return block * words_per_block * 2 >= source_count; },
+			[ & ]( size_t first_chunk, size_t chunk_count ) {
+				chunks_xor( destination + first_chunk, source + first_chunk, std::min( chunk_count, source_count - first_chunk ) );
+				// other 可以比 bit_size() 长，超出的比特不能留在最后一个字中
+				bits_assign_range( destination, data_size, bits_value.chunk_count() * 32 - data_size, false );
+			} );
+		return *this;
+	}
+
+	HierarchicalDynamicBitSet& HierarchicalDynamicBitSet::and_not_operation( const DynamicBitSet& other )
+	{
+		BooleanBitWrapper*		 destination = bits_value.chunk_data();
+		const BooleanBitWrapper* source = other.chunk_data();
+		const size_t			 source_count = other.chunk_count();
+		apply_blocks(
+			[ & ]( size_t block ) { return block_empty( block ) || block * words_per_block * 2 >= source_count; },
+			[ & ]( size_t first_chunk, size_t chunk_count ) {
+				chunks_and_not( destination + first_chunk, source + first_chunk, std::min( chunk_count, source_count - first_chunk ) );
+			} );
+		return *this;
+	}
+
+	HierarchicalDynamicBitSet& HierarchicalDynamicBitSet::and_operation( const HierarchicalDynamicBitSet& other )
+	{
+		check_same_bit_size( data_size, other.data_size, "HierarchicalDynamicBitSet" );
+		BooleanBitWrapper*		 destination = bits_value.chunk_data();
+		const BooleanBitWrapper* source = other.bits_value.chunk_data();
+		apply_blocks(
+			[ this ]( size_t block ) { return block_empty( block ); },
+			[ & ]( size_t first_chunk, size_t chunk_count ) {
+				// 对方为空的块直接清零，不需要读取对方的数据
+				if ( other.block_empty( first_chunk / ( words_per_block * 2 ) ) )
+				{
+					std::fill( destination + first_chunk, destination + first_chunk + chunk_count, BooleanBitWrapper( 0 ) );
+				}
+				else
+				{
+					chunks_and( destination + first_chunk, source + first_chunk, chunk_count );
+				}
+			} );
+		return *this;
+	}
+
+	HierarchicalDynamicBitSet& HierarchicalDynamicBitSet::or_operation( const HierarchicalDynamicBitSet& other )
+	{
+		check_same_bit_size( data_size, other.data_size, "HierarchicalDynamicBitSet" );
+		BooleanBitWrapper*		 destination = bits_value.chunk_data();
+		const BooleanBitWrapper* source = other.bits_value.chunk_data();
+		apply_blocks(
+			[ &other ]( size_t block ) { return other.block_empty( block ); },
+			[ & ]( size_t first_chunk, size_t chunk_count ) { chunks_or( destination + first_chunk, source + first_chunk, chunk_count ); } );
+		return *this;
+	}
+
+	HierarchicalDynamicBitSet& HierarchicalDynamicBitSet::xor_operation( const HierarchicalDynamicBitSet& other )
+	{
+		check_same_bit_size( data_size, other.data_size, "HierarchicalDynamicBitSet" );
+		BooleanBitWrapper*		 destination = bits_value.chunk_data();
+		const BooleanBitWrapper* source = other.bits_value.chunk_data();
+		apply_blocks(
+			[ &other ]( size_t block ) { return other.block_empty( block ); },
+			[ & ]( size_t first_chunk, size_t chunk_count ) { chunks_xor( destination + first_chunk, source + first_chunk, chunk_count ); } );
+		return *this;
+	}
+
+	HierarchicalDynamicBitSet& HierarchicalDynamicBitSet::and_not_operation( const HierarchicalDynamicBitSet& other )
+	{
+		check_same_bit_size( data_size, other.data_size, "HierarchicalDynamicBitSet" );
+		BooleanBitWrapper*		 destination = bits_value.chunk_data();
+		const BooleanBitWrapper* source = other.bits_value.chunk_data();
+		apply_blocks(
+			[ & ]( size_t block ) { return block_empty( block ) || other.block_empty( block ); },
+			[ & ]( size_t first_chunk, size_t chunk_count ) { chunks_and_not( destination + first_chunk, source + first_chunk, chunk_count ); } );
+		return *this;
+	}
+}  // namespace TwilightDream
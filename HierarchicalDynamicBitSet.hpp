@@ -0,0 +1,238 @@
+#pragma once
+
+#include <cstdint>
+#include <cstddef>
+
+#include <vector>
+
+#include "BitOperations.hpp"
+#include "DynamicBitSet.hpp"
+
+namespace TwilightDream
+{
+	/*
+		HierarchicalDynamicBitSet
+		带分层摘要索引 (summary bitmap) 的固定大小比特集，用于在很大的集合中快速查找第一个 1 / 第一个 0 (例如槽位分配)。
+		- 数据按 64 位字划分 (即两个比特块)。第 0 层摘要中每个比特对应一个数据字，上一层的每个比特对应下一层的一个 64 位字，
+		  一直到最高层只剩一个字，所以层数是 ceil( log_64( 字数 ) )：1 Mbit 需要 2 层，256 Mbit 需要 3 层。
+		- 两套摘要：non_empty (对应的字不为零) 与 non_full (对应的字中还有为 0 的有效比特)。
+		- find_first_one / find_first_zero 从摘要中沿着 count_trailing_zeros 向下走，any / none / all 只读取最高层的字，
+		  都是 O(log_64 n)。
+		- 只能通过本类的接口修改比特，每次修改都会向上更新受影响的摘要字 (单个比特的修改最多更新每层一个字)。
+		- 批量的按位运算以"块" (64 个数据字 = 4096 比特，对应第 0 层摘要的一个字) 为单位，
+		  跳过不会改变结果的全零块 (例如 or / xor 时对方为空的块，and 时自己为空的块)。
+		- bit_size() 在构造时确定。最后一个数据字中超出 bit_size() 的比特保持为 0，所以 non_empty 摘要和 find_first_one 不需要额外的掩码，
+		  non_full 摘要则只看有效比特。
+	*/
+	class HierarchicalDynamicBitSet
+	{
+	public:
+		static constexpr size_t npos = static_cast<size_t>( -1 );
+
+		// 第 0 层摘要的一个字覆盖的数据字数量 (一个块)
+		static constexpr size_t words_per_block = 64;
+
+		explicit HierarchicalDynamicBitSet( size_t bit_size = 0 );
+
+		// 大小和内容都取自 other (bit_size() 就是 other.bit_size())，然后一次性建立两套摘要
+		explicit HierarchicalDynamicBitSet( const DynamicBitSet& other );
+
+		size_t bit_size() const noexcept
+		{
+			return data_size;
+		}
+
+		// 64 位数据字的数量
+		size_t word_count() const noexcept
+		{
+			return data_word_count;
+		}
+
+		// 摘要的层数 (bit_size() <= 64 时为 1，空集合为 0)
+		size_t summary_level_count() const noexcept
+		{
+			return non_empty_levels.size();
+		}
+
+		// 底层的比特 (bit_size() 与构造时相同)
+		const DynamicBitSet& bits() const noexcept
+		{
+			return bits_value;
+		}
+
+		bool test( size_t index ) const
+		{
+			check_index( index );
+			return ( load_word( index / 64 ) >> ( index % 64 ) ) & 1;
+		}
+
+		bool operator[]( size_t index ) const
+		{
+			return test( index );
+		}
+
+		// 参数顺序与 DynamicBitSet::set_bit 相同
+		void set_bit( bool value, size_t index );
+
+		void set( size_t index )
+		{
+			set_bit( true, index );
+		}
+
+		void reset( size_t index )
+		{
+			set_bit( false, index );
+		}
+
+		void flip( size_t index );
+
+		// 把 [ pos, pos + len ) 设置为 value
+		void set( size_t pos, size_t len, bool value );
+
+		// 所有位设置为 1 / 0
+		void set();
+		void reset();
+
+		bool any() const noexcept
+		{
+			return !non_empty_levels.empty() && non_empty_levels.back()[ 0 ] != 0;
+		}
+
+		bool none() const noexcept
+		{
+			return !any();
+		}
+
+		// 所有有效比特都为 1 (空集合返回 true)
+		bool all() const noexcept
+		{
+			return non_full_levels.empty() || non_full_levels.back()[ 0 ] == 0;
+		}
+
+		// 第一个 >= from 的 1 / 0 的索引，没有时返回 npos
+		size_t find_first_one( size_t from = 0 ) const noexcept
+		{
+			return find_next( non_empty_levels, false, from );
+		}
+
+		size_t find_first_zero( size_t from = 0 ) const noexcept
+		{
+			return find_next( non_full_levels, true, from );
+		}
+
+		// 查找第一个 0 并把它设置为 1 (用于槽位分配)，返回它的索引；已满时返回 npos
+		size_t find_first_zero_and_set();
+
+		// 批量运算：other 比 bit_size() 短的部分视为 0，超出的部分被忽略
+		HierarchicalDynamicBitSet& and_operation( const DynamicBitSet& other );
+		HierarchicalDynamicBitSet& or_operation( const DynamicBitSet& other );
+		HierarchicalDynamicBitSet& xor_operation( const DynamicBitSet& other );
+		HierarchicalDynamicBitSet& and_not_operation( const DynamicBitSet& other );
+
+		// 两边都有摘要时按块跳过：要求 bit_size() 相同，否则抛出 std::invalid_argument
+		HierarchicalDynamicBitSet& and_operation( const HierarchicalDynamicBitSet& other );
+		HierarchicalDynamicBitSet& or_operation( const HierarchicalDynamicBitSet& other );
+		HierarchicalDynamicBitSet& xor_operation( const HierarchicalDynamicBitSet& other );
+		HierarchicalDynamicBitSet& and_not_operation( const HierarchicalDynamicBitSet& other );
+
+		HierarchicalDynamicBitSet& operator&=( const HierarchicalDynamicBitSet& other )
+		{
+			return and_operation( other );
+		}
+
+		HierarchicalDynamicBitSet& operator|=( const HierarchicalDynamicBitSet& other )
+		{
+			return or_operation( other );
+		}
+
+		HierarchicalDynamicBitSet& operator^=( const HierarchicalDynamicBitSet& other )
+		{
+			return xor_operation( other );
+		}
+
+		size_t hamming_weight() const noexcept;
+
+		friend bool operator==( const HierarchicalDynamicBitSet& left, const HierarchicalDynamicBitSet& right ) noexcept
+		{
+			return left.data_size == right.data_size && left.bits_value == right.bits_value;
+		}
+
+		friend bool operator!=( const HierarchicalDynamicBitSet& left, const HierarchicalDynamicBitSet& right ) noexcept
+		{
+			return !( left == right );
+		}
+
+	private:
+		using SummaryLevels = std::vector<std::vector<uint64_t>>;
+
+		DynamicBitSet bits_value;
+		SummaryLevels non_empty_levels;
+		SummaryLevels non_full_levels;
+		size_t		  data_size = 0;
+		size_t		  data_word_count = 0;
+
+		// 第 word_index 个数据字 (由两个比特块组成，LSB 在前)
+		uint64_t load_word( size_t word_index ) const noexcept
+		{
+			const BooleanBitWrapper* chunks = bits_value.chunk_data();
+			const size_t			 low_chunk = word_index * 2;
+			uint64_t				 value = chunks[ low_chunk ].bits;
+			if ( low_chunk + 1 < bits_value.chunk_count() )
+			{
+				value |= uint64_t( chunks[ low_chunk + 1 ].bits ) << 32;
+			}
+			return value;
+		}
+
+		void store_word( size_t word_index, uint64_t value ) noexcept
+		{
+			BooleanBitWrapper* chunks = bits_value.chunk_data();
+			const size_t	   low_chunk = word_index * 2;
+			chunks[ low_chunk ].bits = static_cast<uint32_t>( value );
+			if ( low_chunk + 1 < bits_value.chunk_count() )
+			{
+				chunks[ low_chunk + 1 ].bits = static_cast<uint32_t>( value >> 32 );
+			}
+		}
+
+		// 第 word_index 个数据字中属于有效比特的掩码
+		uint64_t valid_mask( size_t word_index ) const noexcept
+		{
+			const size_t remaining_bits = data_size - word_index * 64;
+			return remaining_bits >= 64 ? ~uint64_t( 0 ) : ( uint64_t( 1 ) << remaining_bits ) - 1;
+		}
+
+		// 在 levels 中查找第一个 >= from 的候选比特 (zeros 为 true 时数据字取反)
+		size_t find_next( const SummaryLevels& levels, bool zeros, size_t from ) const noexcept;
+
+		void build_levels();
+
+		// 数据字 word_index 被修改之后更新两套摘要
+		void update_word( size_t word_index ) noexcept;
+
+		// 数据字 [ first_word, last_word ] 被修改之后重新计算两套摘要
+		void refresh_words( size_t first_word, size_t last_word ) noexcept;
+
+		// 块的数量和第 block 个块覆盖的比特块范围
+		size_t block_count() const noexcept
+		{
+			return non_empty_levels.empty() ? 0 : non_empty_levels[ 0 ].size();
+		}
+
+		void block_chunk_range( size_t block, size_t& first_chunk, size_t& chunk_count ) const noexcept;
+
+		// 对每个没有被 skip_block( block ) 跳过的块调用 operation( first_chunk, chunk_count )，然后重新计算这个块的摘要
+		template <typename SkipBlock, typename Operation>
+		void apply_blocks( SkipBlock&& skip_block, Operation&& operation );
+
+		bool block_empty( size_t block ) const noexcept
+		{
+			return non_empty_levels[ 0 ][ block ] == 0;
+		}
+
+		void check_index( size_t index ) const
+		{
+			DefaultBitAccess::check_index( index, data_size, "Index out of range from hierarchical bit set" );
+		}
+	};
+}  // namespace TwilightDream
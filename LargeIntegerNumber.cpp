@@ -0,0 +1,718 @@
+#include "LargeIntegerNumber.hpp"
+
+#include <ostream>
+
+#if defined( __x86_64__ ) || defined( __i386__ ) || defined( _M_X64 ) || defined( _M_IX86 )
+#include <immintrin.h>
+#define LARGE_INTEGER_NUMBER_HAVE_ADDCARRY 1
+#endif
+
+#include "BitOperations.hpp"
+
+namespace TwilightDream
+{
+	namespace
+	{
+		using Limb = LargeIntegerNumber::limb_type;
+		using Limbs = std::vector<Limb>;
+
+		constexpr uint64_t limb_base = uint64_t( 1 ) << 32;
+
+		// 一组十进制数字 (10^9 是小于 2^32 的最大的 10 的幂)
+		constexpr Limb	 decimal_group_base = 1000000000;
+		constexpr size_t decimal_group_digits = 9;
+
+		inline Limb add_with_carry( Limb left, Limb right, unsigned char& carry ) noexcept
+		{
+#if defined( LARGE_INTEGER_NUMBER_HAVE_ADDCARRY )
+			unsigned int sum;
+			carry = _addcarry_u32( carry, left, right, &sum );
+			return sum;
+#else
+			uint64_t sum = uint64_t( left ) + right + carry;
+			carry = static_cast<unsigned char>( sum >> 32 );
+			return static_cast<Limb>( sum );
+#endif
+		}
+
+		inline Limb subtract_with_borrow( Limb left, Limb right, unsigned char& borrow ) noexcept
+		{
+#if defined( LARGE_INTEGER_NUMBER_HAVE_ADDCARRY )
+			unsigned int difference;
+			borrow = _subborrow_u32( borrow, left, right, &difference );
+			return difference;
+#else
+			uint64_t difference = uint64_t( left ) - right - borrow;
+			borrow = static_cast<unsigned char>( ( difference >> 32 ) & 1 );
+			return static_cast<Limb>( difference );
+#endif
+		}
+
+		inline void trim( Limbs& limbs ) noexcept
+		{
+			while ( !limbs.empty() && limbs.back() == 0 )
+			{
+				limbs.pop_back();
+			}
+		}
+
+		inline size_t significant_length( const Limb* limbs, size_t length ) noexcept
+		{
+			while ( length > 0 && limbs[ length - 1 ] == 0 )
+			{
+				--length;
+			}
+			return length;
+		}
+
+		int compare_magnitude( const Limb* left, size_t left_length, const Limb* right, size_t right_length ) noexcept
+		{
+			if ( left_length != right_length )
+			{
+				return left_length < right_length ? -1 : 1;
+			}
+			for ( size_t i = left_length; i > 0; --i )
+			{
+				if ( left[ i - 1 ] != right[ i - 1 ] )
+				{
+					return left[ i - 1 ] < right[ i - 1 ] ? -1 : 1;
+				}
+			}
+			return 0;
+		}
+
+		// destination[ 0, destination_length ) += source[ 0, source_length )，要求 source_length <= destination_length，返回最终的进位
+		unsigned char add_into( Limb* destination, size_t destination_length, const Limb* source, size_t source_length ) noexcept
+		{
+			unsigned char carry = 0;
+			size_t		  i = 0;
+			for ( ; i < source_length; ++i )
+			{
+				destination[ i ] = add_with_carry( destination[ i ], source[ i ], carry );
+			}
+			for ( ; carry != 0 && i < destination_length; ++i )
+			{
+				destination[ i ] = add_with_carry( destination[ i ], 0, carry );
+			}
+			return carry;
+		}
+
+		// destination[ 0, destination_length ) -= source[ 0, source_length )，要求 source_length <= destination_length，返回最终的借位
+		unsigned char subtract_from( Limb* destination, size_t destination_length, const Limb* source, size_t source_length ) noexcept
+		{
+			unsigned char borrow = 0;
+			size_t		  i = 0;
+			for ( ; i < source_length; ++i )
+			{
+				destination[ i ] = subtract_with_borrow( destination[ i ], source[ i ], borrow );
+			}
+			for ( ; borrow != 0 && i < destination_length; ++i )
+			{
+				destination[ i ] = subtract_with_borrow( destination[ i ], 0, borrow );
+			}
+			return borrow;
+		}
+
+		Limbs add_magnitude( const Limb* left, size_t left_length, const Limb* right, size_t right_length )
+		{
+			if ( left_length < right_length )
+			{
+				std::swap( left, right );
+				std::swap( left_length, right_length );
+			}
+			Limbs result( left_length + 1, 0 );
+			std::copy( left, left + left_length, result.begin() );
+			result[ left_length ] = add_into( result.data(), left_length, right, right_length );
+			trim( result );
+			return result;
+		}
+
+		// 要求 |left| >= |right|
+		Limbs subtract_magnitude( const Limb* left, size_t left_length, const Limb* right, size_t right_length )
+		{
+			Limbs result( left, left + left_length );
+			subtract_from( result.data(), left_length, right, right_length );
+			trim( result );
+			return result;
+		}
+
+		// output[ 0, left_length + right_length ) 必须已经清零
+		void multiply_schoolbook_into( const Limb* left, size_t left_length, const Limb* right, size_t right_length, Limb* output ) noexcept
+		{
+			for ( size_t i = 0; i < left_length; ++i )
+			{
+				const uint64_t multiplier = left[ i ];
+				if ( multiplier == 0 )
+				{
+					continue;
+				}
+				// (2^32 - 1)^2 + 2 * (2^32 - 1) == 2^64 - 1，所以乘积加上输出和进位不会溢出 64 位
+				uint64_t carry = 0;
+				for ( size_t j = 0; j < right_length; ++j )
+				{
+					const uint64_t product = multiplier * right[ j ] + output[ i + j ] + carry;
+					output[ i + j ] = static_cast<Limb>( product );
+					carry = product >> 32;
+				}
+				output[ i + right_length ] = static_cast<Limb>( carry );
+			}
+		}
+
+		// output[ 0, left_length + right_length ) 必须已经清零
+		void multiply_into( const Limb* left, size_t left_length, const Limb* right, size_t right_length, Limb* output, size_t threshold )
+		{
+			if ( left_length < right_length )
+			{
+				std::swap( left, right );
+				std::swap( left_length, right_length );
+			}
+			if ( right_length == 0 )
+			{
+				return;
+			}
+			if ( right_length < threshold )
+			{
+				multiply_schoolbook_into( left, left_length, right, right_length, output );
+				return;
+			}
+
+			// 长度相差很大时把长的乘数按短乘数的长度切块，每块都是接近平衡的乘法
+			if ( left_length >= 2 * right_length )
+			{
+				Limbs partial( 2 * right_length );
+				for ( size_t offset = 0; offset < left_length; offset += right_length )
+				{
+					const size_t length = std::min( right_length, left_length - offset );
+					std::fill( partial.begin(), partial.begin() + length + right_length, 0 );
+					multiply_into( left + offset, length, right, right_length, partial.data(), threshold );
+					add_into( output + offset, left_length + right_length - offset, partial.data(), length + right_length );
+				}
+				return;
+			}
+
+			/*
+				Karatsuba：x = x1 * B^h + x0，y = y1 * B^h + y0
+				z0 = x0 * y0，z2 = x1 * y1，z1 = (x0 + x1) * (y0 + y1) - z0 - z2
+				x * y = z2 * B^2h + z1 * B^h + z0
+				z0 与 z2 直接写到 output 中互不重叠的两段，z1 最后加到 output + h 上
+			*/
+			const size_t half = ( left_length + 1 ) / 2;
+			const Limb*	 left_low = left;
+			const Limb*	 left_high = left + half;
+			const size_t left_high_length = left_length - half;
+			const Limb*	 right_low = right;
+			const Limb*	 right_high = right + half;
+			const size_t right_high_length = right_length - half;
+
+			const size_t left_low_length = significant_length( left_low, half );
+			const size_t right_low_length = significant_length( right_low, half );
+
+			multiply_into( left_low, left_low_length, right_low, right_low_length, output, threshold );
+			multiply_into( left_high, left_high_length, right_high, right_high_length, output + 2 * half, threshold );
+
+			Limbs left_sum( half + 1, 0 );
+			std::copy( left_low, left_low + half, left_sum.begin() );
+			left_sum[ half ] = add_into( left_sum.data(), half, left_high, left_high_length );
+
+			Limbs right_sum( half + 1, 0 );
+			std::copy( right_low, right_low + half, right_sum.begin() );
+			right_sum[ half ] = add_into( right_sum.data(), half, right_high, right_high_length );
+
+			const size_t left_sum_length = significant_length( left_sum.data(), left_sum.size() );
+			const size_t right_sum_length = significant_length( right_sum.data(), right_sum.size() );
+
+			Limbs middle( 2 * half + 2, 0 );
+			multiply_into( left_sum.data(), left_sum_length, right_sum.data(), right_sum_length, middle.data(), threshold );
+			subtract_from( middle.data(), middle.size(), output, 2 * half );
+			subtract_from( middle.data(), middle.size(), output + 2 * half, left_high_length + right_high_length );
+
+			add_into( output + half, left_length + right_length - half, middle.data(), significant_length( middle.data(), middle.size() ) );
+		}
+
+		// limbs = limbs * multiplier + addend
+		void multiply_add_limb( Limbs& limbs, Limb multiplier, Limb addend )
+		{
+			uint64_t carry = addend;
+			for ( Limb& limb : limbs )
+			{
+				const uint64_t product = uint64_t( limb ) * multiplier + carry;
+				limb = static_cast<Limb>( product );
+				carry = product >> 32;
+			}
+			if ( carry != 0 )
+			{
+				limbs.push_back( static_cast<Limb>( carry ) );
+			}
+		}
+
+		// 原地除以单个肢，返回余数
+		Limb divide_by_limb( Limb* limbs, size_t length, Limb divisor ) noexcept
+		{
+			uint64_t remainder = 0;
+			for ( size_t i = length; i > 0; --i )
+			{
+				const uint64_t numerator = ( remainder << 32 ) | limbs[ i - 1 ];
+				limbs[ i - 1 ] = static_cast<Limb>( numerator / divisor );
+				remainder = numerator % divisor;
+			}
+			return static_cast<Limb>( remainder );
+		}
+
+		/*
+			Knuth 算法 D：要求 divisor_length >= 2，divisor 的最高肢非零，dividend_length >= divisor_length
+			先把两个数左移 shift 位，使除数的最高位为 1，这样每一步估计的商 qhat 最多大 2
+		*/
+		void divide_knuth( const Limb* dividend, size_t dividend_length, const Limb* divisor, size_t divisor_length, Limbs& quotient, Limbs& remainder )
+		{
+			const unsigned shift = count_leading_zeros64( divisor[ divisor_length - 1 ] ) - 32;
+
+			Limbs normalized_divisor( divisor_length );
+			Limbs normalized_dividend( dividend_length + 1 );
+			for ( size_t i = divisor_length - 1; i > 0; --i )
+			{
+				normalized_divisor[ i ] = ( divisor[ i ] << shift ) | ( shift != 0 ? divisor[ i - 1 ] >> ( 32 - shift ) : 0 );
+			}
+			normalized_divisor[ 0 ] = divisor[ 0 ] << shift;
+
+			normalized_dividend[ dividend_length ] = shift != 0 ? dividend[ dividend_length - 1 ] >> ( 32 - shift ) : 0;
+			for ( size_t i = dividend_length - 1; i > 0; --i )
+			{
+				normalized_dividend[ i ] = ( dividend[ i ] << shift ) | ( shift != 0 ? dividend[ i - 1 ] >> ( 32 - shift ) : 0 );
+			}
+			normalized_dividend[ 0 ] = dividend[ 0 ] << shift;
+
+			const uint64_t divisor_top = normalized_divisor[ divisor_length - 1 ];
+			const uint64_t divisor_next = normalized_divisor[ divisor_length - 2 ];
+
+			quotient.assign( dividend_length - divisor_length + 1, 0 );
+			for ( size_t j = dividend_length - divisor_length + 1; j > 0; --j )
+			{
+				Limb* window = normalized_dividend.data() + ( j - 1 );
+
+				// 用最高的两个肢估计商，再用次高的肢修正
+				const uint64_t numerator = ( uint64_t( window[ divisor_length ] ) << 32 ) | window[ divisor_length - 1 ];
+				uint64_t	   estimate = numerator / divisor_top;
+				uint64_t	   estimate_remainder = numerator % divisor_top;
+				while ( estimate >= limb_base || estimate * divisor_next > ( ( estimate_remainder << 32 ) | window[ divisor_length - 2 ] ) )
+				{
+					--estimate;
+					estimate_remainder += divisor_top;
+					if ( estimate_remainder >= limb_base )
+					{
+						break;
+					}
+				}
+
+				// window -= estimate * divisor
+				uint64_t	  carry = 0;
+				unsigned char borrow = 0;
+				for ( size_t i = 0; i < divisor_length; ++i )
+				{
+					const uint64_t product = estimate * normalized_divisor[ i ] + carry;
+					carry = product >> 32;
+					window[ i ] = subtract_with_borrow( window[ i ], static_cast<Limb>( product ), borrow );
+				}
+				window[ divisor_length ] = subtract_with_borrow( window[ divisor_length ], static_cast<Limb>( carry ), borrow );
+
+				// 估计大了 1 (概率约 2/B)：加回一次除数
+				if ( borrow != 0 )
+				{
+					--estimate;
+					window[ divisor_length ] += add_into( window, divisor_length, normalized_divisor.data(), divisor_length );
+				}
+				quotient[ j - 1 ] = static_cast<Limb>( estimate );
+			}
+
+			remainder.assign( divisor_length, 0 );
+			for ( size_t i = 0; i < divisor_length; ++i )
+			{
+				remainder[ i ] = ( normalized_dividend[ i ] >> shift ) | ( shift != 0 ? normalized_dividend[ i + 1 ] << ( 32 - shift ) : 0 );
+			}
+			trim( quotient );
+			trim( remainder );
+		}
+
+		int digit_value( char character ) noexcept
+		{
+			if ( character >= '0' && character <= '9' )
+				return character - '0';
+			if ( character >= 'a' && character <= 'f' )
+				return character - 'a' + 10;
+			if ( character >= 'A' && character <= 'F' )
+				return character - 'A' + 10;
+			return -1;
+		}
+
+		// 2 或 16 进制：每个数字正好对应 bits_per_digit 个比特，从最低位的数字开始直接拼进肢里
+		Limbs parse_power_of_two( const std::string& digits, size_t begin, unsigned bits_per_digit, int base )
+		{
+			Limbs  limbs( ( ( digits.size() - begin ) * bits_per_digit + 31 ) / 32, 0 );
+			size_t bit_index = 0;
+			for ( size_t i = digits.size(); i > begin; --i, bit_index += bits_per_digit )
+			{
+				const int value = digit_value( digits[ i - 1 ] );
+				if ( value < 0 || value >= base )
+				{
+					throw std::invalid_argument( "Invalid digit in LargeIntegerNumber string" );
+				}
+				limbs[ bit_index / 32 ] |= Limb( value ) << ( bit_index % 32 );
+			}
+			trim( limbs );
+			return limbs;
+		}
+
+		Limbs parse_decimal( const std::string& digits, size_t begin )
+		{
+			Limbs  limbs;
+			size_t group_length = ( digits.size() - begin ) % decimal_group_digits;
+			if ( group_length == 0 )
+			{
+				group_length = decimal_group_digits;
+			}
+			for ( size_t position = begin; position < digits.size(); position += group_length, group_length = decimal_group_digits )
+			{
+				Limb group = 0;
+				Limb group_base = 1;
+				for ( size_t i = position; i < position + group_length; ++i )
+				{
+					if ( digits[ i ] < '0' || digits[ i ] > '9' )
+					{
+						throw std::invalid_argument( "Invalid digit in LargeIntegerNumber string" );
+					}
+					group = group * 10 + Limb( digits[ i ] - '0' );
+					group_base *= 10;
+				}
+				multiply_add_limb( limbs, group_base, group );
+			}
+			trim( limbs );
+			return limbs;
+		}
+	}  // namespace
+
+	LargeIntegerNumber::LargeIntegerNumber( int64_t value )
+	{
+		// 取绝对值时先转成无符号数，INT64_MIN 也不会溢出
+		const uint64_t absolute = value < 0 ? uint64_t( 0 ) - static_cast<uint64_t>( value ) : static_cast<uint64_t>( value );
+		*this = from_unsigned( absolute );
+		negative_sign = value < 0;
+	}
+
+	LargeIntegerNumber::LargeIntegerNumber( const std::string& string, int base )
+	{
+		size_t begin = 0;
+		bool   negative = false;
+		if ( !string.empty() && ( string[ 0 ] == '-' || string[ 0 ] == '+' ) )
+		{
+			negative = string[ 0 ] == '-';
+			begin = 1;
+		}
+		if ( begin == string.size() )
+		{
+			throw std::invalid_argument( "Empty LargeIntegerNumber string" );
+		}
+
+		Limbs limbs;
+		switch ( base )
+		{
+			case 2:
+				limbs = parse_power_of_two( string, begin, 1, 2 );
+				break;
+			case 10:
+				limbs = parse_decimal( string, begin );
+				break;
+			case 16:
+				limbs = parse_power_of_two( string, begin, 4, 16 );
+				break;
+			default:
+				throw std::invalid_argument( "Invalid format specifier" );
+		}
+		*this = from_limbs( std::move( limbs ), negative );
+	}
+
+	LargeIntegerNumber::LargeIntegerNumber( const DynamicBitSet& magnitude, bool negative )
+	{
+		const Limb* chunks = reinterpret_cast<const Limb*>( magnitude.chunk_data() );
+		*this = from_limbs( Limbs( chunks, chunks + magnitude.chunk_count() ), negative );
+	}
+
+	LargeIntegerNumber LargeIntegerNumber::from_unsigned( uint64_t value )
+	{
+		return from_limbs( Limbs { static_cast<Limb>( value ), static_cast<Limb>( value >> 32 ) }, false );
+	}
+
+	LargeIntegerNumber LargeIntegerNumber::from_limbs( std::vector<limb_type>&& limbs, bool negative )
+	{
+		trim( limbs );
+		LargeIntegerNumber result;
+		if ( !limbs.empty() )
+		{
+			result.magnitude_bitset = DynamicBitSet( limbs );
+			result.negative_sign = negative;
+		}
+		return result;
+	}
+
+	const LargeIntegerNumber::limb_type* LargeIntegerNumber::limbs() const noexcept
+	{
+		// BooleanBitWrapper 是只包含一个 uint32_t 的标准布局类型 (见 BooleanBitWrapper.hpp 中的 static_assert)
+		return reinterpret_cast<const limb_type*>( magnitude_bitset.chunk_data() );
+	}
+
+	size_t LargeIntegerNumber::bit_length() const noexcept
+	{
+		if ( is_zero() )
+		{
+			return 0;
+		}
+		return limb_count() * limb_bits - ( count_leading_zeros64( limbs()[ limb_count() - 1 ] ) - 32 );
+	}
+
+	LargeIntegerNumber LargeIntegerNumber::abs() const
+	{
+		LargeIntegerNumber result( *this );
+		result.negative_sign = false;
+		return result;
+	}
+
+	int LargeIntegerNumber::compare( const LargeIntegerNumber& other ) const noexcept
+	{
+		if ( sign() != other.sign() )
+		{
+			return sign() < other.sign() ? -1 : 1;
+		}
+		const int magnitude_order = compare_magnitude( limbs(), limb_count(), other.limbs(), other.limb_count() );
+		return negative_sign ? -magnitude_order : magnitude_order;
+	}
+
+	LargeIntegerNumber LargeIntegerNumber::operator-() const
+	{
+		LargeIntegerNumber result( *this );
+		if ( !result.is_zero() )
+		{
+			result.negative_sign = !result.negative_sign;
+		}
+		return result;
+	}
+
+	LargeIntegerNumber& LargeIntegerNumber::operator+=( const LargeIntegerNumber& other )
+	{
+		if ( negative_sign == other.negative_sign )
+		{
+			*this = from_limbs( add_magnitude( limbs(), limb_count(), other.limbs(), other.limb_count() ), negative_sign );
+			return *this;
+		}
+
+		// 异号：用绝对值大的减去小的，符号跟随绝对值大的一方
+		if ( compare_magnitude( limbs(), limb_count(), other.limbs(), other.limb_count() ) >= 0 )
+		{
+			*this = from_limbs( subtract_magnitude( limbs(), limb_count(), other.limbs(), other.limb_count() ), negative_sign );
+		}
+		else
+		{
+			*this = from_limbs( subtract_magnitude( other.limbs(), other.limb_count(), limbs(), limb_count() ), other.negative_sign );
+		}
+		return *this;
+	}
+
+	LargeIntegerNumber& LargeIntegerNumber::operator-=( const LargeIntegerNumber& other )
+	{
+		return *this += -other;
+	}
+
+	LargeIntegerNumber& LargeIntegerNumber::operator*=( const LargeIntegerNumber& other )
+	{
+		return *this = multiply( *this, other );
+	}
+
+	LargeIntegerNumber& LargeIntegerNumber::operator/=( const LargeIntegerNumber& other )
+	{
+		return *this = divide( *this, other ).first;
+	}
+
+	LargeIntegerNumber& LargeIntegerNumber::operator%=( const LargeIntegerNumber& other )
+	{
+		return *this = divide( *this, other ).second;
+	}
+
+	LargeIntegerNumber& LargeIntegerNumber::operator<<=( size_t shift )
+	{
+		if ( is_zero() || shift == 0 )
+		{
+			return *this;
+		}
+		const size_t   limb_shift = shift / limb_bits;
+		const unsigned bit_shift = static_cast<unsigned>( shift % limb_bits );
+		const Limb*	   source = limbs();
+		const size_t   length = limb_count();
+
+		Limbs result( length + limb_shift + 1, 0 );
+		for ( size_t i = 0; i < length; ++i )
+		{
+			result[ i + limb_shift ] |= source[ i ] << bit_shift;
+			if ( bit_shift != 0 )
+			{
+				result[ i + limb_shift + 1 ] = source[ i ] >> ( limb_bits - bit_shift );
+			}
+		}
+		return *this = from_limbs( std::move( result ), negative_sign );
+	}
+
+	LargeIntegerNumber& LargeIntegerNumber::operator>>=( size_t shift )
+	{
+		const size_t limb_shift = shift / limb_bits;
+		if ( limb_shift >= limb_count() )
+		{
+			return *this = LargeIntegerNumber();
+		}
+		const unsigned bit_shift = static_cast<unsigned>( shift % limb_bits );
+		const Limb*	   source = limbs();
+		const size_t   length = limb_count() - limb_shift;
+
+		Limbs result( length, 0 );
+		for ( size_t i = 0; i < length; ++i )
+		{
+			result[ i ] = source[ i + limb_shift ] >> bit_shift;
+			if ( bit_shift != 0 && i + limb_shift + 1 < limb_count() )
+			{
+				result[ i ] |= source[ i + limb_shift + 1 ] << ( limb_bits - bit_shift );
+			}
+		}
+		return *this = from_limbs( std::move( result ), negative_sign );
+	}
+
+	LargeIntegerNumber LargeIntegerNumber::multiply_with_threshold( const LargeIntegerNumber& left, const LargeIntegerNumber& right, size_t threshold )
+	{
+		if ( left.is_zero() || right.is_zero() )
+		{
+			return LargeIntegerNumber();
+		}
+		Limbs result( left.limb_count() + right.limb_count(), 0 );
+		multiply_into( left.limbs(), left.limb_count(), right.limbs(), right.limb_count(), result.data(), threshold );
+		return from_limbs( std::move( result ), left.negative_sign != right.negative_sign );
+	}
+
+	LargeIntegerNumber LargeIntegerNumber::multiply( const LargeIntegerNumber& left, const LargeIntegerNumber& right )
+	{
+		return multiply_with_threshold( left, right, karatsuba_threshold );
+	}
+
+	LargeIntegerNumber LargeIntegerNumber::multiply_schoolbook( const LargeIntegerNumber& left, const LargeIntegerNumber& right )
+	{
+		return multiply_with_threshold( left, right, static_cast<size_t>( -1 ) );
+	}
+
+	LargeIntegerNumber LargeIntegerNumber::multiply_karatsuba( const LargeIntegerNumber& left, const LargeIntegerNumber& right )
+	{
+		// 阈值为 2：一直递归到单个肢 (Karatsuba 至少需要把每个乘数分成两半)
+		return multiply_with_threshold( left, right, 2 );
+	}
+
+	std::pair<LargeIntegerNumber, LargeIntegerNumber> LargeIntegerNumber::divide( const LargeIntegerNumber& dividend, const LargeIntegerNumber& divisor )
+	{
+		if ( divisor.is_zero() )
+		{
+			throw std::invalid_argument( "Division by zero" );
+		}
+		if ( compare_magnitude( dividend.limbs(), dividend.limb_count(), divisor.limbs(), divisor.limb_count() ) < 0 )
+		{
+			return { LargeIntegerNumber(), dividend };
+		}
+
+		const bool quotient_negative = dividend.negative_sign != divisor.negative_sign;
+		Limbs	   quotient;
+		Limbs	   remainder;
+		if ( divisor.limb_count() == 1 )
+		{
+			quotient.assign( dividend.limbs(), dividend.limbs() + dividend.limb_count() );
+			remainder.push_back( divide_by_limb( quotient.data(), quotient.size(), divisor.limbs()[ 0 ] ) );
+		}
+		else
+		{
+			divide_knuth( dividend.limbs(), dividend.limb_count(), divisor.limbs(), divisor.limb_count(), quotient, remainder );
+		}
+		return { from_limbs( std::move( quotient ), quotient_negative ), from_limbs( std::move( remainder ), dividend.negative_sign ) };
+	}
+
+	LargeIntegerNumber LargeIntegerNumber::pow_mod( const LargeIntegerNumber& base, const LargeIntegerNumber& exponent, const LargeIntegerNumber& modulus )
+	{
+		if ( modulus.sign() <= 0 )
+		{
+			throw std::invalid_argument( "pow_mod requires a positive modulus" );
+		}
+		if ( exponent.is_negative() )
+		{
+			throw std::invalid_argument( "pow_mod requires a non-negative exponent" );
+		}
+
+		LargeIntegerNumber reduced_base = base % modulus;
+		if ( reduced_base.is_negative() )
+		{
+			reduced_base += modulus;
+		}
+
+		LargeIntegerNumber result = LargeIntegerNumber( 1 ) % modulus;
+		const Limb*		   exponent_limbs = exponent.limbs();
+		for ( size_t bit = exponent.bit_length(); bit > 0; --bit )
+		{
+			result = ( result * result ) % modulus;
+			if ( ( exponent_limbs[ ( bit - 1 ) / limb_bits ] >> ( ( bit - 1 ) % limb_bits ) ) & 1 )
+			{
+				result = ( result * reduced_base ) % modulus;
+			}
+		}
+		return result;
+	}
+
+	std::string LargeIntegerNumber::to_string( int base ) const
+	{
+		if ( base != 2 && base != 10 && base != 16 )
+		{
+			throw std::invalid_argument( "Invalid format specifier" );
+		}
+		if ( is_zero() )
+		{
+			return "0";
+		}
+
+		std::string digits;
+		if ( base == 10 )
+		{
+			// 反复除以 10^9，每次得到最低的 9 位十进制数字
+			Limbs  quotient( limbs(), limbs() + limb_count() );
+			size_t length = quotient.size();
+			while ( length > 0 )
+			{
+				Limb group = divide_by_limb( quotient.data(), length, decimal_group_base );
+				length = significant_length( quotient.data(), length );
+				for ( size_t i = 0; i < decimal_group_digits && ( length > 0 || group != 0 ); ++i )
+				{
+					digits.push_back( static_cast<char>( '0' + group % 10 ) );
+					group /= 10;
+				}
+			}
+		}
+		else
+		{
+			static const char hex_chars[] = "0123456789ABCDEF";
+			const unsigned	  bits_per_digit = base == 16 ? 4 : 1;
+			const Limb		  digit_mask = ( Limb( 1 ) << bits_per_digit ) - 1;
+			const size_t	  bits = bit_length();
+			for ( size_t bit_index = 0; bit_index < bits; bit_index += bits_per_digit )
+			{
+				digits.push_back( hex_chars[ ( limbs()[ bit_index / limb_bits ] >> ( bit_index % limb_bits ) ) & digit_mask ] );
+			}
+		}
+
+		if ( negative_sign )
+		{
+			digits.push_back( '-' );
+		}
+		std::reverse( digits.begin(), digits.end() );
+		return digits;
+	}
+
+	std::ostream& operator<<( std::ostream& stream, const LargeIntegerNumber& value )
+	{
+		return stream << value.to_string();
+	}
+}  // namespace TwilightDream
@@ -0,0 +1,189 @@
+#pragma once
+
+#include <cstdint>
+#include <cstddef>
+
+#include <iosfwd>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "DynamicBitSet.hpp"
+
+namespace TwilightDream
+{
+	/*
+		LargeIntegerNumber
+		任意精度的有符号整数，使用 符号 + 绝对值 (sign-magnitude) 表示。
+		- 绝对值保存在 DynamicBitSet 中，它的每个 32 位比特块就是一个"肢" (limb)，低位的肢在前 (与 DynamicBitSet 的 LSB 在块 0 一致)，
+		  最高的肢总是非零 (零没有任何肢)。
+		- 加减法：带进位 / 借位链 (x86 上使用 _addcarry_u32 / _subborrow_u32，即 adc / sbb)。
+		- 乘法：较短的乘数少于 karatsuba_threshold 个肢时使用教科书 (schoolbook) 乘法，否则使用 Karatsuba 递归。
+		- 除法：Knuth 算法 D (TAOCP 4.3.1)。商向零截断，余数与被除数同号 (与 C++ 内建整数一致)。
+		- 模幂：从高位到低位的平方-乘。
+		- 十进制转换按 10^9 一组处理，代替 DynamicBitSet 中基于字符串逐位相加的 HighPrecisionNumberAdd。
+	*/
+	class LargeIntegerNumber
+	{
+	public:
+		using limb_type = uint32_t;
+
+		static constexpr size_t limb_bits = 32;
+
+		// 两个乘数都至少有这么多个肢时才使用 Karatsuba
+		static constexpr size_t karatsuba_threshold = 40;
+
+		LargeIntegerNumber() = default;
+
+		LargeIntegerNumber( int64_t value );
+
+		// 字符串可以带前导的 '+' 或 '-'，base 为 2、10 或 16；格式错误时抛出 std::invalid_argument
+		explicit LargeIntegerNumber( const std::string& string, int base = 10 );
+
+		// 把 DynamicBitSet 的比特当作绝对值 (LSB 在索引 0)
+		explicit LargeIntegerNumber( const DynamicBitSet& magnitude, bool negative = false );
+
+		static LargeIntegerNumber from_unsigned( uint64_t value );
+
+		// 绝对值 (每个比特块是一个肢，chunk_count() == limb_count())
+		const DynamicBitSet& magnitude() const noexcept
+		{
+			return magnitude_bitset;
+		}
+
+		bool is_negative() const noexcept
+		{
+			return negative_sign;
+		}
+
+		bool is_zero() const noexcept
+		{
+			return magnitude_bitset.chunk_count() == 0;
+		}
+
+		// -1、0 或 1
+		int sign() const noexcept
+		{
+			return is_zero() ? 0 : ( negative_sign ? -1 : 1 );
+		}
+
+		size_t limb_count() const noexcept
+		{
+			return magnitude_bitset.chunk_count();
+		}
+
+		// 绝对值的二进制位数 (零为 0)
+		size_t bit_length() const noexcept;
+
+		LargeIntegerNumber abs() const;
+
+		// base 为 2、10 或 16 (十六进制使用大写字母)
+		std::string to_string( int base = 10 ) const;
+
+		// 按数值比较，返回 -1、0 或 1
+		int compare( const LargeIntegerNumber& other ) const noexcept;
+
+		LargeIntegerNumber operator-() const;
+
+		LargeIntegerNumber& operator+=( const LargeIntegerNumber& other );
+		LargeIntegerNumber& operator-=( const LargeIntegerNumber& other );
+		LargeIntegerNumber& operator*=( const LargeIntegerNumber& other );
+		LargeIntegerNumber& operator/=( const LargeIntegerNumber& other );
+		LargeIntegerNumber& operator%=( const LargeIntegerNumber& other );
+
+		// 移位作用在绝对值上 (右移对负数是向零截断，而不是向负无穷)
+		LargeIntegerNumber& operator<<=( size_t shift );
+		LargeIntegerNumber& operator>>=( size_t shift );
+
+		friend LargeIntegerNumber operator+( LargeIntegerNumber left, const LargeIntegerNumber& right )
+		{
+			return left += right;
+		}
+
+		friend LargeIntegerNumber operator-( LargeIntegerNumber left, const LargeIntegerNumber& right )
+		{
+			return left -= right;
+		}
+
+		friend LargeIntegerNumber operator*( const LargeIntegerNumber& left, const LargeIntegerNumber& right )
+		{
+			return multiply( left, right );
+		}
+
+		friend LargeIntegerNumber operator/( const LargeIntegerNumber& left, const LargeIntegerNumber& right )
+		{
+			return divide( left, right ).first;
+		}
+
+		friend LargeIntegerNumber operator%( const LargeIntegerNumber& left, const LargeIntegerNumber& right )
+		{
+			return divide( left, right ).second;
+		}
+
+		friend LargeIntegerNumber operator<<( LargeIntegerNumber value, size_t shift )
+		{
+			return value <<= shift;
+		}
+
+		friend LargeIntegerNumber operator>>( LargeIntegerNumber value, size_t shift )
+		{
+			return value >>= shift;
+		}
+
+		friend bool operator==( const LargeIntegerNumber& left, const LargeIntegerNumber& right ) noexcept
+		{
+			return left.compare( right ) == 0;
+		}
+
+		friend bool operator!=( const LargeIntegerNumber& left, const LargeIntegerNumber& right ) noexcept
+		{
+			return left.compare( right ) != 0;
+		}
+
+		friend bool operator<( const LargeIntegerNumber& left, const LargeIntegerNumber& right ) noexcept
+		{
+			return left.compare( right ) < 0;
+		}
+
+		friend bool operator<=( const LargeIntegerNumber& left, const LargeIntegerNumber& right ) noexcept
+		{
+			return left.compare( right ) <= 0;
+		}
+
+		friend bool operator>( const LargeIntegerNumber& left, const LargeIntegerNumber& right ) noexcept
+		{
+			return left.compare( right ) > 0;
+		}
+
+		friend bool operator>=( const LargeIntegerNumber& left, const LargeIntegerNumber& right ) noexcept
+		{
+			return left.compare( right ) >= 0;
+		}
+
+		// 按 karatsuba_threshold 自动选择算法
+		static LargeIntegerNumber multiply( const LargeIntegerNumber& left, const LargeIntegerNumber& right );
+
+		// 强制使用某一种乘法 (用于测试和基准测试)；multiply_karatsuba 一直递归到单个肢，不使用 karatsuba_threshold
+		static LargeIntegerNumber multiply_schoolbook( const LargeIntegerNumber& left, const LargeIntegerNumber& right );
+		static LargeIntegerNumber multiply_karatsuba( const LargeIntegerNumber& left, const LargeIntegerNumber& right );
+
+		// 返回 { 商, 余数 }；除数为零时抛出 std::invalid_argument
+		static std::pair<LargeIntegerNumber, LargeIntegerNumber> divide( const LargeIntegerNumber& dividend, const LargeIntegerNumber& divisor );
+
+		// base^exponent mod modulus，结果在 [0, modulus) 内；要求 exponent >= 0、modulus > 0，否则抛出 std::invalid_argument
+		static LargeIntegerNumber pow_mod( const LargeIntegerNumber& base, const LargeIntegerNumber& exponent, const LargeIntegerNumber& modulus );
+
+	private:
+		// 去掉最高位的零肢之后放进 DynamicBitSet
+		static LargeIntegerNumber from_limbs( std::vector<limb_type>&& limbs, bool negative );
+
+		const limb_type* limbs() const noexcept;
+
+		static LargeIntegerNumber multiply_with_threshold( const LargeIntegerNumber& left, const LargeIntegerNumber& right, size_t threshold );
+
+		DynamicBitSet magnitude_bitset;
+		bool		  negative_sign = false;
+	};
+
+	std::ostream& operator<<( std::ostream& stream, const LargeIntegerNumber& value );
+}  // namespace TwilightDream
@@ -0,0 +1,327 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+#include <stdexcept>
+#include <type_traits>
+#include <vector>
+
+#include "DynamicBitSet.hpp"
+#include "DynamicBitSetKernels.hpp"
+
+namespace TwilightDream
+{
+	/*
+		定宽整数数组 (Packed fixed-width integers)
+		把 width 位 (1 <= width <= 32) 的整数紧密地存放在 DynamicBitSet 的比特块中：第 i 个值占比特 [ i * width, i * width + width )，低位在前。
+		- get / set 只访问值所在的一个或两个相邻的比特块：拼成 64 位之后一次移位和掩码，而不是 width 次单独的比特访问。
+		- pack / unpack 批量转换：每 32 个值正好占 width 个比特块 (FastPFor 的分块方式，但是顺序地水平存放，与 get / set 的布局相同)，
+		  整块的部分交给 chunks_pack_blocks / chunks_unpack_blocks，只有头尾不成块的部分逐个处理。
+		- PackedIntArray<Width> 拥有存储，宽度是编译期常量；PackedIntView / ConstPackedIntView 是运行时宽度的视图，
+		  不拥有存储，比特集重新分配 (例如 resize) 之后视图失效。
+		- set 和 pack 只保留值的低 width 位。
+	*/
+
+	namespace packed_detail
+	{
+		inline uint32_t width_mask( unsigned width ) noexcept
+		{
+			return static_cast<uint32_t>( ~uint64_t( 0 ) >> ( 64 - width ) );
+		}
+
+		// 从比特 bit 开始的 width 位 (1 <= width <= 32)，不要求与 width 对齐
+		inline uint32_t get_bits( const BooleanBitWrapper* chunks, size_t bit, unsigned width ) noexcept
+		{
+			const size_t   chunk = bit / 32;
+			const unsigned shift = static_cast<unsigned>( bit % 32 );
+			// 不跨越比特块时 next 就是 chunk，拼出的高 32 位不影响结果 (不需要分支，也不会读到存储之外)
+			const size_t   next = chunk + ( shift + width > 32 );
+			const uint64_t window = chunks[ chunk ].bits | ( uint64_t( chunks[ next ].bits ) << 32 );
+			return static_cast<uint32_t>( window >> shift ) & width_mask( width );
+		}
+
+		inline void set_bits( BooleanBitWrapper* chunks, size_t bit, unsigned width, uint32_t value ) noexcept
+		{
+			const size_t   chunk = bit / 32;
+			const unsigned shift = static_cast<unsigned>( bit % 32 );
+			const size_t   next = chunk + ( shift + width > 32 );
+			const uint64_t mask = uint64_t( width_mask( width ) ) << shift;
+			uint64_t	   window = chunks[ chunk ].bits | ( uint64_t( chunks[ next ].bits ) << 32 );
+			window = ( window & ~mask ) | ( ( uint64_t( value ) << shift ) & mask );
+			// 先写高位的块：不跨越时 next == chunk，随后写入的低 32 位才是正确的结果
+			chunks[ next ].bits = static_cast<uint32_t>( window >> 32 );
+			chunks[ chunk ].bits = static_cast<uint32_t>( window );
+		}
+
+		inline uint32_t get( const BooleanBitWrapper* chunks, size_t index, unsigned width ) noexcept
+		{
+			return get_bits( chunks, index * width, width );
+		}
+
+		inline void set( BooleanBitWrapper* chunks, size_t index, unsigned width, uint32_t value ) noexcept
+		{
+			set_bits( chunks, index * width, width, value );
+		}
+
+		inline void unpack( const BooleanBitWrapper* chunks, unsigned width, size_t first, size_t count, uint32_t* output ) noexcept
+		{
+			size_t		 index = first;
+			const size_t end = first + count;
+			for ( ; index < end && index % 32 != 0; ++index )
+			{
+				*output++ = get( chunks, index, width );
+			}
+			const size_t block_count = ( end - index ) / 32;
+			chunks_unpack_blocks( chunks + index / 32 * width, output, block_count, width );
+			index += block_count * 32;
+			output += block_count * 32;
+			for ( ; index < end; ++index )
+			{
+				*output++ = get( chunks, index, width );
+			}
+		}
+
+		inline void pack( BooleanBitWrapper* chunks, unsigned width, size_t first, const uint32_t* values, size_t count ) noexcept
+		{
+			size_t		 index = first;
+			const size_t end = first + count;
+			for ( ; index < end && index % 32 != 0; ++index )
+			{
+				set( chunks, index, width, *values++ );
+			}
+			const size_t block_count = ( end - index ) / 32;
+			chunks_pack_blocks( chunks + index / 32 * width, values, block_count, width );
+			index += block_count * 32;
+			values += block_count * 32;
+			for ( ; index < end; ++index )
+			{
+				set( chunks, index, width, *values++ );
+			}
+		}
+
+		inline unsigned check_width( unsigned width )
+		{
+			if ( width == 0 || width > 32 )
+			{
+				throw std::invalid_argument( "Packed integer width must be between 1 and 32" );
+			}
+			return width;
+		}
+
+		inline void check_range( size_t first, size_t count, size_t size )
+		{
+			if ( first > size || count > size - first )
+			{
+				throw std::out_of_range( "Range out of range from packed integer array" );
+			}
+		}
+	}  // namespace packed_detail
+
+	// Chunk 为 const BooleanBitWrapper 时是只读的视图
+	template <typename Chunk>
+	class BasicPackedIntView
+	{
+	public:
+		using Bits = std::conditional_t<std::is_const_v<Chunk>, const DynamicBitSet, DynamicBitSet>;
+
+		// 视图覆盖 bits 的全部存储，即 bits.chunk_count() * 32 / width 个值
+		// (不使用 bit_size()：它是最高的'1'所在的位置，末尾的值为 0 时会变小)
+		BasicPackedIntView( Bits& bits, unsigned width )
+			: chunks( bits.chunk_data() ), data_size( bits.chunk_count() * 32 / packed_detail::check_width( width ) ), value_width( width )
+		{}
+
+		// 视图覆盖 bits 的前 size 个值；size * width 超出存储时抛出 std::out_of_range
+		BasicPackedIntView( Bits& bits, size_t size, unsigned width )
+			: chunks( bits.chunk_data() ), data_size( size ), value_width( packed_detail::check_width( width ) )
+		{
+			packed_detail::check_range( 0, size, bits.chunk_count() * 32 / width );
+		}
+
+		// 直接在比特块上：chunks 至少要有 ( size * width + 31 ) / 32 个
+		BasicPackedIntView( Chunk* chunks, size_t size, unsigned width )
+			: chunks( chunks ), data_size( size ), value_width( packed_detail::check_width( width ) )
+		{}
+
+		// 可写的视图可以转换为只读的视图
+		template <typename Other, typename = std::enable_if_t<std::is_const_v<Chunk> && std::is_same_v<const Other, Chunk>>>
+		BasicPackedIntView( const BasicPackedIntView<Other>& other ) noexcept
+			: chunks( other.chunk_data() ), data_size( other.size() ), value_width( other.width() )
+		{}
+
+		size_t size() const noexcept
+		{
+			return data_size;
+		}
+
+		unsigned width() const noexcept
+		{
+			return value_width;
+		}
+
+		Chunk* chunk_data() const noexcept
+		{
+			return chunks;
+		}
+
+		uint32_t get( size_t index ) const
+		{
+			check_index( index );
+			return packed_detail::get( chunks, index, value_width );
+		}
+
+		uint32_t get_unchecked( size_t index ) const noexcept
+		{
+			return packed_detail::get( chunks, index, value_width );
+		}
+
+		uint32_t operator[]( size_t index ) const
+		{
+			return get( index );
+		}
+
+		void set( size_t index, uint32_t value ) const
+		{
+			static_assert( !std::is_const_v<Chunk>, "Cannot modify through a ConstPackedIntView" );
+			check_index( index );
+			packed_detail::set( chunks, index, value_width, value );
+		}
+
+		void set_unchecked( size_t index, uint32_t value ) const noexcept
+		{
+			static_assert( !std::is_const_v<Chunk>, "Cannot modify through a ConstPackedIntView" );
+			packed_detail::set( chunks, index, value_width, value );
+		}
+
+		// 把值 [ first, first + count ) 写到 output
+		void unpack( size_t first, size_t count, uint32_t* output ) const
+		{
+			packed_detail::check_range( first, count, data_size );
+			packed_detail::unpack( chunks, value_width, first, count, output );
+		}
+
+		std::vector<uint32_t> unpack() const
+		{
+			std::vector<uint32_t> values( data_size );
+			packed_detail::unpack( chunks, value_width, 0, data_size, values.data() );
+			return values;
+		}
+
+		// 把 values[ 0, count ) 写到值 [ first, first + count )
+		void pack( size_t first, const uint32_t* values, size_t count ) const
+		{
+			static_assert( !std::is_const_v<Chunk>, "Cannot modify through a ConstPackedIntView" );
+			packed_detail::check_range( first, count, data_size );
+			packed_detail::pack( chunks, value_width, first, values, count );
+		}
+
+		void pack( const std::vector<uint32_t>& values, size_t first = 0 ) const
+		{
+			pack( first, values.data(), values.size() );
+		}
+
+	private:
+		Chunk*	 chunks;
+		size_t	 data_size;
+		unsigned value_width;
+
+		void check_index( size_t index ) const
+		{
+			DefaultBitAccess::check_index( index, data_size, "Index out of range from packed integer array" );
+		}
+	};
+
+	using PackedIntView = BasicPackedIntView<BooleanBitWrapper>;
+	using ConstPackedIntView = BasicPackedIntView<const BooleanBitWrapper>;
+
+	template <unsigned Width>
+	class PackedIntArray
+	{
+		static_assert( Width >= 1 && Width <= 32, "Packed integer width must be between 1 and 32" );
+
+	public:
+		explicit PackedIntArray( size_t size = 0 ) : bits_value( size * Width, false ), data_size( size ) {}
+
+		explicit PackedIntArray( const std::vector<uint32_t>& values ) : PackedIntArray( values.size() )
+		{
+			view().pack( values );
+		}
+
+		static constexpr unsigned width() noexcept
+		{
+			return Width;
+		}
+
+		size_t size() const noexcept
+		{
+			return data_size;
+		}
+
+		// 底层的比特 (bit_size() 是 size() * Width)
+		const DynamicBitSet& bits() const noexcept
+		{
+			return bits_value;
+		}
+
+		PackedIntView view() noexcept
+		{
+			return PackedIntView( bits_value.chunk_data(), data_size, Width );
+		}
+
+		ConstPackedIntView view() const noexcept
+		{
+			return ConstPackedIntView( bits_value.chunk_data(), data_size, Width );
+		}
+
+		uint32_t get( size_t index ) const
+		{
+			DefaultBitAccess::check_index( index, data_size, "Index out of range from packed integer array" );
+			return packed_detail::get( bits_value.chunk_data(), index, Width );
+		}
+
+		uint32_t get_unchecked( size_t index ) const noexcept
+		{
+			return packed_detail::get( bits_value.chunk_data(), index, Width );
+		}
+
+		uint32_t operator[]( size_t index ) const
+		{
+			return get( index );
+		}
+
+		void set( size_t index, uint32_t value )
+		{
+			DefaultBitAccess::check_index( index, data_size, "Index out of range from packed integer array" );
+			packed_detail::set( bits_value.chunk_data(), index, Width, value );
+		}
+
+		void set_unchecked( size_t index, uint32_t value ) noexcept
+		{
+			packed_detail::set( bits_value.chunk_data(), index, Width, value );
+		}
+
+		void unpack( size_t first, size_t count, uint32_t* output ) const
+		{
+			view().unpack( first, count, output );
+		}
+
+		std::vector<uint32_t> unpack() const
+		{
+			return view().unpack();
+		}
+
+		void pack( size_t first, const uint32_t* values, size_t count )
+		{
+			view().pack( first, values, count );
+		}
+
+		void pack( const std::vector<uint32_t>& values, size_t first = 0 )
+		{
+			view().pack( values, first );
+		}
+
+	private:
+		DynamicBitSet bits_value;
+		size_t		  data_size;
+	};
+}  // namespace TwilightDream
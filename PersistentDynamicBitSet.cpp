@@ -0,0 +1,442 @@
+#include "PersistentDynamicBitSet.hpp"
+
+#include "DynamicBitSetKernels.hpp"
+
+#include <algorithm>
+#include <cstring>
+
+namespace TwilightDream
+{
+	/* PersistentDynamicBitSet */
+
+	PersistentDynamicBitSet::PersistentDynamicBitSet( size_t bit_size )
+		: data_size( bit_size )
+	{
+		// 叶子的数量决定高度，根节点为空 (全零)
+		const size_t leaf_count = ( bit_size + leaf_bits - 1 ) / leaf_bits;
+		for ( size_t capacity = 1; capacity < leaf_count; capacity *= branching )
+		{
+			++tree_height;
+		}
+	}
+
+	PersistentDynamicBitSet::PersistentDynamicBitSet( const DynamicBitSet& other )
+		: PersistentDynamicBitSet( other.bit_size() )
+	{
+		const size_t leaf_count = ( data_size + leaf_bits - 1 ) / leaf_bits;
+
+		// 自底向上建树，全零的叶子和子树保持为空指针
+		std::vector<NodePointer> level( leaf_count );
+		for ( size_t leaf = 0; leaf < leaf_count; ++leaf )
+		{
+			// 只读取叶子内属于 [ 0, bit_size() ) 的比特
+			const size_t leaf_begin = leaf * leaf_bits;
+			const size_t leaf_end = std::min( leaf_begin + leaf_bits, data_size );
+			if ( bits_find_next( other.chunk_data(), leaf_begin, leaf_end ) != leaf_end )
+			{
+				auto copied = std::make_shared<Leaf>();
+				bits_apply_range( BitRangeOperation::Copy, copied->chunks.data(), 0, other.chunk_data(), leaf_begin, leaf_end - leaf_begin );
+				level[ leaf ] = std::move( copied );
+			}
+		}
+
+		for ( size_t height = 0; height < tree_height; ++height )
+		{
+			std::vector<NodePointer> parents( ( level.size() + branching - 1 ) / branching );
+			for ( size_t parent = 0; parent < parents.size(); ++parent )
+			{
+				Branch branch;
+				for ( size_t child = 0; child < branching && parent * branching + child < level.size(); ++child )
+				{
+					branch.children[ child ] = std::move( level[ parent * branching + child ] );
+				}
+				parents[ parent ] = make_branch( std::move( branch ) );
+			}
+			level = std::move( parents );
+		}
+
+		if ( !level.empty() )
+		{
+			root = std::move( level[ 0 ] );
+		}
+	}
+
+	size_t PersistentDynamicBitSet::subtree_bits( size_t height ) noexcept
+	{
+		size_t bits = leaf_bits;
+		for ( size_t level = 0; level < height; ++level )
+		{
+			bits *= branching;
+		}
+		return bits;
+	}
+
+	PersistentDynamicBitSet::NodePointer PersistentDynamicBitSet::make_branch( Branch&& branch )
+	{
+		for ( const auto& child : branch.children )
+		{
+			if ( child )
+			{
+				return std::make_shared<Branch>( std::move( branch ) );
+			}
+		}
+		return nullptr;
+	}
+
+	bool PersistentDynamicBitSet::test( size_t index ) const
+	{
+		check_index( index );
+		const Node* node = root.get();
+		size_t		offset = index;
+		for ( size_t height = tree_height; node != nullptr; --height )
+		{
+			if ( height == 0 )
+			{
+				return ( static_cast<const Leaf*>( node )->chunks[ offset / 32 ].bits >> ( offset % 32 ) ) & 1;
+			}
+			const size_t child_bits = subtree_bits( height - 1 );
+			node = static_cast<const Branch*>( node )->children[ offset / child_bits ].get();
+			offset %= child_bits;
+		}
+		return false;
+	}
+
+	PersistentDynamicBitSet::NodePointer PersistentDynamicBitSet::assign_bits( const NodePointer& node, size_t height, size_t start, const size_t* first, const size_t* last, bool value, bool flip ) const
+	{
+		if ( height == 0 )
+		{
+			auto leaf = node ? std::make_shared<Leaf>( as_leaf( node ) ) : std::make_shared<Leaf>();
+			for ( const size_t* index = first; index != last; ++index )
+			{
+				const size_t   offset = *index - start;
+				const uint32_t mask = uint32_t( 1 ) << ( offset % 32 );
+				uint32_t&	   bits = leaf->chunks[ offset / 32 ].bits;
+				bits = flip ? ( bits ^ mask ) : ( value ? ( bits | mask ) : ( bits & ~mask ) );
+			}
+			return chunks_any( leaf->chunks.data(), leaf_chunks ) ? NodePointer( std::move( leaf ) ) : nullptr;
+		}
+
+		// 只复制这个内部节点 (孩子的指针)，按孩子分组向下递归
+		Branch		 branch = node ? as_branch( node ) : Branch();
+		const size_t child_bits = subtree_bits( height - 1 );
+		while ( first != last )
+		{
+			const size_t  child = ( *first - start ) / child_bits;
+			const size_t  child_end = start + ( child + 1 ) * child_bits;
+			const size_t* group_last = std::lower_bound( first, last, child_end );
+			branch.children[ child ] = assign_bits( branch.children[ child ], height - 1, start + child * child_bits, first, group_last, value, flip );
+			first = group_last;
+		}
+		return make_branch( std::move( branch ) );
+	}
+
+	PersistentDynamicBitSet PersistentDynamicBitSet::with_bit( bool value, size_t index ) const
+	{
+		if ( test( index ) == value )
+		{
+			return *this;
+		}
+		return PersistentDynamicBitSet( assign_bits( root, tree_height, 0, &index, &index + 1, value, false ), data_size, tree_height );
+	}
+
+	PersistentDynamicBitSet PersistentDynamicBitSet::with_flipped( size_t index ) const
+	{
+		check_index( index );
+		return PersistentDynamicBitSet( assign_bits( root, tree_height, 0, &index, &index + 1, false, true ), data_size, tree_height );
+	}
+
+	PersistentDynamicBitSet PersistentDynamicBitSet::with_bits( bool value, std::vector<size_t> indices ) const
+	{
+		for ( size_t index : indices )
+		{
+			check_index( index );
+		}
+		if ( indices.empty() )
+		{
+			return *this;
+		}
+		std::sort( indices.begin(), indices.end() );
+		indices.erase( std::unique( indices.begin(), indices.end() ), indices.end() );
+		return PersistentDynamicBitSet( assign_bits( root, tree_height, 0, indices.data(), indices.data() + indices.size(), value, false ), data_size, tree_height );
+	}
+
+	const PersistentDynamicBitSet::NodePointer& PersistentDynamicBitSet::filled_subtree( size_t height, std::vector<NodePointer>& filled_subtrees )
+	{
+		if ( filled_subtrees.size() <= height )
+		{
+			filled_subtrees.resize( height + 1 );
+		}
+		if ( !filled_subtrees[ height ] )
+		{
+			if ( height == 0 )
+			{
+				auto leaf = std::make_shared<Leaf>();
+				leaf->chunks.fill( BooleanBitWrapper( 0xFFFFFFFF ) );
+				filled_subtrees[ height ] = std::move( leaf );
+			}
+			else
+			{
+				const NodePointer child = filled_subtree( height - 1, filled_subtrees );
+				auto			  branch = std::make_shared<Branch>();
+				branch->children.fill( child );
+				filled_subtrees[ height ] = std::move( branch );
+			}
+		}
+		return filled_subtrees[ height ];
+	}
+
+	PersistentDynamicBitSet::NodePointer PersistentDynamicBitSet::assign_range( const NodePointer& node, size_t height, size_t start, size_t pos, size_t end, bool value, std::vector<NodePointer>& filled_subtrees ) const
+	{
+		const size_t span = subtree_bits( height );
+		const size_t subtree_end = std::min( start + span, data_size );
+
+		// 完整覆盖的子树：清零就是空指针，置一就共享全 1 子树 (跨过 bit_size() 的最后一棵子树除外)
+		if ( pos <= start && end >= subtree_end && ( !value || start + span <= data_size ) )
+		{
+			return value ? filled_subtree( height, filled_subtrees ) : nullptr;
+		}
+
+		const size_t first = std::max( pos, start );
+		const size_t last = std::min( end, subtree_end );
+		if ( height == 0 )
+		{
+			auto leaf = node ? std::make_shared<Leaf>( as_leaf( node ) ) : std::make_shared<Leaf>();
+			bits_assign_range( leaf->chunks.data(), first - start, last - first, value );
+			return chunks_any( leaf->chunks.data(), leaf_chunks ) ? NodePointer( std::move( leaf ) ) : nullptr;
+		}
+
+		Branch		 branch = node ? as_branch( node ) : Branch();
+		const size_t child_bits = subtree_bits( height - 1 );
+		for ( size_t child = ( first - start ) / child_bits; child <= ( last - 1 - start ) / child_bits; ++child )
+		{
+			branch.children[ child ] = assign_range( branch.children[ child ], height - 1, start + child * child_bits, pos, end, value, filled_subtrees );
+		}
+		return make_branch( std::move( branch ) );
+	}
+
+	PersistentDynamicBitSet PersistentDynamicBitSet::with_range( size_t pos, size_t len, bool value ) const
+	{
+		if ( len == 0 )
+		{
+			return *this;
+		}
+		check_index( pos );
+		check_index( pos + len - 1 );
+
+		std::vector<NodePointer> filled_subtrees;
+		return PersistentDynamicBitSet( assign_range( root, tree_height, 0, pos, pos + len, value, filled_subtrees ), data_size, tree_height );
+	}
+
+	/*
+		两个版本的按位运算从根开始同时向下走：指针相同的子树 (包括两边都为空) 和有一边为空的子树可以直接得到结果，
+		只有两边不同的非空子树才继续向下；结果与某一边完全相同时返回那一边的节点，保持共享。
+	*/
+	PersistentDynamicBitSet::NodePointer PersistentDynamicBitSet::combine( const NodePointer& left, const NodePointer& right, size_t height, Operation operation )
+	{
+		if ( left == right )
+		{
+			return ( operation == Operation::And || operation == Operation::Or ) ? left : nullptr;
+		}
+		if ( !left )
+		{
+			return ( operation == Operation::Or || operation == Operation::Xor ) ? right : nullptr;
+		}
+		if ( !right )
+		{
+			return operation == Operation::And ? nullptr : left;
+		}
+
+		if ( height == 0 )
+		{
+			auto					 leaf = std::make_shared<Leaf>( as_leaf( left ) );
+			BooleanBitWrapper*		 destination = leaf->chunks.data();
+			const BooleanBitWrapper* source = as_leaf( right ).chunks.data();
+			switch ( operation )
+			{
+			case Operation::And:
+				chunks_and( destination, source, leaf_chunks );
+				break;
+			case Operation::Or:
+				chunks_or( destination, source, leaf_chunks );
+				break;
+			case Operation::Xor:
+				chunks_xor( destination, source, leaf_chunks );
+				break;
+			case Operation::AndNot:
+				chunks_and_not( destination, source, leaf_chunks );
+				break;
+			}
+			return chunks_any( destination, leaf_chunks ) ? NodePointer( std::move( leaf ) ) : nullptr;
+		}
+
+		const Branch& left_branch = as_branch( left );
+		const Branch& right_branch = as_branch( right );
+		Branch		  result;
+		bool		  same_as_left = true;
+		bool		  same_as_right = true;
+		for ( size_t child = 0; child < branching; ++child )
+		{
+			result.children[ child ] = combine( left_branch.children[ child ], right_branch.children[ child ], height - 1, operation );
+			same_as_left = same_as_left && result.children[ child ] == left_branch.children[ child ];
+			same_as_right = same_as_right && result.children[ child ] == right_branch.children[ child ];
+		}
+		if ( same_as_left )
+		{
+			return left;
+		}
+		if ( same_as_right )
+		{
+			return right;
+		}
+		return make_branch( std::move( result ) );
+	}
+
+	PersistentDynamicBitSet PersistentDynamicBitSet::combine_with( const PersistentDynamicBitSet& other, Operation operation ) const
+	{
+		check_same_bit_size( data_size, other.data_size, "PersistentDynamicBitSet" );
+		return PersistentDynamicBitSet( combine( root, other.root, tree_height, operation ), data_size, tree_height );
+	}
+
+	PersistentDynamicBitSet PersistentDynamicBitSet::and_operation( const PersistentDynamicBitSet& other ) const
+	{
+		return combine_with( other, Operation::And );
+	}
+
+	PersistentDynamicBitSet PersistentDynamicBitSet::or_operation( const PersistentDynamicBitSet& other ) const
+	{
+		return combine_with( other, Operation::Or );
+	}
+
+	PersistentDynamicBitSet PersistentDynamicBitSet::xor_operation( const PersistentDynamicBitSet& other ) const
+	{
+		return combine_with( other, Operation::Xor );
+	}
+
+	PersistentDynamicBitSet PersistentDynamicBitSet::and_not_operation( const PersistentDynamicBitSet& other ) const
+	{
+		return combine_with( other, Operation::AndNot );
+	}
+
+	size_t PersistentDynamicBitSet::hamming_weight() const noexcept
+	{
+		auto weight = []( auto& self, const NodePointer& node, size_t height ) -> size_t {
+			if ( !node )
+			{
+				return 0;
+			}
+			if ( height == 0 )
+			{
+				return chunks_population_count( as_leaf( node ).chunks.data(), leaf_chunks );
+			}
+			size_t sum = 0;
+			for ( const auto& child : as_branch( node ).children )
+			{
+				sum += self( self, child, height - 1 );
+			}
+			return sum;
+		};
+		return weight( weight, root, tree_height );
+	}
+
+	size_t PersistentDynamicBitSet::node_count() const noexcept
+	{
+		auto count = []( auto& self, const NodePointer& node, size_t height ) -> size_t {
+			if ( !node )
+			{
+				return 0;
+			}
+			size_t sum = 1;
+			if ( height != 0 )
+			{
+				for ( const auto& child : as_branch( node ).children )
+				{
+					sum += self( self, child, height - 1 );
+				}
+			}
+			return sum;
+		};
+		return count( count, root, tree_height );
+	}
+
+	size_t PersistentDynamicBitSet::unshared_node_count( const PersistentDynamicBitSet& base ) const
+	{
+		check_same_bit_size( data_size, base.data_size, "PersistentDynamicBitSet" );
+		auto count = []( auto& self, const NodePointer& node, const NodePointer& base_node, size_t height ) -> size_t {
+			if ( !node || node == base_node )
+			{
+				return 0;
+			}
+			size_t sum = 1;
+			if ( height != 0 )
+			{
+				static const NodePointer empty;
+				for ( size_t child = 0; child < branching; ++child )
+				{
+					sum += self( self, as_branch( node ).children[ child ], base_node ? as_branch( base_node ).children[ child ] : empty, height - 1 );
+				}
+			}
+			return sum;
+		};
+		return count( count, root, base.root, tree_height );
+	}
+
+	DynamicBitSet PersistentDynamicBitSet::to_dynamic_bitset() const
+	{
+		DynamicBitSet result( data_size, false );
+		const size_t  chunk_count = result.chunk_count();
+		auto		  copy = [ & ]( auto& self, const NodePointer& node, size_t height, size_t start ) -> void {
+			 if ( !node )
+			 {
+				 return;
+			 }
+			 if ( height == 0 )
+			 {
+				 const size_t first_chunk = start / 32;
+				 const auto&  chunks = as_leaf( node ).chunks;
+				 std::copy( chunks.begin(), chunks.begin() + std::min( leaf_chunks, chunk_count - first_chunk ), result.chunk_data() + first_chunk );
+				 return;
+			 }
+			 const size_t child_bits = subtree_bits( height - 1 );
+			 for ( size_t child = 0; child < branching; ++child )
+			 {
+				 self( self, as_branch( node ).children[ child ], height - 1, start + child * child_bits );
+			 }
+		};
+		copy( copy, root, tree_height, 0 );
+		return result;
+	}
+
+	bool operator==( const PersistentDynamicBitSet& left, const PersistentDynamicBitSet& right ) noexcept
+	{
+		using NodePointer = PersistentDynamicBitSet::NodePointer;
+		if ( left.data_size != right.data_size )
+		{
+			return false;
+		}
+
+		// 全零的子树总是空指针，所以一边为空另一边不为空时一定不相等
+		auto equal = []( auto& self, const NodePointer& a, const NodePointer& b, size_t height ) -> bool {
+			if ( a == b )
+			{
+				return true;
+			}
+			if ( !a || !b )
+			{
+				return false;
+			}
+			if ( height == 0 )
+			{
+				return std::memcmp( PersistentDynamicBitSet::as_leaf( a ).chunks.data(), PersistentDynamicBitSet::as_leaf( b ).chunks.data(), sizeof( PersistentDynamicBitSet::Leaf::chunks ) ) == 0;
+			}
+			for ( size_t child = 0; child < PersistentDynamicBitSet::branching; ++child )
+			{
+				if ( !self( self, PersistentDynamicBitSet::as_branch( a ).children[ child ], PersistentDynamicBitSet::as_branch( b ).children[ child ], height - 1 ) )
+				{
+					return false;
+				}
+			}
+			return true;
+		};
+		return equal( equal, left.root, right.root, left.tree_height );
+	}
+}  // namespace TwilightDream
@@ -0,0 +1,186 @@
+#pragma once
+
+#include <cstdint>
+#include <cstddef>
+
+#include <array>
+#include <memory>
+#include <vector>
+
+#include "DynamicBitSet.hpp"
+
+namespace TwilightDream
+{
+	/*
+		PersistentDynamicBitSet
+		持久化 (不可变、结构共享) 的固定大小比特集，用于同时保留很多个只相差少量比特的版本 (例如 MVCC 的可见性掩码)。
+		- 数据保存在一棵宽树中：叶子是 256 个比特块 (8192 比特)，内部节点有 32 个孩子，1 Gbit 的集合高度为 4。
+		- 所有节点都是不可变的 (std::shared_ptr<const ...>)。修改返回一个新版本，只复制从根到被修改叶子的路径 (O(log n) 个节点)，
+		  旧版本保持有效，两个版本共享其余所有节点。复制一个版本只增加根节点的引用计数。
+		- 空指针表示全零的子树，所以全零的区域不占用内存，and 遇到空子树可以直接得到空子树。
+		- 版本之间的按位运算先比较子树的指针：相同的子树 (包括共享的和都为空的) 不需要读取，
+		  例如 a.or_operation( b ) 在 b 是从 a 修改出来的时只访问两者不同的路径。
+		- 跨过 bit_size() 的最后一个叶子中超出的比特保持为 0，所以它不能共享全 1 的子树，范围赋值会为它单独复制一条路径。
+	*/
+	class PersistentDynamicBitSet
+	{
+	public:
+		// 叶子的比特块数量、叶子的比特数量和内部节点的孩子数量
+		static constexpr size_t leaf_chunks = 256;
+		static constexpr size_t leaf_bits = leaf_chunks * 32;
+		static constexpr size_t branching = 32;
+
+		explicit PersistentDynamicBitSet( size_t bit_size = 0 );
+
+		// bit_size() 取 other.bit_size()，自底向上建树；全零的叶子和子树保持为空指针，不分配内存
+		explicit PersistentDynamicBitSet( const DynamicBitSet& other );
+
+		size_t bit_size() const noexcept
+		{
+			return data_size;
+		}
+
+		// 根节点之下内部节点的层数 (根就是叶子时为 0)
+		size_t height() const noexcept
+		{
+			return tree_height;
+		}
+
+		bool test( size_t index ) const;
+
+		bool operator[]( size_t index ) const
+		{
+			return test( index );
+		}
+
+		// 以下修改都返回新版本，*this 不变
+
+		// 参数顺序与 DynamicBitSet::set_bit 相同；值没有改变时返回共享同一棵树的版本
+		PersistentDynamicBitSet with_bit( bool value, size_t index ) const;
+
+		PersistentDynamicBitSet with_flipped( size_t index ) const;
+
+		// 一次修改多个比特，每个被修改的节点只复制一次 (indices 不需要有序，可以重复)
+		PersistentDynamicBitSet with_bits( bool value, std::vector<size_t> indices ) const;
+
+		// 把 [ pos, pos + len ) 设置为 value；完整覆盖的子树换成空子树或者共享的全 1 子树
+		PersistentDynamicBitSet with_range( size_t pos, size_t len, bool value ) const;
+
+		// 按位运算，要求 bit_size() 相同，否则抛出 std::invalid_argument
+		PersistentDynamicBitSet and_operation( const PersistentDynamicBitSet& other ) const;
+		PersistentDynamicBitSet or_operation( const PersistentDynamicBitSet& other ) const;
+		PersistentDynamicBitSet xor_operation( const PersistentDynamicBitSet& other ) const;
+		PersistentDynamicBitSet and_not_operation( const PersistentDynamicBitSet& other ) const;
+
+		friend PersistentDynamicBitSet operator&( const PersistentDynamicBitSet& left, const PersistentDynamicBitSet& right )
+		{
+			return left.and_operation( right );
+		}
+
+		friend PersistentDynamicBitSet operator|( const PersistentDynamicBitSet& left, const PersistentDynamicBitSet& right )
+		{
+			return left.or_operation( right );
+		}
+
+		friend PersistentDynamicBitSet operator^( const PersistentDynamicBitSet& left, const PersistentDynamicBitSet& right )
+		{
+			return left.xor_operation( right );
+		}
+
+		bool any() const noexcept
+		{
+			// 全零的子树总是空指针，所以非空的根一定包含 1
+			return root != nullptr;
+		}
+
+		bool none() const noexcept
+		{
+			return root == nullptr;
+		}
+
+		size_t hamming_weight() const noexcept;
+
+		// 树中 (非空) 节点的数量，被同一棵树多次引用的节点 (例如全 1 子树) 按出现的次数计算
+		size_t node_count() const noexcept;
+
+		// 不与 base 中相同位置的节点共享的节点数量 (即从 base 派生出这个版本时新分配的节点)，要求 bit_size() 相同
+		size_t unshared_node_count( const PersistentDynamicBitSet& base ) const;
+
+		// 复制为普通的 DynamicBitSet (bit_size() 相同)
+		DynamicBitSet to_dynamic_bitset() const;
+
+		// bit_size() 相同并且每一位都相同 (共享的子树不比较数据)
+		friend bool operator==( const PersistentDynamicBitSet& left, const PersistentDynamicBitSet& right ) noexcept;
+
+		friend bool operator!=( const PersistentDynamicBitSet& left, const PersistentDynamicBitSet& right ) noexcept
+		{
+			return !( left == right );
+		}
+
+	private:
+		// 叶子与内部节点的公共基类；节点的种类由它在树中的高度决定
+		struct Node
+		{};
+
+		using NodePointer = std::shared_ptr<const Node>;
+
+		struct Leaf : Node
+		{
+			std::array<BooleanBitWrapper, leaf_chunks> chunks {};
+		};
+
+		struct Branch : Node
+		{
+			std::array<NodePointer, branching> children {};
+		};
+
+		enum class Operation
+		{
+			And,
+			Or,
+			Xor,
+			AndNot
+		};
+
+		NodePointer root;
+		size_t		data_size = 0;
+		size_t		tree_height = 0;
+
+		PersistentDynamicBitSet( NodePointer tree_root, size_t bit_size, size_t height )
+			: root( std::move( tree_root ) ), data_size( bit_size ), tree_height( height )
+		{}
+
+		// 高度为 height 的子树覆盖的比特数量
+		static size_t subtree_bits( size_t height ) noexcept;
+
+		static const Leaf& as_leaf( const NodePointer& node ) noexcept
+		{
+			return static_cast<const Leaf&>( *node );
+		}
+
+		static const Branch& as_branch( const NodePointer& node ) noexcept
+		{
+			return static_cast<const Branch&>( *node );
+		}
+
+		// 所有孩子都为空时返回空指针，否则返回新的内部节点
+		static NodePointer make_branch( Branch&& branch );
+
+		// 在以 node 为根、从 start 开始的子树中修改排好序的 indices[ first, last )
+		NodePointer assign_bits( const NodePointer& node, size_t height, size_t start, const size_t* first, const size_t* last, bool value, bool flip ) const;
+
+		NodePointer assign_range( const NodePointer& node, size_t height, size_t start, size_t pos, size_t end, bool value, std::vector<NodePointer>& filled_subtrees ) const;
+
+		// 高度为 height 的全 1 子树 (每一层的孩子都指向同一个下一层的全 1 子树，所以只需要 height + 1 个节点)
+		static const NodePointer& filled_subtree( size_t height, std::vector<NodePointer>& filled_subtrees );
+
+		static NodePointer combine( const NodePointer& left, const NodePointer& right, size_t height, Operation operation );
+
+		PersistentDynamicBitSet combine_with( const PersistentDynamicBitSet& other, Operation operation ) const;
+
+		void check_index( size_t index ) const
+		{
+			DefaultBitAccess::check_index( index, data_size, "Index out of range from persistent bit set" );
+		}
+	};
+}  // namespace TwilightDream
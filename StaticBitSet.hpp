@@ -0,0 +1,809 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+#include <array>
+#include <iterator>
+#include <string>
+#include <string_view>
+#include <utility>
+
+#include "DynamicBitSet.hpp"
+
+namespace TwilightDream
+{
+	namespace static_bitset_detail
+	{
+		// 块数不超过这个值时，逐块循环在编译期通过折叠表达式完全展开
+		constexpr size_t unroll_limit = 16;
+
+		template <typename Function, size_t... Indices>
+		constexpr void unrolled_for( Function& function, std::index_sequence<Indices...> )
+		{
+			( function( Indices ), ... );
+		}
+
+		template <size_t Count, typename Function>
+		constexpr void for_each_chunk( Function&& function )
+		{
+			if constexpr ( Count <= unroll_limit )
+			{
+				unrolled_for( function, std::make_index_sequence<Count>() );
+			}
+			else
+			{
+				for ( size_t i = 0; i < Count; ++i )
+				{
+					function( i );
+				}
+			}
+		}
+	}  // namespace static_bitset_detail
+
+	/*
+		StaticBitSet<N>
+		编译期固定宽度的比特集，与 DynamicBitSet 使用相同的 32 位比特块布局 (LSB 在第 0 块) 和相同的成员接口，
+		但存储在对象内部 (栈上)，所有操作都是 constexpr 的，逐块循环在块数较少时在编译期展开。
+		与 DynamicBitSet 不同，bit_size() 总是 N：移位丢弃超出 N 的比特，旋转在恰好 N 个比特上进行，
+		最高块中超出 N 的比特始终保持为 0。
+		适合 64 / 128 / 512 比特这类宽度已知的掩码；需要与动态比特集交互时用 to_dynamic_bitset() / 构造函数转换 (直接复制比特块)。
+	*/
+	template <size_t N>
+	class StaticBitSet
+	{
+		static_assert( N > 0, "StaticBitSet must hold at least one bit" );
+
+	public:
+		static constexpr size_t bits_per_chunk = 32;
+		static constexpr size_t chunk_size = ( N + bits_per_chunk - 1 ) / bits_per_chunk;
+
+		class reference
+		{
+		public:
+			constexpr reference( BooleanBitWrapper& chunk, uint32_t mask ) noexcept
+				: chunk( chunk ), mask( mask )
+			{}
+
+			constexpr reference& operator=( bool value ) noexcept
+			{
+				chunk.bits = value ? ( chunk.bits | mask ) : ( chunk.bits & ~mask );
+				return *this;
+			}
+
+			constexpr reference& operator=( const reference& other ) noexcept
+			{
+				return *this = static_cast<bool>( other );
+			}
+
+			constexpr operator bool() const noexcept
+			{
+				return ( chunk.bits & mask ) != 0;
+			}
+
+			constexpr bool operator~() const noexcept
+			{
+				return ( chunk.bits & mask ) == 0;
+			}
+
+			constexpr reference& flip() noexcept
+			{
+				chunk.bits ^= mask;
+				return *this;
+			}
+
+		private:
+			BooleanBitWrapper& chunk;
+			uint32_t		   mask;
+		};
+
+		// 按比特遍历的随机访问迭代器 (IsConst 为 true 时解引用得到 bool)
+		template <bool IsConst>
+		class basic_iterator
+		{
+		public:
+			using owner_type = std::conditional_t<IsConst, const StaticBitSet, StaticBitSet>;
+			using iterator_category = std::random_access_iterator_tag;
+			using value_type = bool;
+			using difference_type = std::ptrdiff_t;
+			using pointer = void;
+			using reference = std::conditional_t<IsConst, bool, typename StaticBitSet::reference>;
+
+			constexpr basic_iterator() noexcept = default;
+
+			constexpr basic_iterator( owner_type* owner, size_t index ) noexcept
+				: owner( owner ), index( index )
+			{}
+
+			constexpr reference operator*() const noexcept
+			{
+				return ( *owner )[ index ];
+			}
+
+			constexpr reference operator[]( difference_type offset ) const noexcept
+			{
+				return ( *owner )[ index + offset ];
+			}
+
+			constexpr basic_iterator& operator++() noexcept
+			{
+				++index;
+				return *this;
+			}
+
+			constexpr basic_iterator operator++( int ) noexcept
+			{
+				basic_iterator previous = *this;
+				++index;
+				return previous;
+			}
+
+			constexpr basic_iterator& operator--() noexcept
+			{
+				--index;
+				return *this;
+			}
+
+			constexpr basic_iterator operator--( int ) noexcept
+			{
+				basic_iterator previous = *this;
+				--index;
+				return previous;
+			}
+
+			constexpr basic_iterator& operator+=( difference_type offset ) noexcept
+			{
+				index += offset;
+				return *this;
+			}
+
+			constexpr basic_iterator& operator-=( difference_type offset ) noexcept
+			{
+				index -= offset;
+				return *this;
+			}
+
+			friend constexpr basic_iterator operator+( basic_iterator iterator, difference_type offset ) noexcept
+			{
+				return iterator += offset;
+			}
+
+			friend constexpr basic_iterator operator+( difference_type offset, basic_iterator iterator ) noexcept
+			{
+				return iterator += offset;
+			}
+
+			friend constexpr basic_iterator operator-( basic_iterator iterator, difference_type offset ) noexcept
+			{
+				return iterator -= offset;
+			}
+
+			friend constexpr difference_type operator-( const basic_iterator& left, const basic_iterator& right ) noexcept
+			{
+				return static_cast<difference_type>( left.index ) - static_cast<difference_type>( right.index );
+			}
+
+			friend constexpr bool operator==( const basic_iterator& left, const basic_iterator& right ) noexcept
+			{
+				return left.index == right.index;
+			}
+
+			friend constexpr bool operator!=( const basic_iterator& left, const basic_iterator& right ) noexcept
+			{
+				return left.index != right.index;
+			}
+
+			friend constexpr bool operator<( const basic_iterator& left, const basic_iterator& right ) noexcept
+			{
+				return left.index < right.index;
+			}
+
+			friend constexpr bool operator>( const basic_iterator& left, const basic_iterator& right ) noexcept
+			{
+				return left.index > right.index;
+			}
+
+			friend constexpr bool operator<=( const basic_iterator& left, const basic_iterator& right ) noexcept
+			{
+				return left.index <= right.index;
+			}
+
+			friend constexpr bool operator>=( const basic_iterator& left, const basic_iterator& right ) noexcept
+			{
+				return left.index >= right.index;
+			}
+
+		private:
+			owner_type* owner = nullptr;
+			size_t		index = 0;
+		};
+
+		using iterator = basic_iterator<false>;
+		using const_iterator = basic_iterator<true>;
+		using reverse_iterator = std::reverse_iterator<iterator>;
+		using const_reverse_iterator = std::reverse_iterator<const_iterator>;
+
+		constexpr StaticBitSet() noexcept = default;
+
+		// 与 std::bitset 一样可以从整数隐式构造 (超出 N 的高位被丢弃)
+		constexpr StaticBitSet( uint64_t value ) noexcept
+		{
+			chunks[ 0 ].bits = static_cast<uint32_t>( value );
+			if constexpr ( chunk_size > 1 )
+			{
+				chunks[ 1 ].bits = static_cast<uint32_t>( value >> 32 );
+			}
+			sanitize();
+		}
+
+		// 二进制字符串 (MSB 在前)，只使用最后 N 个字符，'1' 以外的字符视为 0
+		constexpr explicit StaticBitSet( std::string_view binary ) noexcept
+		{
+			const size_t length = binary.size() < N ? binary.size() : N;
+			for ( size_t i = 0; i < length; ++i )
+			{
+				if ( binary[ binary.size() - 1 - i ] == '1' )
+				{
+					chunks[ i / bits_per_chunk ].bits |= uint32_t( 1 ) << ( i % bits_per_chunk );
+				}
+			}
+		}
+
+		// 从 DynamicBitSet 复制比特块 (超出 N 的比特被丢弃)
+		explicit StaticBitSet( const DynamicBitSet& other ) noexcept
+		{
+			const size_t			 copy_count = other.chunk_count() < chunk_size ? other.chunk_count() : chunk_size;
+			const BooleanBitWrapper* other_chunks = other.chunk_data();
+			for ( size_t i = 0; i < copy_count; ++i )
+			{
+				chunks[ i ] = other_chunks[ i ];
+			}
+			sanitize();
+		}
+
+		// 转换为 DynamicBitSet (bit_size() 为 N，比特块直接复制)
+		DynamicBitSet to_dynamic_bitset( std::pmr::memory_resource* resource = nullptr ) const
+		{
+			DynamicBitSet result( N, false, resource );
+			std::copy( chunks.begin(), chunks.end(), result.chunk_data() );
+			return result;
+		}
+
+		/* 迭代器 */
+
+		constexpr iterator begin() noexcept
+		{
+			return iterator( this, 0 );
+		}
+
+		constexpr iterator end() noexcept
+		{
+			return iterator( this, N );
+		}
+
+		constexpr const_iterator begin() const noexcept
+		{
+			return const_iterator( this, 0 );
+		}
+
+		constexpr const_iterator end() const noexcept
+		{
+			return const_iterator( this, N );
+		}
+
+		constexpr const_iterator cbegin() const noexcept
+		{
+			return begin();
+		}
+
+		constexpr const_iterator cend() const noexcept
+		{
+			return end();
+		}
+
+		constexpr reverse_iterator rbegin() noexcept
+		{
+			return reverse_iterator( end() );
+		}
+
+		constexpr reverse_iterator rend() noexcept
+		{
+			return reverse_iterator( begin() );
+		}
+
+		constexpr const_reverse_iterator rbegin() const noexcept
+		{
+			return const_reverse_iterator( end() );
+		}
+
+		constexpr const_reverse_iterator rend() const noexcept
+		{
+			return const_reverse_iterator( begin() );
+		}
+
+		/* 大小与状态 */
+
+		static constexpr size_t bit_size() noexcept
+		{
+			return N;
+		}
+
+		static constexpr size_t bit_capacity() noexcept
+		{
+			return chunk_size * bits_per_chunk;
+		}
+
+		static constexpr size_t chunk_count() noexcept
+		{
+			return chunk_size;
+		}
+
+		constexpr BooleanBitWrapper* chunk_data() noexcept
+		{
+			return chunks.data();
+		}
+
+		constexpr const BooleanBitWrapper* chunk_data() const noexcept
+		{
+			return chunks.data();
+		}
+
+		// 最高的比特'1'的位置 + 1 (全 0 时为 0)
+		constexpr size_t valid_number_of_bits() const noexcept
+		{
+			for ( size_t i = chunk_size; i > 0; --i )
+			{
+				const uint32_t value = chunks[ i - 1 ].bits;
+				if ( value != 0 )
+				{
+					return ( i - 1 ) * bits_per_chunk + ( bits_per_chunk - count_leading_zeros32( value ) );
+				}
+			}
+			return 0;
+		}
+
+		constexpr bool all() const noexcept
+		{
+			for ( size_t i = 0; i + 1 < chunk_size; ++i )
+			{
+				if ( chunks[ i ].bits != 0xFFFFFFFF )
+				{
+					return false;
+				}
+			}
+			return chunks[ chunk_size - 1 ].bits == top_chunk_mask();
+		}
+
+		constexpr bool any() const noexcept
+		{
+			uint32_t combined = 0;
+			static_bitset_detail::for_each_chunk<chunk_size>( [ & ]( size_t i ) { combined |= chunks[ i ].bits; } );
+			return combined != 0;
+		}
+
+		constexpr bool none() const noexcept
+		{
+			return !any();
+		}
+
+		/* 单个比特的访问 */
+
+		constexpr reference operator[]( size_t index ) noexcept
+		{
+			return reference( chunks[ index / bits_per_chunk ], uint32_t( 1 ) << ( index % bits_per_chunk ) );
+		}
+
+		constexpr bool operator[]( size_t index ) const noexcept
+		{
+			return test_unchecked( index );
+		}
+
+		constexpr void set_bit( bool value, size_t index )
+		{
+			DefaultBitAccess::check_index( index, N, "Index out of range from set bit" );
+			assign_unchecked( value, index );
+		}
+
+		constexpr bool get_bit( size_t index ) const
+		{
+			DefaultBitAccess::check_index( index, N, "Index out of range from get bit" );
+			return test_unchecked( index );
+		}
+
+		template <typename AccessPolicy = DefaultBitAccess>
+		constexpr bool test( size_t index ) const
+		{
+			AccessPolicy::check_index( index, N, "Index out of range from test" );
+			return test_unchecked( index );
+		}
+
+		template <typename AccessPolicy = DefaultBitAccess>
+		constexpr void assign( bool value, size_t index )
+		{
+			AccessPolicy::check_index( index, N, "Index out of range from assign" );
+			assign_unchecked( value, index );
+		}
+
+		constexpr bool test_unchecked( size_t index ) const noexcept
+		{
+			return ( chunks[ index / bits_per_chunk ].bits >> ( index % bits_per_chunk ) ) & uint32_t( 1 );
+		}
+
+		constexpr void set_unchecked( size_t index ) noexcept
+		{
+			chunks[ index / bits_per_chunk ].bits |= uint32_t( 1 ) << ( index % bits_per_chunk );
+		}
+
+		constexpr void reset_unchecked( size_t index ) noexcept
+		{
+			chunks[ index / bits_per_chunk ].bits &= ~( uint32_t( 1 ) << ( index % bits_per_chunk ) );
+		}
+
+		constexpr void flip_unchecked( size_t index ) noexcept
+		{
+			chunks[ index / bits_per_chunk ].bits ^= uint32_t( 1 ) << ( index % bits_per_chunk );
+		}
+
+		constexpr StaticBitSet& flip( size_t position )
+		{
+			DefaultBitAccess::check_index( position, N, "Filp bit: Position out of range" );
+			flip_unchecked( position );
+			return *this;
+		}
+
+		/* 整体修改 */
+
+		constexpr void set() noexcept
+		{
+			static_bitset_detail::for_each_chunk<chunk_size>( [ & ]( size_t i ) { chunks[ i ].bits = 0xFFFFFFFF; } );
+			sanitize();
+		}
+
+		// 把 [ pos, pos + len ) 设置为 value (超出 N 的部分被忽略)，两端的块使用与范围内核相同的 mask_from / mask_through，中间的块整块赋值
+		constexpr void set( size_t pos, size_t len, bool value ) noexcept
+		{
+			if ( pos >= N || len == 0 )
+			{
+				return;
+			}
+
+			const size_t   last_bit = len > N - pos ? N - 1 : pos + len - 1;
+			const size_t   first = pos / bits_per_chunk;
+			const size_t   last = last_bit / bits_per_chunk;
+			const uint32_t fill = value ? 0xFFFFFFFF : 0x00000000;
+			auto		   assign_masked = [ this, fill ]( size_t chunk, uint32_t mask ) { chunks[ chunk ].bits = ( chunks[ chunk ].bits & ~mask ) | ( fill & mask ); };
+			if ( first == last )
+			{
+				assign_masked( first, mask_from( pos ) & mask_through( last_bit ) );
+				return;
+			}
+			assign_masked( first, mask_from( pos ) );
+			for ( size_t i = first + 1; i < last; ++i )
+			{
+				chunks[ i ].bits = fill;
+			}
+			assign_masked( last, mask_through( last_bit ) );
+		}
+
+		constexpr void reset() noexcept
+		{
+			static_bitset_detail::for_each_chunk<chunk_size>( [ & ]( size_t i ) { chunks[ i ].bits = 0; } );
+		}
+
+		constexpr void reset( size_t pos )
+		{
+			DefaultBitAccess::check_index( pos, N, "Reset bit: Position out of range" );
+			reset_unchecked( pos );
+		}
+
+		constexpr void reset( size_t pos, size_t len ) noexcept
+		{
+			set( pos, len, false );
+		}
+
+		/* 按位运算 */
+
+		constexpr void and_operation( const StaticBitSet& other ) noexcept
+		{
+			static_bitset_detail::for_each_chunk<chunk_size>( [ & ]( size_t i ) { chunks[ i ].bits &= other.chunks[ i ].bits; } );
+		}
+
+		constexpr void or_operation( const StaticBitSet& other ) noexcept
+		{
+			static_bitset_detail::for_each_chunk<chunk_size>( [ & ]( size_t i ) { chunks[ i ].bits |= other.chunks[ i ].bits; } );
+		}
+
+		constexpr void xor_operation( const StaticBitSet& other ) noexcept
+		{
+			static_bitset_detail::for_each_chunk<chunk_size>( [ & ]( size_t i ) { chunks[ i ].bits ^= other.chunks[ i ].bits; } );
+		}
+
+		constexpr void not_operation() noexcept
+		{
+			static_bitset_detail::for_each_chunk<chunk_size>( [ & ]( size_t i ) { chunks[ i ].bits = ~chunks[ i ].bits; } );
+			sanitize();
+		}
+
+		// 左移 (向 MSB 方向)，移出 N 的比特被丢弃
+		constexpr StaticBitSet& left_shift( size_t shift ) noexcept
+		{
+			if ( shift >= N )
+			{
+				reset();
+				return *this;
+			}
+
+			const size_t chunk_shift = shift / bits_per_chunk;
+			const size_t bit_shift = shift % bits_per_chunk;
+			for ( size_t i = chunk_size; i > 0; --i )
+			{
+				const size_t target = i - 1;
+				uint32_t	 value = 0;
+				if ( target >= chunk_shift )
+				{
+					value = chunks[ target - chunk_shift ].bits << bit_shift;
+					if ( bit_shift != 0 && target > chunk_shift )
+					{
+						value |= chunks[ target - chunk_shift - 1 ].bits >> ( bits_per_chunk - bit_shift );
+					}
+				}
+				chunks[ target ].bits = value;
+			}
+			sanitize();
+			return *this;
+		}
+
+		// 右移 (向 LSB 方向)
+		constexpr StaticBitSet& right_shift( size_t shift ) noexcept
+		{
+			if ( shift >= N )
+			{
+				reset();
+				return *this;
+			}
+
+			const size_t chunk_shift = shift / bits_per_chunk;
+			const size_t bit_shift = shift % bits_per_chunk;
+			for ( size_t target = 0; target < chunk_size; ++target )
+			{
+				uint32_t value = 0;
+				if ( target + chunk_shift < chunk_size )
+				{
+					value = chunks[ target + chunk_shift ].bits >> bit_shift;
+					if ( bit_shift != 0 && target + chunk_shift + 1 < chunk_size )
+					{
+						value |= chunks[ target + chunk_shift + 1 ].bits << ( bits_per_chunk - bit_shift );
+					}
+				}
+				chunks[ target ].bits = value;
+			}
+			return *this;
+		}
+
+		// 在恰好 N 个比特上循环左移
+		constexpr void rotate_left( size_t shift ) noexcept
+		{
+			shift %= N;
+			if ( shift == 0 )
+			{
+				return;
+			}
+			StaticBitSet wrapped = *this;
+			wrapped.right_shift( N - shift );
+			left_shift( shift );
+			or_operation( wrapped );
+		}
+
+		// 在恰好 N 个比特上循环右移
+		constexpr void rotate_right( size_t shift ) noexcept
+		{
+			shift %= N;
+			if ( shift == 0 )
+			{
+				return;
+			}
+			rotate_left( N - shift );
+		}
+
+		constexpr size_t hamming_weight() const noexcept
+		{
+			size_t total_count = 0;
+			static_bitset_detail::for_each_chunk<chunk_size>( [ & ]( size_t i ) { total_count += chunks[ i ].count_bits(); } );
+			return total_count;
+		}
+
+		constexpr size_t hamming_distance( const StaticBitSet& other ) const noexcept
+		{
+			size_t distance = 0;
+			static_bitset_detail::for_each_chunk<chunk_size>( [ & ]( size_t i ) { distance += BooleanBitWrapper( chunks[ i ].bits ^ other.chunks[ i ].bits ).count_bits(); } );
+			return distance;
+		}
+
+		/* 运算符 */
+
+		constexpr StaticBitSet& operator&=( const StaticBitSet& other ) noexcept
+		{
+			and_operation( other );
+			return *this;
+		}
+
+		constexpr StaticBitSet& operator|=( const StaticBitSet& other ) noexcept
+		{
+			or_operation( other );
+			return *this;
+		}
+
+		constexpr StaticBitSet& operator^=( const StaticBitSet& other ) noexcept
+		{
+			xor_operation( other );
+			return *this;
+		}
+
+		constexpr StaticBitSet& operator<<=( size_t shift ) noexcept
+		{
+			return left_shift( shift );
+		}
+
+		constexpr StaticBitSet& operator>>=( size_t shift ) noexcept
+		{
+			return right_shift( shift );
+		}
+
+		constexpr StaticBitSet operator~() const noexcept
+		{
+			StaticBitSet result = *this;
+			result.not_operation();
+			return result;
+		}
+
+		constexpr StaticBitSet operator<<( size_t shift ) const noexcept
+		{
+			StaticBitSet result = *this;
+			return result.left_shift( shift );
+		}
+
+		constexpr StaticBitSet operator>>( size_t shift ) const noexcept
+		{
+			StaticBitSet result = *this;
+			return result.right_shift( shift );
+		}
+
+		friend constexpr StaticBitSet operator&( StaticBitSet left, const StaticBitSet& right ) noexcept
+		{
+			return left &= right;
+		}
+
+		friend constexpr StaticBitSet operator|( StaticBitSet left, const StaticBitSet& right ) noexcept
+		{
+			return left |= right;
+		}
+
+		friend constexpr StaticBitSet operator^( StaticBitSet left, const StaticBitSet& right ) noexcept
+		{
+			return left ^= right;
+		}
+
+		friend constexpr bool operator==( const StaticBitSet& left, const StaticBitSet& right ) noexcept
+		{
+			for ( size_t i = 0; i < chunk_size; ++i )
+			{
+				if ( left.chunks[ i ].bits != right.chunks[ i ].bits )
+				{
+					return false;
+				}
+			}
+			return true;
+		}
+
+		friend constexpr bool operator!=( const StaticBitSet& left, const StaticBitSet& right ) noexcept
+		{
+			return !( left == right );
+		}
+
+		// 与比特相同的 DynamicBitSet 的 hash() 相等
+		uint64_t hash( uint64_t seed = 0 ) const noexcept
+		{
+			return BitChunkHasher::hash( chunks.data(), chunk_size, seed );
+		}
+
+		/* 字符串转换 (输出与 DynamicBitSet 相同) */
+
+		std::string format_binary_string( bool include_leading_zeros = false ) const
+		{
+			std::string result( N, '0' );
+			for ( size_t i = 0; i < N; ++i )
+			{
+				if ( test_unchecked( i ) )
+				{
+					result[ N - 1 - i ] = '1';
+				}
+			}
+
+			if ( !include_leading_zeros )
+			{
+				const size_t first_non_zero = result.find_first_not_of( '0' );
+				return first_non_zero == std::string::npos ? std::string( "0" ) : result.substr( first_non_zero );
+			}
+			return result;
+		}
+
+		std::vector<std::string> string_hexadecimal_raw_array() const
+		{
+			return to_dynamic_bitset().string_hexadecimal_raw_array();
+		}
+
+		std::string string_hexadecimal_hugenumber() const
+		{
+			return to_dynamic_bitset().string_hexadecimal_hugenumber();
+		}
+
+		std::vector<std::string> string_decimal_raw_array() const
+		{
+			return to_dynamic_bitset().string_decimal_raw_array();
+		}
+
+		std::string string_decimal_hugenumber() const
+		{
+			return to_dynamic_bitset().string_decimal_hugenumber();
+		}
+
+		std::vector<bool> bit_vector_data() const
+		{
+			std::vector<bool> result( N );
+			for ( size_t i = 0; i < N; ++i )
+			{
+				result[ i ] = test_unchecked( i );
+			}
+			return result;
+		}
+
+	private:
+		std::array<BooleanBitWrapper, chunk_size> chunks {};
+
+		static constexpr uint32_t top_chunk_mask() noexcept
+		{
+			return N % bits_per_chunk == 0 ? 0xFFFFFFFF : ( ( uint32_t( 1 ) << ( N % bits_per_chunk ) ) - 1 );
+		}
+
+		// value 不能为 0
+		static constexpr uint32_t count_leading_zeros32( uint32_t value ) noexcept
+		{
+#if defined( __GNUC__ ) || defined( __clang__ )
+			return static_cast<uint32_t>( __builtin_clz( value ) );
+#else
+			uint32_t count = 0;
+			while ( ( value & 0x80000000 ) == 0 )
+			{
+				value <<= 1;
+				++count;
+			}
+			return count;
+#endif
+		}
+
+		constexpr void assign_unchecked( bool value, size_t index ) noexcept
+		{
+			const uint32_t mask = uint32_t( 1 ) << ( index % bits_per_chunk );
+			uint32_t&	   chunk = chunks[ index / bits_per_chunk ].bits;
+			chunk = value ? ( chunk | mask ) : ( chunk & ~mask );
+		}
+
+		// 保持最高块中超出 N 的比特为 0
+		constexpr void sanitize() noexcept
+		{
+			chunks[ chunk_size - 1 ].bits &= top_chunk_mask();
+		}
+	};
+}  // namespace TwilightDream
+
+namespace std
+{
+	template <size_t N>
+	struct hash<TwilightDream::StaticBitSet<N>>
+	{
+		size_t operator()( const TwilightDream::StaticBitSet<N>& bits ) const noexcept
+		{
+			return static_cast<size_t>( bits.hash() );
+		}
+	};
+}  // namespace std
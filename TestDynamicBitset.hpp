@@ -1,6 +1,64 @@
 #pragma once
 
 #include "DynamicBitSet.hpp"
+#include "ConcurrentDynamicBitSet.hpp"
+#include "StaticBitSet.hpp"
+#include "LargeIntegerNumber.hpp"
+#include "CachedHashDynamicBitSet.hpp"
+#include "CopyOnWriteDynamicBitSet.hpp"
+#include "PersistentDynamicBitSet.hpp"
+#include "TrackedDynamicBitSet.hpp"
+#include "HierarchicalDynamicBitSet.hpp"
+#include "PackedIntArray.hpp"
+#include "EliasFanoSequence.hpp"
+
+#include <cmath>
+#include <map>
+#include <thread>
+#include <unordered_map>
+#include <unordered_set>
+
+// 测试共用的随机比特集：chunk_count 个随机的块 (bit_size() 只到最高的'1')
+inline TwilightDream::DynamicBitSet random_set( std::mt19937& generator, size_t chunk_count )
+{
+	std::vector<uint32_t> words( chunk_count );
+	for ( auto& word : words )
+	{
+		word = generator();
+	}
+	return TwilightDream::DynamicBitSet( words );
+}
+
+// 测试共用的随机比特集：bit_size() 固定为 bit_size，bit_size 之上的比特为 0
+inline TwilightDream::DynamicBitSet random_bits( std::mt19937& generator, size_t bit_size )
+{
+	TwilightDream::DynamicBitSet bits( bit_size, false );
+	for ( size_t chunk = 0; chunk < bits.chunk_count(); ++chunk )
+	{
+		bits.chunk_data()[ chunk ].bits = generator();
+	}
+	if ( bit_size % 32 != 0 )
+	{
+		bits.chunk_data()[ bits.chunk_count() - 1 ].bits &= ( uint32_t( 1 ) << ( bit_size % 32 ) ) - 1;
+	}
+	return bits;
+}
+
+// 块的数量和每个块都相同 (比 operator== 更严格：operator== 忽略高位的零块)
+inline bool same_chunks( const TwilightDream::DynamicBitSet& left, const TwilightDream::DynamicBitSet& right )
+{
+	return left.chunk_count() == right.chunk_count() && std::equal( left.chunk_data(), left.chunk_data() + left.chunk_count(), right.chunk_data() );
+}
+
+// 逐块断言 actual 与 expected 相同 (块的数量也相同)，包装类型的测试传入 to_dynamic_bitset() 或 bits()
+inline void assert_same_chunks( const TwilightDream::DynamicBitSet& actual, const TwilightDream::DynamicBitSet& expected )
+{
+	assert( actual.chunk_count() == expected.chunk_count() );
+	for ( size_t chunk = 0; chunk < actual.chunk_count(); ++chunk )
+	{
+		assert( actual.chunk_data()[ chunk ].bits == expected.chunk_data()[ chunk ].bits );
+	}
+}
 
 inline void testBooleanBitWrapper()
 {
@@ -39,6 +97,19 @@ inline void testBooleanBitWrapper()
 	wrapper.bit_rightshift( 2 );
 	assert( wrapper.bits == 0b00000000000000000000000000000001 );
 
+	// Test bit 31 (最高位不能触发有符号移位溢出)
+	wrapper.bits = 0;
+	wrapper.bit_set( true, 31 );
+	assert( wrapper.bits == 0x80000000 && wrapper.bit_get( 31 ) );
+	wrapper.bit_flip( 31 );
+	assert( wrapper.bits == 0 );
+
+	// 编译期可用
+	constexpr BooleanBitWrapper constant( 0xF0F0F0F0 );
+	static_assert( constant.count_bits() == 16, "count_bits must be constexpr" );
+	static_assert( constant.bit_get( 4 ) && !constant.bit_get( 0 ), "bit_get must be constexpr" );
+	static_assert( std::is_trivially_copyable<BooleanBitWrapper>::value, "BooleanBitWrapper must be trivially copyable" );
+
 	std::cout << "All BooleanBitWrapper tests passed!\n";
 }
 
@@ -372,6 +443,10 @@ inline void testConversions()
 	std::cout << "input:  " << long_binary << std::endl;
 	std::cout << "output: " << output << std::endl;
 	assert( output == long_binary );
+	// 两个二进制字符串的构造函数给出相同的 bit_size()，都保留前导零
+	const DynamicBitSet db1_unformatted( long_binary );
+	assert( db1_unformatted.bit_size() == long_binary.size() && db1.bit_size() == long_binary.size() );
+	assert( db1_unformatted.format_binary_string( true ) == long_binary && db1_unformatted == db1 );
 	std::cout << "Test for long binary string passed." << std::endl;
 
 	std::string	  long_decimal = "1234567890123456789012345678901234567890123456789012345678901234567890123456789012345678901234567890123456789012345678901234567890123456789012345678901234567890";
@@ -416,6 +491,20 @@ inline void testLargeData()
 	std::chrono::duration<double> elapsed = end - start;
 	std::cout << "Time taken to set " << largeSize << " bits to false: " << elapsed.count() << "s\n";
 
+	// 测试性能：无边界检查的快速路径
+	start = std::chrono::high_resolution_clock::now();
+	for ( size_t i = 0; i < largeSize; ++i )
+	{
+		largeDb.set_unchecked( i );
+	}
+	for ( size_t i = 0; i < largeSize; ++i )
+	{
+		largeDb.reset_unchecked( i );
+	}
+	end = std::chrono::high_resolution_clock::now();
+	elapsed = end - start;
+	std::cout << "Time taken to set and reset " << largeSize << " bits (unchecked): " << elapsed.count() << "s\n";
+
 	// 确保所有位都设置为 false
 	for ( size_t i = 0; i < largeSize; ++i )
 	{
@@ -627,14 +716,2179 @@ inline void testOperatorsAndModifications()
 	std::cout << "All operator and modification tests passed!\n";
 }
 
-//void test_long_uint32_vector()
-//{
-//	std::vector<uint32_t> long_vector( 1000, 4294967295 );	// 1000个全为1的32位整数
-//	DynamicBitSet		  db( long_vector );
-//	std::vector<uint32_t> output = db.to_uint32_vector();  // 假设你有这样一个方法
-//	assert( output == long_vector );
-//	std::cout << "Test for long std::vector<uint32_t> passed." << std::endl;
-//}
+inline void testUncheckedAccess()
+{
+	using namespace TwilightDream;
+	DynamicBitSet db( 100, false );
+
+	db.set_unchecked( 0 );
+	db.set_unchecked( 31 );
+	db.set_unchecked( 32 );
+	db.set_unchecked( 99 );
+	assert( db.test_unchecked( 0 ) && db.test_unchecked( 31 ) && db.test_unchecked( 32 ) && db.test_unchecked( 99 ) );
+	assert( !db.test_unchecked( 1 ) && !db.test_unchecked( 98 ) );
+	assert( db.hamming_weight() == 4 );
+
+	db.reset_unchecked( 31 );
+	db.flip_unchecked( 33 );
+	assert( !db.get_bit( 31 ) && db.get_bit( 33 ) );
+
+	// 编译期访问策略
+	db.assign<UncheckedBitAccess>( true, 50 );
+	assert( db.test<UncheckedBitAccess>( 50 ) );
+	assert( db.test<CheckedBitAccess>( 50 ) );
+
+	bool thrown = false;
+	try
+	{
+		db.test<CheckedBitAccess>( 100 );
+	}
+	catch ( const std::out_of_range& )
+	{
+		thrown = true;
+	}
+	assert( thrown );
+
+	std::cout << "All unchecked access tests passed!\n";
+}
+
+inline void testBatchOperations()
+{
+	using namespace TwilightDream;
+	std::mt19937_64 gen( 20240601 );
+
+	// 覆盖多个分桶区域，以便走计数排序分桶的路径
+	const size_t		  size = 5000000;
+	DynamicBitSet		  db( size, false );
+	std::vector<bool>	  reference( size, false );
+	std::vector<size_t>	  indices( 20000 );
+	std::uniform_int_distribution<size_t> dis( 0, size - 1 );
+	for ( auto& index : indices )
+	{
+		index = dis( gen );
+	}
+
+	db.set_many( indices );
+	for ( size_t index : indices )
+	{
+		reference[ index ] = true;
+	}
+
+	std::vector<bool> tested = db.test_many( indices );
+	for ( size_t i = 0; i < indices.size(); ++i )
+	{
+		assert( tested[ i ] == true );
+	}
+
+	// 翻转前一半，清除后一半的前 100 个
+	db.flip_many( indices.data(), indices.size() / 2 );
+	for ( size_t i = 0; i < indices.size() / 2; ++i )
+	{
+		reference[ indices[ i ] ] = !reference[ indices[ i ] ];
+	}
+	db.reset_many( indices.data() + indices.size() / 2, 100 );
+	for ( size_t i = indices.size() / 2; i < indices.size() / 2 + 100; ++i )
+	{
+		reference[ indices[ i ] ] = false;
+	}
+
+	std::vector<size_t> probes( 1000 );
+	for ( auto& index : probes )
+	{
+		index = dis( gen );
+	}
+	probes.insert( probes.end(), indices.begin(), indices.end() );
+	tested = db.test_many( probes );
+	for ( size_t i = 0; i < probes.size(); ++i )
+	{
+		assert( tested[ i ] == reference[ probes[ i ] ] );
+		assert( db.get_bit( probes[ i ] ) == reference[ probes[ i ] ] );
+	}
+
+	// set_many 使用 DefaultBitAccess：定义 LARGE_DYNAMIC_BITSET_UNCHECKED_ACCESS 时不检查越界
+#if !defined( LARGE_DYNAMIC_BITSET_UNCHECKED_ACCESS )
+	bool thrown = false;
+	try
+	{
+		db.set_many( std::vector<size_t>{ 1, size } );
+	}
+	catch ( const std::out_of_range& )
+	{
+		thrown = true;
+	}
+	assert( thrown );
+#endif
+
+	std::cout << "All batch operation tests passed!\n";
+}
+
+inline void testParallelOperations()
+{
+	using namespace TwilightDream;
+	std::mt19937					gen( 7 );
+	std::uniform_int_distribution<uint32_t> dis;
+
+	// 使用很小的分段阈值，强制小数据也走多线程路径
+	const ParallelExecution execution( 4, 16 );
+
+	std::vector<uint32_t> values_a( 1000 ), values_b( 777 );
+	for ( auto& value : values_a )
+	{
+		value = dis( gen );
+	}
+	for ( auto& value : values_b )
+	{
+		value = dis( gen );
+	}
+
+	const DynamicBitSet a( values_a );
+	const DynamicBitSet b( values_b );
+
+	assert( a.hamming_weight( execution ) == a.hamming_weight() );
+	assert( a.valid_number_of_bits( execution ) == a.valid_number_of_bits() );
+
+	DynamicBitSet sequential = a, parallel = a;
+	sequential.and_operation( b );
+	parallel.and_operation( b, execution );
+	assert( sequential == parallel && sequential.bit_size() == parallel.bit_size() );
+
+	sequential = b, parallel = b;
+	sequential.or_operation( a );
+	parallel.or_operation( a, execution );
+	assert( sequential == parallel && sequential.bit_size() == parallel.bit_size() );
+
+	sequential = b, parallel = b;
+	sequential.xor_operation( a );
+	parallel.xor_operation( a, execution );
+	assert( sequential == parallel && sequential.bit_size() == parallel.bit_size() );
+
+	sequential = a, parallel = a;
+	sequential.not_operation();
+	parallel.not_operation( execution );
+	assert( sequential == parallel && sequential.bit_size() == parallel.bit_size() );
+
+	for ( size_t shift : { size_t( 1 ), size_t( 7 ), size_t( 23 ), size_t( 32 ), size_t( 64 ), size_t( 96 ) } )
+	{
+		sequential = a, parallel = a;
+		sequential.left_shift( shift );
+		parallel.left_shift( shift, execution );
+		assert( sequential == parallel );
+
+		sequential = a, parallel = a;
+		sequential.right_shift( shift );
+		parallel.right_shift( shift, execution );
+		assert( sequential == parallel );
+	}
+
+	// 大位移：并行版本一次完成，对照逐块移动的结果
+	sequential = a, parallel = a;
+	for ( size_t remaining = 5000; remaining > 0; )
+	{
+		const size_t step = std::min<size_t>( remaining, 24 );
+		sequential.left_shift( step );
+		remaining -= step;
+	}
+	parallel.left_shift( 5000, execution );
+	assert( sequential == parallel );
+
+	parallel.set( execution );
+	assert( parallel.all() && parallel.bit_size() == parallel.bit_capacity() );
+	parallel.reset( execution );
+	assert( parallel.none() && parallel.bit_size() == 0 );
+
+	// 工作线程中抛出的异常在所有线程结束之后传给调用者，part_index 最小的一个优先
+	std::atomic<size_t> finished_parts { 0 };
+	bool				caught = false;
+	try
+	{
+		parallel_for_chunk_ranges( execution, 1000, [ &finished_parts ]( size_t, size_t, size_t part_index ) {
+			if ( part_index % 2 == 0 )
+			{
+				throw std::runtime_error( "part " + std::to_string( part_index ) );
+			}
+			++finished_parts;
+		} );
+	}
+	catch ( const std::runtime_error& error )
+	{
+		caught = std::string( error.what() ) == "part 0";
+	}
+	assert( caught && finished_parts == 2 );
+
+	std::cout << "All parallel operation tests passed!\n";
+}
+
+inline void testConcurrentDynamicBitSet()
+{
+	using namespace TwilightDream;
+	const size_t			thread_count = 4;
+	const size_t			size = 10000;
+	ConcurrentDynamicBitSet bits( size );
+
+	// 多个线程同时设置交错的比特 (共享相同的字)，不应丢失任何更新
+	std::vector<std::thread> workers;
+	for ( size_t thread_index = 0; thread_index < thread_count; ++thread_index )
+	{
+		workers.emplace_back( [ &bits, thread_index, thread_count, size ]() {
+			for ( size_t i = thread_index; i < size; i += thread_count )
+			{
+				assert( !bits.fetch_set( i ) );
+			}
+		} );
+	}
+	for ( auto& worker : workers )
+	{
+		worker.join();
+	}
+	workers.clear();
+	assert( bits.hamming_weight() == size );
+	assert( bits.test_and_set( 17 ) );
+	assert( bits.fetch_reset( 17 ) && !bits.test( 17 ) );
+	assert( !bits.test_and_set( 17 ) && bits.test( 17 ) );
+
+	// 并发分配槽位：每个槽位只会被分配一次，直到全部被占满
+	bits.reset();
+	std::vector<std::vector<size_t>> allocated( thread_count );
+	for ( size_t thread_index = 0; thread_index < thread_count; ++thread_index )
+	{
+		workers.emplace_back( [ &bits, &allocated, thread_index ]() {
+			for ( size_t slot = bits.find_first_zero_and_set(); slot != ConcurrentDynamicBitSet::npos; slot = bits.find_first_zero_and_set() )
+			{
+				allocated[ thread_index ].push_back( slot );
+			}
+		} );
+	}
+	for ( auto& worker : workers )
+	{
+		worker.join();
+	}
+
+	std::vector<size_t> all_slots;
+	for ( const auto& slots : allocated )
+	{
+		all_slots.insert( all_slots.end(), slots.begin(), slots.end() );
+	}
+	std::sort( all_slots.begin(), all_slots.end() );
+	assert( all_slots.size() == size );
+	for ( size_t i = 0; i < size; ++i )
+	{
+		assert( all_slots[ i ] == i );
+	}
+
+	// 与 DynamicBitSet 之间的转换和按位或合并
+	DynamicBitSet pattern( 100, false );
+	pattern.set_bit( true, 3 );
+	pattern.set_bit( true, 64 );
+	pattern.set_bit( true, 99 );
+	ConcurrentDynamicBitSet merged( 100 );
+	merged.fetch_set( 5 );
+	merged.or_merge( pattern );
+	DynamicBitSet snapshot = merged.snapshot();
+	assert( snapshot.hamming_weight() == 4 );
+	assert( snapshot.get_bit( 3 ) && snapshot.get_bit( 5 ) && snapshot.get_bit( 64 ) && snapshot.get_bit( 99 ) );
+
+	std::cout << "All concurrent bit set tests passed!\n";
+}
+
+inline void testAllocators()
+{
+	using namespace TwilightDream;
+
+	// 默认按 cache line 对齐
+	DynamicBitSet aligned( 1000, true );
+	assert( reinterpret_cast<uintptr_t>( aligned.chunk_data() ) % 64 == 0 );
+	assert( aligned.memory_resource() == cache_aligned_memory_resource() );
+
+	// 每个请求的临时比特集来自 monotonic buffer，派生出的拷贝也留在同一个 arena 中
+	alignas( 64 ) static unsigned char	buffer[ 64 * 1024 ];
+	std::pmr::monotonic_buffer_resource arena( buffer, sizeof( buffer ), std::pmr::null_memory_resource() );
+	{
+		DynamicBitSet temporary( 4096, false, &arena );
+		temporary.set_bit( true, 100 );
+		const unsigned char* data = reinterpret_cast<const unsigned char*>( temporary.chunk_data() );
+		assert( data >= buffer && data < buffer + sizeof( buffer ) );
+		assert( reinterpret_cast<uintptr_t>( data ) % 64 == 0 );
+
+		DynamicBitSet copied( temporary );
+		assert( copied.memory_resource() == &arena );
+		assert( copied.get_bit( 100 ) );
+
+		// 赋值给一个普通的比特集时，目标保持自己的资源
+		DynamicBitSet long_lived;
+		long_lived = temporary;
+		assert( long_lived.memory_resource() == cache_aligned_memory_resource() );
+		assert( long_lived.get_bit( 100 ) );
+
+		// 移动赋值也不传播资源：资源不同时复制比特块 (可能分配，所以不是 noexcept)
+		DynamicBitSet moved_into;
+		moved_into = std::move( copied );
+		assert( moved_into.memory_resource() == cache_aligned_memory_resource() );
+		assert( moved_into.get_bit( 100 ) );
+	}
+	static_assert( std::is_nothrow_move_constructible_v<DynamicBitSet>, "move construction keeps the source resource" );
+	static_assert( !std::is_nothrow_move_assignable_v<DynamicBitSet>, "move assignment may allocate" );
+
+	// 超过阈值的比特集使用大页资源
+	DynamicBitSet huge( size_t( 64 ) * 1024 * 1024, false, huge_page_memory_resource() );
+	assert( reinterpret_cast<uintptr_t>( huge.chunk_data() ) % HugePageMemoryResource::huge_page_size == 0 );
+	huge.set_bit( true, huge.bit_size() - 1 );
+	assert( huge.hamming_weight() == 1 );
+
+	std::cout << "All allocator tests passed!\n";
+}
+
+inline void testInstrumentation()
+{
+	using namespace TwilightDream;
+
+	reset_instrumentation();
+
+	DynamicBitSet bits( 1024, false );
+	bits.set_bit( true, 1023 );
+	bits.set_bit( true, 3 );
+	bits.rotate_left( 300 );  // vector<bool> 回退路径
+	bits.insert( true, 10 );  // 逐位移动
+	bits.resize( 4096 );
+	bits.hamming_weight();
+	bits.shrink_to_fit();  // 重新计算 valid_number_of_bits()
+
+	const DynamicBitSetStatistics statistics = instrumentation_snapshot();
+	if ( instrumentation_enabled )
+	{
+		assert( statistics[ BitSetOperation::RotateLeft ].calls == 1 );
+		assert( statistics[ BitSetOperation::RotateLeft ].slow_path_hits == 1 );
+		assert( statistics[ BitSetOperation::Insert ].calls == 1 );
+		assert( statistics[ BitSetOperation::Insert ].slow_path_hits == 1 );
+		assert( statistics[ BitSetOperation::Resize ].calls >= 2 );
+		assert( statistics[ BitSetOperation::Resize ].reallocations >= 1 );
+		assert( statistics[ BitSetOperation::Resize ].bytes_allocated >= 4096 / 8 );
+		assert( statistics[ BitSetOperation::HammingWeight ].calls >= 1 );
+		assert( statistics[ BitSetOperation::HammingWeight ].bytes_touched >= 4096 / 8 );
+		assert( statistics[ BitSetOperation::ValidNumberOfBits ].calls >= 1 );
+		assert( std::string( operation_name( BitSetOperation::RotateLeft ) ) == "rotate_left" );
+
+		reset_instrumentation();
+		assert( instrumentation_snapshot()[ BitSetOperation::Resize ].calls == 0 );
+	}
+	else
+	{
+		// 关闭时不记录任何东西
+		for ( const auto& operation : statistics.operations )
+		{
+			assert( operation.calls == 0 && operation.bytes_touched == 0 && operation.reallocations == 0 && operation.slow_path_hits == 0 );
+		}
+	}
+
+	std::cout << "All instrumentation tests passed!\n";
+}
+
+inline void testStaticBitSet()
+{
+	using namespace TwilightDream;
+
+	// 编译期计算
+	constexpr StaticBitSet<64>	mask = StaticBitSet<64>( 0xFF00FF00FF00FF00ULL );
+	static_assert( mask.hamming_weight() == 32, "constexpr hamming_weight" );
+	static_assert( ( mask << 8 ).hamming_weight() == 24, "constexpr left shift" );
+	static_assert( ( mask >> 8 ) == StaticBitSet<64>( 0x00FF00FF00FF00FFULL ), "constexpr right shift" );
+	static_assert( ( ~mask ).test( 0 ) && !( ~mask ).test( 63 ), "constexpr not" );
+	static_assert( StaticBitSet<100>( std::string_view( "101" ) ).valid_number_of_bits() == 3, "constexpr binary string" );
+	static_assert( sizeof( StaticBitSet<512> ) == 64, "StaticBitSet is stored inline" );
+
+	constexpr StaticBitSet<70> rotated = []() {
+		StaticBitSet<70> bits( 1 );
+		bits.rotate_right( 1 );
+		return bits;
+	}();
+	static_assert( rotated.test( 69 ) && rotated.hamming_weight() == 1, "constexpr rotate over exactly N bits" );
+
+	// 与 DynamicBitSet 的结果一致 (宽度为 32 的倍数时移位语义相同)
+	std::mt19937		  generator( 7 );
+	std::vector<uint32_t> words( 4 );
+	for ( auto& word : words )
+	{
+		word = generator();
+	}
+	words.back() |= 0x80000000;
+
+	const DynamicBitSet	   dynamic( words );
+	const StaticBitSet<128> fixed( dynamic );
+	assert( fixed.hamming_weight() == dynamic.hamming_weight() );
+	assert( fixed.format_binary_string() == dynamic.format_binary_string() );
+	assert( fixed.string_hexadecimal_hugenumber() == dynamic.string_hexadecimal_hugenumber() );
+	assert( fixed.string_decimal_hugenumber() == dynamic.string_decimal_hugenumber() );
+
+	for ( size_t shift : { size_t( 1 ), size_t( 31 ), size_t( 32 ), size_t( 45 ), size_t( 127 ) } )
+	{
+		DynamicBitSet dynamic_left = dynamic;
+		DynamicBitSet dynamic_right = dynamic;
+		dynamic_left.left_shift( shift );
+		dynamic_right.right_shift( shift );
+		assert( ( fixed << shift ).format_binary_string() == dynamic_left.format_binary_string() );
+		assert( ( fixed >> shift ).format_binary_string() == dynamic_right.format_binary_string() );
+	}
+
+	// 往返转换
+	assert( StaticBitSet<128>( fixed.to_dynamic_bitset() ) == fixed );
+	assert( fixed.to_dynamic_bitset().bit_size() == 128 );
+
+	// 旋转 N 次回到原值
+	StaticBitSet<100> odd_width( std::string_view( "1100000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000001011" ) );
+	const StaticBitSet<100> original = odd_width;
+	odd_width.rotate_left( 37 );
+	assert( odd_width.hamming_weight() == original.hamming_weight() );
+	odd_width.rotate_right( 37 );
+	assert( odd_width == original );
+	odd_width.rotate_left( 1 );
+	assert( odd_width.test( 0 ) && odd_width.test( 1 ) && odd_width.test( 2 ) && odd_width.test( 4 ) && odd_width.test( 99 ) && !odd_width.test( 98 ) );
+
+	// 迭代器
+	size_t counted = 0;
+	for ( bool bit : fixed )
+	{
+		counted += bit;
+	}
+	assert( counted == fixed.hamming_weight() );
+
+	StaticBitSet<40> bits;
+	for ( auto bit : bits )
+	{
+		bit = true;
+	}
+	assert( bits.all() && bits.hamming_weight() == 40 );
+	assert( *bits.rbegin() == true );
+	bits.flip( 39 );
+	assert( !bits.all() && bits.valid_number_of_bits() == 39 );
+
+	bool thrown = false;
+	try
+	{
+		bits.test<CheckedBitAccess>( 40 );
+	}
+	catch ( const std::out_of_range& )
+	{
+		thrown = true;
+	}
+	assert( thrown );
+
+	// reset( pos ) 的越界检查与 set_bit / flip 相同 (使用 DefaultBitAccess)
+#if !defined( LARGE_DYNAMIC_BITSET_UNCHECKED_ACCESS )
+	thrown = false;
+	try
+	{
+		bits.reset( 40 );
+	}
+	catch ( const std::out_of_range& )
+	{
+		thrown = true;
+	}
+	assert( thrown );
+#endif
+	bits.reset( 0 );
+	assert( !bits.test( 0 ) && bits.hamming_weight() == 38 );
+
+	// 范围赋值与逐位赋值一致：同一个块内、跨越多个块、以及超出 N 的部分
+	const size_t ranges[][ 2 ] = { { 3, 7 }, { 0, 32 }, { 31, 2 }, { 5, 90 }, { 64, 36 }, { 90, 50 }, { 99, 1 }, { 100, 5 }, { 10, 0 } };
+	for ( const auto& range : ranges )
+	{
+		for ( const bool value : { true, false } )
+		{
+			StaticBitSet<100> ranged = original;
+			StaticBitSet<100> bitwise = original;
+			ranged.set( range[ 0 ], range[ 1 ], value );
+			for ( size_t i = range[ 0 ]; i < range[ 0 ] + range[ 1 ] && i < 100; ++i )
+			{
+				bitwise.set_bit( value, i );
+			}
+			assert( ranged == bitwise );
+		}
+	}
+	static_assert( []() {
+		StaticBitSet<70> ranged;
+		ranged.set( 30, 40, true );
+		return ranged.hamming_weight() == 40 && !ranged.test( 29 ) && ranged.test( 69 );
+	}(), "constexpr range set" );
+
+	std::cout << "All static bit set tests passed!\n";
+}
+
+inline void testLargeIntegerNumber()
+{
+	using namespace TwilightDream;
+
+	// 字符串转换
+	const LargeIntegerNumber two_pow_64( "18446744073709551616" );
+	assert( two_pow_64 == ( LargeIntegerNumber( 1 ) << 64 ) );
+	assert( two_pow_64.to_string( 16 ) == "10000000000000000" );
+	assert( two_pow_64.bit_length() == 65 && two_pow_64.limb_count() == 3 );
+	assert( LargeIntegerNumber( "-ff", 16 ) == LargeIntegerNumber( -255 ) );
+	assert( LargeIntegerNumber( "1011", 2 ).to_string() == "11" );
+	assert( LargeIntegerNumber( "-1000000000000000000000000000001" ).to_string() == "-1000000000000000000000000000001" );
+	assert( LargeIntegerNumber( "000" ).is_zero() && LargeIntegerNumber( "-0" ).sign() == 0 );
+	assert( LargeIntegerNumber( INT64_MIN ).to_string() == "-9223372036854775808" );
+	assert( LargeIntegerNumber::from_unsigned( UINT64_MAX ) + 1 == two_pow_64 );
+
+	bool thrown = false;
+	try
+	{
+		LargeIntegerNumber( "12a4" );
+	}
+	catch ( const std::invalid_argument& )
+	{
+		thrown = true;
+	}
+	assert( thrown );
+
+	// 与 DynamicBitSet 基于字符串的十进制转换一致
+	std::mt19937		  generator( 37 );
+	std::vector<uint32_t> words( 12 );
+	for ( auto& word : words )
+	{
+		word = generator();
+	}
+	words.back() |= 0x80000000;
+	const DynamicBitSet		 bits( words );
+	const LargeIntegerNumber from_bits( bits );
+	assert( from_bits.to_string() == bits.string_decimal_hugenumber() );
+	assert( from_bits.to_string( 16 ) == bits.string_hexadecimal_hugenumber() );
+	assert( LargeIntegerNumber( bits.string_decimal_hugenumber() ) == from_bits );
+	assert( from_bits.magnitude().format_binary_string() == bits.format_binary_string() );
+
+	// 符号与进位 / 借位
+	assert( LargeIntegerNumber( 5 ) - LargeIntegerNumber( 8 ) == LargeIntegerNumber( -3 ) );
+	assert( LargeIntegerNumber( -5 ) + LargeIntegerNumber( 5 ) == LargeIntegerNumber() );
+	assert( two_pow_64 - 1 == LargeIntegerNumber::from_unsigned( UINT64_MAX ) );
+	assert( LargeIntegerNumber( -3 ) < LargeIntegerNumber( 2 ) && LargeIntegerNumber( -3 ) < LargeIntegerNumber( -2 ) );
+
+	// 截断除法，余数与被除数同号
+	assert( LargeIntegerNumber( -7 ) / LargeIntegerNumber( 2 ) == LargeIntegerNumber( -3 ) );
+	assert( LargeIntegerNumber( -7 ) % LargeIntegerNumber( 2 ) == LargeIntegerNumber( -1 ) );
+	assert( LargeIntegerNumber( 7 ) % LargeIntegerNumber( -2 ) == LargeIntegerNumber( 1 ) );
+
+	auto random_number = [ &generator ]( size_t limbs ) {
+		std::vector<uint32_t> values( limbs );
+		for ( auto& value : values )
+		{
+			value = generator();
+		}
+		values.back() |= 1;
+		return LargeIntegerNumber( DynamicBitSet( values ), generator() & 1 );
+	};
+
+	// Karatsuba 与教科书乘法一致，除法与乘法互逆
+	for ( size_t left_limbs : { size_t( 1 ), size_t( 3 ), size_t( 40 ), size_t( 97 ), size_t( 300 ) } )
+	{
+		for ( size_t right_limbs : { size_t( 1 ), size_t( 2 ), size_t( 41 ), size_t( 128 ) } )
+		{
+			const LargeIntegerNumber left = random_number( left_limbs );
+			const LargeIntegerNumber right = random_number( right_limbs );
+			const LargeIntegerNumber product = left * right;
+			assert( product == LargeIntegerNumber::multiply_schoolbook( left, right ) );
+			assert( product == LargeIntegerNumber::multiply_karatsuba( left, right ) );
+			assert( product / right == left && ( product % right ).is_zero() );
+
+			const auto [ quotient, remainder ] = LargeIntegerNumber::divide( left, right );
+			assert( quotient * right + remainder == left );
+			assert( remainder.abs() < right.abs() );
+			assert( remainder.is_zero() || remainder.is_negative() == left.is_negative() );
+		}
+	}
+
+	// 全 1 的肢会触发 Knuth 算法 D 中的"加回"分支
+	const LargeIntegerNumber all_ones = ( LargeIntegerNumber( 1 ) << 512 ) - 1;
+	const LargeIntegerNumber divisor = ( LargeIntegerNumber( 1 ) << 256 ) - ( LargeIntegerNumber( 1 ) << 31 ) + 1;
+	const auto [ quotient, remainder ] = LargeIntegerNumber::divide( all_ones, divisor );
+	assert( quotient * divisor + remainder == all_ones && remainder < divisor );
+
+	// 移位
+	assert( ( from_bits << 77 ) >> 77 == from_bits );
+	assert( ( from_bits >> 1000 ).is_zero() );
+
+	// 模幂：费马小定理，2^61 - 1 是素数
+	const LargeIntegerNumber mersenne_prime = ( LargeIntegerNumber( 1 ) << 61 ) - 1;
+	assert( LargeIntegerNumber::pow_mod( 3, mersenne_prime - 1, mersenne_prime ) == LargeIntegerNumber( 1 ) );
+	assert( LargeIntegerNumber::pow_mod( -2, 3, 5 ) == LargeIntegerNumber( 2 ) );
+	assert( LargeIntegerNumber::pow_mod( 4, 0, 1 ).is_zero() );
+	assert( LargeIntegerNumber::pow_mod( 4, 13, 497 ) == LargeIntegerNumber( 445 ) );
+
+	std::cout << "All large integer number tests passed!\n";
+}
+
+inline void testComparisons()
+{
+	using namespace TwilightDream;
+
+	// 相同的比特，不同的 reserve() 历史和长度
+	DynamicBitSet reserved( std::string( "1011" ) );
+	reserved.reserve( 4096 );
+	const DynamicBitSet plain( std::string( "1011" ) );
+	DynamicBitSet padded( 300, false );
+	padded.set_bit( true, 0 );
+	padded.set_bit( true, 1 );
+	padded.set_bit( true, 3 );
+	assert( reserved == plain && plain == padded && padded == reserved );
+	assert( plain.compare( padded ) == 0 && !( plain < padded ) && plain <= padded );
+	assert( DynamicBitSet() == DynamicBitSet( 64, false ) );
+
+	// 从最高的块向下比较
+	padded.set_bit( true, 299 );
+	assert( plain < padded && padded > plain && plain != padded );
+	assert( DynamicBitSet( std::string( "0111" ) ) < DynamicBitSet( std::string( "1000" ) ) );
+
+	// 与 LargeIntegerNumber 的数值顺序一致，可以作为 std::map 的键
+	std::mt19937			   generator( 38 );
+	std::vector<DynamicBitSet> sets;
+	for ( size_t i = 0; i < 64; ++i )
+	{
+		std::vector<uint32_t> words( 1 + generator() % 40 );
+		for ( auto& word : words )
+		{
+			word = generator() % 4 == 0 ? 0 : generator();
+		}
+		sets.emplace_back( words );
+	}
+	sets.push_back( sets.front() );
+	for ( const auto& left : sets )
+	{
+		for ( const auto& right : sets )
+		{
+			assert( left.compare( right ) == LargeIntegerNumber( left ).compare( LargeIntegerNumber( right ) ) );
+		}
+	}
+
+	std::map<DynamicBitSet, size_t> index;
+	for ( size_t i = 0; i < sets.size(); ++i )
+	{
+		index.emplace( sets[ i ], i );
+	}
+	assert( index.size() == sets.size() - 1 );
+	std::sort( sets.begin(), sets.end() );
+	assert( std::is_sorted( sets.begin(), sets.end(), []( const DynamicBitSet& left, const DynamicBitSet& right ) {
+		return LargeIntegerNumber( left ) < LargeIntegerNumber( right );
+	} ) );
+
+	// 子集与相交 (长度不同)
+	DynamicBitSet small( 40, false );
+	DynamicBitSet large( 1000, false );
+	small.set_bit( true, 3 );
+	small.set_bit( true, 35 );
+	large.set_bit( true, 3 );
+	large.set_bit( true, 35 );
+	assert( small.is_subset_of( large ) && large.is_subset_of( small ) && !small.is_proper_subset_of( large ) );
+	large.set_bit( true, 900 );
+	assert( small.is_subset_of( large ) && !large.is_subset_of( small ) );
+	assert( small.is_proper_subset_of( large ) && !large.is_proper_subset_of( small ) );
+	assert( small.intersects( large ) && large.intersects( small ) );
+	small.set_bit( true, 36 );
+	assert( !small.is_subset_of( large ) && !small.is_proper_subset_of( large ) );
+	small.set_bit( false, 3 );
+	small.set_bit( false, 35 );
+	assert( !small.intersects( large ) );
+	assert( DynamicBitSet().is_subset_of( small ) && DynamicBitSet().is_proper_subset_of( small ) && !DynamicBitSet().intersects( small ) );
+
+	std::cout << "All comparison tests passed!\n";
+}
+
+// CachedHashDynamicBitSet::modify() 不接受返回引用的 modifier (引用会在缓存失效之后继续修改比特)
+template <typename Modifier, typename = void>
+struct HasCachedModify : std::false_type
+{
+};
+
+template <typename Modifier>
+struct HasCachedModify<Modifier, std::void_t<decltype( std::declval<TwilightDream::CachedHashDynamicBitSet&>().modify( std::declval<Modifier>() ) )>> : std::true_type
+{
+};
+
+inline void testHashing()
+{
+	using namespace TwilightDream;
+
+	std::mt19937		  generator( 39 );
+	std::vector<uint32_t> words( 100 );
+	for ( auto& word : words )
+	{
+		word = generator();
+	}
+	const DynamicBitSet bits( words );
+
+	// 与容量、长度和高位的零块无关
+	DynamicBitSet padded( words );
+	padded.reserve( 100000 );
+	padded.resize( 5000 );
+	assert( padded == bits && padded.hash() == bits.hash() );
+	assert( std::hash<DynamicBitSet>()( padded ) == std::hash<DynamicBitSet>()( bits ) );
+	assert( DynamicBitSet().hash() == DynamicBitSet( 1000, false ).hash() );
+	assert( bits.hash() != bits.hash( 1 ) );
+
+	// 流式计算与一次性计算一致 (任意切分，包括中间的零块)
+	std::vector<uint32_t> with_zeros = words;
+	std::fill( with_zeros.begin() + 40, with_zeros.begin() + 70, 0 );
+	with_zeros.resize( 130, 0 );
+	const DynamicBitSet zero_runs( with_zeros );
+	const auto*			chunks = zero_runs.chunk_data();
+	for ( size_t split_count = 1; split_count < 12; ++split_count )
+	{
+		BitChunkHasher hasher;
+		size_t		   offset = 0;
+		while ( offset < zero_runs.chunk_count() )
+		{
+			const size_t length = std::min<size_t>( 1 + generator() % 37, zero_runs.chunk_count() - offset );
+			hasher.update( chunks + offset, length );
+			offset += length;
+		}
+		assert( hasher.finish() == zero_runs.hash() );
+	}
+
+	BitChunkHasher word_hasher;
+	for ( size_t i = 0; i < words.size(); i += 2 )
+	{
+		word_hasher.update( uint64_t( words[ i ] ) | ( uint64_t( words[ i + 1 ] ) << 32 ) );
+	}
+	assert( word_hasher.finish() == bits.hash() );
+
+	// 交换两个条带、翻转任意一个比特都会改变哈希值
+	std::vector<uint32_t> swapped = words;
+	std::swap_ranges( swapped.begin(), swapped.begin() + BitChunkHasher::stripe_chunks, swapped.begin() + BitChunkHasher::stripe_chunks );
+	assert( DynamicBitSet( swapped ).hash() != bits.hash() );
+
+	std::unordered_set<uint64_t> hashes;
+	for ( size_t i = 0; i < bits.bit_size(); i += 7 )
+	{
+		DynamicBitSet flipped = bits;
+		flipped.flip( i );
+		hashes.insert( flipped.hash() );
+	}
+	assert( hashes.size() == ( bits.bit_size() + 6 ) / 7 );
+
+	// StaticBitSet 与比特相同的 DynamicBitSet 哈希值相同
+	const StaticBitSet<200> fixed( DynamicBitSet( std::vector<uint32_t>( words.begin(), words.begin() + 6 ) ) );
+	assert( fixed.hash() == DynamicBitSet( std::vector<uint32_t>( words.begin(), words.begin() + 6 ) ).hash() );
+	assert( std::hash<StaticBitSet<200>>()( fixed ) == fixed.hash() );
+
+	// 用于去重
+	std::unordered_set<DynamicBitSet> unique;
+	unique.insert( bits );
+	unique.insert( padded );
+	unique.insert( zero_runs );
+	assert( unique.size() == 2 );
+
+	// 带缓存的哈希
+	CachedHashDynamicBitSet cached( bits );
+	assert( !cached.hash_cached() );
+	assert( cached.hash() == bits.hash() && cached.hash_cached() );
+	cached.modify( []( DynamicBitSet& value ) { value.flip( 3 ); } );
+	assert( !cached.hash_cached() && cached.hash() != bits.hash() );
+	const size_t weight = cached.modify( []( DynamicBitSet& value ) { return value.hamming_weight(); } );
+	assert( weight == cached.bits().hamming_weight() && !cached.hash_cached() );
+	auto returns_value = []( DynamicBitSet& value ) { return value; };
+	auto returns_reference = []( DynamicBitSet& value ) -> DynamicBitSet& { return value; };
+	auto returns_const_reference = []( DynamicBitSet& value ) -> const DynamicBitSet& { return value; };
+	static_assert( HasCachedModify<decltype( returns_value )>::value, "modifier returning a copy" );
+	static_assert( !HasCachedModify<decltype( returns_reference )>::value, "a returned reference would outlive the invalidation" );
+	static_assert( !HasCachedModify<decltype( returns_const_reference )>::value, "a returned reference would outlive the invalidation" );
+	cached.assign( padded );
+	assert( cached.hash() == bits.hash() );
+
+	std::unordered_map<CachedHashDynamicBitSet, size_t> counts;
+	++counts[ CachedHashDynamicBitSet( bits ) ];
+	++counts[ CachedHashDynamicBitSet( padded ) ];
+	++counts[ CachedHashDynamicBitSet( zero_runs ) ];
+	assert( counts.size() == 2 && counts[ cached ] == 2 );
+
+	std::cout << "All hashing tests passed!\n";
+}
+
+inline void testFusedOperations()
+{
+	using namespace TwilightDream;
+
+	std::mt19937 generator( 40 );
+	auto reference = []( const DynamicBitSet& set, size_t chunk ) -> uint32_t {
+		return chunk < set.chunk_count() ? set.chunk_data()[ chunk ].bits : 0;
+	};
+
+	// andnot / ornot / xnor
+	const DynamicBitSet left = random_set( generator, 70 );
+	const DynamicBitSet right = random_set( generator, 45 );
+
+	DynamicBitSet and_not = left;
+	and_not.and_not_operation( right );
+	DynamicBitSet or_not = left;
+	or_not.or_not_operation( right );
+	DynamicBitSet xnor = left;
+	xnor.xnor_operation( right );
+	DynamicBitSet short_xnor = right;
+	short_xnor.xnor_operation( left );
+	for ( size_t chunk = 0; chunk < 70; ++chunk )
+	{
+		const uint32_t a = reference( left, chunk );
+		const uint32_t b = reference( right, chunk );
+		assert( reference( and_not, chunk ) == ( a & ~b ) );
+		assert( reference( or_not, chunk ) == ( chunk < 45 ? ( a | ~b ) : a ) );
+		assert( reference( xnor, chunk ) == ~( a ^ b ) );
+		assert( reference( short_xnor, chunk ) == ~( a ^ b ) );
+	}
+
+	DynamicBitSet self_or_not = right;
+	self_or_not.or_not_operation( right );
+	assert( self_or_not.hamming_weight() == 45 * 32 );
+
+	// 三输入函数：所有 256 个真值表与逐块计算一致 (包括不满 16 个块的尾部和不同的长度)
+	const DynamicBitSet third = random_set( generator, 37 );
+	for ( unsigned truth_table = 0; truth_table < 256; ++truth_table )
+	{
+		DynamicBitSet result = left;
+		result.ternary_operation( right, third, static_cast<uint8_t>( truth_table ) );
+		for ( size_t chunk = 0; chunk < 70; chunk += 3 )
+		{
+			const uint32_t a = reference( left, chunk ), b = reference( right, chunk ), c = reference( third, chunk );
+			uint32_t	   expected = 0;
+			for ( unsigned bit = 0; bit < 32; ++bit )
+			{
+				const unsigned index = ( ( ( a >> bit ) & 1 ) << 2 ) | ( ( ( b >> bit ) & 1 ) << 1 ) | ( ( c >> bit ) & 1 );
+				expected |= uint32_t( ( truth_table >> index ) & 1 ) << bit;
+			}
+			assert( reference( result, chunk ) == expected );
+		}
+	}
+
+	DynamicBitSet majority = left;
+	majority.ternary_operation( right, third, ternary_function::majority );
+	DynamicBitSet select = left;
+	select.ternary_operation( right, third, ternary_function::select );
+	for ( size_t chunk = 0; chunk < 70; ++chunk )
+	{
+		const uint32_t a = reference( left, chunk ), b = reference( right, chunk ), c = reference( third, chunk );
+		assert( reference( majority, chunk ) == ( ( a & b ) | ( a & c ) | ( b & c ) ) );
+		assert( reference( select, chunk ) == ( ( a & b ) | ( ~a & c ) ) );
+	}
+
+	// N 路运算与逐个 |= / &= 以及逐位计数一致
+	std::vector<DynamicBitSet> sets;
+	for ( size_t i = 0; i < 11; ++i )
+	{
+		const size_t chunk_count = 60 + generator() % 200;
+		sets.push_back( random_set( generator, chunk_count ) );
+	}
+
+	DynamicBitSet chained_union;
+	for ( const auto& set : sets )
+	{
+		chained_union |= set;
+	}
+	assert( DynamicBitSet::union_all( sets ) == chained_union );
+	assert( DynamicBitSet::threshold_count( sets, 1 ) == chained_union );
+
+	DynamicBitSet chained_intersection = sets.front();
+	for ( const auto& set : sets )
+	{
+		chained_intersection &= set;
+	}
+	assert( DynamicBitSet::intersect_all( sets ) == chained_intersection );
+	assert( DynamicBitSet::threshold_count( sets, sets.size() ) == chained_intersection );
+	assert( DynamicBitSet::intersect_all( std::vector<DynamicBitSet>() ).chunk_count() == 0 );
+
+	for ( size_t threshold : { size_t( 2 ), size_t( 6 ), size_t( 10 ) } )
+	{
+		const DynamicBitSet counted = DynamicBitSet::threshold_count( sets, threshold );
+		for ( size_t chunk = 0; chunk < counted.chunk_count(); ++chunk )
+		{
+			for ( unsigned bit = 0; bit < 32; ++bit )
+			{
+				size_t votes = 0;
+				for ( const auto& set : sets )
+				{
+					votes += ( reference( set, chunk ) >> bit ) & 1;
+				}
+				assert( ( ( reference( counted, chunk ) >> bit ) & 1 ) == ( votes >= threshold ) );
+			}
+		}
+	}
+	assert( DynamicBitSet::threshold_count( sets, sets.size() + 1 ).hamming_weight() == 0 );
+
+	std::cout << "All fused operation tests passed!\n";
+}
+
+//void test_long_uint32_vector()
+//{
+//	std::vector<uint32_t> long_vector( 1000, 4294967295 );	// 1000个全为1的32位整数
+//	DynamicBitSet		  db( long_vector );
+//	std::vector<uint32_t> output = db.to_uint32_vector();  // 假设你有这样一个方法
+//	assert( output == long_vector );
+//	std::cout << "Test for long std::vector<uint32_t> passed." << std::endl;
+//}
+
+inline void testHierarchicalBitSet()
+{
+	using namespace TwilightDream;
+
+	std::mt19937 generator( 41 );
+
+	auto find_reference = []( const std::vector<bool>& reference, bool value, size_t from ) {
+		for ( size_t index = from; index < reference.size(); ++index )
+		{
+			if ( reference[ index ] == value )
+			{
+				return index;
+			}
+		}
+		return HierarchicalDynamicBitSet::npos;
+	};
+	auto check = [ & ]( const HierarchicalDynamicBitSet& bits, const std::vector<bool>& reference ) {
+		const size_t ones = std::count( reference.begin(), reference.end(), true );
+		assert( bits.hamming_weight() == ones );
+		assert( bits.any() == ( ones != 0 ) );
+		assert( bits.none() == ( ones == 0 ) );
+		assert( bits.all() == ( ones == reference.size() ) );
+		for ( size_t probe = 0; probe < 8; ++probe )
+		{
+			const size_t from = reference.empty() ? 0 : generator() % reference.size();
+			assert( bits.find_first_one( from ) == find_reference( reference, true, from ) );
+			assert( bits.find_first_zero( from ) == find_reference( reference, false, from ) );
+		}
+		assert( bits.find_first_one() == find_reference( reference, true, 0 ) );
+		assert( bits.find_first_zero() == find_reference( reference, false, 0 ) );
+	};
+
+	// 4097 个字需要 3 层摘要
+	for ( size_t bit_size : { size_t( 0 ), size_t( 1 ), size_t( 64 ), size_t( 100 ), size_t( 4096 ), size_t( 4096 * 64 + 37 ) } )
+	{
+		HierarchicalDynamicBitSet bits( bit_size );
+		std::vector<bool>		  reference( bit_size, false );
+		check( bits, reference );
+		if ( bit_size == 0 )
+		{
+			assert( bits.find_first_zero_and_set() == HierarchicalDynamicBitSet::npos );
+			continue;
+		}
+
+		for ( size_t round = 0; round < 200; ++round )
+		{
+			const size_t index = generator() % bit_size;
+			switch ( generator() % 4 )
+			{
+			case 0:
+				bits.set( index );
+				reference[ index ] = true;
+				break;
+			case 1:
+				bits.reset( index );
+				reference[ index ] = false;
+				break;
+			case 2:
+				bits.flip( index );
+				reference[ index ] = !reference[ index ];
+				break;
+			default:
+			{
+				const size_t length = generator() % ( bit_size - index ) + 1;
+				const bool	 value = generator() % 2;
+				bits.set( index, length, value );
+				std::fill( reference.begin() + index, reference.begin() + index + length, value );
+				break;
+			}
+			}
+			if ( round % 20 == 0 )
+			{
+				check( bits, reference );
+			}
+		}
+		check( bits, reference );
+		for ( size_t index = 0; index < bit_size; ++index )
+		{
+			assert( bits.test( index ) == reference[ index ] );
+		}
+
+		// 填满之后从摘要中分配
+		bits.set();
+		std::fill( reference.begin(), reference.end(), true );
+		check( bits, reference );
+		assert( bits.find_first_zero_and_set() == HierarchicalDynamicBitSet::npos );
+		const size_t hole = bit_size / 3;
+		bits.reset( hole );
+		assert( bits.find_first_zero() == hole );
+		assert( bits.find_first_zero_and_set() == hole );
+		assert( bits.all() );
+
+		bits.reset();
+		std::fill( reference.begin(), reference.end(), false );
+		check( bits, reference );
+	}
+
+	// 批量运算：与 DynamicBitSet 的结果比较，包括跳过空块的路径
+	const size_t bit_size = 4096 * 20 + 77;
+	auto		 random_sparse = [ & ]( size_t empty_every ) {
+		std::vector<uint32_t> words( ( bit_size + 31 ) / 32 );
+		for ( size_t chunk = 0; chunk < words.size(); ++chunk )
+		{
+			words[ chunk ] = ( chunk / 128 ) % empty_every == 0 ? 0 : generator();
+		}
+		words.back() &= ( uint32_t( 1 ) << ( bit_size % 32 ) ) - 1;
+		return DynamicBitSet( words );
+	};
+	// DynamicBitSet( words ) 的 bit_size() 只到最高的 1，这里固定为 bit_size
+	auto make = [ bit_size ]( const DynamicBitSet& bits ) {
+		HierarchicalDynamicBitSet result( bit_size );
+		result.or_operation( bits );
+		return result;
+	};
+	auto rebuilt = []( const HierarchicalDynamicBitSet& bits ) {
+		// 重新从数据构造的摘要必须与增量维护的摘要给出相同的结果
+		return HierarchicalDynamicBitSet( bits.bits() );
+	};
+
+	const DynamicBitSet left = random_sparse( 3 );
+	const DynamicBitSet right = random_sparse( 4 );
+	const DynamicBitSet short_right = random_sparse( 2 ) >> 5000;
+
+	DynamicBitSet expected = left;
+	expected.and_operation( right );
+	HierarchicalDynamicBitSet result = make( left );
+	result.and_operation( make( right ) );
+	assert_same_chunks( result.bits(), expected );
+
+	expected = left;
+	expected.or_operation( right );
+	result = make( left );
+	result |= make( right );
+	assert_same_chunks( result.bits(), expected );
+
+	expected = left;
+	expected.xor_operation( right );
+	result = make( left );
+	result ^= make( right );
+	assert_same_chunks( result.bits(), expected );
+
+	expected = left;
+	expected.and_not_operation( right );
+	result = make( left );
+	result.and_not_operation( make( right ) );
+	assert_same_chunks( result.bits(), expected );
+	for ( size_t from = 0; from < bit_size; from += 997 )
+	{
+		assert( result.find_first_one( from ) == rebuilt( result ).find_first_one( from ) );
+		assert( result.find_first_zero( from ) == rebuilt( result ).find_first_zero( from ) );
+	}
+
+	// 较短的 DynamicBitSet：缺少的部分视为 0
+	result = make( left );
+	result.and_operation( short_right );
+	for ( size_t index = 0; index < bit_size; ++index )
+	{
+		assert( result.test( index ) == ( left.get_bit( index ) && index < short_right.bit_size() && short_right.get_bit( index ) ) );
+	}
+	assert( result.hamming_weight() == rebuilt( result ).hamming_weight() );
+
+	result = make( left );
+	result.or_operation( short_right );
+	result.xor_operation( short_right );
+	result.and_not_operation( short_right );
+	for ( size_t index = 0; index < bit_size; ++index )
+	{
+		const bool other = index < short_right.bit_size() && short_right.get_bit( index );
+		assert( result.test( index ) == ( ( ( left.get_bit( index ) || other ) != other ) && !other ) );
+	}
+	assert( result.find_first_one() == rebuilt( result ).find_first_one() );
+
+	bool thrown = false;
+	try
+	{
+		result.or_operation( HierarchicalDynamicBitSet( bit_size + 1 ) );
+	}
+	catch ( const std::invalid_argument& )
+	{
+		thrown = true;
+	}
+	assert( thrown );
+
+	std::cout << "All HierarchicalDynamicBitSet tests passed!\n";
+}
+
+inline void testCopyOnWriteBitSet()
+{
+	using namespace TwilightDream;
+
+	std::mt19937 generator( 42 );
+
+	// 3 个完整的块加上一个不完整的块
+	const size_t bit_size = CopyOnWriteDynamicBitSet::block_bits * 3 + 100;
+	const DynamicBitSet source = random_bits( generator, bit_size );
+
+	CopyOnWriteDynamicBitSet original( source );
+	assert( original.bit_size() == bit_size && original.to_dynamic_bitset().bit_size() == bit_size );
+	assert( original.block_count() == 4 );
+	assert_same_chunks( original.to_dynamic_bitset(), source );
+	assert( original.hamming_weight() == source.hamming_weight() );
+
+	// 复制只共享存储；修改一个比特只复制这个比特所在的块
+	CopyOnWriteDynamicBitSet copy = original;
+	assert( copy.shares_storage( original ) );
+	assert( copy == original );
+	const size_t index = CopyOnWriteDynamicBitSet::block_bits + 5;
+	copy.set_bit( !source.get_bit( index ), index );
+	assert( !copy.shares_storage( original ) );
+	assert( copy.shares_block( original, 0 ) && !copy.shares_block( original, 1 ) && copy.shares_block( original, 2 ) && copy.shares_block( original, 3 ) );
+	assert( copy.test( index ) != original.test( index ) );
+	assert( copy != original );
+	assert_same_chunks( original.to_dynamic_bitset(), source );
+
+	// 写入一个值相同的比特不会复制
+	CopyOnWriteDynamicBitSet unchanged = original;
+	unchanged.set_bit( source.get_bit( 7 ), 7 );
+	assert( unchanged.shares_storage( original ) );
+
+	copy.flip( index );
+	assert( copy == original );
+	assert( !copy.shares_block( original, 1 ) );
+
+	// 与 DynamicBitSet 对比单个比特和范围的修改
+	DynamicBitSet			 expected = source;
+	CopyOnWriteDynamicBitSet modified = original;
+	for ( size_t round = 0; round < 300; ++round )
+	{
+		const size_t position = generator() % bit_size;
+		switch ( generator() % 3 )
+		{
+		case 0:
+			modified.set( position );
+			expected.set_bit( true, position );
+			break;
+		case 1:
+			modified.flip( position );
+			expected.set_bit( !expected.get_bit( position ), position );
+			break;
+		default:
+		{
+			// 有时跨越整个块
+			const size_t length = generator() % std::min<size_t>( bit_size - position, CopyOnWriteDynamicBitSet::block_bits * 2 ) + 1;
+			const bool	 value = generator() % 2;
+			modified.set( position, length, value );
+			for ( size_t offset = 0; offset < length; ++offset )
+			{
+				expected.set_bit( value, position + offset );
+			}
+			break;
+		}
+		}
+	}
+	assert_same_chunks( modified.to_dynamic_bitset(), expected );
+	assert( modified.hamming_weight() == expected.hamming_weight() );
+	assert_same_chunks( original.to_dynamic_bitset(), source );
+
+	// 整块覆盖的范围换成零块或者全 1 块
+	CopyOnWriteDynamicBitSet filled( bit_size, true );
+	assert( filled.hamming_weight() == bit_size );
+	filled.set( 0, bit_size, false );
+	assert( filled.none() );
+	filled.set();
+	assert( filled.hamming_weight() == bit_size );
+	filled.reset();
+	assert( filled.none() && filled.hamming_weight() == 0 );
+	CopyOnWriteDynamicBitSet empty( bit_size );
+	assert( filled == empty && filled.shares_block( empty, 0 ) );
+
+	// 按位运算，包括共享块、零块与自身的快速路径
+	const DynamicBitSet		 other_source = random_bits( generator, bit_size );
+	CopyOnWriteDynamicBitSet other( other_source );
+	other.set( CopyOnWriteDynamicBitSet::block_bits * 2, CopyOnWriteDynamicBitSet::block_bits, false );
+	DynamicBitSet other_expected = other.to_dynamic_bitset();
+
+	CopyOnWriteDynamicBitSet result = original;
+	result &= other;
+	expected = source;
+	expected.and_operation( other_expected );
+	assert_same_chunks( result.to_dynamic_bitset(), expected );
+	assert( result.shares_block( empty, 2 ) );
+
+	result = original;
+	result |= other;
+	expected = source;
+	expected.or_operation( other_expected );
+	assert_same_chunks( result.to_dynamic_bitset(), expected );
+	assert( result.shares_block( original, 2 ) );
+
+	result = original;
+	result ^= other;
+	expected = source;
+	expected.xor_operation( other_expected );
+	assert_same_chunks( result.to_dynamic_bitset(), expected );
+
+	result = original;
+	result.and_not_operation( other );
+	expected = source;
+	expected.and_not_operation( other_expected );
+	assert_same_chunks( result.to_dynamic_bitset(), expected );
+
+	result = empty;
+	result |= original;
+	assert( result == original && result.shares_block( original, 0 ) );
+	result ^= original;
+	assert( result.none() && result.shares_block( empty, 1 ) );
+
+	result = original;
+	result ^= result;
+	assert( result.none() );
+	assert_same_chunks( original.to_dynamic_bitset(), source );
+
+	bool thrown = false;
+	try
+	{
+		result.or_operation( CopyOnWriteDynamicBitSet( bit_size + 1 ) );
+	}
+	catch ( const std::invalid_argument& )
+	{
+		thrown = true;
+	}
+	assert( thrown );
+
+	std::cout << "All CopyOnWriteDynamicBitSet tests passed!\n";
+}
+
+inline void testPersistentBitSet()
+{
+	using namespace TwilightDream;
+
+	std::mt19937 generator( 43 );
+
+	// 高度为 2：33 个叶子需要两层内部节点
+	const size_t bit_size = PersistentDynamicBitSet::leaf_bits * 33 - 7;
+	DynamicBitSet source = random_bits( generator, bit_size );
+	for ( size_t chunk = 0; chunk < source.chunk_count(); chunk += PersistentDynamicBitSet::leaf_chunks * 3 )
+	{
+		// 一部分叶子保持全零
+		std::fill_n( source.chunk_data() + chunk, std::min( PersistentDynamicBitSet::leaf_chunks, source.chunk_count() - chunk ), BooleanBitWrapper( 0 ) );
+	}
+
+	const PersistentDynamicBitSet empty( bit_size );
+	assert( empty.height() == 2 && empty.none() && empty.node_count() == 0 );
+	const PersistentDynamicBitSet base( source );
+	assert( base.height() == 2 && base.to_dynamic_bitset().bit_size() == base.bit_size() );
+	assert_same_chunks( base.to_dynamic_bitset(), source );
+	assert( base.hamming_weight() == source.hamming_weight() );
+
+	// 修改一个比特只复制根到叶子的路径，旧版本不变
+	const size_t				  index = PersistentDynamicBitSet::leaf_bits * 5 + 123;
+	const PersistentDynamicBitSet flipped = base.with_flipped( index );
+	assert( flipped.test( index ) != base.test( index ) );
+	assert( flipped.unshared_node_count( base ) == flipped.height() + 1 );
+	assert_same_chunks( base.to_dynamic_bitset(), source );
+	assert( flipped != base );
+	assert( flipped.with_flipped( index ) == base );
+	assert( base.with_bit( base.test( index ), index ).unshared_node_count( base ) == 0 );
+
+	// 多个版本，每个版本相对上一个版本修改一批比特
+	std::vector<PersistentDynamicBitSet> versions { base };
+	std::vector<DynamicBitSet>			 expected_versions { source };
+	for ( size_t version = 0; version < 8; ++version )
+	{
+		std::vector<size_t> indices;
+		for ( size_t count = 0; count < 50; ++count )
+		{
+			indices.push_back( generator() % bit_size );
+		}
+		const bool value = version % 2 == 0;
+		versions.push_back( versions.back().with_bits( value, indices ) );
+		expected_versions.push_back( expected_versions.back() );
+		for ( size_t changed : indices )
+		{
+			expected_versions.back().set_bit( value, changed );
+		}
+	}
+	for ( size_t version = 0; version < versions.size(); ++version )
+	{
+		assert_same_chunks( versions[ version ].to_dynamic_bitset(), expected_versions[ version ] );
+		assert( versions[ version ].hamming_weight() == expected_versions[ version ].hamming_weight() );
+	}
+	// 修改 50 个比特的版本最多新分配 50 个叶子和它们的路径
+	assert( versions[ 1 ].unshared_node_count( versions[ 0 ] ) <= 50 + 50 + 2 );
+
+	// 范围修改：完整覆盖的子树共享全 1 子树或者变为空
+	const PersistentDynamicBitSet filled = empty.with_range( 0, bit_size, true );
+	assert( filled.hamming_weight() == bit_size );
+	assert( filled.node_count() < 3 + 2 * PersistentDynamicBitSet::branching + 2 );
+	assert( filled.with_range( 0, bit_size, false ).none() );
+	for ( size_t round = 0; round < 20; ++round )
+	{
+		const size_t position = generator() % bit_size;
+		const size_t length = generator() % ( bit_size - position ) + 1;
+		const bool	 value = generator() % 2;
+		versions.push_back( versions.back().with_range( position, length, value ) );
+		expected_versions.push_back( expected_versions.back() );
+		for ( size_t offset = 0; offset < length; ++offset )
+		{
+			expected_versions.back().set_bit( value, position + offset );
+		}
+		assert_same_chunks( versions.back().to_dynamic_bitset(), expected_versions.back() );
+	}
+
+	// 版本之间的按位运算
+	const PersistentDynamicBitSet& left = versions[ 3 ];
+	const PersistentDynamicBitSet& right = versions[ 6 ];
+	DynamicBitSet				   expected = expected_versions[ 3 ];
+	expected.and_operation( expected_versions[ 6 ] );
+	assert_same_chunks( ( left & right ).to_dynamic_bitset(), expected );
+	expected = expected_versions[ 3 ];
+	expected.or_operation( expected_versions[ 6 ] );
+	assert_same_chunks( ( left | right ).to_dynamic_bitset(), expected );
+	expected = expected_versions[ 3 ];
+	expected.xor_operation( expected_versions[ 6 ] );
+	assert_same_chunks( ( left ^ right ).to_dynamic_bitset(), expected );
+	expected = expected_versions[ 3 ];
+	expected.and_not_operation( expected_versions[ 6 ] );
+	assert_same_chunks( left.and_not_operation( right ).to_dynamic_bitset(), expected );
+
+	// 相同的子树按指针跳过：与自己运算的结果共享整棵树
+	assert( ( base & base ).unshared_node_count( base ) == 0 );
+	assert( ( base | empty ).unshared_node_count( base ) == 0 );
+	assert( ( base ^ base ).none() );
+	assert( ( base | flipped ).unshared_node_count( base ) <= flipped.height() + 1 );
+
+	bool thrown = false;
+	try
+	{
+		base.or_operation( PersistentDynamicBitSet( bit_size + 1 ) );
+	}
+	catch ( const std::invalid_argument& )
+	{
+		thrown = true;
+	}
+	assert( thrown );
+
+	std::cout << "All PersistentDynamicBitSet tests passed!\n";
+}
+
+inline void testTrackedBitSet()
+{
+	using namespace TwilightDream;
+
+	std::mt19937 generator( 44 );
+	const size_t bit_size = TrackedDynamicBitSet::block_bits * 100 + 45;
+
+	const DynamicBitSet source = random_bits( generator, bit_size );
+
+	TrackedDynamicBitSet primary( source );
+	TrackedDynamicBitSet replica( source );
+	assert( primary.block_count() == 101 && primary.dirty_block_count() == 0 );
+
+	// 没有修改时增量只有头部：bit_size (3 个字节的变长整数) 和 entry_count (1 个字节)
+	assert( primary.export_delta().size() == 4 );
+
+	// 值没有改变的写入不会让块变脏
+	primary.set_bit( primary.test( 10 ), 10 );
+	assert( primary.dirty_block_count() == 0 );
+
+	primary.flip( 10 );
+	primary.set_bit( !primary.test( TrackedDynamicBitSet::block_bits * 7 + 3 ), TrackedDynamicBitSet::block_bits * 7 + 3 );
+	assert( primary.dirty_block_count() == 2 && primary.is_dirty( 0 ) && primary.is_dirty( 7 ) && !primary.is_dirty( 1 ) );
+
+	// 翻转两次之后块仍然是脏的，但内容没有变化，不会出现在增量中
+	primary.flip( TrackedDynamicBitSet::block_bits * 50 );
+	primary.flip( TrackedDynamicBitSet::block_bits * 50 );
+	assert( primary.is_dirty( 50 ) );
+
+	std::vector<uint8_t> delta = primary.export_delta_and_checkpoint();
+	assert( primary.dirty_block_count() == 0 );
+	// 两个条目，每个条目只有一个非零的比特块
+	assert( delta.size() < 30 );
+	replica.apply_delta( delta );
+	assert_same_chunks( replica.bits(), primary.bits() );
+	replica.checkpoint();
+
+	// 随机的单个比特、范围和批量修改，之后同步
+	for ( size_t round = 0; round < 5; ++round )
+	{
+		for ( size_t change = 0; change < 40; ++change )
+		{
+			const size_t index = generator() % bit_size;
+			switch ( generator() % 3 )
+			{
+			case 0:
+				primary.flip( index );
+				break;
+			case 1:
+				primary.set_bit( generator() % 2, index );
+				break;
+			default:
+				primary.set( index, std::min<size_t>( generator() % 2000 + 1, bit_size - index ), generator() % 2 );
+				break;
+			}
+		}
+		if ( round == 3 )
+		{
+			DynamicBitSet mask( bit_size / 2, true );
+			primary.and_operation( mask );
+			primary.xor_operation( source );
+		}
+
+		const std::vector<uint8_t> round_delta = primary.export_delta_and_checkpoint();
+		replica.apply_delta( round_delta );
+		replica.checkpoint();
+		assert_same_chunks( replica.bits(), primary.bits() );
+	}
+
+	// make_delta 与增量跟踪得到的结果一致
+	TrackedDynamicBitSet fresh( source );
+	fresh.apply_delta( TrackedDynamicBitSet::make_delta( source, primary.bits() ) );
+	assert_same_chunks( fresh.bits(), primary.bits() );
+	assert( TrackedDynamicBitSet::make_delta( source, source ).size() == 4 );
+
+	// 批量运算只让内容改变的块变脏
+	TrackedDynamicBitSet bulk( source );
+	DynamicBitSet		 sparse( bit_size, false );
+	sparse.set_bit( true, TrackedDynamicBitSet::block_bits * 20 + 1 );
+	sparse.set_bit( !source.get_bit( TrackedDynamicBitSet::block_bits * 30 ), TrackedDynamicBitSet::block_bits * 30 );
+	bulk.or_operation( sparse );
+	assert( bulk.dirty_block_count() <= 2 );
+
+	// 较长的操作数超出 bit_size() 的比特被忽略，最后一个块不会变脏
+	TrackedDynamicBitSet padded( source );
+	DynamicBitSet		 longer( bit_size + 64, false );
+	longer.set_bit( true, bit_size + 1 );
+	padded.or_operation( longer );
+	padded.xor_operation( longer );
+	assert( padded.dirty_block_count() == 0 );
+	assert_same_chunks( padded.bits(), source );
+
+	// 格式错误与大小不同的增量被拒绝，内容不变
+	auto rejected = [ & ]( const std::vector<uint8_t>& bad ) {
+		const DynamicBitSet before = replica.bits();
+		bool				thrown = false;
+		try
+		{
+			replica.apply_delta( bad );
+		}
+		catch ( const std::invalid_argument& )
+		{
+			thrown = true;
+		}
+		assert_same_chunks( replica.bits(), before );
+		return thrown;
+	};
+	TrackedDynamicBitSet other_size( bit_size + 1 );
+	other_size.flip( 0 );
+	assert( rejected( other_size.export_delta() ) );
+	std::vector<uint8_t> truncated = delta;
+	truncated.pop_back();
+	assert( rejected( truncated ) );
+	std::vector<uint8_t> trailing = delta;
+	trailing.push_back( 0 );
+	assert( rejected( trailing ) );
+
+	std::cout << "All TrackedDynamicBitSet tests passed!\n";
+}
+
+// complement_view() 只能在左值上调用：右值上的重载被删除
+template <typename Bits, typename = void>
+struct HasComplementView : std::false_type
+{
+};
+
+template <typename Bits>
+struct HasComplementView<Bits, std::void_t<decltype( std::declval<Bits>().complement_view() )>> : std::true_type
+{
+};
+
+inline void testComplementView()
+{
+	using namespace TwilightDream;
+
+	static_assert( HasComplementView<const DynamicBitSet&>::value, "complement_view on an lvalue" );
+	static_assert( !HasComplementView<DynamicBitSet>::value, "complement_view on a temporary would dangle" );
+
+	std::mt19937 generator( 45 );
+
+	// 惰性取反的视图与物化的结果逐块一致 (包括两边长度不同的情况)
+	const size_t lengths[][ 2 ] = { { 70, 45 }, { 45, 70 }, { 45, 45 } };
+	for ( const auto& length : lengths )
+	{
+		DynamicBitSet		left = random_set( generator, length[ 0 ] );
+		const DynamicBitSet right = random_set( generator, length[ 1 ] );
+		const auto			complement = right.complement_view();
+		DynamicBitSet		materialized = ~right;
+		assert( same_chunks( materialized, complement.materialize() ) );
+		assert( same_chunks( materialized, DynamicBitSet( complement ) ) );
+
+		DynamicBitSet expected_and = left;
+		expected_and.and_operation( materialized );
+		DynamicBitSet expected_or = left;
+		expected_or.or_operation( materialized );
+		DynamicBitSet expected_xor = left;
+		expected_xor.xor_operation( materialized );
+
+		assert( same_chunks( left & complement, expected_and ) );
+		assert( same_chunks( left | complement, expected_or ) );
+		assert( same_chunks( left ^ complement, expected_xor ) );
+		assert( same_chunks( left & ~right, expected_and ) );
+
+		DynamicBitSet assigned = left;
+		assigned &= complement;
+		assert( same_chunks( assigned, expected_and ) );
+		assigned = left;
+		assigned |= complement;
+		assert( same_chunks( assigned, expected_or ) );
+		assigned = left;
+		assigned ^= complement;
+		assert( same_chunks( assigned, expected_xor ) );
+
+		// 视图在左边时值相同
+		assert( ( complement & left ) == expected_and );
+		assert( ( complement | left ) == expected_or );
+		assert( ( complement ^ left ) == expected_xor );
+
+		// 两边都是视图
+		const auto left_complement = left.complement_view();
+		assert( ( left_complement & complement ) == ( ~left & materialized ) );
+		assert( ( left_complement | complement ) == ( ~left | materialized ) );
+		assert( ( left_complement ^ complement ) == ( ~left ^ materialized ) );
+
+		// 比较不物化，结果与物化之后的比较相同
+		assert( complement == materialized && materialized == complement );
+		assert( complement != left && left != complement );
+		assert( ( left_complement == complement ) == ( ~left == materialized ) );
+		assert( complement == right.complement_view() );
+	}
+
+	// 查询和迭代直接读原来的比特块
+	const DynamicBitSet bits = random_set( generator, 3 );
+	const auto			complement = bits.complement_view();
+	assert( &~complement == &bits );
+	assert( complement.chunk_count() == 3 && complement.size() == 96 );
+	assert( complement.hamming_weight() == 96 - bits.hamming_weight() );
+	for ( size_t index = 0; index < 96; ++index )
+	{
+		assert( complement[ index ] == !bits.chunk_data()[ index / 32 ].bit_get( index % 32 ) );
+	}
+	assert( complement.any() && !complement.none() );
+	size_t iterated = 0;
+	for ( const bool bit : complement )
+	{
+		assert( bit == complement[ iterated ] );
+		++iterated;
+	}
+	assert( iterated == 96 );
+	assert( static_cast<size_t>( std::count( complement.begin(), complement.end(), true ) ) == complement.hamming_weight() );
+
+	// 与视图不同，~ 的结果是独立的比特集
+	DynamicBitSet owner = bits;
+	auto		  inverted = ~owner;
+	owner.not_operation();
+	assert( inverted == owner && inverted.bit_size() == ( ~bits ).bit_size() );
+	assert( ~bits == complement && ( ~bits ).hamming_weight() == complement.hamming_weight() );
+
+	// 高位多出的全'1'块取反之后为 0，不影响比较
+	DynamicBitSet padded( std::vector<uint32_t> { 0x0F0F0F0F, 0xFFFFFFFF } );
+	const DynamicBitSet low( std::vector<uint32_t> { 0xF0F0F0F0 } );
+	assert( padded.complement_view() == low && low == padded.complement_view() );
+	assert( padded.complement_view() != DynamicBitSet( std::vector<uint32_t> { 0xF0F0F0F0, 1 } ) );
+
+	DynamicBitSet full( 64, true );
+	assert( full.complement_view().none() );
+	assert( ( full & full.complement_view() ).hamming_weight() == 0 );
+	assert( ( full | full.complement_view() ).hamming_weight() == 64 );
+
+	// 自身与自身的取反运算
+	DynamicBitSet self = bits;
+	self ^= self.complement_view();
+	assert( self.hamming_weight() == 96 );
+
+	// 非 const 的左操作数：必须选中视图的重载 (不能经过 operator DynamicBitSet() 物化，也不能有歧义)
+	DynamicBitSet mutable_left = random_set( generator, 3 );
+	DynamicBitSet mutable_right = random_set( generator, 2 );
+	const DynamicBitSet mutable_expected_and = mutable_left & ~mutable_right;
+	const DynamicBitSet mutable_expected_or = mutable_left | ~mutable_right;
+	const DynamicBitSet mutable_expected_xor = mutable_left ^ ~mutable_right;
+	assert( same_chunks( mutable_left & mutable_right.complement_view(), mutable_expected_and ) );
+	assert( same_chunks( mutable_left | mutable_right.complement_view(), mutable_expected_or ) );
+	assert( same_chunks( mutable_left ^ mutable_right.complement_view(), mutable_expected_xor ) );
+
+	std::cout << "All complement view tests passed!\n";
+}
+
+inline void testRangeOperations()
+{
+	using namespace TwilightDream;
+
+	std::mt19937 generator( 46 );
+	auto bit = []( const DynamicBitSet& set, size_t index ) {
+		return set.chunk_data()[ index / 32 ].bit_get( index % 32 );
+	};
+
+	// 每一种运算、各种偏移和长度 (包括同一个块内、跨越很多块、两边偏移的差为负数) 与逐比特的计算一致
+	const BitRangeOperation operations[] = { BitRangeOperation::Copy, BitRangeOperation::And, BitRangeOperation::Or, BitRangeOperation::Xor, BitRangeOperation::AndNot };
+	for ( int round = 0; round < 400; ++round )
+	{
+		const DynamicBitSet destination = random_set( generator, 12 );
+		const DynamicBitSet source = random_set( generator, 9 );
+		const size_t		len = generator() % ( round % 4 == 0 ? 40 : 288 );
+		const size_t		pos = generator() % ( 384 - len + 1 );
+		const size_t		source_pos = generator() % ( 288 - len + 1 );
+		for ( const BitRangeOperation operation : operations )
+		{
+			DynamicBitSet result = destination;
+			result.apply_range( operation, pos, source, source_pos, len );
+			for ( size_t index = 0; index < 384; ++index )
+			{
+				bool expected = bit( destination, index );
+				if ( index >= pos && index < pos + len )
+				{
+					const bool value = bit( source, index - pos + source_pos );
+					switch ( operation )
+					{
+						case BitRangeOperation::Copy:
+							expected = value;
+							break;
+						case BitRangeOperation::And:
+							expected = expected && value;
+							break;
+						case BitRangeOperation::Or:
+							expected = expected || value;
+							break;
+						case BitRangeOperation::Xor:
+							expected = expected != value;
+							break;
+						case BitRangeOperation::AndNot:
+							expected = expected && !value;
+							break;
+					}
+				}
+				assert( bit( result, index ) == expected );
+			}
+		}
+
+		// 同一个集合内重叠的复制与先复制出源范围相同
+		const size_t  self_source = generator() % ( 384 - len + 1 );
+		DynamicBitSet moved = destination;
+		moved.copy_bits( pos, moved, self_source, len );
+		DynamicBitSet expected = destination;
+		expected.copy_bits( pos, DynamicBitSet( destination ), self_source, len );
+		assert( same_chunks( moved, expected ) );
+
+		// 范围计数和查找
+		size_t count = 0;
+		size_t first_one = DynamicBitSet::npos;
+		for ( size_t index = pos + len; index > pos; --index )
+		{
+			if ( bit( destination, index - 1 ) )
+			{
+				++count;
+				first_one = index - 1;
+			}
+		}
+		assert( destination.count( pos, len ) == count );
+		assert( destination.any( pos, len ) == ( count != 0 ) );
+		assert( destination.find_next( pos, pos + len ) == first_one );
+
+		// 范围赋值只改变范围之内的比特
+		for ( const bool value : { false, true } )
+		{
+			DynamicBitSet assigned = destination;
+			bits_assign_range( assigned.chunk_data(), pos, len, value );
+			for ( size_t index = 0; index < 384; ++index )
+			{
+				assert( bit( assigned, index ) == ( index >= pos && index < pos + len ? value : bit( destination, index ) ) );
+			}
+		}
+	}
+
+	// find_next 跳过很长的全零区域
+	DynamicBitSet sparse( 100000, false );
+	sparse.set_bit( true, 3 );
+	sparse.set_bit( true, 70001 );
+	assert( sparse.find_next( 0 ) == 3 );
+	assert( sparse.find_next( 4 ) == 70001 );
+	assert( sparse.find_next( 4, 70001 ) == DynamicBitSet::npos );
+	assert( sparse.find_next( 70002 ) == DynamicBitSet::npos );
+	assert( sparse.count( 0, 100000 ) == 2 );
+	assert( !sparse.any( 4, 69997 ) );
+
+	// 复制到 bit_size() 之上时 bit_size() 随之增大
+	DynamicBitSet grown( std::vector<uint32_t>( 4, 0 ) );
+	assert( grown.bit_size() == 0 );
+	grown.copy_bits( 90, sparse, 0, 4 );
+	assert( grown.bit_size() == 94 );
+	assert( grown.find_next( 0 ) == 93 );
+
+	bool thrown = false;
+	try
+	{
+		grown.copy_bits( 100, sparse, 0, 29 );
+	}
+	catch ( const std::out_of_range& )
+	{
+		thrown = true;
+	}
+	assert( thrown );
+
+	std::cout << "All range operation tests passed!\n";
+}
+
+inline void testRandomFill()
+{
+	using namespace TwilightDream;
+
+	// 填充全部的比特块，之后 bit_size() 等于 bit_capacity()
+	DynamicBitSet bits( 1000, false );
+	Xoshiro256	  generator( 47 );
+	bits.fill_random( generator );
+	assert( bits.bit_size() == 1024 && bits.chunk_count() == 32 );
+	assert( bits.hamming_weight() > 400 && bits.hamming_weight() < 600 );
+
+	// 32 位的生成器也可以使用
+	std::mt19937 mersenne( 47 );
+	bits.fill_random( mersenne );
+	assert( bits.hamming_weight() > 400 && bits.hamming_weight() < 600 );
+
+	// 使用种子的结果是确定的，并且与线程数无关
+	const size_t			size = 1000003;
+	const ParallelExecution parallel( 4, 64 );
+	DynamicBitSet			serial( size, false );
+	DynamicBitSet			threaded( size, false );
+	serial.fill_random( 7 );
+	threaded.fill_random( 7, parallel );
+	assert( serial == threaded && serial.bit_size() == serial.bit_capacity() );
+	const size_t filled_bits = serial.bit_size();
+	threaded.fill_random( 8, parallel );
+	assert( !( serial == threaded ) );
+
+	// 整数的左值是种子而不是生成器
+	static_assert( is_uniform_random_bit_generator_v<Xoshiro256> && is_uniform_random_bit_generator_v<std::mt19937>, "standard generators" );
+	static_assert( !is_uniform_random_bit_generator_v<int> && !is_uniform_random_bit_generator_v<const std::mt19937>, "not generators" );
+	int seed = 7;
+	threaded.fill_random( seed );
+	assert( serial == threaded );
+	DynamicBitSet seeded( size, false );
+	seed = 11;
+	serial.fill_bernoulli( 0.3, 11 );
+	seeded.fill_bernoulli( 0.3, seed );
+	assert( serial == seeded );
+
+	// Bernoulli(p)：1000003 位的计数在期望值的 6 个标准差之内
+	const double probabilities[] = { 0.001, 0.1, 0.3, 0.5, 0.75, 0.999 };
+	for ( const double probability : probabilities )
+	{
+		serial.fill_bernoulli( probability, 11 );
+		threaded.fill_bernoulli( probability, 11, parallel );
+		assert( serial == threaded );
+
+		const double expected = probability * filled_bits;
+		const double deviation = std::sqrt( filled_bits * probability * ( 1 - probability ) );
+		const double count = static_cast<double>( serial.hamming_weight() );
+		assert( std::abs( count - expected ) < 6 * deviation );
+
+		DynamicBitSet small( 77, false );
+		small.fill_bernoulli( probability, generator );
+		assert( small.bit_size() == 96 && small.chunk_count() == 3 );
+	}
+
+	serial.fill_bernoulli( 0.0, 3 );
+	assert( serial.hamming_weight() == 0 );
+	serial.fill_bernoulli( 1.0, generator );
+	assert( serial.hamming_weight() == filled_bits );
+
+	// "填充，然后 &=" 的循环：按位运算缩小 bit_size() 之后，填充的范围仍然是全部的存储
+	DynamicBitSet mask( 100000, false );
+	mask.fill_random( 5 );
+	for ( uint64_t round = 0; round < 6; ++round )
+	{
+		DynamicBitSet other( 100000, false );
+		other.fill_random( 100 + round );
+		mask &= other;
+	}
+	assert( mask.bit_size() < 100000 );
+	mask.fill_random( 5 );
+	assert( mask.bit_size() == 100000 && mask.hamming_weight() > 45000 );
+	mask.fill_bernoulli( 0.0, 5 );
+	mask.fill_bernoulli( 0.5, 5 );
+	assert( mask.bit_size() == 100000 && mask.hamming_weight() > 45000 );
+	mask.fill_bernoulli( 1.0, generator );
+	assert( mask.hamming_weight() == 100000 );
+
+	bool thrown = false;
+	try
+	{
+		serial.fill_bernoulli( 1.5, 3 );
+	}
+	catch ( const std::invalid_argument& )
+	{
+		thrown = true;
+	}
+	assert( thrown );
+
+	std::cout << "All random fill tests passed!\n";
+}
+
+inline void testPositions()
+{
+	using namespace TwilightDream;
+
+	std::mt19937 generator( 48 );
+
+	// 升序 (带重复) 与乱序的输入得到相同的集合，to_positions 还原去重之后的升序列表
+	for ( const size_t bit_size : { size_t( 1 ), size_t( 31 ), size_t( 64 ), size_t( 1000 ), size_t( 100000 ) } )
+	{
+		std::vector<uint32_t> positions;
+		for ( size_t i = 0; i < bit_size / 3 + 1; ++i )
+		{
+			positions.push_back( static_cast<uint32_t>( generator() % bit_size ) );
+		}
+		std::vector<uint32_t> sorted = positions;
+		std::sort( sorted.begin(), sorted.end() );
+
+		const DynamicBitSet from_sorted = DynamicBitSet::from_positions( sorted, bit_size );
+		const DynamicBitSet from_unsorted = DynamicBitSet::from_positions( positions, bit_size );
+		assert( from_sorted == from_unsorted && from_sorted.bit_size() == bit_size );
+		for ( const uint32_t position : positions )
+		{
+			assert( from_sorted.get_bit( position ) );
+		}
+
+		sorted.erase( std::unique( sorted.begin(), sorted.end() ), sorted.end() );
+		assert( from_sorted.hamming_weight() == sorted.size() );
+
+		std::vector<uint32_t> narrow;
+		from_sorted.to_positions( narrow );
+		assert( narrow == sorted );
+
+		std::vector<uint64_t> wide;
+		from_sorted.to_positions( wide );
+		assert( wide.size() == sorted.size() && std::equal( wide.begin(), wide.end(), sorted.begin() ) );
+		assert( DynamicBitSet::from_positions( wide, bit_size ) == from_sorted );
+	}
+
+	// 稠密的集合 (每个 16 位的组都是满的) 和空集合
+	const DynamicBitSet full( 100, true );
+	std::vector<uint32_t> all;
+	full.to_positions( all );
+	assert( all.size() == 100 && all.front() == 0 && all.back() == 99 );
+
+	const DynamicBitSet empty = DynamicBitSet::from_positions( std::vector<uint64_t>() );
+	std::vector<uint64_t> none;
+	empty.to_positions( none );
+	assert( empty.bit_size() == 0 && none.empty() );
+
+	// 默认的 bit_size 是最大的位置 + 1
+	const uint64_t sparse[] = { 5, 1u << 20, 3 };
+	const DynamicBitSet inferred = DynamicBitSet::from_positions( sparse, 3 );
+	assert( inferred.bit_size() == ( 1u << 20 ) + 1 && inferred.hamming_weight() == 3 );
+
+	bool thrown = false;
+	try
+	{
+		DynamicBitSet::from_positions( sparse, 3, 1000 );
+	}
+	catch ( const std::out_of_range& )
+	{
+		thrown = true;
+	}
+	assert( thrown );
+
+	std::cout << "All position list tests passed!\n";
+}
+
+inline void testPackedIntArray()
+{
+	using namespace TwilightDream;
+
+	std::mt19937 generator( 49 );
+
+	for ( unsigned width = 1; width <= 32; ++width )
+	{
+		const uint32_t		  mask = static_cast<uint32_t>( ~uint64_t( 0 ) >> ( 64 - width ) );
+		const size_t		  count = 300;
+		std::vector<uint32_t> values( count );
+		for ( auto& value : values )
+		{
+			value = static_cast<uint32_t>( generator() ) & mask;
+		}
+
+		// set / get 与逐位的布局一致，写一个值不影响相邻的值
+		DynamicBitSet bits( count * width, false );
+		PackedIntView view( bits, count, width );
+		assert( view.size() == count && PackedIntView( bits, width ).size() == bits.chunk_count() * 32 / width );
+		for ( size_t i = 0; i < count; ++i )
+		{
+			view.set( i, values[ i ] | ~mask );
+		}
+		for ( size_t i = 0; i < count; ++i )
+		{
+			assert( view.get( i ) == values[ i ] );
+			for ( unsigned bit = 0; bit < width; ++bit )
+			{
+				assert( bits.get_bit( i * width + bit ) == ( ( values[ i ] >> bit & 1 ) != 0 ) );
+			}
+		}
+
+		// 批量的 unpack / pack：不从块边界开始、跨越多个块并且带有不成块的尾部
+		const ConstPackedIntView read_only = view;
+		std::vector<uint32_t>	 output( count - 40 );
+		read_only.unpack( 5, output.size(), output.data() );
+		assert( std::equal( output.begin(), output.end(), values.begin() + 5 ) );
+		assert( read_only.unpack() == values );
+
+		DynamicBitSet packed_bits( count * width, false );
+		PackedIntView packed( packed_bits, count, width );
+		packed.pack( values );
+		assert( packed_bits == bits );
+
+		std::vector<uint32_t> replacement( 100 );
+		for ( auto& value : replacement )
+		{
+			value = static_cast<uint32_t>( generator() );
+		}
+		packed.pack( 7, replacement.data(), replacement.size() );
+		for ( size_t i = 0; i < count; ++i )
+		{
+			const uint32_t expected = i >= 7 && i < 107 ? replacement[ i - 7 ] & mask : values[ i ];
+			assert( packed.get( i ) == expected );
+		}
+	}
+
+	// 编译期宽度的数组
+	std::vector<uint32_t> codes( 1000 );
+	for ( auto& code : codes )
+	{
+		code = static_cast<uint32_t>( generator() ) & 0x7FFFFFFF;
+	}
+	const PackedIntArray<31> wide_codes( codes );
+	assert( wide_codes.size() == 1000 && wide_codes.bits().bit_size() == 1000 * 31 && wide_codes.unpack() == codes );
+
+	// 视图的长度来自存储而不是 bit_size()：末尾的值为 0 时不变
+	DynamicBitSet sparse_bits( std::vector<uint32_t> { 0xFFFFFFFF, 0, 0 } );
+	sparse_bits &= DynamicBitSet( std::vector<uint32_t> { 0x0000FFFF, 0xFFFFFFFF, 0xFFFFFFFF } );
+	assert( sparse_bits.bit_size() == 16 );
+	const ConstPackedIntView sparse_view( sparse_bits, 8 );
+	assert( sparse_view.size() == 12 && sparse_view.get( 1 ) == 0xFF && sparse_view.get( 11 ) == 0 );
+
+	PackedIntArray<3> small_codes( 10 );
+	small_codes.set( 4, 5 );
+	small_codes.set( 5, 7 );
+	small_codes.set( 4, 2 );
+	assert( small_codes[ 4 ] == 2 && small_codes[ 5 ] == 7 && small_codes[ 3 ] == 0 && small_codes.view().get( 5 ) == 7 );
+
+	bool thrown = false;
+	// get 的越界检查使用 DefaultBitAccess；unpack / pack 的范围总是检查
+#if !defined( LARGE_DYNAMIC_BITSET_UNCHECKED_ACCESS )
+	try
+	{
+		small_codes.get( 10 );
+	}
+	catch ( const std::out_of_range& )
+	{
+		thrown = true;
+	}
+	assert( thrown );
+#endif
+
+	thrown = false;
+	try
+	{
+		uint32_t output[ 8 ];
+		small_codes.unpack( 5, 6, output );
+	}
+	catch ( const std::out_of_range& )
+	{
+		thrown = true;
+	}
+	assert( thrown );
+
+	thrown = false;
+	try
+	{
+		const ConstPackedIntView too_long( sparse_bits, 13, 8 );
+	}
+	catch ( const std::out_of_range& )
+	{
+		thrown = true;
+	}
+	assert( thrown );
+
+	thrown = false;
+	try
+	{
+		DynamicBitSet bits( 64, false );
+		PackedIntView invalid( bits, 33 );
+	}
+	catch ( const std::invalid_argument& )
+	{
+		thrown = true;
+	}
+	assert( thrown );
+
+	std::cout << "All packed integer array tests passed!\n";
+}
+
+inline void testEliasFano()
+{
+	using namespace TwilightDream;
+
+	std::mt19937_64 generator( 50 );
+
+	// 字内的 select 与逐位的结果一致
+	for ( int round = 0; round < 1000; ++round )
+	{
+		const uint64_t word = generator() & generator();
+		uint32_t	   rank = 0;
+		for ( uint32_t bit = 0; bit < 64; ++bit )
+		{
+			if ( ( word >> bit ) & 1 )
+			{
+				assert( select_in_word64( word, rank++ ) == bit );
+			}
+		}
+	}
+
+	// 稠密 (低位为 0)、一般和稀疏的序列，带有重复的值
+	for ( const uint64_t spacing : { uint64_t( 1 ), uint64_t( 3 ), uint64_t( 100 ), uint64_t( 1 ) << 36 } )
+	{
+		for ( const size_t count : { size_t( 0 ), size_t( 1 ), size_t( 33 ), size_t( 1000 ), size_t( 20000 ) } )
+		{
+			std::vector<uint64_t> values( count );
+			uint64_t			  value = generator() % 10;
+			for ( auto& element : values )
+			{
+				element = value;
+				value += generator() % ( spacing * 2 );
+			}
+			const uint64_t			universe = count == 0 ? 0 : values.back() + 1 + generator() % 1000;
+			const EliasFanoSequence sequence( values, universe );
+			assert( sequence.size() == count && sequence.universe() == universe );
+			assert( sequence.decode() == values );
+			for ( size_t i = 0; i < count; ++i )
+			{
+				assert( sequence.access( i ) == values[ i ] );
+			}
+
+			// next_geq 与 std::lower_bound 一致 (包括大于所有值的查询)
+			for ( int query = 0; query < 2000; ++query )
+			{
+				const uint64_t target = universe == 0 ? generator() % 10 : generator() % ( universe + 10 );
+				const size_t   expected = static_cast<size_t>( std::lower_bound( values.begin(), values.end(), target ) - values.begin() );
+				assert( sequence.next_geq( target ) == expected );
+			}
+			for ( size_t i = 0; i < count; i += 7 )
+			{
+				assert( sequence.next_geq( values[ i ] ) == static_cast<size_t>( std::lower_bound( values.begin(), values.end(), values[ i ] ) - values.begin() ) );
+			}
+		}
+	}
+
+	// 稀疏的 32 位 ID：每个值大约 2 + log2( universe / n ) 比特
+	std::vector<uint32_t> ids( 100000 );
+	for ( auto& id : ids )
+	{
+		id = static_cast<uint32_t>( generator() );
+	}
+	std::sort( ids.begin(), ids.end() );
+	const EliasFanoSequence id_sequence( ids, uint64_t( 1 ) << 32 );
+	assert( id_sequence.low_width() == 15 && id_sequence.encoded_bits() < ids.size() * 18 );
+	assert( id_sequence.access( 12345 ) == ids[ 12345 ] );
+
+	// 很大的 universe：低位超过 32 位，高位的比特图仍然不超过 2n + 1 比特 (与 universe 无关)
+	const EliasFanoSequence single( std::vector<uint64_t> { ( uint64_t( 1 ) << 60 ) + 12345 } );
+	assert( single.low_width() == 60 && single.high_bits().chunk_count() * 32 <= 64 && single.access( 0 ) == ( uint64_t( 1 ) << 60 ) + 12345 );
+	assert( single.next_geq( 0 ) == 0 && single.next_geq( ( uint64_t( 1 ) << 60 ) + 12346 ) == 1 );
+
+	for ( const uint64_t universe : { uint64_t( 1 ) << 45, uint64_t( 1 ) << 63, ~uint64_t( 0 ) } )
+	{
+		std::vector<uint64_t> wide( 1000 );
+		for ( auto& value : wide )
+		{
+			value = generator() % universe;
+		}
+		std::sort( wide.begin(), wide.end() );
+		const EliasFanoSequence wide_sequence( wide, universe );
+		assert( wide_sequence.low_width() > 32 && wide_sequence.high_bits().chunk_count() * 32 <= 2 * wide.size() + 64 );
+		assert( wide_sequence.encoded_bits() < wide.size() * ( wide_sequence.low_width() + 3 ) + 256 );
+		assert( wide_sequence.decode() == wide );
+		for ( size_t i = 0; i < wide.size(); ++i )
+		{
+			assert( wide_sequence.access( i ) == wide[ i ] );
+			assert( wide_sequence.next_geq( wide[ i ] ) == static_cast<size_t>( std::lower_bound( wide.begin(), wide.end(), wide[ i ] ) - wide.begin() ) );
+			const uint64_t target = generator() % universe;
+			assert( wide_sequence.next_geq( target ) == static_cast<size_t>( std::lower_bound( wide.begin(), wide.end(), target ) - wide.begin() ) );
+		}
+	}
+
+	// 与 DynamicBitSet 之间的转换
+	DynamicBitSet bits( 5000, false );
+	for ( int i = 0; i < 700; ++i )
+	{
+		bits.set_bit( true, generator() % 5000 );
+	}
+	const EliasFanoSequence from_bits( bits );
+	assert( from_bits.size() == bits.hamming_weight() && from_bits.universe() == 5000 );
+	assert( from_bits.to_dynamic_bitset() == bits );
+
+	// 流式构造与错误
+	EliasFanoBuilder builder( 3, 100 );
+	builder.push_back( 10 );
+	builder.push_back( 10 );
+	bool thrown = false;
+	try
+	{
+		builder.push_back( 9 );
+	}
+	catch ( const std::invalid_argument& )
+	{
+		thrown = true;
+	}
+	assert( thrown );
+
+	thrown = false;
+	try
+	{
+		builder.build();
+	}
+	catch ( const std::invalid_argument& )
+	{
+		thrown = true;
+	}
+	assert( thrown );
+
+	builder.push_back( 99 );
+	thrown = false;
+	try
+	{
+		builder.push_back( 99 );
+	}
+	catch ( const std::invalid_argument& )
+	{
+		thrown = true;
+	}
+	assert( thrown );
+
+	const EliasFanoSequence built = builder.build();
+	assert( built.size() == 3 && built[ 0 ] == 10 && built[ 1 ] == 10 && built[ 2 ] == 99 && built.next_geq( 11 ) == 2 );
+
+	thrown = false;
+	try
+	{
+		EliasFanoBuilder bounded( 1, 100 );
+		bounded.push_back( 100 );
+	}
+	catch ( const std::invalid_argument& )
+	{
+		thrown = true;
+	}
+	assert( thrown );
+
+	// access 的越界检查使用 DefaultBitAccess
+#if !defined( LARGE_DYNAMIC_BITSET_UNCHECKED_ACCESS )
+	thrown = false;
+	try
+	{
+		built.access( 3 );
+	}
+	catch ( const std::out_of_range& )
+	{
+		thrown = true;
+	}
+	assert( thrown );
+#endif
+
+	std::cout << "All Elias-Fano sequence tests passed!\n";
+}
 
 inline void AllTestBitset()
 {
@@ -664,4 +2918,25 @@ inline void AllTestBitset()
 	testLargeData();
 	testRandomData();
 	testOperatorsAndModifications();
+	testUncheckedAccess();
+	testBatchOperations();
+	testParallelOperations();
+	testConcurrentDynamicBitSet();
+	testAllocators();
+	testInstrumentation();
+	testStaticBitSet();
+	testLargeIntegerNumber();
+	testComparisons();
+	testHashing();
+	testFusedOperations();
+	testHierarchicalBitSet();
+	testCopyOnWriteBitSet();
+	testPersistentBitSet();
+	testTrackedBitSet();
+	testComplementView();
+	testRangeOperations();
+	testRandomFill();
+	testPositions();
+	testPackedIntArray();
+	testEliasFano();
 }
\ No newline at end of file
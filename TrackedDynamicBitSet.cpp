@@ -0,0 +1,375 @@
+#include "TrackedDynamicBitSet.hpp"
+
+#include "BitOperations.hpp"
+#include "DynamicBitSetKernels.hpp"
+
+#include <cstring>
+#include <stdexcept>
+
+namespace TwilightDream
+{
+	namespace
+	{
+		void write_varint( std::vector<uint8_t>& output, uint64_t value )
+		{
+			while ( value >= 0x80 )
+			{
+				output.push_back( static_cast<uint8_t>( value | 0x80 ) );
+				value >>= 7;
+			}
+			output.push_back( static_cast<uint8_t>( value ) );
+		}
+
+		uint64_t read_varint( const std::vector<uint8_t>& input, size_t& position )
+		{
+			uint64_t value = 0;
+			for ( unsigned shift = 0; shift < 64; shift += 7 )
+			{
+				if ( position >= input.size() )
+				{
+					throw std::invalid_argument( "TrackedDynamicBitSet: truncated delta" );
+				}
+				const uint8_t byte = input[ position++ ];
+				value |= uint64_t( byte & 0x7F ) << shift;
+				if ( ( byte & 0x80 ) == 0 )
+				{
+					return value;
+				}
+			}
+			throw std::invalid_argument( "TrackedDynamicBitSet: malformed varint in delta" );
+		}
+
+		// 一个块的 XOR 载荷：交替写出零块的游程和非零块的字面量
+		void write_payload( std::vector<uint8_t>& output, const uint32_t* chunks, size_t count )
+		{
+			size_t chunk = 0;
+			while ( chunk < count )
+			{
+				const size_t zero_begin = chunk;
+				while ( chunk < count && chunks[ chunk ] == 0 )
+				{
+					++chunk;
+				}
+				const size_t literal_begin = chunk;
+				while ( chunk < count && chunks[ chunk ] != 0 )
+				{
+					++chunk;
+				}
+
+				write_varint( output, literal_begin - zero_begin );
+				write_varint( output, chunk - literal_begin );
+				for ( size_t literal = literal_begin; literal < chunk; ++literal )
+				{
+					for ( unsigned byte = 0; byte < 4; ++byte )
+					{
+						output.push_back( static_cast<uint8_t>( chunks[ literal ] >> ( byte * 8 ) ) );
+					}
+				}
+			}
+		}
+
+		// 把块 [ first_chunk, first_chunk + count ) 的差异 (current XOR base) 编码为一个条目，没有差异时返回 false
+		template <typename LoadBase, typename LoadCurrent>
+		bool write_entry( std::vector<uint8_t>& output, size_t block_gap, size_t count, LoadBase&& load_base, LoadCurrent&& load_current )
+		{
+			uint32_t difference[ TrackedDynamicBitSet::block_chunks ];
+			uint32_t any = 0;
+			for ( size_t chunk = 0; chunk < count; ++chunk )
+			{
+				difference[ chunk ] = load_current( chunk ) ^ load_base( chunk );
+				any |= difference[ chunk ];
+			}
+			if ( any == 0 )
+			{
+				return false;
+			}
+			write_varint( output, block_gap );
+			write_payload( output, difference, count );
+			return true;
+		}
+
+		// 条目的数量在写完之后才知道，先写条目再拼上头部
+		std::vector<uint8_t> finish_delta( size_t bit_size, size_t entry_count, const std::vector<uint8_t>& entries )
+		{
+			std::vector<uint8_t> delta;
+			delta.reserve( entries.size() + 20 );
+			write_varint( delta, bit_size );
+			write_varint( delta, entry_count );
+			delta.insert( delta.end(), entries.begin(), entries.end() );
+			return delta;
+		}
+	}  // namespace
+
+	/* TrackedDynamicBitSet */
+
+	TrackedDynamicBitSet::TrackedDynamicBitSet( size_t bit_size )
+		: bits_value( bit_size, false ), data_size( bit_size )
+	{
+		dirty_blocks.assign( ( block_count() + 63 ) / 64, 0 );
+	}
+
+	TrackedDynamicBitSet::TrackedDynamicBitSet( const DynamicBitSet& other )
+		: TrackedDynamicBitSet( other.bit_size() )
+	{
+		bits_apply_range( BitRangeOperation::Copy, bits_value.chunk_data(), 0, other.chunk_data(), 0, data_size );
+	}
+
+	void TrackedDynamicBitSet::touch_block( size_t block )
+	{
+		if ( is_dirty( block ) )
+		{
+			return;
+		}
+		dirty_blocks[ block / 64 ] |= uint64_t( 1 ) << ( block % 64 );
+
+		BlockChunks				 preimage {};
+		const BooleanBitWrapper* chunks = bits_value.chunk_data() + block * block_chunks;
+		std::copy( chunks, chunks + block_chunk_count( block ), preimage.begin() );
+		checkpoint_blocks.emplace( block, preimage );
+	}
+
+	void TrackedDynamicBitSet::set_bit( bool value, size_t index )
+	{
+		check_index( index );
+		BooleanBitWrapper& chunk = bits_value.chunk_data()[ index / 32 ];
+		if ( chunk.bit_get( index % 32 ) != value )
+		{
+			touch_block( index / block_bits );
+			chunk.bit_set( value, index % 32 );
+		}
+	}
+
+	void TrackedDynamicBitSet::flip( size_t index )
+	{
+		check_index( index );
+		touch_block( index / block_bits );
+		bits_value.chunk_data()[ index / 32 ].bits ^= uint32_t( 1 ) << ( index % 32 );
+	}
+
+	void TrackedDynamicBitSet::set( size_t pos, size_t len, bool value )
+	{
+		if ( len == 0 )
+		{
+			return;
+		}
+		check_index( pos );
+		check_index( pos + len - 1 );
+
+		// 范围在每个块中的部分已经全部是 value 时不修改，块保持干净
+		const size_t	   end = pos + len;
+		BooleanBitWrapper* chunks = bits_value.chunk_data();
+		for ( size_t block = pos / block_bits; block <= ( end - 1 ) / block_bits; ++block )
+		{
+			const size_t first = std::max( pos, block * block_bits );
+			const size_t last = std::min( end, block * block_bits + block_bits );
+			if ( bits_population_count( chunks, first, last - first ) != ( value ? last - first : 0 ) )
+			{
+				touch_block( block );
+				bits_assign_range( chunks, first, last - first, value );
+			}
+		}
+	}
+
+	template <typename Operation>
+	void TrackedDynamicBitSet::update_blocks( Operation&& operation )
+	{
+		BooleanBitWrapper* chunks = bits_value.chunk_data();
+		for ( size_t block = 0; block < block_count(); ++block )
+		{
+			const size_t	   first_chunk = block * block_chunks;
+			const size_t	   count = block_chunk_count( block );
+			BlockChunks		   updated;
+			std::copy( chunks + first_chunk, chunks + first_chunk + count, updated.begin() );
+			operation( updated.data(), first_chunk, count );
+			// 最后一个块中超出 bit_size() 的比特在比较之前去掉 (其余的块 valid_bits 等于 count * 32)
+			const size_t valid_bits = std::min( block_bits, data_size - block * block_bits );
+			bits_assign_range( updated.data(), valid_bits, count * 32 - valid_bits, false );
+			if ( std::memcmp( updated.data(), chunks + first_chunk, count * sizeof( BooleanBitWrapper ) ) != 0 )
+			{
+				touch_block( block );
+				std::copy( updated.begin(), updated.begin() + count, chunks + first_chunk );
+			}
+		}
+	}
+
+	TrackedDynamicBitSet& TrackedDynamicBitSet::and_operation( const DynamicBitSet& other )
+	{
+		const size_t source_count = other.chunk_count();
+		update_blocks( [ & ]( BooleanBitWrapper* updated, size_t first_chunk, size_t count ) {
+			const size_t overlap = first_chunk < source_count ? std::min( count, source_count - first_chunk ) : 0;
+			chunks_and( updated, other.chunk_data() + first_chunk, overlap );
+			std::fill( updated + overlap, updated + count, BooleanBitWrapper( 0 ) );
+		} );
+		return *this;
+	}
+
+	TrackedDynamicBitSet& TrackedDynamicBitSet::or_operation( const DynamicBitSet& other )
+	{
+		const size_t source_count = other.chunk_count();
+		update_blocks( [ & ]( BooleanBitWrapper* updated, size_t first_chunk, size_t count ) {
+			if ( first_chunk < source_count )
+			{
+				chunks_or( updated, other.chunk_data() + first_chunk, std::min( count, source_count - first_chunk ) );
+			}
+		} );
+		return *this;
+	}
+
+	TrackedDynamicBitSet& TrackedDynamicBitSet::xor_operation( const DynamicBitSet& other )
+	{
+		const size_t source_count = other.chunk_count();
+		update_blocks( [ & ]( BooleanBitWrapper* updated, size_t first_chunk, size_t count ) {
+			if ( first_chunk < source_count )
+			{
+				chunks_xor( updated, other.chunk_data() + first_chunk, std::min( count, source_count - first_chunk ) );
+			}
+		} );
+		return *this;
+	}
+
+	void TrackedDynamicBitSet::checkpoint()
+	{
+		std::fill( dirty_blocks.begin(), dirty_blocks.end(), 0 );
+		checkpoint_blocks.clear();
+	}
+
+	std::vector<uint8_t> TrackedDynamicBitSet::export_delta() const
+	{
+		std::vector<uint8_t>	 entries;
+		size_t					 entry_count = 0;
+		size_t					 next_block = 0;
+		const BooleanBitWrapper* chunks = bits_value.chunk_data();
+
+		// 按块序号的顺序遍历脏块比特图
+		for ( size_t word = 0; word < dirty_blocks.size(); ++word )
+		{
+			for ( uint64_t pending = dirty_blocks[ word ]; pending != 0; pending &= pending - 1 )
+			{
+				const size_t	   block = word * 64 + count_trailing_zeros64( pending );
+				const size_t	   first_chunk = block * block_chunks;
+				const BlockChunks& preimage = checkpoint_blocks.at( block );
+				const bool		   written = write_entry(
+					  entries, block - next_block, block_chunk_count( block ), [ & ]( size_t chunk ) { return preimage[ chunk ].bits; }, [ & ]( size_t chunk ) { return chunks[ first_chunk + chunk ].bits; } );
+				if ( written )
+				{
+					++entry_count;
+					next_block = block + 1;
+				}
+			}
+		}
+		return finish_delta( data_size, entry_count, entries );
+	}
+
+	std::vector<uint8_t> TrackedDynamicBitSet::export_delta_and_checkpoint()
+	{
+		std::vector<uint8_t> delta = export_delta();
+		checkpoint();
+		return delta;
+	}
+
+	std::vector<uint8_t> TrackedDynamicBitSet::make_delta( const DynamicBitSet& base, const DynamicBitSet& current )
+	{
+		const size_t		 chunk_count = ( current.bit_size() + 31 ) / 32;
+		const size_t		 blocks = ( chunk_count + block_chunks - 1 ) / block_chunks;
+		std::vector<uint8_t> entries;
+		size_t				 entry_count = 0;
+		size_t				 next_block = 0;
+
+		auto load = []( const DynamicBitSet& bits, size_t chunk ) -> uint32_t {
+			return chunk < bits.chunk_count() ? bits.chunk_data()[ chunk ].bits : 0;
+		};
+		for ( size_t block = 0; block < blocks; ++block )
+		{
+			const size_t first_chunk = block * block_chunks;
+			const size_t count = std::min( block_chunks, chunk_count - first_chunk );
+			// 只比较 current 的有效比特 (base 中超出 current.bit_size() 的比特不属于增量)
+			auto load_base = [ & ]( size_t chunk ) {
+				uint32_t value = load( base, first_chunk + chunk );
+				if ( first_chunk + chunk == chunk_count - 1 && current.bit_size() % 32 != 0 )
+				{
+					value &= ( uint32_t( 1 ) << ( current.bit_size() % 32 ) ) - 1;
+				}
+				return value;
+			};
+			auto load_current = [ & ]( size_t chunk ) {
+				uint32_t value = load( current, first_chunk + chunk );
+				if ( first_chunk + chunk == chunk_count - 1 && current.bit_size() % 32 != 0 )
+				{
+					value &= ( uint32_t( 1 ) << ( current.bit_size() % 32 ) ) - 1;
+				}
+				return value;
+			};
+			if ( write_entry( entries, block - next_block, count, load_base, load_current ) )
+			{
+				++entry_count;
+				next_block = block + 1;
+			}
+		}
+		return finish_delta( current.bit_size(), entry_count, entries );
+	}
+
+	void TrackedDynamicBitSet::apply_delta( const std::vector<uint8_t>& delta )
+	{
+		size_t position = 0;
+		if ( read_varint( delta, position ) != data_size )
+		{
+			throw std::invalid_argument( "TrackedDynamicBitSet: delta was exported from a bit set of a different size" );
+		}
+
+		// 先完整地解码并检查，再修改内容，格式错误时保持不变
+		const uint64_t										   entry_count = read_varint( delta, position );
+		std::vector<std::pair<size_t, BlockChunks>>			   blocks;
+		size_t												   next_block = 0;
+		for ( uint64_t entry = 0; entry < entry_count; ++entry )
+		{
+			const uint64_t gap = read_varint( delta, position );
+			if ( gap >= block_count() || next_block + gap >= block_count() )
+			{
+				throw std::invalid_argument( "TrackedDynamicBitSet: block index out of range in delta" );
+			}
+			const size_t block = next_block + gap;
+			const size_t count = block_chunk_count( block );
+
+			BlockChunks payload {};
+			size_t		chunk = 0;
+			while ( chunk < count )
+			{
+				const uint64_t zero_chunks = read_varint( delta, position );
+				const uint64_t literal_chunks = read_varint( delta, position );
+				if ( zero_chunks > count - chunk || literal_chunks > count - chunk - zero_chunks || zero_chunks + literal_chunks == 0 )
+				{
+					throw std::invalid_argument( "TrackedDynamicBitSet: malformed payload in delta" );
+				}
+				chunk += zero_chunks;
+				if ( delta.size() - position < literal_chunks * 4 )
+				{
+					throw std::invalid_argument( "TrackedDynamicBitSet: truncated delta" );
+				}
+				for ( uint64_t literal = 0; literal < literal_chunks; ++literal, ++chunk )
+				{
+					uint32_t value = 0;
+					for ( unsigned byte = 0; byte < 4; ++byte )
+					{
+						value |= uint32_t( delta[ position++ ] ) << ( byte * 8 );
+					}
+					payload[ chunk ].bits = value;
+				}
+			}
+			blocks.emplace_back( block, payload );
+			next_block = block + 1;
+		}
+		if ( position != delta.size() )
+		{
+			throw std::invalid_argument( "TrackedDynamicBitSet: trailing bytes after delta" );
+		}
+
+		BooleanBitWrapper* chunks = bits_value.chunk_data();
+		for ( const auto& [ block, payload ] : blocks )
+		{
+			touch_block( block );
+			chunks_xor( chunks + block * block_chunks, payload.data(), block_chunk_count( block ) );
+		}
+		// 增量来自另一个副本，其中超出 bit_size() 的比特不能留下
+		bits_assign_range( chunks, data_size, bits_value.chunk_count() * 32 - data_size, false );
+	}
+}  // namespace TwilightDream
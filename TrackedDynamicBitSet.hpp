@@ -0,0 +1,133 @@
+#pragma once
+
+#include <cstdint>
+#include <cstddef>
+
+#include <algorithm>
+#include <array>
+#include <unordered_map>
+#include <vector>
+
+#include "DynamicBitSet.hpp"
+
+namespace TwilightDream
+{
+	/*
+		TrackedDynamicBitSet
+		记录自上一个检查点 (checkpoint) 以来被修改过的块的固定大小比特集，用于在进程之间增量地同步很大的比特集。
+		- 每个块是 16 个比特块 (512 比特，一条 cache line)。脏块用一个比特图记录；
+		  一个块第一次被修改时保存它在检查点时的内容 (前像)，所以额外的内存只与被修改的块数成正比。
+		- export_delta() 输出每个脏块的 (块序号, 当前内容 XOR 前像)，内容没有变化的脏块被省略。
+		  apply_delta() 把增量 XOR 到另一个副本上，所以同步的代价只与修改量有关，与集合的大小无关。
+		- 只能通过本类的接口修改比特 (bits() 只返回常量引用)。批量运算在比较块的新旧内容之前就去掉超出 bit_size() 的比特，
+		  所以较长的操作数不会让最后一个块变脏，增量中也不会出现这些比特。
+
+		增量的格式 (所有整数都是 LEB128 变长编码，比特块是小端的 32 位整数)：
+			delta   := bit_size  entry_count  entry*
+			entry   := block_gap  payload          block_gap 是块序号减去 (上一个块序号 + 1)，第一个块减去 0
+			payload := ( zero_chunks  literal_chunks  literal* )*   全零的比特块按游程编码，直到覆盖整个块
+	*/
+	class TrackedDynamicBitSet
+	{
+	public:
+		static constexpr size_t block_chunks = 16;
+		static constexpr size_t block_bits = block_chunks * 32;
+
+		explicit TrackedDynamicBitSet( size_t bit_size = 0 );
+
+		// bit_size() 取 other.bit_size()，构造完成时的内容就是第一个检查点 (没有脏块)
+		explicit TrackedDynamicBitSet( const DynamicBitSet& other );
+
+		size_t bit_size() const noexcept
+		{
+			return data_size;
+		}
+
+		size_t block_count() const noexcept
+		{
+			return ( bits_value.chunk_count() + block_chunks - 1 ) / block_chunks;
+		}
+
+		// 底层的比特 (bit_size() 与构造时相同)
+		const DynamicBitSet& bits() const noexcept
+		{
+			return bits_value;
+		}
+
+		bool test( size_t index ) const
+		{
+			check_index( index );
+			return bits_value.chunk_data()[ index / 32 ].bit_get( index % 32 );
+		}
+
+		bool operator[]( size_t index ) const
+		{
+			return test( index );
+		}
+
+		// 参数顺序与 DynamicBitSet::set_bit 相同；值没有改变时块不会变脏
+		void set_bit( bool value, size_t index );
+
+		void flip( size_t index );
+
+		// 把 [ pos, pos + len ) 设置为 value
+		void set( size_t pos, size_t len, bool value );
+
+		// 批量运算：other 比 bit_size() 短的部分视为 0，超出的部分被忽略；只有内容真正改变的块才变脏
+		TrackedDynamicBitSet& and_operation( const DynamicBitSet& other );
+		TrackedDynamicBitSet& or_operation( const DynamicBitSet& other );
+		TrackedDynamicBitSet& xor_operation( const DynamicBitSet& other );
+
+		// 第 block 个块自检查点以来是否被修改过
+		bool is_dirty( size_t block ) const noexcept
+		{
+			return ( dirty_blocks[ block / 64 ] >> ( block % 64 ) ) & 1;
+		}
+
+		size_t dirty_block_count() const noexcept
+		{
+			return checkpoint_blocks.size();
+		}
+
+		// 把当前内容作为新的检查点：清除脏块记录和保存的前像
+		void checkpoint();
+
+		// 自检查点以来的增量 (不改变状态)
+		std::vector<uint8_t> export_delta() const;
+
+		// 先 export_delta() 再 checkpoint()
+		std::vector<uint8_t> export_delta_and_checkpoint();
+
+		// 把增量 XOR 到当前内容上 (被改变的块变脏)；bit_size() 不同或者格式错误时抛出 std::invalid_argument
+		void apply_delta( const std::vector<uint8_t>& delta );
+
+		// 从 base 到 current 的增量 (逐块比较，bit_size() 取 current 的)，可以用于第一次同步
+		static std::vector<uint8_t> make_delta( const DynamicBitSet& base, const DynamicBitSet& current );
+
+	private:
+		using BlockChunks = std::array<BooleanBitWrapper, block_chunks>;
+
+		DynamicBitSet						   bits_value;
+		std::vector<uint64_t>				   dirty_blocks;
+		std::unordered_map<size_t, BlockChunks> checkpoint_blocks;
+		size_t								   data_size = 0;
+
+		// 第 block 个块中有效的比特块数量
+		size_t block_chunk_count( size_t block ) const noexcept
+		{
+			return std::min( block_chunks, bits_value.chunk_count() - block * block_chunks );
+		}
+
+		// 在修改第 block 个块之前调用：第一次修改时保存前像并标记为脏
+		void touch_block( size_t block );
+
+		// 对每个块的副本调用 operation( chunks, first_chunk, count )，结果与原内容不同时才写回 (并让块变脏)
+		template <typename Operation>
+		void update_blocks( Operation&& operation );
+
+		void check_index( size_t index ) const
+		{
+			DefaultBitAccess::check_index( index, data_size, "Index out of range from tracked bit set" );
+		}
+	};
+}  // namespace TwilightDream